@@ -31,6 +31,7 @@
 #include <zmq.hpp>
 #include <zmq_addon.hpp>
 
+#include "constellation/controller/ControllerConfiguration.hpp"
 #include "constellation/core/chirp/Manager.hpp"
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/log/log.hpp"
@@ -395,9 +396,35 @@ CSCP1Message Controller::sendCommand(std::string_view satellite_name, CSCP1Messa
     }
 }
 
+void Controller::update_config(Connection& conn,
+                               std::string_view verb,
+                               const CommandPayload& payload,
+                               const CSCP1Message& reply) {
+    if(reply.getVerb().first != CSCP1Message::Type::SUCCESS || !std::holds_alternative<Dictionary>(payload)) {
+        return;
+    }
+
+    const auto verb_lc = transform(verb, ::tolower);
+    const auto& config = std::get<Dictionary>(payload);
+    if(verb_lc == "initialize") {
+        conn.config = config;
+    } else if(verb_lc == "reconfigure") {
+        for(const auto& [key, value] : config) {
+            conn.config.insert_or_assign(key, value);
+        }
+    }
+}
+
 CSCP1Message Controller::sendCommand(std::string_view satellite_name, std::string verb, const CommandPayload& payload) {
-    auto send_msg = build_message(std::move(verb), payload);
-    return sendCommand(satellite_name, send_msg);
+    auto send_msg = build_message(verb, payload);
+    auto reply = sendCommand(satellite_name, send_msg);
+
+    const std::lock_guard connection_lock {connection_mutex_};
+    const auto sat = connections_.find(satellite_name);
+    if(sat != connections_.end()) {
+        update_config(sat->second, verb, payload, reply);
+    }
+    return reply;
 }
 
 std::map<std::string, CSCP1Message> Controller::sendCommands(CSCP1Message& cmd) {
@@ -430,8 +457,17 @@ std::map<std::string, CSCP1Message> Controller::sendCommands(CSCP1Message& cmd)
 }
 
 std::map<std::string, CSCP1Message> Controller::sendCommands(std::string verb, const CommandPayload& payload) {
-    auto send_msg = build_message(std::move(verb), payload);
-    return sendCommands(send_msg);
+    auto send_msg = build_message(verb, payload);
+    auto replies = sendCommands(send_msg);
+
+    const std::lock_guard connection_lock {connection_mutex_};
+    for(const auto& [name, reply] : replies) {
+        const auto sat = connections_.find(name);
+        if(sat != connections_.end()) {
+            update_config(sat->second, verb, payload, reply);
+        }
+    }
+    return replies;
 }
 
 std::map<std::string, CSCP1Message> Controller::sendCommands(const std::string& verb,
@@ -446,10 +482,59 @@ std::map<std::string, CSCP1Message> Controller::sendCommands(const std::string&
         // Start command sending and store future:
         futures.emplace(name, std::async(std::launch::async, [&]() {
                             // Prepare message:
-                            auto send_msg = (payloads.contains(name)
-                                                 ? build_message(verb, payloads.at(name))
-                                                 : CSCP1Message({controller_name_}, {CSCP1Message::Type::REQUEST, verb}));
-                            return send_receive(sat, send_msg);
+                            const auto payload_it = payloads.find(name);
+                            if(payload_it == payloads.end()) {
+                                auto send_msg = CSCP1Message({controller_name_}, {CSCP1Message::Type::REQUEST, verb});
+                                return send_receive(sat, send_msg);
+                            }
+                            auto send_msg = build_message(verb, payload_it->second);
+                            auto reply = send_receive(sat, send_msg);
+                            update_config(sat, verb, payload_it->second, reply);
+                            return reply;
+                        }));
+    }
+
+    for(auto& [sat, future] : futures) {
+        try {
+            auto reply = future.get();
+            const auto name = reply.getHeader().getSender();
+
+            // Store received reply:
+            replies.emplace(name, std::move(reply));
+        } catch(const NetworkError& e) {
+            LOG(logger_, CRITICAL) << e.what();
+
+            // Create ERROR reply instead
+            CSCP1Message reply {sat, {CSCP1Message::Type::ERROR, e.what()}};
+            replies.emplace(sat, std::move(reply));
+        }
+    }
+    return replies;
+}
+
+std::map<std::string, CSCP1Message> Controller::sendReconfigure(const ControllerConfiguration& configuration) {
+
+    std::map<std::string, std::future<CSCP1Message>> futures {};
+    std::map<std::string, CSCP1Message> replies {};
+
+    const std::lock_guard connection_lock {connection_mutex_};
+
+    for(auto& [name, sat] : connections_) {
+        // Only send keys which changed with respect to the applied configuration
+        auto changes = ControllerConfiguration::diff(sat.config, configuration.getSatelliteConfiguration(name));
+        if(changes.empty()) {
+            LOG(logger_, DEBUG) << "Configuration of " << name << " unchanged, skipping reconfigure";
+            continue;
+        }
+        LOG(logger_, DEBUG) << "Reconfiguring " << name << " with " << changes.size() << " changed keys";
+        const CommandPayload payload = std::move(changes);
+
+        // Start command sending and store future:
+        futures.emplace(name, std::async(std::launch::async, [&, payload]() {
+                            auto send_msg = build_message("reconfigure", payload);
+                            auto reply = send_receive(sat, send_msg);
+                            update_config(sat, "reconfigure", payload, reply);
+                            return reply;
                         }));
     }
 
@@ -29,6 +29,7 @@
 #include <zmq.hpp>
 
 #include "constellation/build.hpp"
+#include "constellation/controller/ControllerConfiguration.hpp"
 #include "constellation/core/chirp/Manager.hpp"
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/heartbeat/HeartbeatRecv.hpp"
@@ -77,6 +78,9 @@ namespace constellation::controller {
             std::string last_message {}; // NOLINT(readability-redundant-member-init)
             config::Dictionary commands {};
 
+            /** Configuration last applied successfully via initialize or reconfigure */
+            config::Dictionary config {};
+
             /** Heartbeat status */
             std::chrono::milliseconds interval {10000};
             std::chrono::system_clock::time_point last_heartbeat {std::chrono::system_clock::now()};
@@ -188,6 +192,19 @@ namespace constellation::controller {
         std::map<std::string, message::CSCP1Message> sendCommands(const std::string& verb,
                                                                   const std::map<std::string, CommandPayload>& payloads);
 
+        /**
+         * @brief Send changed configurations to all connected satellites
+         * @details For each connected satellite the configuration is obtained from the provided controller configuration
+         * and compared to the configuration last applied successfully via the `initialize` or `reconfigure` commands. Only
+         * the added or changed keys are sent as partial configuration with the `reconfigure` command, satellites without
+         * changes are skipped. The response from all satellites which received a command is returned as a map.
+         *
+         * @param configuration Controller configuration
+         *
+         * @return Map of satellite canonical names and their CSCP response messages
+         */
+        std::map<std::string, message::CSCP1Message> sendReconfigure(const ControllerConfiguration& configuration);
+
         /**
          * @brief Helper to check if all connected satellites are in a given state
          *
@@ -298,6 +315,19 @@ namespace constellation::controller {
          */
         message::CSCP1Message build_message(std::string verb, const CommandPayload& payload) const;
 
+        /**
+         * @brief Helper to keep track of the configuration applied to a satellite
+         *
+         * @param conn Target connection
+         * @param verb Command which was sent
+         * @param payload Payload of the command
+         * @param reply CSCP response message
+         */
+        static void update_config(Connection& conn,
+                                  std::string_view verb,
+                                  const CommandPayload& payload,
+                                  const message::CSCP1Message& reply);
+
         /**
          * @brief Callback helper for CHIPR service discovery
          *
@@ -9,10 +9,17 @@
 
 #include "ControllerConfiguration.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -26,15 +33,65 @@
 
 #include "constellation/controller/exceptions.hpp"
 #include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/config/Value.hpp"
 #include "constellation/core/log/log.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/string_hash_map.hpp"
 
 using namespace constellation::controller;
 using namespace constellation::config;
 using namespace constellation::log;
 using namespace constellation::utils;
 
+namespace {
+    // Dictionaries parsed from TOML data
+    struct ParsedConfiguration {
+        Dictionary global_config;
+        string_hash_map<Dictionary> type_configs;
+        string_hash_map<Dictionary> satellite_configs;
+    };
+
+    // Cache of parsed configurations keyed by the TOML data, oldest entries are evicted first
+    class ParseCache {
+    public:
+        std::optional<ParsedConfiguration> find(std::string_view toml) {
+            const std::lock_guard lock {mutex_};
+            // Entries are compared by their full content, such that different data can never be mistaken for each other
+            const auto it = entries_.find(toml);
+            if(it == entries_.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        void insert(std::string_view toml, ParsedConfiguration parsed) {
+            const std::lock_guard lock {mutex_};
+            const auto [it, inserted] = entries_.insert_or_assign(std::string(toml), std::move(parsed));
+            if(inserted) {
+                order_.push_back(it);
+            }
+            while(order_.size() > max_entries) {
+                entries_.erase(order_.front());
+                order_.pop_front();
+            }
+        }
+
+    private:
+        using Entries = std::map<std::string, ParsedConfiguration, std::less<>>;
+
+        static constexpr std::size_t max_entries = 8;
+        std::mutex mutex_;
+        Entries entries_;
+        std::deque<Entries::iterator> order_;
+    };
+
+    ParseCache& parse_cache() {
+        static ParseCache cache {};
+        return cache;
+    }
+} // namespace
+
 ControllerConfiguration::ControllerConfiguration(const std::filesystem::path& path) {
     // Check if file exists
     if(!std::filesystem::is_regular_file(path)) {
@@ -90,6 +147,20 @@ std::string ControllerConfiguration::getAsTOML() const {
                 tbl.emplace(key, get_toml_array(value.get<std::vector<double>>()));
             } else if(std::holds_alternative<std::vector<std::int64_t>>(value)) {
                 tbl.emplace(key, get_toml_array(value.get<std::vector<std::int64_t>>()));
+            } else if(std::holds_alternative<config::TypedArray>(value)) {
+                const auto& typed_array = std::get<config::TypedArray>(value);
+                const auto dtype = typed_array.getDType();
+                if(dtype == config::DType::FLOAT || dtype == config::DType::DOUBLE) {
+                    tbl.emplace(key, get_toml_array(value.get<std::vector<double>>()));
+                } else if(dtype == config::DType::UINT64 &&
+                          std::ranges::any_of(typed_array.span<std::uint64_t>(), [](std::uint64_t element) {
+                              return element > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+                          })) {
+                    // TOML only supports signed 64-bit integers
+                    throw ConfigFileTypeError(key, "Value exceeds range of 64-bit signed integers");
+                } else {
+                    tbl.emplace(key, get_toml_array(value.get<std::vector<std::int64_t>>()));
+                }
             }
 
             // FIXME timestamp? char vector?
@@ -127,6 +198,20 @@ std::string ControllerConfiguration::getAsTOML() const {
 }
 
 void ControllerConfiguration::parse_toml(std::string_view toml) {
+    auto cached = parse_cache().find(toml);
+    if(cached.has_value()) {
+        LOG(config_parser_logger_, DEBUG) << "Using cached configuration with identical content";
+        global_config_ = std::move(cached->global_config);
+        type_configs_ = std::move(cached->type_configs);
+        satellite_configs_ = std::move(cached->satellite_configs);
+        return;
+    }
+
+    parse_toml_uncached(toml);
+    parse_cache().insert(toml, {global_config_, type_configs_, satellite_configs_});
+}
+
+void ControllerConfiguration::parse_toml_uncached(std::string_view toml) {
     toml::table tbl {};
     try {
         tbl = toml::parse(toml);
@@ -270,6 +355,18 @@ void ControllerConfiguration::addSatelliteConfiguration(std::string_view canonic
     }
 }
 
+Dictionary ControllerConfiguration::diff(const Dictionary& previous, const Dictionary& current) {
+    Dictionary changes {};
+    for(const auto& [key, value] : current) {
+        const auto previous_it = previous.find(key);
+        if(previous_it == previous.end() ||
+           static_cast<const value_t&>(previous_it->second) != static_cast<const value_t&>(value)) {
+            changes.emplace(key, value);
+        }
+    }
+    return changes;
+}
+
 Dictionary ControllerConfiguration::getSatelliteConfiguration(std::string_view canonical_name) const {
     LOG(config_parser_logger_, TRACE) << "Fetching configuration for " << canonical_name;
 
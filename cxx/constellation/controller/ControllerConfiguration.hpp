@@ -88,12 +88,30 @@ namespace constellation::controller {
 
         CNSTLN_API void addSatelliteConfiguration(std::string_view canonical_name, config::Dictionary config);
 
+        /**
+         * @brief Compute the changes between two configuration dictionaries
+         *
+         * This can be used to obtain a partial configuration for the `reconfigure` transition from the configuration last
+         * applied to a satellite and the configuration obtained from `getSatelliteConfiguration()`.
+         *
+         * @note Keys which are only present in the previous configuration are not contained since they cannot be removed via
+         *       reconfiguration
+         *
+         * @param previous Previously applied configuration
+         * @param current Current configuration
+         * @return Dictionary with all keys which were added or whose value changed, empty if nothing changed
+         */
+        CNSTLN_API static config::Dictionary diff(const config::Dictionary& previous, const config::Dictionary& current);
+
         CNSTLN_API std::string getAsTOML() const;
 
     private:
         /**
          * @brief Parse a string view with TOML data into dictionaries
          *
+         * Parsed dictionaries are cached process-wide keyed by the TOML data, such that loading an unchanged configuration
+         * file again does not require parsing.
+         *
          * @param toml TOML data as string
          *
          * @throws ConfigFileNotFoundError if the configuration file could not be found or opened
@@ -102,6 +120,13 @@ namespace constellation::controller {
          */
         void parse_toml(std::string_view toml);
 
+        /**
+         * @brief Parse TOML data into dictionaries without using the cache
+         *
+         * @param toml TOML data as string
+         */
+        void parse_toml_uncached(std::string_view toml);
+
     private:
         /* Key-value pairs of the global satellite section */
         config::Dictionary global_config_;
@@ -15,6 +15,7 @@
 #include <iomanip>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "constellation/core/config/Dictionary.hpp"
@@ -30,7 +31,7 @@ Configuration::Configuration(const Dictionary& dict, bool mark_used) {
     }
 };
 
-std::size_t Configuration::count(std::initializer_list<std::string> keys) const {
+std::size_t Configuration::count(std::initializer_list<std::string_view> keys) const {
     if(keys.size() == 0) {
         throw std::invalid_argument("list of keys cannot be empty");
     }
@@ -44,42 +45,41 @@ std::size_t Configuration::count(std::initializer_list<std::string> keys) const
     return found;
 }
 
-std::string Configuration::getText(const std::string& key) const {
-    try {
-        const auto& dictval = config_.at(utils::transform(key, ::tolower));
-        dictval.markUsed();
-        return dictval.str();
-    } catch(std::out_of_range& e) {
-        throw MissingKeyError(key);
+std::string Configuration::getText(std::string_view key) const {
+    const auto key_it = config_.find(key);
+    if(key_it == config_.end()) {
+        throw MissingKeyError(utils::to_string(key));
     }
+    key_it->second.markUsed();
+    return key_it->second.str();
 }
 
 /**
  * For a relative path the absolute path of the configuration file is prepended. Absolute paths are not changed.
  */
-std::filesystem::path Configuration::getPath(const std::string& key, bool check_exists) const {
+std::filesystem::path Configuration::getPath(std::string_view key, bool check_exists) const {
     try {
         return path_to_absolute(get<std::string>(key), check_exists);
     } catch(std::invalid_argument& e) {
-        throw InvalidValueError(getText(key), key, e.what());
+        throw InvalidValueError(getText(key), utils::to_string(key), e.what());
     }
 }
 /**
  * For a relative path the absolute path of the configuration file is prepended. Absolute paths are not changed.
  */
-std::filesystem::path Configuration::getPathWithExtension(const std::string& key,
+std::filesystem::path Configuration::getPathWithExtension(std::string_view key,
                                                           const std::string& extension,
                                                           bool check_exists) const {
     try {
         return path_to_absolute(std::filesystem::path(get<std::string>(key)).replace_extension(extension), check_exists);
     } catch(std::invalid_argument& e) {
-        throw InvalidValueError(getText(key), key, e.what());
+        throw InvalidValueError(getText(key), utils::to_string(key), e.what());
     }
 }
 /**
  * For all relative paths the absolute path of the configuration file is prepended. Absolute paths are not changed.
  */
-std::vector<std::filesystem::path> Configuration::getPathArray(const std::string& key, bool check_exists) const {
+std::vector<std::filesystem::path> Configuration::getPathArray(std::string_view key, bool check_exists) const {
     const auto vals = getArray<std::string>(key);
     std::vector<std::filesystem::path> path_array {};
     path_array.reserve(vals.size());
@@ -90,7 +90,7 @@ std::vector<std::filesystem::path> Configuration::getPathArray(const std::string
             path_array.emplace_back(path_to_absolute(path, check_exists));
         }
     } catch(std::invalid_argument& e) {
-        throw InvalidValueError(getText(key), key, e.what());
+        throw InvalidValueError(getText(key), utils::to_string(key), e.what());
     }
     return path_array;
 }
@@ -98,14 +98,12 @@ std::vector<std::filesystem::path> Configuration::getPathArray(const std::string
 /**
  *  The alias is only used if new key does not exist but old key does. The old key is automatically marked as used.
  */
-void Configuration::setAlias(const std::string& new_key, const std::string& old_key, bool warn) {
+void Configuration::setAlias(std::string_view new_key, std::string_view old_key, bool warn) {
     if(!has(old_key) || has(new_key)) {
         return;
     }
 
-    const auto new_key_lc = utils::transform(new_key, ::tolower);
-    const auto old_key_lc = utils::transform(old_key, ::tolower);
-    config_[new_key_lc] = config_.at(old_key_lc);
+    config_.emplace(utils::transform(new_key, ::tolower), config_.find(old_key)->second);
 
     LOG_IF(WARNING, warn) << "Parameter " << std::quoted(old_key) << " is deprecated and superseded by "
                           << std::quoted(new_key);
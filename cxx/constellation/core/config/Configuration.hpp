@@ -15,6 +15,7 @@
 #include <initializer_list>
 #include <map>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -110,7 +111,7 @@ namespace constellation::config {
          *
          * @note Keys are handled case-insensitively
          */
-        bool has(const std::string& key) const { return config_.contains(utils::transform(key, ::tolower)); }
+        bool has(std::string_view key) const { return config_.contains(key); }
 
         /**
          * @brief Check how many of the given keys are defined
@@ -122,7 +123,7 @@ namespace constellation::config {
          *
          * @note Keys are handled case-insensitively
          */
-        CNSTLN_API std::size_t count(std::initializer_list<std::string> keys) const;
+        CNSTLN_API std::size_t count(std::initializer_list<std::string_view> keys) const;
 
         /**
          * @brief Get value of a key in requested type
@@ -135,7 +136,7 @@ namespace constellation::config {
          * @throws InvalidTypeError If the conversion to the requested type did not succeed
          * @throws InvalidTypeError If an overflow happened while converting the key
          */
-        template <typename T> T get(const std::string& key) const;
+        template <typename T> T get(std::string_view key) const;
 
         /**
          * @brief Get value of a key in requested type or default value if it does not exists
@@ -149,7 +150,7 @@ namespace constellation::config {
          * @throws InvalidKeyError If the conversion to the requested type did not succeed
          * @throws InvalidKeyError If an overflow happened while converting the key
          */
-        template <typename T> T get(const std::string& key, const T& def);
+        template <typename T> T get(std::string_view key, const T& def);
 
         /**
          * @brief Get values for a key containing an array
@@ -162,7 +163,7 @@ namespace constellation::config {
          * @throws InvalidKeyError If the conversion to the requested type did not succeed
          * @throws InvalidKeyError If an overflow happened while converting the key
          */
-        template <typename T> std::vector<T> getArray(const std::string& key) const { return get<std::vector<T>>(key); }
+        template <typename T> std::vector<T> getArray(std::string_view key) const { return get<std::vector<T>>(key); }
 
         /**
          * @brief Get values for a key containing an array or default array if it does not exists
@@ -176,7 +177,7 @@ namespace constellation::config {
          * @throws InvalidKeyError If the conversion to the requested type did not succeed
          * @throws InvalidKeyError If an overflow happened while converting the key
          */
-        template <typename T> std::vector<T> getArray(const std::string& key, const std::vector<T>& def);
+        template <typename T> std::vector<T> getArray(std::string_view key, const std::vector<T>& def);
 
         /**
          * @brief Get literal value of a key as string
@@ -184,7 +185,7 @@ namespace constellation::config {
          * @return Literal value of the key
          * @note This function does also not remove quotation marks in strings, Keys are handled case-insensitively
          */
-        CNSTLN_API std::string getText(const std::string& key) const;
+        CNSTLN_API std::string getText(std::string_view key) const;
 
         /**
          * @brief Get absolute path to file with paths relative to the configuration
@@ -196,7 +197,7 @@ namespace constellation::config {
          *
          * @throws InvalidValueError If the path did not exists while the check_exists parameter is given
          */
-        CNSTLN_API std::filesystem::path getPath(const std::string& key, bool check_exists = false) const;
+        CNSTLN_API std::filesystem::path getPath(std::string_view key, bool check_exists = false) const;
 
         /**
          * @brief Get absolute path to file with paths relative to the configuration
@@ -209,7 +210,7 @@ namespace constellation::config {
          *
          * @throws InvalidValueError If the path did not exists while the check_exists parameter is given
          */
-        CNSTLN_API std::filesystem::path getPathWithExtension(const std::string& key,
+        CNSTLN_API std::filesystem::path getPathWithExtension(std::string_view key,
                                                               const std::string& extension,
                                                               bool check_exists = false) const;
 
@@ -223,7 +224,7 @@ namespace constellation::config {
          *
          * @throws InvalidValueError If the path did not exists while the check_exists parameter is given
          */
-        CNSTLN_API std::vector<std::filesystem::path> getPathArray(const std::string& key, bool check_exists = false) const;
+        CNSTLN_API std::vector<std::filesystem::path> getPathArray(std::string_view key, bool check_exists = false) const;
 
         /**
          * @brief Set value for a key in a given type
@@ -233,7 +234,7 @@ namespace constellation::config {
          *
          * @note Keys are handled case-insensitively and stored in lower case.
          */
-        template <typename T> void set(const std::string& key, const T& val, bool mark_used = false);
+        template <typename T> void set(std::string_view key, const T& val, bool mark_used = false);
 
         /**
          * @brief Set list of values for a key in a given type
@@ -243,7 +244,7 @@ namespace constellation::config {
          *
          * @note Keys are handled case-insensitively and stored in lower case.
          */
-        template <typename T> void setArray(const std::string& key, const std::vector<T>& val, bool mark_used = false) {
+        template <typename T> void setArray(std::string_view key, const std::vector<T>& val, bool mark_used = false) {
             set<std::vector<T>>(key, val, mark_used);
         }
 
@@ -255,7 +256,7 @@ namespace constellation::config {
          *
          * @note Keys are handled case-insensitively and stored in lower case.
          */
-        template <typename T> void setDefault(const std::string& key, const T& val);
+        template <typename T> void setDefault(std::string_view key, const T& val);
 
         /**
          * @brief Set default list of values for a key only if it is not defined yet
@@ -265,7 +266,7 @@ namespace constellation::config {
          *
          * @note Keys are handled case-insensitively and stored in lower case.
          */
-        template <typename T> void setDefaultArray(const std::string& key, const std::vector<T>& val);
+        template <typename T> void setDefaultArray(std::string_view key, const std::vector<T>& val);
 
         /**
          * @brief Set alias name for an already existing key
@@ -275,7 +276,7 @@ namespace constellation::config {
          * @note This marks the old key as "used" automatically. Keys are handled case-insensitively and stored in lower
          * case.
          */
-        CNSTLN_API void setAlias(const std::string& new_key, const std::string& old_key, bool warn = false);
+        CNSTLN_API void setAlias(std::string_view new_key, std::string_view old_key, bool warn = false);
 
         /**
          * @brief Get number of key-value pairs for specific group and usage setting
@@ -325,7 +326,8 @@ namespace constellation::config {
          */
         template <typename F> void for_each(Group group, Usage usage, F f) const;
 
-        std::map<std::string, ConfigValue> config_;
+        /** Keys are stored in lower case, the comparator allows lookups without transforming the requested key */
+        std::map<std::string, ConfigValue, utils::case_insensitive_less> config_;
     };
 
 } // namespace constellation::config
@@ -13,7 +13,9 @@
 
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <typeinfo>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -24,59 +26,66 @@
 
 namespace constellation::config {
 
-    template <typename T> T Configuration::get(const std::string& key) const {
-        const auto key_lc = utils::transform(key, ::tolower);
+    template <typename T> T Configuration::get(std::string_view key) const {
+        const auto key_it = config_.find(key);
+        if(key_it == config_.end()) {
+            // Requested key has not been found in dictionary
+            throw MissingKeyError(utils::to_string(key));
+        }
+        const auto& dictval = key_it->second;
         try {
-            const auto& dictval = config_.at(key_lc);
             const auto val = dictval.get<T>();
             dictval.markUsed();
             return val;
-        } catch(const std::out_of_range&) {
-            // Requested key has not been found in dictionary
-            throw MissingKeyError(key);
         } catch(const std::bad_variant_access&) {
             // Value held by the dictionary entry could not be cast to desired type
-            throw InvalidTypeError(key, config_.at(key_lc).demangle(), utils::demangle<T>());
+            throw InvalidTypeError(key, dictval.demangle(), utils::demangle<T>());
         } catch(const std::invalid_argument& error) {
             // Value held by the dictionary entry could not be converted to desired type
-            throw InvalidValueError(getText(key), key, error.what());
+            throw InvalidValueError(getText(key), utils::to_string(key), error.what());
         }
     }
 
-    template <typename T> T Configuration::get(const std::string& key, const T& def) {
+    template <typename T> T Configuration::get(std::string_view key, const T& def) {
         setDefault<T>(key, def);
         return get<T>(key);
     }
 
-    template <typename T> std::vector<T> Configuration::getArray(const std::string& key, const std::vector<T>& def) {
+    template <typename T> std::vector<T> Configuration::getArray(std::string_view key, const std::vector<T>& def) {
         return get<std::vector<T>>(key, def);
     }
 
-    template <typename T> void Configuration::set(const std::string& key, const T& val, bool mark_used) {
-        const auto key_lc = utils::transform(key, ::tolower);
+    template <typename T> void Configuration::set(std::string_view key, const T& val, bool mark_used) {
         try {
-            config_[key_lc] = {Value::set(val), mark_used};
+            auto config_value = ConfigValue(Value::set(val), mark_used);
+            // Only create a lower-case copy of the key if it does not exist yet
+            const auto key_it = config_.find(key);
+            if(key_it != config_.end()) {
+                key_it->second = std::move(config_value);
+            } else {
+                config_.emplace(utils::transform(key, ::tolower), std::move(config_value));
+            }
         } catch(const std::bad_cast&) {
             // Value held by the dictionary entry could not be cast to desired type
             throw InvalidTypeError(key, utils::demangle<T>(), utils::demangle<value_t>());
         } catch(const std::overflow_error& error) {
             if constexpr(utils::convertible_to_string<T>) {
-                throw InvalidValueError(utils::to_string(val), key, error.what());
+                throw InvalidValueError(utils::to_string(val), utils::to_string(key), error.what());
             } else if constexpr(utils::convertible_range_to_string<T>) {
-                throw InvalidValueError(utils::range_to_string(val), key, error.what());
+                throw InvalidValueError(utils::range_to_string(val), utils::to_string(key), error.what());
             } else {
-                throw InvalidValueError("<unknown>", key, error.what());
+                throw InvalidValueError("<unknown>", utils::to_string(key), error.what());
             }
         }
     }
 
-    template <typename T> void Configuration::setDefault(const std::string& key, const T& val) {
+    template <typename T> void Configuration::setDefault(std::string_view key, const T& val) {
         if(!has(key)) {
             set<T>(key, val, false);
         }
     }
 
-    template <typename T> void Configuration::setDefaultArray(const std::string& key, const std::vector<T>& val) {
+    template <typename T> void Configuration::setDefaultArray(std::string_view key, const std::vector<T>& val) {
         if(!has(key)) {
             setArray<T>(key, val, false);
         }
@@ -9,16 +9,27 @@
 
 #include "Dictionary.hpp"
 
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <msgpack.hpp>
 
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/message/PayloadBuffer.hpp"
 #include "constellation/core/utils/casts.hpp"
 #include "constellation/core/utils/msgpack.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/string_hash_map.hpp"
 
 using namespace constellation::config;
 using namespace constellation::message;
@@ -51,6 +62,7 @@ void List::msgpack_unpack(const msgpack::object& msgpack_object) {
 
 PayloadBuffer List::assemble() const {
     msgpack::sbuffer sbuf {};
+    const TypedArray::AlignmentScope alignment_scope {sbuf};
     utils::msgpack_pack(sbuf, *this);
     return {std::move(sbuf)};
 }
@@ -102,6 +114,7 @@ void Dictionary::msgpack_unpack(const msgpack::object& msgpack_object) {
 
 PayloadBuffer Dictionary::assemble() const {
     msgpack::sbuffer sbuf {};
+    const TypedArray::AlignmentScope alignment_scope {sbuf};
     utils::msgpack_pack(sbuf, *this);
     return {std::move(sbuf)};
 }
@@ -119,3 +132,179 @@ std::string Dictionary::to_string(bool prefix) const {
     }
     return out;
 }
+
+FlatDictionary::FlatDictionary(std::initializer_list<std::pair<std::string_view, Value>> init) {
+    entries_.reserve(init.size());
+    for(const auto& [key, value] : init) {
+        insert_or_assign(key, value);
+    }
+}
+
+FlatDictionary::FlatDictionary(const Dictionary& dict) {
+    // Dictionary is already sorted by key
+    entries_.reserve(dict.size());
+    for(const auto& [key, value] : dict) {
+        entries_.emplace_back(store_key(key), value);
+    }
+}
+
+FlatDictionary::operator Dictionary() const {
+    Dictionary dict {};
+    for(const auto& [key, value] : entries_) {
+        dict.emplace_hint(dict.end(), key, value);
+    }
+    return dict;
+}
+
+std::optional<std::string_view> FlatDictionary::intern(std::string_view key) {
+    // Strings in the nodes of an unordered set are never moved, views to them stay valid when inserting
+    static string_hash_set keys {};
+    static std::shared_mutex keys_mutex {};
+
+    {
+        const std::shared_lock keys_lock {keys_mutex};
+        const auto key_it = keys.find(key);
+        if(key_it != keys.end()) [[likely]] {
+            return *key_it;
+        }
+    }
+
+    const std::unique_lock keys_lock {keys_mutex};
+    const auto key_it = keys.find(key);
+    if(key_it != keys.end()) {
+        return *key_it;
+    }
+    if(keys.size() >= max_interned_keys) {
+        return std::nullopt;
+    }
+    return *keys.emplace(key).first;
+}
+
+std::string_view FlatDictionary::store_key(std::string_view key) {
+    const auto interned_key = intern(key);
+    if(interned_key.has_value()) [[likely]] {
+        return interned_key.value();
+    }
+    return *owned_keys_.emplace_back(std::make_shared<const std::string>(key));
+}
+
+FlatDictionary::iterator FlatDictionary::lower_bound(std::string_view key) {
+    return std::ranges::lower_bound(entries_, key, {}, &value_type::first);
+}
+
+FlatDictionary::iterator FlatDictionary::find(std::string_view key) {
+    const auto it = lower_bound(key);
+    return (it != entries_.end() && it->first == key) ? it : entries_.end();
+}
+
+FlatDictionary::const_iterator FlatDictionary::find(std::string_view key) const {
+    const auto it = std::ranges::lower_bound(entries_, key, {}, &value_type::first);
+    return (it != entries_.end() && it->first == key) ? it : entries_.end();
+}
+
+Value& FlatDictionary::at(std::string_view key) {
+    const auto it = find(key);
+    if(it == entries_.end()) {
+        throw std::out_of_range("FlatDictionary::at");
+    }
+    return it->second;
+}
+
+const Value& FlatDictionary::at(std::string_view key) const {
+    const auto it = find(key);
+    if(it == entries_.end()) {
+        throw std::out_of_range("FlatDictionary::at");
+    }
+    return it->second;
+}
+
+Value& FlatDictionary::operator[](std::string_view key) {
+    return emplace(key, {}).first->second;
+}
+
+std::pair<FlatDictionary::iterator, bool> FlatDictionary::emplace(std::string_view key, Value value) {
+    // Fast path for keys arriving in sorted order
+    if(entries_.empty() || entries_.back().first < key) {
+        entries_.emplace_back(store_key(key), std::move(value));
+        return {std::prev(entries_.end()), true};
+    }
+    const auto it = lower_bound(key);
+    if(it != entries_.end() && it->first == key) {
+        return {it, false};
+    }
+    return {entries_.emplace(it, store_key(key), std::move(value)), true};
+}
+
+std::pair<FlatDictionary::iterator, bool> FlatDictionary::insert_or_assign(std::string_view key, Value value) {
+    auto [it, inserted] = emplace(key, {});
+    it->second = std::move(value);
+    return {it, inserted};
+}
+
+FlatDictionary::size_type FlatDictionary::erase(std::string_view key) {
+    const auto it = find(key);
+    if(it == entries_.end()) {
+        return 0;
+    }
+    std::erase_if(owned_keys_, [&](const auto& owned_key) { return owned_key->data() == it->first.data(); });
+    entries_.erase(it);
+    return 1;
+}
+
+void FlatDictionary::msgpack_pack(msgpack::packer<msgpack::sbuffer>& msgpack_packer) const {
+    msgpack_packer.pack_map(entries_.size());
+
+    for(auto const& [key, val] : entries_) {
+        msgpack_packer.pack(key);
+        msgpack_packer.pack(val);
+    }
+}
+
+void FlatDictionary::msgpack_unpack(const msgpack::object& msgpack_object) {
+    // Unpack map
+    if(msgpack_object.type != msgpack::type::MAP) [[unlikely]] {
+        throw msgpack::type_error();
+    }
+    const auto msgpack_map_raw = msgpack_object.via.map; // NOLINT(cppcoreguidelines-pro-type-union-access)
+    const auto msgpack_map = std::span(msgpack_map_raw.ptr, msgpack_map_raw.size);
+    entries_.reserve(entries_.size() + msgpack_map.size());
+
+    for(const auto& msgpack_kv : msgpack_map) {
+        // Unpack key, view into the msgpack object to avoid allocating
+        if(msgpack_kv.key.type != msgpack::type::STR) [[unlikely]] {
+            throw msgpack::type_error();
+        }
+        const auto msgpack_key = msgpack_kv.key.via.str; // NOLINT(cppcoreguidelines-pro-type-union-access)
+        const auto key = std::string_view(msgpack_key.ptr, msgpack_key.size);
+
+        // Unpack value
+        auto value = Value();
+        value.msgpack_unpack(msgpack_kv.val);
+
+        // Insert / overwrite in the map
+        insert_or_assign(key, std::move(value));
+    }
+}
+
+PayloadBuffer FlatDictionary::assemble() const {
+    msgpack::sbuffer sbuf {};
+    const TypedArray::AlignmentScope alignment_scope {sbuf};
+    utils::msgpack_pack(sbuf, *this);
+    return {std::move(sbuf)};
+}
+
+FlatDictionary FlatDictionary::disassemble(const PayloadBuffer& message) {
+    return msgpack_unpack_to<FlatDictionary>(to_char_ptr(message.span().data()), message.span().size());
+}
+
+std::string FlatDictionary::to_string(bool prefix) const {
+    std::string out = (prefix ? "\n" : "");
+    out += range_to_string(
+        entries_,
+        [prefix](const auto& it) { return (prefix ? " " : "") + std::string(it.first) + ": " + it.second.str(); },
+        "\n");
+    if(out == "\n") {
+        out.clear();
+    }
+    return out;
+}
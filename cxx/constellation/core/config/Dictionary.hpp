@@ -9,8 +9,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <initializer_list>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <msgpack/object_decl.hpp>
@@ -83,4 +89,126 @@ namespace constellation::config {
         CNSTLN_API std::string to_string(bool prefix = true) const;
     };
 
+    /**
+     * Dictionary type backed by a sorted vector with interned keys
+     *
+     * Keys are interned in a process-wide table, such that unpacking a dictionary with already known keys only allocates
+     * the entries and the values but not the keys. The table is limited to `max_interned_keys` entries to not grow without
+     * bounds with keys received from the network, further keys are stored in the dictionary itself and shared between
+     * its copies. Lookups are binary searches over a contiguous range. The MessagePack
+     * representation is identical to the one of `Dictionary`, and both types can be converted into each other.
+     */
+    class FlatDictionary {
+    public:
+        using key_type = std::string_view;
+        using mapped_type = Value;
+        using value_type = std::pair<std::string_view, Value>;
+        using container_type = std::vector<value_type>;
+        using size_type = container_type::size_type;
+        using iterator = container_type::iterator;
+        using const_iterator = container_type::const_iterator;
+
+        /** Maximum number of keys in the process-wide key table */
+        static constexpr std::size_t max_interned_keys {4096};
+
+    public:
+        FlatDictionary() = default;
+
+        /** Create a flat dictionary from key-value pairs */
+        CNSTLN_API FlatDictionary(std::initializer_list<std::pair<std::string_view, Value>> init);
+
+        /** Create a flat dictionary from a dictionary */
+        CNSTLN_API FlatDictionary(const Dictionary& dict); // NOLINT(google-explicit-constructor)
+
+        /** Convert flat dictionary to a dictionary */
+        CNSTLN_API operator Dictionary() const; // NOLINT(google-explicit-constructor)
+
+        /**
+         * @brief Intern a key in the process-wide key table
+         *
+         * @param key Key to intern
+         * @return View to the interned key which stays valid until the end of the program, or empty optional if the key is
+         *         not interned yet and the key table is full
+         */
+        CNSTLN_API static std::optional<std::string_view> intern(std::string_view key);
+
+        iterator begin() { return entries_.begin(); }
+        iterator end() { return entries_.end(); }
+        const_iterator begin() const { return entries_.begin(); }
+        const_iterator end() const { return entries_.end(); }
+        const_iterator cbegin() const { return entries_.cbegin(); }
+        const_iterator cend() const { return entries_.cend(); }
+
+        size_type size() const { return entries_.size(); }
+        bool empty() const { return entries_.empty(); }
+        void clear() {
+            entries_.clear();
+            owned_keys_.clear();
+        }
+        void reserve(size_type size) { entries_.reserve(size); }
+
+        /** Find entry with the given key, returns `end()` if not found */
+        CNSTLN_API iterator find(std::string_view key);
+
+        /** Find entry with the given key, returns `end()` if not found */
+        CNSTLN_API const_iterator find(std::string_view key) const;
+
+        /** Check if the dictionary contains the given key */
+        bool contains(std::string_view key) const { return find(key) != end(); }
+
+        /**
+         * @brief Get value of the given key
+         *
+         * @throw std::out_of_range If the key is not contained in the dictionary
+         */
+        CNSTLN_API Value& at(std::string_view key);
+
+        /**
+         * @brief Get value of the given key
+         *
+         * @throw std::out_of_range If the key is not contained in the dictionary
+         */
+        CNSTLN_API const Value& at(std::string_view key) const;
+
+        /** Get value of the given key, inserting an empty value if the key is not contained in the dictionary */
+        CNSTLN_API Value& operator[](std::string_view key);
+
+        /** Insert value if the key is not contained in the dictionary */
+        CNSTLN_API std::pair<iterator, bool> emplace(std::string_view key, Value value);
+
+        /** Insert value or overwrite the existing value of the key */
+        CNSTLN_API std::pair<iterator, bool> insert_or_assign(std::string_view key, Value value);
+
+        /** Remove entry with the given key, returns number of removed entries */
+        CNSTLN_API size_type erase(std::string_view key);
+
+        /** Pack flat dictionary with msgpack */
+        CNSTLN_API void msgpack_pack(msgpack::packer<msgpack::sbuffer>& msgpack_packer) const;
+
+        /** Unpack flat dictionary with msgpack */
+        CNSTLN_API void msgpack_unpack(const msgpack::object& msgpack_object);
+
+        /** Assemble flat dictionary via msgpack to message payload */
+        CNSTLN_API message::PayloadBuffer assemble() const;
+
+        /** Disassemble flat dictionary from message payload */
+        CNSTLN_API static FlatDictionary disassemble(const message::PayloadBuffer& message);
+
+        /**
+         * @brief Convert flat dictionary to human readable string
+         *
+         * @param prefix If true prefix the first line with a newline if dictionary not empty
+         * @return String with one line for each key-value pair
+         */
+        CNSTLN_API std::string to_string(bool prefix = true) const;
+
+    private:
+        iterator lower_bound(std::string_view key);
+        std::string_view store_key(std::string_view key);
+
+    private:
+        container_type entries_;
+        std::vector<std::shared_ptr<const std::string>> owned_keys_;
+    };
+
 } // namespace constellation::config
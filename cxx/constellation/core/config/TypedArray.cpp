@@ -0,0 +1,149 @@
+/**
+ * @file
+ * @brief Implementation of TypedArray
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "TypedArray.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <msgpack.hpp>
+
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/enum.hpp"
+#include "constellation/core/utils/string.hpp"
+
+using namespace constellation::config;
+using namespace constellation::utils;
+
+namespace {
+    // Buffer of the innermost alignment scope on this thread
+    thread_local const msgpack::sbuffer* scope_buffer = nullptr; // NOLINT(*-avoid-non-const-global-variables)
+
+    // Size of the MessagePack extension header including the extension type for a given data size
+    std::size_t ext_header_size(std::size_t size) {
+        if(size == 1 || size == 2 || size == 4 || size == 8 || size == 16) {
+            return 2;
+        }
+        if(size <= 0xFF) {
+            return 3;
+        }
+        if(size <= 0xFFFF) {
+            return 4;
+        }
+        return 6;
+    }
+
+    // Reverse byte order of all elements, only required on big-endian hosts
+    void swap_elements(std::span<std::byte> data, std::size_t element_size) {
+        for(std::size_t pos = 0; pos + element_size <= data.size(); pos += element_size) {
+            std::ranges::reverse(data.subspan(pos, element_size));
+        }
+    }
+} // namespace
+
+TypedArray::AlignmentScope::AlignmentScope(const msgpack::sbuffer& sbuf) : previous_(scope_buffer) {
+    scope_buffer = &sbuf;
+}
+
+TypedArray::AlignmentScope::~AlignmentScope() {
+    scope_buffer = previous_;
+}
+
+std::size_t TypedArray::dtype_size(DType dtype) {
+    return dispatch(dtype, []<typename T>(std::type_identity<T>) { return sizeof(T); });
+}
+
+bool TypedArray::operator==(const TypedArray& other) const {
+    return dtype_ == other.dtype_ && size_ == other.size_ && std::ranges::equal(bytes(), other.bytes());
+}
+
+std::string TypedArray::to_string() const {
+    return dispatch(dtype_, [&]<typename T>(std::type_identity<T>) { return "[" + range_to_string(span<T>()) + "]"; });
+}
+
+void TypedArray::msgpack_pack(msgpack::packer<msgpack::sbuffer>& msgpack_packer) const {
+    // Pad element data to the element size, the header size depends on the total size and thus on the padding
+    const auto position = (scope_buffer != nullptr ? scope_buffer->size() : 0);
+    const auto alignment = dtype_size(dtype_);
+    std::size_t padding {0};
+    for(int iteration = 0; iteration < 3; ++iteration) {
+        const auto data_position = position + ext_header_size(2 + padding + size_bytes()) + 2 + padding;
+        const auto missing = (alignment - (data_position % alignment)) % alignment;
+        if(missing == 0) {
+            break;
+        }
+        padding += missing;
+    }
+
+    const std::array<std::uint8_t, 2> prefix {std::to_underlying(dtype_), static_cast<std::uint8_t>(padding)};
+    constexpr std::array<char, 32> zeros {};
+    msgpack_packer.pack_ext(prefix.size() + padding + size_bytes(), msgpack_ext_type);
+    msgpack_packer.pack_ext_body(to_char_ptr(prefix.data()), prefix.size());
+    msgpack_packer.pack_ext_body(zeros.data(), padding);
+
+    if constexpr(std::endian::native == std::endian::little) {
+        msgpack_packer.pack_ext_body(to_char_ptr(bytes().data()), size_bytes());
+    } else {
+        auto data = std::vector<std::byte>(bytes().begin(), bytes().end());
+        swap_elements(data, dtype_size(dtype_));
+        msgpack_packer.pack_ext_body(to_char_ptr(data.data()), data.size());
+    }
+}
+
+std::optional<std::pair<DType, std::span<const std::byte>>> TypedArray::view_bytes(const msgpack::object& msgpack_object) {
+    if(msgpack_object.type != msgpack::type::EXT) {
+        return std::nullopt;
+    }
+    const auto msgpack_ext = msgpack_object.via.ext; // NOLINT(cppcoreguidelines-pro-type-union-access)
+    if(msgpack_ext.type() != msgpack_ext_type || msgpack_ext.size < 2) {
+        return std::nullopt;
+    }
+
+    // First byte is the element type, second byte the number of padding bytes before the element data
+    const auto ext_data = std::span(to_byte_ptr(msgpack_ext.data()), msgpack_ext.size);
+    const auto dtype = enum_cast<DType>(std::to_integer<std::uint8_t>(ext_data[0]));
+    const auto padding = std::to_integer<std::size_t>(ext_data[1]);
+    if(!dtype.has_value() || 2 + padding > ext_data.size()) {
+        return std::nullopt;
+    }
+    const auto data = ext_data.subspan(2 + padding);
+    if(data.size() % dtype_size(dtype.value()) != 0) {
+        return std::nullopt;
+    }
+    return std::make_pair(dtype.value(), data);
+}
+
+void TypedArray::msgpack_unpack(const msgpack::object& msgpack_object) {
+    const auto data = view_bytes(msgpack_object);
+    if(!data.has_value()) [[unlikely]] {
+        throw msgpack::type_error();
+    }
+
+    const auto& [dtype, bytes] = data.value();
+    dtype_ = dtype;
+    size_ = bytes.size() / dtype_size(dtype);
+
+    // Single copy into aligned storage
+    storage_.assign((bytes.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t), 0);
+    if(!bytes.empty()) {
+        std::memcpy(storage_.data(), bytes.data(), bytes.size());
+    }
+    if constexpr(std::endian::native != std::endian::little) {
+        swap_elements(std::as_writable_bytes(std::span(storage_)).first(bytes.size()), dtype_size(dtype_));
+    }
+}
@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @brief Typed contiguous array with serialization functions for MessagePack
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <msgpack/object_decl.hpp>
+#include <msgpack/pack_decl.hpp>
+#include <msgpack/sbuffer_decl.hpp>
+
+#include "constellation/build.hpp"
+
+namespace constellation::config {
+
+    /** Element type of a typed array */
+    enum class DType : std::uint8_t {
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT64,
+        UINT64,
+        FLOAT,
+        DOUBLE,
+    };
+
+    /// @cond doxygen_suppress
+
+    // Map element types to their DType
+    template <typename T> struct dtype_of {};
+    template <> struct dtype_of<std::int8_t> : std::integral_constant<DType, DType::INT8> {};
+    template <> struct dtype_of<std::uint8_t> : std::integral_constant<DType, DType::UINT8> {};
+    template <> struct dtype_of<std::int16_t> : std::integral_constant<DType, DType::INT16> {};
+    template <> struct dtype_of<std::uint16_t> : std::integral_constant<DType, DType::UINT16> {};
+    template <> struct dtype_of<std::int32_t> : std::integral_constant<DType, DType::INT32> {};
+    template <> struct dtype_of<std::uint32_t> : std::integral_constant<DType, DType::UINT32> {};
+    template <> struct dtype_of<std::int64_t> : std::integral_constant<DType, DType::INT64> {};
+    template <> struct dtype_of<std::uint64_t> : std::integral_constant<DType, DType::UINT64> {};
+    template <> struct dtype_of<float> : std::integral_constant<DType, DType::FLOAT> {};
+    template <> struct dtype_of<double> : std::integral_constant<DType, DType::DOUBLE> {};
+
+    // Concept for types which can be stored in a typed array
+    template <typename T>
+    concept typed_array_element = requires { dtype_of<T>::value; };
+
+    /// @endcond
+
+    /**
+     * @brief Contiguous array of numbers with a single element type
+     *
+     * In contrast to vectors held by `Value`, which are encoded element by element, typed arrays are encoded as a single
+     * MessagePack extension object containing a one-byte `DType` marker, the number of padding bytes as one byte, the
+     * padding bytes and the little-endian element data. The padding aligns the element data to the element size relative
+     * to the start of the buffer, see `AlignmentScope`. This allows large numeric tables to be transmitted and viewed
+     * without copying. The element data is stored with 8-byte alignment and can be accessed as a span without conversion.
+     */
+    class TypedArray {
+    public:
+        /** MessagePack extension type of typed arrays */
+        static constexpr std::int8_t msgpack_ext_type = 0x43;
+
+        /**
+         * @brief Scope in which typed arrays are packed into a given buffer
+         *
+         * MessagePack packers do not expose the position in their buffer. Within this scope, typed arrays packed on the
+         * same thread align their element data relative to the start of the given buffer. Outside of a scope, the element
+         * data is aligned relative to the start of the extension object.
+         */
+        class CNSTLN_API AlignmentScope {
+        public:
+            /**
+             * @brief Open scope for packing into a buffer
+             *
+             * @param sbuf Buffer into which typed arrays are packed, needs to outlive the scope
+             */
+            CNSTLN_API explicit AlignmentScope(const msgpack::sbuffer& sbuf);
+
+            CNSTLN_API ~AlignmentScope();
+
+            // No copy/move constructor/assignment
+            /// @cond doxygen_suppress
+            AlignmentScope(const AlignmentScope& other) = delete;
+            AlignmentScope& operator=(const AlignmentScope& other) = delete;
+            AlignmentScope(AlignmentScope&& other) = delete;
+            AlignmentScope& operator=(AlignmentScope&& other) = delete;
+            /// @endcond
+
+        private:
+            const msgpack::sbuffer* previous_;
+        };
+
+    public:
+        TypedArray() = default;
+
+        /**
+         * @brief Construct typed array by copying elements
+         *
+         * @param values Elements of the array
+         */
+        template <typed_array_element T>
+        explicit TypedArray(std::span<const T> values) : dtype_(dtype_of<T>::value), size_(values.size()) {
+            storage_.resize((values.size_bytes() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+            if(!values.empty()) {
+                std::memcpy(storage_.data(), values.data(), values.size_bytes());
+            }
+        }
+
+        /**
+         * @brief Construct typed array by copying elements
+         *
+         * @param values Elements of the array
+         */
+        template <typed_array_element T>
+        explicit TypedArray(const std::vector<T>& values) : TypedArray(std::span<const T>(values)) {}
+
+        /** Return element type */
+        DType getDType() const { return dtype_; }
+
+        /** Return number of elements */
+        std::size_t size() const { return size_; }
+
+        /** Return if the array is empty */
+        bool empty() const { return size_ == 0; }
+
+        /** Return size of the element data in bytes */
+        std::size_t size_bytes() const { return size_ * dtype_size(dtype_); }
+
+        /** Return view on the element data */
+        std::span<const std::byte> bytes() const { return std::as_bytes(std::span(storage_)).first(size_bytes()); }
+
+        /**
+         * @brief Get view on the elements without conversion
+         *
+         * @return Span of the elements
+         * @throws std::bad_variant_access If the requested type does not match the element type
+         */
+        template <typed_array_element T> std::span<const T> span() const {
+            if(dtype_of<T>::value != dtype_) {
+                throw std::bad_variant_access();
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            return {reinterpret_cast<const T*>(storage_.data()), size_};
+        }
+
+        /**
+         * @brief Get copy of the elements converted to the requested type
+         *
+         * @return Vector of the converted elements
+         */
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        std::vector<T> to_vector() const {
+            return dispatch(dtype_, [&]<typename U>(std::type_identity<U>) {
+                const auto values = span<U>();
+                return std::vector<T>(values.begin(), values.end());
+            });
+        }
+
+        /**
+         * @brief Get view on the elements of a typed array directly in an unpacked MessagePack object
+         *
+         * This avoids copying the elements if the MessagePack object references the original message buffer. The view is
+         * only valid as long as the buffer is alive.
+         *
+         * @param msgpack_object MessagePack object
+         * @return Span of the elements, or an empty optional if the object is not a typed array of the requested type or if
+         *         the element data is not suitably aligned, e.g. if the buffer itself is not aligned
+         */
+        template <typed_array_element T>
+        static std::optional<std::span<const T>> view(const msgpack::object& msgpack_object) {
+            const auto data = view_bytes(msgpack_object);
+            if(!data.has_value() || data->first != dtype_of<T>::value || std::endian::native != std::endian::little ||
+               reinterpret_cast<std::uintptr_t>(data->second.data()) % alignof(T) != 0) { // NOLINT(*-reinterpret-cast)
+                return std::nullopt;
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            return std::span<const T>(reinterpret_cast<const T*>(data->second.data()), data->second.size() / sizeof(T));
+        }
+
+        /**
+         * @brief Get element size of a given element type
+         *
+         * @param dtype Element type
+         * @return Size of a single element in bytes
+         */
+        CNSTLN_API static std::size_t dtype_size(DType dtype);
+
+        /** Compare element type and element data */
+        CNSTLN_API bool operator==(const TypedArray& other) const;
+
+        /** Convert typed array to human readable string */
+        CNSTLN_API std::string to_string() const;
+
+        /** Pack typed array with msgpack */
+        CNSTLN_API void msgpack_pack(msgpack::packer<msgpack::sbuffer>& msgpack_packer) const;
+
+        /** Unpack typed array with msgpack */
+        CNSTLN_API void msgpack_unpack(const msgpack::object& msgpack_object);
+
+    private:
+        /** Call function with type identity of the element type */
+        template <typename F> static decltype(auto) dispatch(DType dtype, F&& func) {
+            switch(dtype) {
+            case DType::INT8: return func(std::type_identity<std::int8_t>());
+            case DType::UINT8: return func(std::type_identity<std::uint8_t>());
+            case DType::INT16: return func(std::type_identity<std::int16_t>());
+            case DType::UINT16: return func(std::type_identity<std::uint16_t>());
+            case DType::INT32: return func(std::type_identity<std::int32_t>());
+            case DType::UINT32: return func(std::type_identity<std::uint32_t>());
+            case DType::INT64: return func(std::type_identity<std::int64_t>());
+            case DType::UINT64: return func(std::type_identity<std::uint64_t>());
+            case DType::FLOAT: return func(std::type_identity<float>());
+            case DType::DOUBLE: return func(std::type_identity<double>());
+            default: std::unreachable();
+            }
+        }
+
+        /** Get element type and little-endian element data of a typed array MessagePack object */
+        CNSTLN_API static std::optional<std::pair<DType, std::span<const std::byte>>>
+        view_bytes(const msgpack::object& msgpack_object);
+
+    private:
+        DType dtype_ {DType::UINT8};
+        std::size_t size_ {};
+        // Storage in 64-bit words to guarantee alignment for all element types
+        std::vector<std::uint64_t> storage_;
+    };
+
+} // namespace constellation::config
@@ -21,6 +21,7 @@
 
 #include <msgpack.hpp>
 
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/message/PayloadBuffer.hpp"
 #include "constellation/core/utils/casts.hpp"
 #include "constellation/core/utils/msgpack.hpp"
@@ -39,6 +40,8 @@ std::string Value::str() const {
                 out = "NIL";
             } else if constexpr(convertible_to_string<T>) {
                 out = to_string(arg);
+            } else if constexpr(std::same_as<T, TypedArray>) {
+                out = arg.to_string();
             } else if constexpr(std::same_as<T, std::vector<char>>) {
                 // Special case: print chars in hex
                 out = "[ " + range_to_string(arg, char_to_hex_string, " ") + " ]";
@@ -131,6 +134,11 @@ void Value::msgpack_unpack(const msgpack::object& msgpack_object) {
             break;
         }
         case msgpack::type::EXT: {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+            if(msgpack_object.via.ext.type() == TypedArray::msgpack_ext_type) {
+                *this = msgpack_object.as<TypedArray>();
+                break;
+            }
             // Try to convert to time_point, throws if wrong EXT type
             *this = msgpack_object.as<std::chrono::system_clock::time_point>();
             break;
@@ -148,6 +156,7 @@ void Value::msgpack_unpack(const msgpack::object& msgpack_object) {
 
 PayloadBuffer Value::assemble() const {
     msgpack::sbuffer sbuf {};
+    const TypedArray::AlignmentScope alignment_scope {sbuf};
     utils::msgpack_pack(sbuf, *this);
     return {std::move(sbuf)};
 }
@@ -22,6 +22,7 @@
 #include <msgpack/sbuffer_decl.hpp>
 
 #include "constellation/build.hpp"
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/message/PayloadBuffer.hpp"
 #include "constellation/core/utils/type.hpp"
 
@@ -45,7 +46,7 @@ namespace constellation::config {
      * Value type for Dictionary using std::variant
      *
      * Allowed types: nil, bool, int64, double, string, time point, vectors of bool, int64, double, string, time point,
-     *                bytes (vector of char)
+     *                bytes (vector of char), typed numeric arrays
      */
     using value_t = std::variant<std::monostate,
                                  bool,
@@ -58,7 +59,8 @@ namespace constellation::config {
                                  std::vector<std::int64_t>,
                                  std::vector<double>,
                                  std::vector<std::string>,
-                                 std::vector<std::chrono::system_clock::time_point>>;
+                                 std::vector<std::chrono::system_clock::time_point>,
+                                 TypedArray>;
 
     /**
      * @class Value
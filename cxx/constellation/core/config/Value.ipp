@@ -20,6 +20,7 @@
 #include <variant>
 #include <vector>
 
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/utils/enum.hpp"
 #include "constellation/core/utils/string.hpp"
 #include "constellation/core/utils/type.hpp"
@@ -39,6 +40,15 @@ namespace constellation::config {
             return {};
         }
 
+        // Typed arrays can be converted to vectors of any arithmetic type
+        if constexpr(utils::is_std_vector_v<T>) {
+            if constexpr(std::is_arithmetic_v<typename T::value_type>) {
+                if(std::holds_alternative<TypedArray>(*this)) {
+                    return std::get<TypedArray>(*this).to_vector<typename T::value_type>();
+                }
+            }
+        }
+
         // Value is directly held by variant
         if constexpr(is_one_of_v<T, value_t>) {
             return std::get<T>(*this);
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief Implementation of the aligned buffer pool
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "AlignedBuffer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+
+#include "constellation/core/utils/exceptions.hpp"
+
+using namespace constellation::message;
+using namespace constellation::utils;
+
+AlignedBufferPool::AlignedBufferPool(std::size_t alignment, std::size_t max_buffers)
+    : alignment_(alignment), storage_(std::make_shared<Storage>()) {
+    if(!std::has_single_bit(alignment)) {
+        throw LogicError("Buffer alignment needs to be a power of two");
+    }
+    storage_->max_buffers = max_buffers;
+}
+
+std::shared_ptr<AlignedBuffer> AlignedBufferPool::acquire(std::size_t size) {
+    std::unique_ptr<AlignedBuffer> buffer {};
+    {
+        const std::lock_guard lock {storage_->mutex};
+        auto& buffers = storage_->buffers;
+        if(!buffers.empty()) {
+            // Prefer a buffer which is large enough to avoid reallocation
+            auto it = std::ranges::find_if(buffers, [=](const auto& buf) { return buf.capacity() >= size; });
+            if(it == buffers.end()) {
+                it = std::prev(buffers.end());
+            }
+            buffer = std::make_unique<AlignedBuffer>(std::move(*it));
+            buffers.erase(it);
+        }
+    }
+    if(buffer) {
+        buffer->resize(size);
+    } else {
+        buffer = std::make_unique<AlignedBuffer>(size, alignment_);
+    }
+
+    // Return buffer to the pool if it still exists, otherwise free it
+    return {buffer.release(), [weak_storage = std::weak_ptr<Storage>(storage_)](AlignedBuffer* buf) {
+                const std::unique_ptr<AlignedBuffer> owned_buf {buf};
+                const auto storage = weak_storage.lock();
+                if(storage) {
+                    const std::lock_guard lock {storage->mutex};
+                    if(storage->buffers.size() < storage->max_buffers) {
+                        storage->buffers.emplace_back(std::move(*owned_buf));
+                    }
+                }
+            }};
+}
+
+std::shared_ptr<AlignedBuffer> AlignedBufferPool::copy(std::span<const std::byte> data) {
+    auto buffer = acquire(data.size());
+    std::ranges::copy(data, buffer->data());
+    return buffer;
+}
+
+std::size_t AlignedBufferPool::idle() const {
+    const std::lock_guard lock {storage_->mutex};
+    return storage_->buffers.size();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file
+ * @brief Aligned memory buffer for payload frames
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "constellation/build.hpp"
+#include "constellation/core/utils/exceptions.hpp"
+
+namespace constellation::message {
+
+    /**
+     * @brief Owning memory buffer with a guaranteed alignment of its start address
+     *
+     * The buffer can be moved into a `PayloadBuffer` and thus added as a frame to data messages without copying. Typical
+     * alignments are the cache line size for SIMD loads and the page size for `O_DIRECT` writes.
+     */
+    class AlignedBuffer {
+    public:
+        /** Alignment for SIMD loads */
+        static constexpr std::size_t cache_line = 64;
+
+        /** Alignment for direct I/O and DMA transfers */
+        static constexpr std::size_t page = 4096;
+
+    public:
+        /**
+         * @brief Allocate an uninitialized aligned buffer
+         *
+         * @param size Size of the buffer in bytes
+         * @param alignment Alignment of the buffer in bytes, needs to be a power of two
+         * @throw LogicError If the alignment is not a power of two
+         */
+        explicit AlignedBuffer(std::size_t size, std::size_t alignment = cache_line)
+            : data_(nullptr, Deleter(alignment)), alignment_(alignment) {
+            if(!std::has_single_bit(alignment)) {
+                throw utils::LogicError("Buffer alignment needs to be a power of two");
+            }
+            resize(size);
+        }
+
+        ~AlignedBuffer() = default;
+
+        // No copy constructor/assignment
+        /// @cond doxygen_suppress
+        AlignedBuffer(const AlignedBuffer& other) = delete;
+        AlignedBuffer& operator=(const AlignedBuffer& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Move constructor leaving the other buffer empty
+         */
+        AlignedBuffer(AlignedBuffer&& other) noexcept
+            : data_(std::move(other.data_)), size_(std::exchange(other.size_, 0)),
+              capacity_(std::exchange(other.capacity_, 0)), alignment_(other.alignment_) {}
+
+        /**
+         * @brief Move assignment leaving the other buffer empty
+         */
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+            data_ = std::move(other.data_);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            alignment_ = other.alignment_;
+            return *this;
+        }
+
+        /**
+         * @brief Return the size of the buffer in bytes
+         */
+        std::size_t size() const { return size_; }
+
+        /**
+         * @brief Return the number of bytes the buffer can hold without reallocation
+         */
+        std::size_t capacity() const { return capacity_; }
+
+        /**
+         * @brief Return the alignment of the buffer in bytes
+         */
+        std::size_t alignment() const { return alignment_; }
+
+        /**
+         * @brief Return pointer to the aligned data
+         */
+        std::byte* data() { return data_.get(); }
+
+        /**
+         * @brief Return pointer to the aligned data
+         */
+        const std::byte* data() const { return data_.get(); }
+
+        /**
+         * @brief Write access to the data in the buffer
+         */
+        std::span<std::byte> span() { return {data_.get(), size_}; }
+
+        /**
+         * @brief Read-only access to the data in the buffer
+         */
+        std::span<const std::byte> span() const { return {data_.get(), size_}; }
+
+        /**
+         * @brief Change the size of the buffer
+         *
+         * @note The content is not preserved if the new size exceeds the capacity of the buffer
+         *
+         * @param size New size of the buffer in bytes
+         */
+        void resize(std::size_t size) {
+            if(size > capacity_) {
+                data_.reset(static_cast<std::byte*>(::operator new[](size, std::align_val_t(alignment_))));
+                capacity_ = size;
+            }
+            size_ = size;
+        }
+
+        /**
+         * @brief Check if a memory address is aligned
+         *
+         * @param ptr Memory address
+         * @param alignment Alignment in bytes
+         * @return True if the address is a multiple of the alignment
+         */
+        static bool is_aligned(const void* ptr, std::size_t alignment) {
+            return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0; // NOLINT(*-reinterpret-cast)
+        }
+
+    private:
+        struct Deleter {
+            std::size_t alignment;
+            void operator()(std::byte* ptr) const { ::operator delete[](ptr, std::align_val_t(alignment)); }
+        };
+
+    private:
+        std::unique_ptr<std::byte[], Deleter> data_; // NOLINT(*-avoid-c-arrays)
+        std::size_t size_ {};
+        std::size_t capacity_ {};
+        std::size_t alignment_;
+    };
+
+    /**
+     * @brief Pool of aligned buffers which are recycled after use
+     *
+     * Buffers are handed out as shared pointers which return the buffer to the pool when the last reference is dropped.
+     * This avoids an allocation per frame when payload frames are repeatedly copied into aligned memory. Buffers returned
+     * after the pool has been destroyed are freed.
+     */
+    class CNSTLN_API AlignedBufferPool {
+    public:
+        /**
+         * @brief Construct a buffer pool
+         *
+         * @param alignment Alignment of the buffers in bytes, needs to be a power of two
+         * @param max_buffers Maximum number of idle buffers kept in the pool
+         * @throw LogicError If the alignment is not a power of two
+         */
+        CNSTLN_API explicit AlignedBufferPool(std::size_t alignment = AlignedBuffer::cache_line,
+                                              std::size_t max_buffers = 64);
+
+        /**
+         * @brief Return the alignment of the buffers in bytes
+         */
+        std::size_t alignment() const { return alignment_; }
+
+        /**
+         * @brief Get a buffer from the pool or allocate a new one
+         *
+         * @param size Size of the buffer in bytes
+         * @return Shared pointer to the buffer, which returns the buffer to the pool on destruction
+         */
+        CNSTLN_API std::shared_ptr<AlignedBuffer> acquire(std::size_t size);
+
+        /**
+         * @brief Copy data into a buffer from the pool
+         *
+         * @param data Data to be copied
+         * @return Shared pointer to the buffer containing the data
+         */
+        CNSTLN_API std::shared_ptr<AlignedBuffer> copy(std::span<const std::byte> data);
+
+        /**
+         * @brief Return the number of idle buffers in the pool
+         */
+        CNSTLN_API std::size_t idle() const;
+
+    private:
+        struct Storage {
+            std::mutex mutex;
+            std::vector<AlignedBuffer> buffers;
+            std::size_t max_buffers {};
+        };
+
+    private:
+        std::size_t alignment_;
+        std::shared_ptr<Storage> storage_;
+    };
+
+} // namespace constellation::message
@@ -16,6 +16,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <msgpack.hpp>
 
@@ -50,17 +51,17 @@ BaseHeader BaseHeader::disassemble(Protocol protocol, std::span<const std::byte>
         }
 
         // Unpack sender
-        const auto sender = msgpack_unpack_to<std::string>(to_char_ptr(data.data()), data.size_bytes(), offset);
+        auto sender = msgpack_unpack_to<std::string>(to_char_ptr(data.data()), data.size_bytes(), offset);
 
         // Unpack time
         const auto time =
             msgpack_unpack_to<std::chrono::system_clock::time_point>(to_char_ptr(data.data()), data.size_bytes(), offset);
 
         // Unpack tags
-        const auto tags = msgpack_unpack_to<Dictionary>(to_char_ptr(data.data()), data.size_bytes(), offset);
+        auto tags = msgpack_unpack_to<FlatDictionary>(to_char_ptr(data.data()), data.size_bytes(), offset);
 
         // Construct header
-        return {protocol, sender, time, tags};
+        return {protocol, std::move(sender), time, std::move(tags)};
     } catch(const MsgpackUnpackError& e) {
         throw MessageDecodingError(e.what());
     }
@@ -70,7 +71,7 @@ void BaseHeader::msgpack_pack(msgpack::packer<msgpack::sbuffer>& msgpack_packer)
     // first pack version
     msgpack_packer.pack(get_protocol_identifier(protocol_));
     // then sender
-    msgpack_packer.pack(sender_);
+    msgpack_packer.pack(getSender());
     // then time
     msgpack_packer.pack(time_);
     // then tags
@@ -81,7 +82,7 @@ std::string BaseHeader::to_string() const {
     std::ostringstream out {};
     std::boolalpha(out);
     out << "Header: " << get_readable_protocol(protocol_) << '\n' //
-        << "Sender: " << sender_ << '\n'                          //
+        << "Sender: " << getSender() << '\n'                      //
         << "Time:   " << utils::to_string(time_) << '\n'          //
         << "Tags:" << tags_.to_string();
 
@@ -11,6 +11,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
@@ -44,13 +45,13 @@ namespace constellation::message {
         constexpr protocol::Protocol getProtocol() const { return protocol_; }
 
         /** Return message sender */
-        std::string_view getSender() const { return sender_; }
+        std::string_view getSender() const { return shared_sender_ ? std::string_view(*shared_sender_) : sender_; }
 
         /** Return message time */
         constexpr std::chrono::system_clock::time_point getTime() const { return time_; }
 
         /** Return message tags */
-        const config::Dictionary& getTags() const { return tags_; }
+        const config::FlatDictionary& getTags() const { return tags_; }
 
         /** Return if message has given tag */
         bool hasTag(const std::string& key) const { return tags_.contains(utils::transform(key, ::tolower)); }
@@ -83,9 +84,23 @@ namespace constellation::message {
         BaseHeader(protocol::Protocol protocol,
                    std::string sender,
                    std::chrono::system_clock::time_point time,
-                   config::Dictionary tags = {})
+                   config::FlatDictionary tags = {})
             : protocol_(protocol), sender_(std::move(sender)), time_(time), tags_(std::move(tags)) {}
 
+        /**
+         * Construct new message header with a sender name shared between headers
+         *
+         * @param protocol Message protocol
+         * @param sender Shared sender name
+         * @param time Message time
+         * @param tags Message tags (defaults to empty dictionary)
+         */
+        BaseHeader(protocol::Protocol protocol,
+                   std::shared_ptr<const std::string> sender,
+                   std::chrono::system_clock::time_point time,
+                   config::FlatDictionary tags = {})
+            : protocol_(protocol), shared_sender_(std::move(sender)), time_(time), tags_(std::move(tags)) {}
+
         /**
          * Disassemble message from from bytes
          *
@@ -97,8 +112,9 @@ namespace constellation::message {
     private:
         protocol::Protocol protocol_;
         std::string sender_;
+        std::shared_ptr<const std::string> shared_sender_;
         std::chrono::system_clock::time_point time_;
-        config::Dictionary tags_;
+        config::FlatDictionary tags_;
     };
 
 } // namespace constellation::message
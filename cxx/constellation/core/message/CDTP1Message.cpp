@@ -9,14 +9,21 @@
 
 #include "CDTP1Message.hpp"
 
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <shared_mutex>
 #include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <msgpack.hpp>
@@ -40,8 +47,124 @@ using namespace constellation::message;
 using namespace constellation::protocol;
 using namespace constellation::utils;
 
+namespace {
+    template <typename T> void write_le(std::byte* out, T value) {
+        if constexpr(std::endian::native != std::endian::little) {
+            value = std::byteswap(value);
+        }
+        std::memcpy(out, &value, sizeof(T));
+    }
+
+    template <typename T> T read_le(const std::byte* in) {
+        T value {};
+        std::memcpy(&value, in, sizeof(T));
+        if constexpr(std::endian::native != std::endian::little) {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+
+    // Flags of the compact header
+    constexpr std::uint8_t compact_flag_tags = 0x01;
+} // namespace
+
+bool CDTP1Message::SenderRegistry::add(std::string_view sender) {
+    const auto id = Header::sender_id(sender);
+    const std::unique_lock lock {mutex_};
+    // Never replace a registered sender, since compact headers of that sender would be attributed to the new one
+    const auto [it, inserted] = senders_.try_emplace(id, std::make_shared<const std::string>(sender));
+    return inserted || *it->second == sender;
+}
+
+void CDTP1Message::SenderRegistry::remove(std::string_view sender) {
+    const std::unique_lock lock {mutex_};
+    const auto it = senders_.find(Header::sender_id(sender));
+    // Only remove the sender itself and not a different sender with colliding ID
+    if(it != senders_.end() && *it->second == sender) {
+        senders_.erase(it);
+    }
+}
+
+void CDTP1Message::SenderRegistry::clear() {
+    const std::unique_lock lock {mutex_};
+    senders_.clear();
+}
+
+std::shared_ptr<const std::string> CDTP1Message::SenderRegistry::resolve(std::uint64_t id) const {
+    const std::shared_lock lock {mutex_};
+    const auto it = senders_.find(id);
+    return it != senders_.end() ? it->second : nullptr;
+}
+
+std::uint64_t CDTP1Message::Header::sender_id(std::string_view sender) {
+    // 64-bit FNV-1a
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for(const auto c : sender) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+void CDTP1Message::Header::compact_pack(msgpack::sbuffer& sbuf) const {
+    if(type_ != Type::DATA) {
+        throw IncorrectMessageType("Compact header only available for DATA messages");
+    }
+
+    const auto& tags = getTags();
+    std::array<std::byte, compact_size> header {};
+    header[0] = std::byte(compact_marker);
+    header[1] = std::byte(std::to_underlying(type_));
+    header[2] = std::byte(tags.empty() ? 0 : compact_flag_tags);
+    write_le(&header[4], sender_id(getSender()));
+    write_le(&header[12], seq_);
+    sbuf.write(to_char_ptr(header.data()), header.size());
+
+    if(!tags.empty()) {
+        msgpack::pack(sbuf, tags);
+    }
+}
+
+CDTP1Message::Header CDTP1Message::Header::compact_disassemble(std::span<const std::byte> data,
+                                                               const SenderRegistry* registry) {
+    if(data.size() < compact_size) {
+        throw MessageDecodingError("Compact header too short");
+    }
+
+    const auto type = static_cast<Type>(std::to_integer<std::uint8_t>(data[1]));
+    if(type != Type::DATA) {
+        throw MessageDecodingError("Compact header only available for DATA messages");
+    }
+    const auto flags = std::to_integer<std::uint8_t>(data[2]);
+    const auto id = read_le<std::uint64_t>(&data[4]);
+    const auto seq = read_le<std::uint64_t>(&data[12]);
+
+    // Resolve sender from registry, the name is shared instead of copied
+    auto sender = registry != nullptr ? registry->resolve(id) : nullptr;
+    if(sender == nullptr) {
+        throw MessageDecodingError("Compact header with unknown sender ID, no BOR message received from sender");
+    }
+
+    FlatDictionary tags {};
+    if((flags & compact_flag_tags) != 0) {
+        try {
+            const auto tags_data = data.subspan(compact_size);
+            tags = msgpack_unpack_to<FlatDictionary>(to_char_ptr(tags_data.data()), tags_data.size_bytes());
+        } catch(const MsgpackUnpackError& e) {
+            throw MessageDecodingError(e.what());
+        }
+    }
+
+    return {std::move(sender), std::move(tags), seq, type};
+}
+
 // Similar to BaseHeader::disassemble in BaseHeader.cpp, check when modifying
-CDTP1Message::Header CDTP1Message::Header::disassemble(std::span<const std::byte> data) {
+CDTP1Message::Header CDTP1Message::Header::disassemble(std::span<const std::byte> data,
+                                                       const SenderRegistry* registry) {
+    if(!data.empty() && std::to_integer<std::uint8_t>(data.front()) == compact_marker) {
+        return compact_disassemble(data, registry);
+    }
+
     try {
         // Offset since we decode four separate msgpack objects
         std::size_t offset = 0;
@@ -62,7 +185,7 @@ CDTP1Message::Header CDTP1Message::Header::disassemble(std::span<const std::byte
         }
 
         // Unpack sender
-        const auto sender = msgpack_unpack_to<std::string>(to_char_ptr(data.data()), data.size_bytes(), offset);
+        auto sender = msgpack_unpack_to<std::string>(to_char_ptr(data.data()), data.size_bytes(), offset);
 
         // Unpack message type
         const auto type = msgpack_unpack_to_enum<Type>(to_char_ptr(data.data()), data.size_bytes(), offset);
@@ -71,10 +194,10 @@ CDTP1Message::Header CDTP1Message::Header::disassemble(std::span<const std::byte
         const auto seq = msgpack_unpack_to<std::uint64_t>(to_char_ptr(data.data()), data.size_bytes(), offset);
 
         // Unpack tags
-        const auto tags = msgpack_unpack_to<Dictionary>(to_char_ptr(data.data()), data.size_bytes(), offset);
+        auto tags = msgpack_unpack_to<FlatDictionary>(to_char_ptr(data.data()), data.size_bytes(), offset);
 
         // Construct header
-        return {sender, tags, seq, type};
+        return {std::move(sender), std::move(tags), seq, type};
     } catch(const MsgpackUnpackError& e) {
         throw MessageDecodingError(e.what());
     }
@@ -118,27 +241,32 @@ std::size_t CDTP1Message::countPayloadBytes() const {
         });
 }
 
-zmq::multipart_t CDTP1Message::assemble() {
+zmq::multipart_t CDTP1Message::assemble(bool compact_header, const PayloadBuffer::ReleaseCallback& release_callback) {
     zmq::multipart_t frames {};
 
-    // First frame: header
+    // First frame: header, BOR and EOR always use the MessagePack encoding
     msgpack::sbuffer sbuf_header {};
-    msgpack_pack(sbuf_header, header_);
+    if(compact_header && header_.getType() == Type::DATA) {
+        header_.compact_pack(sbuf_header);
+    } else {
+        msgpack_pack(sbuf_header, header_);
+    }
     frames.add(PayloadBuffer(std::move(sbuf_header)).to_zmq_msg_release());
 
     // Second frame until Nth frame: always move payload (no reuse)
     for(auto& PayloadBuffer : payload_buffers_) {
-        frames.add(PayloadBuffer.to_zmq_msg_release());
+        frames.add(release_callback ? PayloadBuffer.to_zmq_msg_release(release_callback)
+                                    : PayloadBuffer.to_zmq_msg_release());
     }
     // clear payload_frames_ member as payload buffers has been released
     payload_buffers_.clear();
     return frames;
 }
 
-CDTP1Message CDTP1Message::disassemble(zmq::multipart_t& frames) {
+CDTP1Message CDTP1Message::disassemble(zmq::multipart_t& frames, const SenderRegistry* registry) {
     // Decode header
     const auto header_frame = frames.pop();
-    const auto header = Header::disassemble({to_byte_ptr(header_frame.data()), header_frame.size()});
+    const auto header = Header::disassemble({to_byte_ptr(header_frame.data()), header_frame.size()}, registry);
 
     // Create message, reversing space for frames
     auto cdtp_message = CDTP1Message(header, frames.size());
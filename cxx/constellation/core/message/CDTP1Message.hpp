@@ -12,11 +12,16 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
 #include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include <msgpack/sbuffer_decl.hpp>
 #include <zmq_addon.hpp>
 
 #include "constellation/build.hpp"
@@ -27,7 +32,16 @@
 
 namespace constellation::message {
 
-    /** Class representing a CDTP1 message */
+    /**
+     * @brief Class representing a CDTP1 message
+     *
+     * Besides the MessagePack header encoding, DATA messages can use a compact binary header. It consists of a fixed-size
+     * little-endian structure with a marker byte, the message type, a flag byte, a reserved byte, a 64-bit sender ID and the
+     * 64-bit sequence number. Tags are appended as MessagePack map only if present. The marker byte is never used by
+     * MessagePack, such that both encodings can be distinguished by the first byte of the header frame. The sender ID is a
+     * hash of the sender name and is resolved via a sender registry kept by the receiver, to which the sender is added
+     * when its BOR message is received.
+     */
     class CDTP1Message {
     public:
         enum class Type : std::uint8_t {
@@ -36,9 +50,53 @@ namespace constellation::message {
             EOR = '\x02',
         };
 
+        /**
+         * @brief Registry of senders for the resolution of sender IDs in compact headers
+         *
+         * The registry is owned by the receiving side, which adds a sender when its BOR message is received and removes it
+         * again when its EOR message is received. Access to the registry is thread-safe.
+         */
+        class CNSTLN_API SenderRegistry {
+        public:
+            /**
+             * @brief Add a sender to the registry
+             *
+             * A sender is rejected if its ID collides with the ID of a different sender added before. Such senders cannot
+             * be resolved from compact headers and have to use the MessagePack header encoding.
+             *
+             * @param sender Sender name
+             * @return True if the sender is registered, false if its ID is already taken by a different sender
+             */
+            [[nodiscard]] CNSTLN_API bool add(std::string_view sender);
+
+            /**
+             * @brief Remove a sender from the registry
+             *
+             * @param sender Sender name
+             */
+            CNSTLN_API void remove(std::string_view sender);
+
+            /**
+             * @brief Remove all senders from the registry
+             */
+            CNSTLN_API void clear();
+
+            /**
+             * @brief Resolve a sender ID
+             *
+             * @param id Sender ID from a compact header
+             * @return Sender name shared with the registry, or nullptr if the ID is unknown
+             */
+            CNSTLN_API std::shared_ptr<const std::string> resolve(std::uint64_t id) const;
+
+        private:
+            mutable std::shared_mutex mutex_;
+            std::map<std::uint64_t, std::shared_ptr<const std::string>> senders_;
+        };
+
         class CNSTLN_API Header final : public BaseHeader {
         public:
-            Header(std::string sender, std::uint64_t seq, Type type, config::Dictionary tags = {})
+            Header(std::string sender, std::uint64_t seq, Type type, config::FlatDictionary tags = {})
                 : BaseHeader(protocol::CDTP1, std::move(sender), {}, std::move(tags)), seq_(seq), type_(type) {}
 
             constexpr std::uint64_t getSequenceNumber() const { return seq_; }
@@ -47,12 +105,50 @@ namespace constellation::message {
 
             CNSTLN_API std::string to_string() const final;
 
-            CNSTLN_API static Header disassemble(std::span<const std::byte> data);
+            /**
+             * @brief Disassemble header from bytes in either encoding
+             *
+             * The sender ID of compact headers is resolved via the given sender registry, the sender name is shared with the
+             * registry instead of being copied.
+             *
+             * @param data View to byte data
+             * @param registry Registry to resolve sender IDs of compact headers (optional)
+             * @throw MessageDecodingError If the header could not be decoded or the sender ID of a compact header is unknown
+             */
+            CNSTLN_API static Header disassemble(std::span<const std::byte> data, const SenderRegistry* registry = nullptr);
 
             CNSTLN_API void msgpack_pack(msgpack::packer<msgpack::sbuffer>& msgpack_packer) const final;
 
+            /**
+             * @brief Pack header using the compact binary encoding
+             *
+             * @param sbuf Buffer to which the header is appended
+             * @throw IncorrectMessageType If the message is not a DATA message
+             */
+            CNSTLN_API void compact_pack(msgpack::sbuffer& sbuf) const;
+
+            /**
+             * @brief Get the sender ID used in compact headers
+             *
+             * @param sender Sender name
+             * @return 64-bit FNV-1a hash of the sender name
+             */
+            CNSTLN_API static std::uint64_t sender_id(std::string_view sender);
+
+        public:
+            /** Marker of compact headers, this byte is never used by MessagePack */
+            static constexpr std::uint8_t compact_marker = 0xC1;
+
+            /** Size of the fixed part of compact headers in bytes */
+            static constexpr std::size_t compact_size = 20;
+
         private:
-            Header(std::string sender, config::Dictionary tags, std::uint64_t seq, Type type)
+            CNSTLN_LOCAL static Header compact_disassemble(std::span<const std::byte> data, const SenderRegistry* registry);
+
+        private:
+            Header(std::string sender, config::FlatDictionary tags, std::uint64_t seq, Type type)
+                : BaseHeader(protocol::CDTP1, std::move(sender), {}, std::move(tags)), seq_(seq), type_(type) {}
+            Header(std::shared_ptr<const std::string> sender, config::FlatDictionary tags, std::uint64_t seq, Type type)
                 : BaseHeader(protocol::CDTP1, std::move(sender), {}, std::move(tags)), seq_(seq), type_(type) {}
 
         private:
@@ -82,6 +178,11 @@ namespace constellation::message {
          */
         const std::vector<message::PayloadBuffer>& getPayload() const { return payload_buffers_; }
 
+        /**
+         * @return Reference to the payload of the message
+         */
+        std::vector<message::PayloadBuffer>& getPayload() { return payload_buffers_; }
+
         /**
          * @param payload Payload buffer containing a payload to be added as ZeroMQ message
          */
@@ -101,15 +202,22 @@ namespace constellation::message {
          * Assemble full message to frames for ZeroMQ
          *
          * This function always moves the payload
+         *
+         * @param compact_header If the compact binary header should be used for DATA messages
+         * @param release_callback Callback invoked for each payload frame once ZeroMQ released its data (optional)
          */
-        CNSTLN_API zmq::multipart_t assemble();
+        CNSTLN_API zmq::multipart_t assemble(bool compact_header = false,
+                                             const PayloadBuffer::ReleaseCallback& release_callback = {});
 
         /**
          * Disassemble message from ZeroMQ frames
          *
          * This function moves the payload frames
+         *
+         * @param frames ZeroMQ frames of the message
+         * @param registry Registry to resolve sender IDs of compact headers (optional)
          */
-        CNSTLN_API static CDTP1Message disassemble(zmq::multipart_t& frames);
+        CNSTLN_API static CDTP1Message disassemble(zmq::multipart_t& frames, const SenderRegistry* registry = nullptr);
 
     private:
         Header header_;
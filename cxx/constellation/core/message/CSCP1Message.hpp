@@ -59,7 +59,7 @@ namespace constellation::message {
         public:
             Header(std::string sender,
                    std::chrono::system_clock::time_point time = std::chrono::system_clock::now(),
-                   config::Dictionary tags = {})
+                   config::FlatDictionary tags = {})
                 : BaseHeader(protocol::CSCP1, std::move(sender), time, std::move(tags)) {}
 
             static Header disassemble(std::span<const std::byte> data) {
@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @brief Implementation of the data flow control feedback
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "DataFeedback.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include <msgpack.hpp>
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/exceptions.hpp"
+#include "constellation/core/utils/msgpack.hpp"
+#include "constellation/core/utils/string.hpp"
+
+using namespace constellation::message;
+using namespace constellation::utils;
+
+zmq::multipart_t DataFeedback::assemble() const {
+    zmq::multipart_t frames {};
+
+    msgpack::sbuffer sbuf_seq {};
+    msgpack_pack(sbuf_seq, seq_);
+    frames.addmem(sbuf_seq.data(), sbuf_seq.size());
+
+    msgpack::sbuffer sbuf_lagging {};
+    msgpack_pack(sbuf_lagging, lagging_);
+    frames.addmem(sbuf_lagging.data(), sbuf_lagging.size());
+
+    msgpack::sbuffer sbuf_compact_header {};
+    msgpack_pack(sbuf_compact_header, compact_header_);
+    frames.addmem(sbuf_compact_header.data(), sbuf_compact_header.size());
+
+    msgpack::sbuffer sbuf_received {};
+    msgpack_pack(sbuf_received, received_);
+    frames.addmem(sbuf_received.data(), sbuf_received.size());
+
+    return frames;
+}
+
+DataFeedback DataFeedback::disassemble(const zmq::multipart_t& frames) {
+    if(frames.size() != DataFeedback::frames) {
+        throw MessageDecodingError("Wrong number of frames for feedback, expected " + to_string(DataFeedback::frames) +
+                                   " but got " + to_string(frames.size()));
+    }
+    try {
+        const auto seq = msgpack_unpack_to<std::uint64_t>(to_char_ptr(frames[0].data()), frames[0].size());
+        const auto lagging = msgpack_unpack_to<bool>(to_char_ptr(frames[1].data()), frames[1].size());
+        const auto compact_header = msgpack_unpack_to<bool>(to_char_ptr(frames[2].data()), frames[2].size());
+        const auto received = msgpack_unpack_to<std::uint64_t>(to_char_ptr(frames[3].data()), frames[3].size());
+        return {seq, lagging, compact_header, received};
+    } catch(const MsgpackUnpackError& e) {
+        throw MessageDecodingError(e.what());
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @brief Flow control feedback between data receivers and transmitters
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <zmq_addon.hpp>
+
+#include "constellation/build.hpp"
+
+namespace constellation::message {
+
+    /**
+     * @brief Feedback exchanged between data receivers and transmitters for flow control
+     *
+     * Receivers regularly report the sequence number of the last processed message and whether they lag behind the data
+     * stream. Transmitters reply with the sequence number of the last message they created and whether they consider their
+     * receivers as lagging behind, which allows receivers to determine the number of messages still queued.
+     *
+     * Receivers additionally announce whether they can decode compact DATA message headers of the transmitter. Transmitters
+     * only use compact headers if all connected receivers announced support, such that receivers without support for
+     * compact headers keep receiving MessagePack headers.
+     *
+     * Receivers also report the number of data messages received in the current run. In a receiver group, the transmitter
+     * compares the sum over all members with the number of messages it sent to account for missed messages.
+     *
+     * Receivers send feedback at least once per feedback interval while a run is ongoing, such that transmitters can
+     * discard the feedback of receivers which stopped sending it.
+     *
+     * The feedback consists of four frames, the sequence number, the lagging flag, the compact header flag and the number
+     * of received messages, which distinguishes it from retransmission requests consisting of a single frame.
+     */
+    class DataFeedback {
+    public:
+        /** Number of frames of assembled feedback */
+        static constexpr std::size_t frames = 4;
+
+        /** Interval in which receivers send feedback */
+        static constexpr std::chrono::milliseconds interval {100};
+
+    public:
+        /**
+         * @brief Construct feedback
+         *
+         * @param seq Sequence number of the last processed or sent message
+         * @param lagging Whether the receiver lags behind the data stream
+         * @param compact_header Whether the receiver can decode compact headers of the transmitter
+         * @param received Number of data messages received in the current run
+         */
+        constexpr DataFeedback(std::uint64_t seq, bool lagging, bool compact_header = false, std::uint64_t received = 0)
+            : seq_(seq), lagging_(lagging), compact_header_(compact_header), received_(received) {}
+
+        /**
+         * @return Sequence number of the last processed or sent message
+         */
+        constexpr std::uint64_t getSequenceNumber() const { return seq_; }
+
+        /**
+         * @return Whether the receiver lags behind the data stream
+         */
+        constexpr bool isLagging() const { return lagging_; }
+
+        /**
+         * @return Whether the receiver can decode compact headers of the transmitter
+         */
+        constexpr bool supportsCompactHeader() const { return compact_header_; }
+
+        /**
+         * @return Number of data messages received by the receiver in the current run
+         */
+        constexpr std::uint64_t getReceived() const { return received_; }
+
+        /**
+         * @brief Assemble feedback to ZeroMQ frames
+         */
+        CNSTLN_API zmq::multipart_t assemble() const;
+
+        /**
+         * @brief Disassemble feedback from ZeroMQ frames
+         *
+         * @param frames Frames of the feedback
+         * @throw MessageDecodingError If the feedback could not be decoded
+         */
+        CNSTLN_API static DataFeedback disassemble(const zmq::multipart_t& frames);
+
+    private:
+        std::uint64_t seq_;
+        bool lagging_;
+        bool compact_header_;
+        std::uint64_t received_;
+    };
+
+} // namespace constellation::message
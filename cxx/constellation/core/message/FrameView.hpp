@@ -0,0 +1,140 @@
+/**
+ * @file
+ * @brief Typed read-only views on payload frames
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constellation/core/config/TypedArray.hpp"
+#include "constellation/core/message/AlignedBuffer.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/message/PayloadBuffer.hpp"
+#include "constellation/core/utils/enum.hpp"
+#include "constellation/core/utils/string.hpp"
+
+namespace constellation::message {
+
+    /** Concept for types which can be viewed directly in the memory of payload frames */
+    template <typename T>
+    concept frame_element = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && !std::is_pointer_v<T>;
+
+    /** Name of the message tag describing the element type of the payload frames */
+    constexpr std::string_view frame_dtype_tag = "dtype";
+
+    /**
+     * @brief Get the value of the element type tag for a given element type
+     *
+     * @return Name of the element type, e.g. `FLOAT`
+     */
+    template <config::typed_array_element T> std::string frame_dtype() {
+        return utils::enum_name(config::dtype_of<T>::value);
+    }
+
+    /**
+     * @brief Get a typed read-only view on the data of a payload frame
+     *
+     * The view references the memory of the frame, which needs to outlive the view.
+     *
+     * @param frame Data of the payload frame
+     * @return Span of the elements in the frame
+     * @throw InvalidPayload If the frame size is not a multiple of the element size or the frame is not suitably aligned
+     */
+    template <frame_element T> std::span<const T> frame_view(std::span<const std::byte> frame) {
+        if(frame.size() % sizeof(T) != 0) {
+            throw InvalidPayload("Frame size of " + utils::to_string(frame.size()) +
+                                 " bytes is not a multiple of the element size of " + utils::to_string(sizeof(T)) +
+                                 " bytes");
+        }
+        if(!AlignedBuffer::is_aligned(frame.data(), alignof(T))) {
+            throw InvalidPayload("Frame is not aligned to " + utils::to_string(alignof(T)) +
+                                 " bytes, consider setting `_payload_alignment` on the receiver");
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return {reinterpret_cast<const T*>(frame.data()), frame.size() / sizeof(T)};
+    }
+
+    /**
+     * @brief Get a typed read-only view on a payload frame
+     *
+     * @param frame Payload frame
+     * @return Span of the elements in the frame
+     * @throw InvalidPayload If the frame size is not a multiple of the element size or the frame is not suitably aligned
+     */
+    template <frame_element T> std::span<const T> frame_view(const PayloadBuffer& frame) {
+        return frame_view<T>(frame.span());
+    }
+
+    /**
+     * @brief Get a typed read-only view on a payload frame of a data message
+     *
+     * If the message header contains the `dtype` tag and the element type is a numeric type, the element type is checked
+     * against the tag.
+     *
+     * @param message Data message
+     * @param index Index of the payload frame
+     * @return Span of the elements in the frame
+     * @throw InvalidPayload If the frame does not exist, does not match the tagged element type, its size is not a
+     *                       multiple of the element size or it is not suitably aligned
+     */
+    template <frame_element T> std::span<const T> frame_view(const CDTP1Message& message, std::size_t index) {
+        const auto& payload = message.getPayload();
+        if(index >= payload.size()) {
+            throw InvalidPayload("Frame " + utils::to_string(index) + " requested but message only contains " +
+                                 utils::to_string(payload.size()) + " frames");
+        }
+        if constexpr(config::typed_array_element<T>) {
+            const auto& header = message.getHeader();
+            if(header.hasTag(std::string(frame_dtype_tag))) {
+                const auto dtype = header.getTag<std::string>(std::string(frame_dtype_tag));
+                if(utils::enum_cast<config::DType>(dtype) != config::dtype_of<T>::value) {
+                    throw InvalidPayload("Frames tagged with element type " + dtype + " cannot be viewed as " +
+                                         frame_dtype<T>());
+                }
+            }
+        }
+        return frame_view<T>(payload[index]);
+    }
+
+    /**
+     * @brief Get typed read-only views on a payload frame containing records as struct of arrays
+     *
+     * The frame has to contain the columns of all records one after another, i.e. first the values of the first type for
+     * all records, then the values of the second type for all records and so on. The number of records is derived from the
+     * frame size. Columns are not padded, such that every column needs to start at an address suitably aligned for its
+     * type.
+     *
+     * @param frame Payload frame
+     * @return Tuple with a span for each column
+     * @throw InvalidPayload If the frame size is not a multiple of the record size or a column is not suitably aligned
+     */
+    template <frame_element... Ts>
+        requires(sizeof...(Ts) > 0)
+    std::tuple<std::span<const Ts>...> frame_columns(const PayloadBuffer& frame) {
+        constexpr auto record_size = (sizeof(Ts) + ...);
+        const auto data = frame.span();
+        if(data.size() % record_size != 0) {
+            throw InvalidPayload("Frame size of " + utils::to_string(data.size()) +
+                                 " bytes is not a multiple of the record size of " + utils::to_string(record_size) +
+                                 " bytes");
+        }
+        const auto records = data.size() / record_size;
+        std::size_t offset = 0;
+        // Braced initialization guarantees evaluation from left to right
+        return std::tuple<std::span<const Ts>...> {
+            frame_view<Ts>(data.subspan(std::exchange(offset, offset + (records * sizeof(Ts))), records * sizeof(Ts)))...};
+    }
+
+} // namespace constellation::message
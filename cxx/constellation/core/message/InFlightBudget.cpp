@@ -0,0 +1,59 @@
+/**
+ * @file
+ * @brief Implementation of the in-flight budget
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "InFlightBudget.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+using namespace constellation::message;
+
+InFlightBudget::InFlightBudget(std::size_t max_bytes) : bytes_(0), max_bytes_(max_bytes) {}
+
+void InFlightBudget::configure(std::size_t max_bytes) {
+    const std::lock_guard lock {mutex_};
+    max_bytes_ = max_bytes;
+    // A larger limit might allow waiting acquisitions to proceed
+    cv_.notify_all();
+}
+
+bool InFlightBudget::fits(std::size_t bytes) const {
+    const auto max_bytes = max_bytes_.load();
+    const auto bytes_in_flight = bytes_.load();
+    return max_bytes == 0 || bytes_in_flight == 0 || bytes_in_flight + bytes <= max_bytes;
+}
+
+bool InFlightBudget::acquire(std::size_t bytes, std::chrono::milliseconds timeout) {
+    // Without limit bytes are only counted, which does not require synchronization
+    if(!enabled()) {
+        bytes_ += bytes;
+        return true;
+    }
+
+    std::unique_lock lock {mutex_};
+    const auto predicate = [&]() { return fits(bytes); };
+    if(timeout < std::chrono::milliseconds(0)) {
+        cv_.wait(lock, predicate);
+    } else if(!cv_.wait_for(lock, timeout, predicate)) {
+        return false;
+    }
+    bytes_ += bytes;
+    return true;
+}
+
+void InFlightBudget::release(std::size_t bytes) {
+    bytes_ -= bytes;
+
+    // Only acquisitions waiting for the limit need to be woken up, locking ensures they do not miss the notification
+    if(enabled()) {
+        const std::lock_guard lock {mutex_};
+        cv_.notify_all();
+    }
+}
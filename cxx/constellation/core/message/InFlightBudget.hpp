@@ -0,0 +1,88 @@
+/**
+ * @file
+ * @brief Budget for payload bytes handed to ZeroMQ but not yet released
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+#include "constellation/build.hpp"
+
+namespace constellation::message {
+
+    /**
+     * @brief Accounting of payload bytes in flight with an optional upper limit
+     *
+     * The high water mark of ZeroMQ sockets counts messages independent of their size, such that a socket can queue large
+     * amounts of memory before blocking. This budget counts the bytes of payload handed to ZeroMQ, which are released again
+     * via the release callback of the `PayloadBuffer` once ZeroMQ no longer needs the data. If a limit is set, acquiring
+     * bytes blocks until enough bytes have been released to stay within the limit.
+     *
+     * A single acquisition exceeding the limit is allowed if no other bytes are in flight, otherwise it could never succeed.
+     * Without limit, acquiring and releasing only counts the bytes without locking.
+     */
+    class InFlightBudget {
+    public:
+        /**
+         * @brief Construct in-flight budget
+         *
+         * @param max_bytes Maximum number of bytes in flight, zero disables the limit
+         */
+        CNSTLN_API InFlightBudget(std::size_t max_bytes = 0);
+
+        /**
+         * @brief Change the maximum number of bytes in flight
+         *
+         * @param max_bytes Maximum number of bytes in flight, zero disables the limit
+         */
+        CNSTLN_API void configure(std::size_t max_bytes);
+
+        /**
+         * @brief Check if the number of bytes in flight is limited
+         */
+        bool enabled() const { return max_bytes_.load() > 0; }
+
+        /**
+         * @brief Get the current number of bytes in flight
+         */
+        std::size_t bytes() const { return bytes_.load(); }
+
+        /**
+         * @brief Acquire bytes from the budget
+         *
+         * @param bytes Number of bytes to acquire
+         * @param timeout Maximum time to wait for bytes to be released, negative values wait indefinitely
+         * @return True if the bytes were acquired, false if the timeout was reached
+         */
+        CNSTLN_API bool acquire(std::size_t bytes, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+        /**
+         * @brief Release previously acquired bytes
+         *
+         * @note This function is thread-safe and can be used in the release callback of a `PayloadBuffer`
+         *
+         * @param bytes Number of bytes to release
+         */
+        CNSTLN_API void release(std::size_t bytes);
+
+    private:
+        /** Check if bytes can be acquired, requires `mutex_` to be locked */
+        bool fits(std::size_t bytes) const;
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::atomic_size_t bytes_;
+        std::atomic_size_t max_bytes_;
+    };
+
+} // namespace constellation::message
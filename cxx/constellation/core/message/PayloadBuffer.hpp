@@ -12,6 +12,7 @@
 #include <any>
 #include <concepts>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <ranges>
 #include <span>
@@ -22,6 +23,7 @@
 #include <msgpack/sbuffer.hpp>
 #include <zmq.hpp>
 
+#include "constellation/core/message/AlignedBuffer.hpp"
 #include "constellation/core/utils/casts.hpp"
 #include "constellation/core/utils/std_future.hpp"
 
@@ -41,6 +43,10 @@ namespace constellation::message {
      *
      */
     class PayloadBuffer {
+    public:
+        /** Callback invoked with the size of the data once ZeroMQ released it */
+        using ReleaseCallback = std::function<void(std::size_t)>;
+
     public:
         /**
          * @brief Construct buffer given by moving an arbitrary object
@@ -72,6 +78,20 @@ namespace constellation::message {
                                 return {utils::to_byte_ptr(buf_ref->data()), buf_ref->size()};
                             }) {}
 
+        /**
+         * @brief Specialized constructor for `AlignedBuffer`
+         */
+        PayloadBuffer(AlignedBuffer&& buf)
+            : PayloadBuffer(std::make_shared<AlignedBuffer>(std::move(buf))) {}
+
+        /**
+         * @brief Specialized constructor for shared `AlignedBuffer`, e.g. from an `AlignedBufferPool`
+         */
+        PayloadBuffer(std::shared_ptr<AlignedBuffer> buf)
+            : PayloadBuffer(std::move(buf), [](std::shared_ptr<AlignedBuffer>& buf_ref) -> std::span<std::byte> {
+                  return buf_ref->span();
+              }) {}
+
         /**
          * @brief Specialized constructor for non-const ranges
          */
@@ -138,6 +158,14 @@ namespace constellation::message {
          */
         constexpr bool empty() const { return span_.empty(); }
 
+        /**
+         * @brief Check if the data in the buffer starts at an aligned address
+         *
+         * @param alignment Alignment in bytes
+         * @return If the start address of the data is a multiple of the alignment
+         */
+        bool is_aligned(std::size_t alignment) const { return AlignedBuffer::is_aligned(span_.data(), alignment); }
+
         /**
          * @brief Interpret data as string
          *
@@ -178,6 +206,45 @@ namespace constellation::message {
             return msg;
         }
 
+        /**
+         * @brief Create a ZeroMQ message for zero-copy transport, notifying when ZeroMQ released the data
+         *
+         * ZeroMQ releases the data once the message and all copies sharing its content are destroyed, e.g. after the message
+         * has been written to the network. The callback is invoked from the thread releasing the data, which can be an
+         * internal thread of ZeroMQ, and thus has to be thread-safe.
+         *
+         * @note The buffer will be released after this function, meaning that the buffer cannot be used anymore
+         *
+         * @param release_callback Callback invoked with the size of the data once ZeroMQ released it
+         * @return ZeroMQ message owning the data in the buffer
+         */
+        zmq::message_t to_zmq_msg_release(ReleaseCallback release_callback) {
+            // Without data ZeroMQ never calls the free function
+            if(!release_callback || span_.data() == nullptr) {
+                return to_zmq_msg_release();
+            }
+
+            struct Release {
+                std::any* any_ptr;
+                ReleaseCallback callback;
+                std::size_t size;
+            };
+            // Free function for zero-copy: delete std::any owning the memory, then notify
+            auto free_fn = [](void* /* data */, void* hint) {
+                auto* release_ptr = reinterpret_cast<Release*>(hint); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                delete release_ptr->any_ptr;                          // NOLINT(cppcoreguidelines-owning-memory)
+                release_ptr->callback(release_ptr->size);
+                delete release_ptr; // NOLINT(cppcoreguidelines-owning-memory)
+            };
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            auto* release_ptr = new Release {any_ptr_, std::move(release_callback), span_.size()};
+            auto msg = zmq::message_t(span_.data(), span_.size(), free_fn, release_ptr);
+            // Release buffer since ZeroMQ took over ownership of the data
+            release();
+
+            return msg;
+        }
+
     private:
         // Release buffer: reset pointer and span without deleting the memory-owning object
         void release() noexcept {
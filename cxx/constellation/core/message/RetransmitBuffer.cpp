@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @brief Implementation of the retransmission buffer
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "RetransmitBuffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <msgpack.hpp>
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/exceptions.hpp"
+#include "constellation/core/utils/msgpack.hpp"
+
+using namespace constellation::message;
+using namespace constellation::utils;
+
+RetransmitBuffer::RetransmitBuffer(std::size_t max_messages, clock::duration max_age)
+    : max_messages_(max_messages), max_age_(max_age) {}
+
+void RetransmitBuffer::configure(std::size_t max_messages, clock::duration max_age) {
+    const std::lock_guard lock {mutex_};
+    entries_.clear();
+    max_messages_ = max_messages;
+    max_age_ = max_age;
+}
+
+void RetransmitBuffer::clear() {
+    const std::lock_guard lock {mutex_};
+    entries_.clear();
+}
+
+std::size_t RetransmitBuffer::size() {
+    const std::lock_guard lock {mutex_};
+    evict(clock::now());
+    return entries_.size();
+}
+
+bool RetransmitBuffer::dropOldest() {
+    const std::lock_guard lock {mutex_};
+    if(entries_.empty()) {
+        return false;
+    }
+    entries_.pop_front();
+    return true;
+}
+
+zmq::multipart_t RetransmitBuffer::share(zmq::multipart_t& frames) {
+    zmq::multipart_t shared {};
+    for(auto& frame : frames) {
+        // Copying a message only increases the reference count of its content
+        zmq::message_t shared_frame {};
+        shared_frame.copy(frame);
+        shared.add(std::move(shared_frame));
+    }
+    return shared;
+}
+
+void RetransmitBuffer::store(std::uint64_t seq, zmq::multipart_t&& frames) {
+    const auto now = clock::now();
+    const std::lock_guard lock {mutex_};
+    if(max_messages_ == 0) {
+        return;
+    }
+    entries_.emplace_back(seq, now, std::move(frames));
+    evict(now);
+}
+
+std::vector<std::pair<std::uint64_t, zmq::multipart_t>> RetransmitBuffer::retrieve(std::uint64_t begin, std::uint64_t end) {
+    std::vector<std::pair<std::uint64_t, zmq::multipart_t>> messages {};
+    const std::lock_guard lock {mutex_};
+    evict(clock::now());
+
+    // Entries are ordered by sequence number since they are stored in order of sending
+    auto it = std::ranges::lower_bound(entries_, begin, {}, &Entry::seq);
+    for(; it != entries_.end() && it->seq <= end; ++it) {
+        messages.emplace_back(it->seq, share(it->frames));
+    }
+    return messages;
+}
+
+void RetransmitBuffer::evict(clock::time_point now) {
+    while(entries_.size() > max_messages_) {
+        entries_.pop_front();
+    }
+    while(!entries_.empty() && now - entries_.front().time > max_age_) {
+        entries_.pop_front();
+    }
+}
+
+zmq::message_t RetransmitBuffer::encode_range(std::uint64_t begin, std::uint64_t end) {
+    msgpack::sbuffer sbuf {};
+    msgpack_pack(sbuf, std::make_pair(begin, end));
+    return {sbuf.data(), sbuf.size()};
+}
+
+std::pair<std::uint64_t, std::uint64_t> RetransmitBuffer::decode_range(std::span<const std::byte> data) {
+    try {
+        return msgpack_unpack_to<std::pair<std::uint64_t, std::uint64_t>>(to_char_ptr(data.data()), data.size_bytes());
+    } catch(const MsgpackUnpackError& e) {
+        throw MessageDecodingError(e.what());
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @brief Bounded buffer of recently sent messages for retransmission
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/build.hpp"
+
+namespace constellation::message {
+
+    /**
+     * @brief Bounded and time-limited ring of recently sent messages
+     *
+     * The buffer retains the assembled frames of messages by their sequence number such that they can be sent again when a
+     * receiver requests a range of missing sequence numbers. Frames share their content with the sent messages, thus storing
+     * a message does not copy its payload but keeps it alive until the message is evicted. Messages are evicted when the
+     * buffer holds more than the maximum number of messages or when they are older than the maximum age.
+     *
+     * Retransmission requests consist of a single frame with the range of sequence numbers. Each reply starts with the same
+     * range frame followed by the frames of the message, the final reply consists of the range frame only.
+     */
+    class RetransmitBuffer {
+    public:
+        using clock = std::chrono::steady_clock;
+
+    public:
+        /**
+         * @brief Construct retransmission buffer
+         *
+         * @param max_messages Maximum number of messages to retain, zero disables the buffer
+         * @param max_age Maximum time for which messages are retained
+         */
+        CNSTLN_API RetransmitBuffer(std::size_t max_messages = 0, clock::duration max_age = std::chrono::seconds(10));
+
+        /**
+         * @brief Change the bounds of the buffer and drop all retained messages
+         *
+         * @param max_messages Maximum number of messages to retain, zero disables the buffer
+         * @param max_age Maximum time for which messages are retained
+         */
+        CNSTLN_API void configure(std::size_t max_messages, clock::duration max_age);
+
+        /**
+         * @brief Check if the buffer retains messages
+         */
+        bool enabled() const { return max_messages_ > 0; }
+
+        /**
+         * @brief Drop all retained messages
+         */
+        CNSTLN_API void clear();
+
+        /**
+         * @brief Get the number of currently retained messages
+         */
+        CNSTLN_API std::size_t size();
+
+        /**
+         * @brief Drop the oldest retained message, e.g. to release its payload before the bounds are reached
+         *
+         * @return True if a message was dropped, false if no message is retained
+         */
+        CNSTLN_API bool dropOldest();
+
+        /**
+         * @brief Create frames sharing their content with the given frames
+         *
+         * @param frames Frames to share, e.g. an assembled message before sending it
+         * @return New frames referencing the same content
+         */
+        CNSTLN_API static zmq::multipart_t share(zmq::multipart_t& frames);
+
+        /**
+         * @brief Retain the frames of a sent message
+         *
+         * @param seq Sequence number of the message
+         * @param frames Frames of the message, e.g. obtained via `share()`
+         */
+        CNSTLN_API void store(std::uint64_t seq, zmq::multipart_t&& frames);
+
+        /**
+         * @brief Retrieve all retained messages in a range of sequence numbers
+         *
+         * @param begin First sequence number of the range
+         * @param end Last sequence number of the range (inclusive)
+         * @return Pairs of sequence number and frames sharing their content with the retained messages, ordered by sequence
+         */
+        CNSTLN_API std::vector<std::pair<std::uint64_t, zmq::multipart_t>> retrieve(std::uint64_t begin, std::uint64_t end);
+
+        /**
+         * @brief Encode a range of sequence numbers for a retransmission request or reply
+         *
+         * @param begin First sequence number of the range
+         * @param end Last sequence number of the range (inclusive)
+         * @return Frame with the encoded range
+         */
+        CNSTLN_API static zmq::message_t encode_range(std::uint64_t begin, std::uint64_t end);
+
+        /**
+         * @brief Decode a range of sequence numbers of a retransmission request or reply
+         *
+         * @param data Frame with the encoded range
+         * @return Pair of first and last sequence number
+         * @throw MessageDecodingError If the range could not be decoded
+         */
+        CNSTLN_API static std::pair<std::uint64_t, std::uint64_t> decode_range(std::span<const std::byte> data);
+
+    private:
+        /** Evict messages exceeding the bounds, requires `mutex_` to be locked */
+        void evict(clock::time_point now);
+
+    private:
+        struct Entry {
+            std::uint64_t seq;
+            clock::time_point time;
+            zmq::multipart_t frames;
+        };
+
+        std::mutex mutex_;
+        std::deque<Entry> entries_;
+        std::size_t max_messages_;
+        clock::duration max_age_;
+    };
+
+} // namespace constellation::message
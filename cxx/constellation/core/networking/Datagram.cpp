@@ -0,0 +1,375 @@
+/**
+ * @file
+ * @brief Implementation of the UDP datagram transport
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "Datagram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <asio.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/message/PayloadBuffer.hpp"
+#include "constellation/core/networking/exceptions.hpp"
+#include "constellation/core/networking/Port.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/string.hpp"
+
+using namespace constellation::message;
+using namespace constellation::networking;
+using namespace constellation::utils;
+
+namespace {
+    template <typename T> void write_le(std::byte* out, T value) {
+        if constexpr(std::endian::native != std::endian::little) {
+            value = std::byteswap(value);
+        }
+        std::memcpy(out, &value, sizeof(T));
+    }
+
+    template <typename T> T read_le(const std::byte* in) {
+        T value {};
+        std::memcpy(&value, in, sizeof(T));
+        if constexpr(std::endian::native != std::endian::little) {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+
+    // Maximum number of buffers Asio gathers into a single datagram
+    constexpr std::size_t max_gather_buffers = 64;
+} // namespace
+
+std::array<std::byte, DatagramHeader::size> DatagramHeader::pack() const {
+    std::array<std::byte, size> data {};
+    data[0] = std::byte(marker);
+    data[1] = std::byte(version);
+    write_le(&data[4], fragment_index);
+    write_le(&data[8], fragment_count);
+    write_le(&data[12], sender_id);
+    write_le(&data[20], seq);
+    write_le(&data[28], offset);
+    write_le(&data[36], body_size);
+    return data;
+}
+
+DatagramHeader DatagramHeader::unpack(std::span<const std::byte> data) {
+    if(data.size() < size) {
+        throw MessageDecodingError("Datagram too short");
+    }
+    if(std::to_integer<std::uint8_t>(data[0]) != marker) {
+        throw MessageDecodingError("Datagram without header marker");
+    }
+    if(std::to_integer<std::uint8_t>(data[1]) != version) {
+        throw MessageDecodingError("Datagram with unsupported version " + to_string(std::to_integer<int>(data[1])));
+    }
+    return {
+        .fragment_index = read_le<std::uint32_t>(&data[4]),
+        .fragment_count = read_le<std::uint32_t>(&data[8]),
+        .sender_id = read_le<std::uint64_t>(&data[12]),
+        .seq = read_le<std::uint64_t>(&data[20]),
+        .offset = read_le<std::uint64_t>(&data[28]),
+        .body_size = read_le<std::uint64_t>(&data[36]),
+    };
+}
+
+DatagramSender::DatagramSender(const asio::ip::address_v4& address,
+                               Port port,
+                               const asio::ip::address_v4& multicast_interface,
+                               std::size_t datagram_size)
+    : endpoint_(address, port), socket_(io_context_), datagram_size_(datagram_size) {
+    if(datagram_size_ <= DatagramHeader::size || datagram_size_ > max_datagram_size) {
+        throw NetworkError("Datagram size of " + to_string(datagram_size_) + " bytes not between " +
+                           to_string(DatagramHeader::size + 1) + " and " + to_string(max_datagram_size) + " bytes");
+    }
+
+    try {
+        socket_.open(asio::ip::udp::v4());
+        if(address.is_multicast()) {
+            // Deliver datagrams also to receivers on this host
+            socket_.set_option(asio::ip::multicast::enable_loopback(true));
+            if(!multicast_interface.is_unspecified()) {
+                socket_.set_option(asio::ip::multicast::outbound_interface(multicast_interface));
+            }
+        }
+        // Never block in the kernel, waiting is done explicitly if requested
+        socket_.non_blocking(true);
+    } catch(const asio::system_error& e) {
+        throw NetworkError(e.what());
+    }
+}
+
+bool DatagramSender::send(std::uint64_t sender_id, std::uint64_t seq, const zmq::multipart_t& frames, bool wait) {
+    // The body consists of a frame table with the number of frames and their sizes followed by the frames
+    std::vector<std::byte> frame_table((frames.size() + 1) * sizeof(std::uint64_t));
+    write_le(frame_table.data(), static_cast<std::uint64_t>(frames.size()));
+    std::vector<std::span<const std::byte>> segments {};
+    segments.reserve(frames.size() + 1);
+    segments.emplace_back(frame_table);
+    std::uint64_t body_size = frame_table.size();
+    for(std::size_t n = 0; n < frames.size(); ++n) {
+        write_le(&frame_table[(n + 1) * sizeof(std::uint64_t)], static_cast<std::uint64_t>(frames[n].size()));
+        segments.emplace_back(to_byte_ptr(frames[n].data()), frames[n].size());
+        body_size += frames[n].size();
+    }
+
+    const auto payload_size = datagram_size_ - DatagramHeader::size;
+    const auto fragment_count = (body_size + payload_size - 1) / payload_size;
+    if(fragment_count > std::numeric_limits<std::uint32_t>::max()) {
+        throw NetworkError("Message of " + to_string(body_size) + " bytes too large for datagram transport");
+    }
+
+    DatagramHeader header {.fragment_index = 0,
+                           .fragment_count = static_cast<std::uint32_t>(fragment_count),
+                           .sender_id = sender_id,
+                           .seq = seq,
+                           .offset = 0,
+                           .body_size = body_size};
+    std::vector<asio::const_buffer> buffers {};
+    std::size_t segment = 0;
+    std::size_t segment_offset = 0;
+    for(std::uint32_t index = 0; index < header.fragment_count; ++index) {
+        header.fragment_index = index;
+        header.offset = static_cast<std::uint64_t>(index) * payload_size;
+        const auto header_data = header.pack();
+        buffers.clear();
+        buffers.emplace_back(header_data.data(), header_data.size());
+
+        // Gather the fragment from the segments of the body without copying them
+        auto remaining = std::min<std::uint64_t>(payload_size, body_size - header.offset);
+        while(remaining > 0) {
+            const auto& data = segments[segment];
+            const auto length = std::min<std::uint64_t>(remaining, data.size() - segment_offset);
+            if(length > 0) {
+                buffers.emplace_back(data.subspan(segment_offset, length).data(), length);
+            }
+            remaining -= length;
+            segment_offset += length;
+            if(segment_offset == data.size()) {
+                ++segment;
+                segment_offset = 0;
+            }
+        }
+
+        if(!send_datagram(buffers, wait)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DatagramSender::send_datagram(const std::vector<asio::const_buffer>& buffers, bool wait) {
+    // Asio only gathers a limited number of buffers, copy fragments spanning many small frames
+    const auto gather = buffers.size() > max_gather_buffers;
+    if(gather) {
+        gather_buffer_.resize(asio::buffer_size(buffers));
+        asio::buffer_copy(asio::buffer(gather_buffer_), buffers);
+    }
+
+    while(true) {
+        asio::error_code ec {};
+        if(gather) {
+            socket_.send_to(asio::buffer(gather_buffer_), endpoint_, 0, ec);
+        } else {
+            socket_.send_to(buffers, endpoint_, 0, ec);
+        }
+        if(!ec) {
+            return true;
+        }
+        if(ec != asio::error::would_block && ec != asio::error::try_again) {
+            throw NetworkError("Failed sending datagram: " + ec.message());
+        }
+        if(!wait) {
+            return false;
+        }
+        socket_.wait(asio::ip::udp::socket::wait_write, ec);
+    }
+}
+
+DatagramReceiver::DatagramReceiver(const asio::ip::address_v4& address,
+                                   Port port,
+                                   std::uint64_t sender_id,
+                                   std::size_t datagram_size,
+                                   std::size_t max_message_size)
+    : socket_(io_context_), sender_id_(sender_id), payload_size_(datagram_size - DatagramHeader::size),
+      max_message_size_(max_message_size), buffer_(DatagramSender::max_datagram_size) {
+    if(datagram_size <= DatagramHeader::size || datagram_size > DatagramSender::max_datagram_size) {
+        throw NetworkError("Datagram size of " + to_string(datagram_size) + " bytes not between " +
+                           to_string(DatagramHeader::size + 1) + " and " + to_string(DatagramSender::max_datagram_size) +
+                           " bytes");
+    }
+
+    try {
+        socket_.open(asio::ip::udp::v4());
+        if(address.is_multicast()) {
+            // Several receivers on this host can subscribe to the same group
+            socket_.set_option(asio::socket_base::reuse_address(true));
+        }
+        // Absorb bursts of fragments, the operating system might limit the size
+        socket_.set_option(asio::socket_base::receive_buffer_size(4 * 1024 * 1024));
+        socket_.bind({asio::ip::address_v4::any(), port});
+    } catch(const asio::system_error& e) {
+        throw NetworkError(e.what());
+    }
+
+    if(address.is_multicast()) {
+        // Join on the default interface and on the loopback interface to receive datagrams from senders on this host
+        bool joined = false;
+        for(const auto& multicast_interface : {asio::ip::address_v4::any(), asio::ip::address_v4::loopback()}) {
+            asio::error_code ec {};
+            socket_.set_option(asio::ip::multicast::join_group(address, multicast_interface), ec);
+            joined = joined || !ec;
+        }
+        if(!joined) {
+            throw NetworkError("Could not join multicast group " + address.to_string());
+        }
+    }
+}
+
+std::optional<zmq::multipart_t> DatagramReceiver::recv(std::chrono::steady_clock::duration timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(wait(std::max(deadline - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration::zero()))) {
+        std::size_t length = 0;
+        try {
+            length = socket_.receive(asio::buffer(buffer_));
+        } catch(const asio::system_error& e) {
+            throw NetworkError(e.what());
+        }
+        auto frames = process({buffer_.data(), length});
+        if(frames.has_value()) {
+            return frames;
+        }
+    }
+    return std::nullopt;
+}
+
+bool DatagramReceiver::wait(std::chrono::steady_clock::duration timeout) {
+    if(socket_.available() > 0) {
+        return true;
+    }
+    if(timeout == std::chrono::steady_clock::duration::zero()) {
+        return false;
+    }
+
+    bool readable = false;
+    socket_.async_wait(asio::ip::udp::socket::wait_read, [&](const asio::error_code& ec) { readable = !ec; });
+    io_context_.restart();
+    io_context_.run_for(timeout);
+
+    // If IO context not stopped, then no datagram arrived, cancel and complete the pending wait
+    if(!io_context_.stopped()) {
+        socket_.cancel();
+        io_context_.run();
+    }
+    return readable;
+}
+
+std::optional<zmq::multipart_t> DatagramReceiver::process(std::span<const std::byte> datagram) {
+    const auto header = DatagramHeader::unpack(datagram);
+
+    // Ignore other senders in the same multicast group and late fragments of completed or dropped messages
+    if(header.sender_id != sender_id_ || header.seq <= last_seq_) {
+        return std::nullopt;
+    }
+
+    // Reject oversized messages before allocating memory for them
+    if(header.body_size > max_message_size_) {
+        throw MessageDecodingError("Message " + to_string(header.seq) + " of " + to_string(header.body_size) +
+                                   " bytes exceeds maximum message size of " + to_string(max_message_size_) + " bytes");
+    }
+
+    // The fragmentation of the message is fully determined by its size and the datagram size of the sender
+    const auto payload = datagram.subspan(DatagramHeader::size);
+    const auto fragment_count = (header.body_size + payload_size_ - 1) / payload_size_;
+    const auto offset = static_cast<std::uint64_t>(header.fragment_index) * payload_size_;
+    if(header.fragment_count != fragment_count || header.fragment_index >= header.fragment_count ||
+       header.offset != offset || payload.size() != std::min<std::uint64_t>(payload_size_, header.body_size - offset)) {
+        throw MessageDecodingError("Invalid fragment " + to_string(header.fragment_index) + " of message " +
+                                   to_string(header.seq));
+    }
+
+    auto fragments_it = fragments_.find(header.seq);
+    if(fragments_it == fragments_.end()) {
+        // Drop the oldest incomplete message if too many are pending
+        if(fragments_.size() >= max_incomplete) {
+            fragments_.erase(fragments_.begin());
+            ++incomplete_;
+        }
+        fragments_it = fragments_
+                           .emplace(header.seq,
+                                    Fragments {.body = std::vector<std::byte>(header.body_size),
+                                               .received = std::vector<bool>(header.fragment_count, false),
+                                               .missing = header.fragment_count})
+                           .first;
+    }
+    auto& fragments = fragments_it->second;
+    if(fragments.body.size() != header.body_size || fragments.received.size() != header.fragment_count) {
+        throw MessageDecodingError("Inconsistent fragment " + to_string(header.fragment_index) + " of message " +
+                                   to_string(header.seq));
+    }
+
+    // Skip duplicate fragments
+    if(fragments.received[header.fragment_index]) {
+        return std::nullopt;
+    }
+    std::ranges::copy(payload, std::next(fragments.body.begin(), static_cast<std::ptrdiff_t>(header.offset)));
+    fragments.received[header.fragment_index] = true;
+    if(--fragments.missing > 0) {
+        return std::nullopt;
+    }
+
+    // Message complete, earlier incomplete messages can no longer be returned in order
+    auto body = std::make_shared<std::vector<std::byte>>(std::move(fragments.body));
+    incomplete_ += static_cast<std::uint64_t>(std::distance(fragments_.begin(), fragments_it));
+    fragments_.erase(fragments_.begin(), std::next(fragments_it));
+    last_seq_ = header.seq;
+
+    // Decode frame table
+    const auto body_span = std::span<const std::byte>(*body);
+    if(body_span.size() < sizeof(std::uint64_t)) {
+        throw MessageDecodingError("Message " + to_string(header.seq) + " without frame table");
+    }
+    const auto frame_count = read_le<std::uint64_t>(body_span.data());
+    if(frame_count >= body_span.size() / sizeof(std::uint64_t)) {
+        throw MessageDecodingError("Message " + to_string(header.seq) + " with invalid frame table");
+    }
+    std::uint64_t offset = (frame_count + 1) * sizeof(std::uint64_t);
+
+    zmq::multipart_t frames {};
+    for(std::uint64_t n = 0; n < frame_count; ++n) {
+        const auto frame_size = read_le<std::uint64_t>(body_span.subspan((n + 1) * sizeof(std::uint64_t)).data());
+        if(frame_size > body_span.size() - offset) {
+            throw MessageDecodingError("Message " + to_string(header.seq) + " with invalid frame size");
+        }
+        // Frames share the reassembled body without copying it
+        frames.add(PayloadBuffer(body,
+                                 [offset, frame_size](std::shared_ptr<std::vector<std::byte>>& body_ref) {
+                                     return std::span<std::byte>(*body_ref).subspan(offset, frame_size);
+                                 })
+                       .to_zmq_msg_release());
+        offset += frame_size;
+    }
+    if(offset != body_span.size()) {
+        throw MessageDecodingError("Message " + to_string(header.seq) + " with invalid frame table");
+    }
+    return frames;
+}
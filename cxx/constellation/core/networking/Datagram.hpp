@@ -0,0 +1,218 @@
+/**
+ * @file
+ * @brief Lossy transport of CDTP messages via UDP datagrams
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <asio/buffer.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/address_v4.hpp>
+#include <asio/ip/udp.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/build.hpp"
+#include "constellation/core/networking/Port.hpp"
+
+namespace constellation::networking {
+
+    /**
+     * @brief Header preceding every datagram of a message
+     *
+     * The frames of a message are serialized into a body consisting of the number of frames and the size of each frame,
+     * followed by the content of all frames. The body is split into fragments fitting into a single datagram. Each datagram
+     * starts with this fixed-size little-endian header containing a marker byte, the version, two reserved bytes, the index
+     * of the fragment and the total number of fragments, the 64-bit sender ID, the 64-bit sequence number of the message,
+     * the offset of the fragment in the body and the total size of the body.
+     */
+    struct DatagramHeader {
+        /** Marker of datagram headers */
+        static constexpr std::uint8_t marker = 0xCD;
+
+        /** Version of the datagram format */
+        static constexpr std::uint8_t version = 1;
+
+        /** Size of the header in bytes */
+        static constexpr std::size_t size = 44;
+
+        std::uint32_t fragment_index;
+        std::uint32_t fragment_count;
+        std::uint64_t sender_id;
+        std::uint64_t seq;
+        std::uint64_t offset;
+        std::uint64_t body_size;
+
+        /**
+         * @brief Pack header into its binary representation
+         */
+        CNSTLN_API std::array<std::byte, size> pack() const;
+
+        /**
+         * @brief Unpack header from the start of a datagram
+         *
+         * @param data Content of the datagram
+         * @throw MessageDecodingError If the datagram does not start with a valid header
+         */
+        CNSTLN_API static DatagramHeader unpack(std::span<const std::byte> data);
+    };
+
+    /**
+     * @brief Sender of messages via UDP datagrams
+     *
+     * Messages are sent to a unicast address or to a multicast group. Messages exceeding the datagram size are split into
+     * several fragments. There is no flow control or retransmission, datagrams which cannot be delivered are lost.
+     */
+    class DatagramSender {
+    public:
+        /** Default datagram size, fitting into the MTU of Ethernet without IP fragmentation */
+        static constexpr std::size_t default_datagram_size = 1472;
+
+        /** Maximum datagram size, limited by the maximum UDP payload over IPv4 */
+        static constexpr std::size_t max_datagram_size = 65507;
+
+    public:
+        /**
+         * @brief Construct datagram sender
+         *
+         * @param address Unicast address or multicast group to send to
+         * @param port Port to send to
+         * @param multicast_interface Address of the interface for outgoing multicast datagrams, any address uses the default
+         *                            route
+         * @param datagram_size Maximum size of a datagram including the header
+         * @throw NetworkError If the socket could not be opened or the datagram size is too small
+         */
+        CNSTLN_API DatagramSender(const asio::ip::address_v4& address,
+                                  Port port,
+                                  const asio::ip::address_v4& multicast_interface = asio::ip::address_v4::any(),
+                                  std::size_t datagram_size = default_datagram_size);
+
+        /**
+         * @brief Send a message
+         *
+         * @param sender_id ID of the sender, see `CDTP1Message::Header::sender_id()`
+         * @param seq Sequence number of the message
+         * @param frames Frames of the message
+         * @param wait Whether to wait if the send buffer of the socket is full, otherwise the message is dropped
+         * @return True if all fragments of the message were sent, false otherwise
+         * @throw NetworkError If sending failed
+         */
+        CNSTLN_API bool send(std::uint64_t sender_id, std::uint64_t seq, const zmq::multipart_t& frames, bool wait = true);
+
+        /**
+         * @brief Get the address to which messages are sent
+         */
+        asio::ip::address_v4 getAddress() const { return endpoint_.address().to_v4(); }
+
+        /**
+         * @brief Get the port to which messages are sent
+         */
+        Port getPort() const { return endpoint_.port(); }
+
+    private:
+        /** Send a single datagram, returns false if it would block and waiting is disabled */
+        bool send_datagram(const std::vector<asio::const_buffer>& buffers, bool wait);
+
+    private:
+        asio::io_context io_context_;
+        asio::ip::udp::endpoint endpoint_;
+        asio::ip::udp::socket socket_;
+        std::size_t datagram_size_;
+        std::vector<std::byte> gather_buffer_;
+    };
+
+    /**
+     * @brief Receiver of messages sent via UDP datagrams
+     *
+     * The receiver reassembles the fragments of messages from a single sender and returns messages in order of their
+     * sequence number. Datagrams from other senders are ignored. Messages arriving after a message with a higher sequence
+     * number are dropped, as are incomplete messages once a later message has been completed or too many messages are
+     * incomplete at the same time.
+     *
+     * Fragments need to match the datagram size of the sender, such that the fragment count, offset and size follow from
+     * the size of the message. Messages larger than the maximum message size are rejected before allocating memory.
+     */
+    class DatagramReceiver {
+    public:
+        /** Maximum number of incomplete messages kept for reassembly */
+        static constexpr std::size_t max_incomplete = 16;
+
+        /** Default maximum size of a reassembled message */
+        static constexpr std::size_t default_max_message_size = 64 * 1024 * 1024;
+
+    public:
+        /**
+         * @brief Construct datagram receiver
+         *
+         * @param address Unicast address or multicast group to which messages are sent
+         * @param port Port to which messages are sent, zero selects an ephemeral port
+         * @param sender_id ID of the sender from which messages are received
+         * @param datagram_size Maximum size of a datagram used by the sender
+         * @param max_message_size Maximum size of a reassembled message in bytes
+         * @throw NetworkError If the datagram size is invalid, the socket could not be opened or the multicast group could
+         *                     not be joined
+         */
+        CNSTLN_API DatagramReceiver(const asio::ip::address_v4& address,
+                                    Port port,
+                                    std::uint64_t sender_id,
+                                    std::size_t datagram_size = DatagramSender::default_datagram_size,
+                                    std::size_t max_message_size = default_max_message_size);
+
+        /**
+         * @brief Get the port to which the receiver is bound
+         */
+        Port getPort() const { return socket_.local_endpoint().port(); }
+
+        /**
+         * @brief Get the number of messages dropped since not all of their fragments arrived in time
+         */
+        std::uint64_t countIncomplete() const { return incomplete_; }
+
+        /**
+         * @brief Receive the next complete message
+         *
+         * @param timeout Maximum time to wait for datagrams, zero only processes datagrams which already arrived
+         * @return Frames of the message if one was completed
+         * @throw MessageDecodingError If a datagram is not a valid fragment
+         * @throw NetworkError If receiving failed
+         */
+        CNSTLN_API std::optional<zmq::multipart_t> recv(std::chrono::steady_clock::duration timeout);
+
+    private:
+        /** Wait until a datagram can be read */
+        bool wait(std::chrono::steady_clock::duration timeout);
+
+        /** Add a datagram to its message, returns the frames of the message if it was completed */
+        std::optional<zmq::multipart_t> process(std::span<const std::byte> datagram);
+
+    private:
+        struct Fragments {
+            std::vector<std::byte> body;
+            std::vector<bool> received;
+            std::uint32_t missing;
+        };
+
+        asio::io_context io_context_;
+        asio::ip::udp::socket socket_;
+        std::uint64_t sender_id_;
+        std::size_t payload_size_;
+        std::size_t max_message_size_;
+        std::vector<std::byte> buffer_;
+        std::map<std::uint64_t, Fragments> fragments_;
+        std::uint64_t last_seq_ {0};
+        std::uint64_t incomplete_ {0};
+    };
+
+} // namespace constellation::networking
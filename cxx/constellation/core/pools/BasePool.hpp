@@ -11,6 +11,7 @@
 
 #include <any>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <functional>
@@ -46,8 +47,9 @@ namespace constellation::pools {
          *
          * @param log_topic Logger topic to be used for this component
          * @param callback Callback function pointer for received messages
+         * @param measure_handling If `message_handled()` should be called with the time spent in the callback
          */
-        BasePool(std::string_view log_topic, std::function<void(MESSAGE&&)> callback);
+        BasePool(std::string_view log_topic, std::function<void(MESSAGE&&)> callback, bool measure_handling = false);
 
         /**
          * @brief Destruct BasePool
@@ -120,6 +122,47 @@ namespace constellation::pools {
          */
         virtual void host_disposed(const chirp::DiscoveredService& service);
 
+        /**
+         * @brief Method for derived classes to act on an exception thrown in the pool thread
+         *
+         * This method is called from the pool thread after the exception has been stored, such that a subsequent call to
+         * `checkPoolException()` rethrows it. It allows derived classes to react immediately instead of polling.
+         */
+        virtual void pool_exception_raised();
+
+        /**
+         * @brief Method to decode a received message, by default `MESSAGE::disassemble()` is used
+         *
+         * This method is called from the pool thread with `sockets_mutex_` locked. It allows derived classes to pass
+         * additional state required for decoding.
+         *
+         * @param frames ZeroMQ frames of the received message
+         * @return Decoded message
+         */
+        virtual MESSAGE decode_message(zmq::multipart_t& frames);
+
+        /**
+         * @brief Method for derived classes to act on a message after it has been passed to the message callback
+         *
+         * This method is called from the pool thread with `sockets_mutex_` locked if enabled on construction. It allows
+         * derived classes to monitor whether they keep up with the incoming messages of each connected host.
+         *
+         * @param service Service from which the message was received
+         * @param latency Time spent in the message callback
+         * @param pending Whether further messages from this service are already queued
+         */
+        virtual void message_handled(const chirp::DiscoveredService& service,
+                                     std::chrono::nanoseconds latency,
+                                     bool pending);
+
+        /**
+         * @brief Method for derived classes to perform regular tasks in the pool thread
+         *
+         * This method is called from the pool thread with `sockets_mutex_` locked after every poll of the sockets, which
+         * happens at least every 50ms while sockets are connected.
+         */
+        virtual void poll_completed();
+
         /**
          * @brief Return all connected sockets
          *
@@ -170,6 +213,7 @@ namespace constellation::pools {
         std::atomic_size_t poller_events_;
 
         std::function<void(MESSAGE&&)> message_callback_;
+        bool measure_handling_;
 
         std::map<chirp::DiscoveredService, zmq::socket_t> sockets_;
         std::atomic_size_t socket_count_ {0};
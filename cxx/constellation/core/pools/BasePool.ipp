@@ -12,6 +12,7 @@
 #include "BasePool.hpp" // NOLINT(misc-header-include-cycle)
 
 #include <any>
+#include <chrono>
 #include <exception>
 #include <functional>
 #include <mutex>
@@ -37,8 +38,10 @@
 namespace constellation::pools {
 
     template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
-    BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::BasePool(std::string_view log_topic, std::function<void(MESSAGE&&)> callback)
-        : pool_logger_(log_topic), message_callback_(std::move(callback)) {}
+    BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::BasePool(std::string_view log_topic,
+                                                      std::function<void(MESSAGE&&)> callback,
+                                                      bool measure_handling)
+        : pool_logger_(log_topic), message_callback_(std::move(callback)), measure_handling_(measure_handling) {}
 
     template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
     void BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::startPool() {
@@ -93,6 +96,22 @@ namespace constellation::pools {
     template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
     void BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::host_disposed(const chirp::DiscoveredService& /*service*/) {}
 
+    template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
+    void BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::pool_exception_raised() {}
+
+    template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
+    MESSAGE BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::decode_message(zmq::multipart_t& frames) {
+        return MESSAGE::disassemble(frames);
+    }
+
+    template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
+    void BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::message_handled(const chirp::DiscoveredService& /*service*/,
+                                                                  std::chrono::nanoseconds /*latency*/,
+                                                                  bool /*pending*/) {}
+
+    template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
+    void BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::poll_completed() {}
+
     template <typename MESSAGE, protocol::CHIRP::ServiceIdentifier SERVICE, zmq::socket_type SOCKET_TYPE>
     void BasePool<MESSAGE, SERVICE, SOCKET_TYPE>::checkPoolException() {
         // If exception has been thrown, disconnect from all remote sockets and propagate it
@@ -118,14 +137,26 @@ namespace constellation::pools {
              * pending. Since this is set per-socket, we can pass a reference to the currently registered socket to the
              * lambda and then directly access the socket, read the ZMQ message and pass it to the message callback.
              */
-            const zmq::active_poller_t::handler_type handler = [this, sock = zmq::socket_ref(socket)](zmq::event_flags ef) {
+            const zmq::active_poller_t::handler_type handler = [this, service, sock = zmq::socket_ref(socket)](
+                                                                   zmq::event_flags ef) {
                 // Check if flags indicate the correct ZMQ event (pollin, incoming message):
                 if((ef & zmq::event_flags::pollin) != zmq::event_flags::none) {
                     zmq::multipart_t zmq_msg {};
                     auto received = zmq_msg.recv(sock);
                     if(received) {
                         try {
-                            message_callback_(MESSAGE::disassemble(zmq_msg));
+                            if(!measure_handling_) [[likely]] {
+                                message_callback_(decode_message(zmq_msg));
+                                return;
+                            }
+
+                            const auto start = std::chrono::steady_clock::now();
+                            message_callback_(decode_message(zmq_msg));
+                            const auto latency = std::chrono::steady_clock::now() - start;
+
+                            // Reading the events processes pending commands, afterwards pollin shows queued messages
+                            const auto pending = (sock.get(zmq::sockopt::events) & ZMQ_POLLIN) != 0;
+                            message_handled(service, latency, pending);
                         } catch(const message::MessageDecodingError& error) {
                             LOG(pool_logger_, WARNING) << error.what();
                         } catch(const message::IncorrectMessageType& error) {
@@ -290,13 +321,17 @@ namespace constellation::pools {
                 } catch(const zmq::error_t& error) {
                     throw networking::NetworkError(error.what());
                 }
+
+                poll_completed();
             }
         } catch(const std::exception& error) {
             LOG(pool_logger_, CRITICAL) << "Caught exception in pool thread: " << error.what();
             exception_ptr_ = std::current_exception();
+            pool_exception_raised();
         } catch(...) {
             LOG(pool_logger_, CRITICAL) << "Caught exception in pool thread";
             exception_ptr_ = std::current_exception();
+            pool_exception_raised();
         }
     }
 } // namespace constellation::pools
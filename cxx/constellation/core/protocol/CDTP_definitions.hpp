@@ -31,4 +31,13 @@ namespace constellation::protocol::CDTP {
         ABORTED = 0x08,
     };
 
+    /** Transport used for data messages */
+    enum class Transport : std::uint8_t {
+        /** Reliable transport via TCP, sending blocks if receivers do not keep up */
+        TCP,
+
+        /** Lossy transport via UDP datagrams, messages which are not delivered are counted as missed */
+        UDP,
+    };
+
 } // namespace constellation::protocol::CDTP
@@ -81,6 +81,7 @@ namespace constellation::protocol::CSCP {
         _get_commands,
         _get_remotes,
         _get_services,
+        _get_result,
     };
 
     /**
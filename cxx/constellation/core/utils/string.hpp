@@ -44,6 +44,20 @@ namespace constellation::utils {
         return out;
     }
 
+    /**
+     * @brief Transparent comparator ordering strings case-insensitively
+     *
+     * This allows case-insensitive lookups in ordered containers without creating lower-case copies of the keys.
+     */
+    struct case_insensitive_less { // NOLINT(readability-identifier-naming)
+        using is_transparent = void;
+
+        bool operator()(std::string_view lhs, std::string_view rhs) const {
+            const auto to_lower = [](char character) { return std::tolower(static_cast<unsigned char>(character)); };
+            return std::ranges::lexicographical_compare(lhs, rhs, std::ranges::less(), to_lower, to_lower);
+        }
+    };
+
     /** Converts a string-like object to a string */
     template <typename S>
         requires std::convertible_to<S, std::string_view>
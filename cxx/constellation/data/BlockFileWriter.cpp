@@ -0,0 +1,276 @@
+/**
+ * @file
+ * @brief Block file writer implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "BlockFileWriter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef CNSTLN_DATA_ZSTD
+#include <zstd.h>
+#endif
+
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/thread.hpp"
+#include "constellation/data/exceptions.hpp"
+
+using namespace constellation::data;
+using namespace constellation::utils;
+
+double CompressionStatistics::getCompressionRatio() const {
+    const auto bytes_out = bytes_out_.load();
+    return bytes_out > 0 ? static_cast<double>(bytes_in_.load()) / static_cast<double>(bytes_out) : 1.0;
+}
+
+double CompressionStatistics::getWorkerThroughput(std::size_t worker) const {
+    const auto& stats = workers_.at(worker);
+    const auto busy_ns = stats.busy_ns.load();
+    // Bytes per nanosecond are GB/s
+    return busy_ns > 0 ? 1e3 * static_cast<double>(stats.bytes.load()) / static_cast<double>(busy_ns) : 0.0;
+}
+
+BlockFileWriter::BlockFileWriter(
+    std::ofstream file, Compression compression, std::size_t workers, std::size_t block_size, int level)
+    : file_(std::move(file)), compression_(compression), block_size_(block_size), level_(level) {
+
+    if(!isAvailable(compression_)) {
+        throw CompressionError("Compression " + to_string(compression_) + " is not available in this build");
+    }
+
+    if(compression_ == Compression::NONE) {
+        statistics_ = std::make_shared<CompressionStatistics>(0);
+        return;
+    }
+
+    if(workers == 0) {
+        throw CompressionError("At least one compression worker is required");
+    }
+    if(block_size_ == 0) {
+        throw CompressionError("Block size needs to be larger than zero");
+    }
+
+    statistics_ = std::make_shared<CompressionStatistics>(workers);
+    current_block_.reserve(block_size_);
+    for(std::size_t n = 0; n < workers; ++n) {
+        auto& worker = workers_.emplace_back(std::bind_front(&BlockFileWriter::worker_loop, this), n);
+        set_thread_name(worker, "Compressor" + to_string(n));
+    }
+}
+
+BlockFileWriter::~BlockFileWriter() {
+    try {
+        close();
+    } catch(...) { // NOLINT(bugprone-empty-catch)
+        // Errors cannot be reported from the destructor
+    }
+}
+
+bool BlockFileWriter::isAvailable(Compression compression) {
+    switch(compression) {
+    case Compression::NONE: return true;
+#ifdef CNSTLN_DATA_ZSTD
+    case Compression::ZSTD: return true;
+#endif
+    default: return false;
+    }
+}
+
+void BlockFileWriter::write(std::span<const std::byte> data) {
+    if(closed_) {
+        throw CompressionError("Cannot write to closed file");
+    }
+
+    // Write directly to file without compression
+    if(compression_ == Compression::NONE) {
+        write_file(data);
+        statistics_->bytes_in_ += data.size();
+        statistics_->bytes_out_ += data.size();
+        return;
+    }
+
+    rethrow_error();
+
+    // Fill blocks and submit them to the workers once full
+    while(!data.empty()) {
+        const auto length = std::min(block_size_ - current_block_.size(), data.size());
+        current_block_.insert(current_block_.end(), data.begin(), data.begin() + static_cast<std::ptrdiff_t>(length));
+        data = data.subspan(length);
+
+        if(current_block_.size() == block_size_) {
+            // Limit memory usage by allowing a maximum of two blocks per worker to be pending
+            wait_pending((2 * workers_.size()) - 1);
+            submit_block();
+        }
+    }
+}
+
+void BlockFileWriter::flush() {
+    if(closed_) {
+        return;
+    }
+
+    if(compression_ != Compression::NONE) {
+        if(!current_block_.empty()) {
+            submit_block();
+        }
+        wait_pending(0);
+    }
+
+    const std::lock_guard file_lock {file_mutex_};
+    file_.flush();
+}
+
+void BlockFileWriter::close() {
+    if(closed_) {
+        return;
+    }
+
+    flush();
+    closed_ = true;
+
+    // Stop and join workers
+    workers_.clear();
+
+    file_.close();
+}
+
+void BlockFileWriter::submit_block() {
+    std::vector<std::byte> data {};
+    data.reserve(block_size_);
+    std::swap(data, current_block_);
+
+    std::unique_lock lock {mutex_};
+    queue_.emplace_back(next_sequence_++, std::move(data));
+    ++pending_;
+    lock.unlock();
+
+    queue_cv_.notify_one();
+}
+
+void BlockFileWriter::wait_pending(std::size_t max_pending) {
+    std::unique_lock lock {mutex_};
+    written_cv_.wait(lock, [&]() { return pending_ <= max_pending || error_ != nullptr; });
+    lock.unlock();
+
+    rethrow_error();
+}
+
+void BlockFileWriter::rethrow_error() {
+    const std::lock_guard lock {mutex_};
+    if(error_ != nullptr) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void BlockFileWriter::worker_loop(const std::stop_token& stop_token, std::size_t worker) {
+    auto& stats = statistics_->workers_[worker];
+
+    while(!stop_token.stop_requested()) {
+        std::unique_lock lock {mutex_};
+
+        // Wait for a block or a stop request
+        if(!queue_cv_.wait(lock, stop_token, [this]() { return !queue_.empty(); })) {
+            break;
+        }
+
+        auto block = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+
+        // Compress outside the lock
+        try {
+            const auto start = std::chrono::steady_clock::now();
+            auto compressed = compress(block.data);
+            const auto duration =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            stats.bytes += block.data.size();
+            stats.busy_ns += static_cast<std::uint64_t>(duration.count());
+            statistics_->bytes_in_ += block.data.size();
+
+            lock.lock();
+            completed_.emplace(block.sequence, std::move(compressed));
+            lock.unlock();
+
+            write_completed();
+        } catch(...) {
+            lock.lock();
+            error_ = std::current_exception();
+            lock.unlock();
+            written_cv_.notify_all();
+        }
+    }
+}
+
+std::vector<std::byte> BlockFileWriter::compress([[maybe_unused]] std::span<const std::byte> data) const {
+#ifdef CNSTLN_DATA_ZSTD
+    if(compression_ == Compression::ZSTD) {
+        // Reuse compression context of the worker thread
+        thread_local const std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx {ZSTD_createCCtx(), &ZSTD_freeCCtx};
+        ZSTD_CCtx_reset(cctx.get(), ZSTD_reset_session_and_parameters);
+        ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_compressionLevel, level_);
+        ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_checksumFlag, 1);
+
+        std::vector<std::byte> compressed(ZSTD_compressBound(data.size()));
+        const auto size = ZSTD_compress2(cctx.get(), compressed.data(), compressed.size(), data.data(), data.size());
+        if(ZSTD_isError(size) != 0) {
+            throw CompressionError("Failed to compress block: " + std::string(ZSTD_getErrorName(size)));
+        }
+        compressed.resize(size);
+        return compressed;
+    }
+#endif
+    throw CompressionError("Compression " + to_string(compression_) + " is not available in this build");
+}
+
+void BlockFileWriter::write_completed() {
+    // Only one thread writes at a time, blocks are written in the order they were submitted
+    const std::lock_guard file_lock {file_mutex_};
+
+    while(true) {
+        std::unique_lock lock {mutex_};
+        const auto block_it = completed_.find(next_write_);
+        if(block_it == completed_.end()) {
+            break;
+        }
+        auto data = std::move(block_it->second);
+        completed_.erase(block_it);
+        lock.unlock();
+
+        write_file(data);
+        statistics_->bytes_out_ += data.size();
+
+        lock.lock();
+        ++next_write_;
+        --pending_;
+        lock.unlock();
+        written_cv_.notify_all();
+    }
+}
+
+void BlockFileWriter::write_file(std::span<const std::byte> data) {
+    file_.write(to_char_ptr(data.data()), static_cast<std::streamsize>(data.size()));
+    if(!file_.good()) {
+        throw CompressionError("Failed to write to file");
+    }
+}
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * @brief File writer with parallel block compression
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "constellation/build.hpp"
+
+namespace constellation::data {
+
+    /** Compression algorithm used by the `BlockFileWriter` */
+    enum class Compression : std::uint8_t {
+        /** Data is written unmodified */
+        NONE,
+        /** Blocks are written as independent Zstandard frames with content checksum */
+        ZSTD,
+    };
+
+    /**
+     * @brief Statistics of a `BlockFileWriter`
+     *
+     * All members can be read while the writer is in use, e.g. to publish them as metrics.
+     */
+    class CNSTLN_API CompressionStatistics {
+    public:
+        /** Statistics of a single compression worker */
+        struct Worker {
+            /** Number of uncompressed bytes processed by the worker */
+            std::atomic_uint64_t bytes;
+            /** Time spent compressing in nanoseconds */
+            std::atomic_uint64_t busy_ns;
+        };
+
+    public:
+        explicit CompressionStatistics(std::size_t workers) : workers_(workers) {}
+
+        /**
+         * @brief Get the ratio of uncompressed to compressed bytes of all blocks written so far
+         */
+        CNSTLN_API double getCompressionRatio() const;
+
+        /**
+         * @brief Get the compression throughput of a worker while busy
+         *
+         * @param worker Index of the worker
+         * @return Throughput in MB/s
+         */
+        CNSTLN_API double getWorkerThroughput(std::size_t worker) const;
+
+        /**
+         * @brief Get the number of compression workers
+         */
+        std::size_t getWorkers() const { return workers_.size(); }
+
+    private:
+        friend class BlockFileWriter;
+
+        std::atomic_uint64_t bytes_in_;
+        std::atomic_uint64_t bytes_out_;
+        std::vector<Worker> workers_;
+    };
+
+    /**
+     * @brief Writer which optionally compresses the written data in blocks on a pool of worker threads
+     *
+     * Without compression, data is written to the file directly and the output is identical to writing to the file stream.
+     * With compression, the data is collected into blocks of a fixed size which are compressed concurrently and written to
+     * the file in the order in which they were submitted. For Zstandard, every block is an independent frame including a
+     * checksum of its content, such that the file can be decompressed with the standard `zstd` tool.
+     *
+     * @note Only one thread may call the member functions of this class at a time
+     */
+    class CNSTLN_API BlockFileWriter {
+    public:
+        /**
+         * @brief Construct a block file writer
+         *
+         * @param file Binary output file stream to write to
+         * @param compression Compression algorithm
+         * @param workers Number of compression worker threads
+         * @param block_size Size of uncompressed blocks in bytes
+         * @param level Compression level
+         * @throw CompressionError If the compression algorithm is not available or the parameters are invalid
+         */
+        CNSTLN_API BlockFileWriter(std::ofstream file,
+                                   Compression compression = Compression::NONE,
+                                   std::size_t workers = 1,
+                                   std::size_t block_size = 1024 * 1024,
+                                   int level = 3);
+
+        /**
+         * @brief Destruct the writer, writing all pending blocks and closing the file
+         */
+        CNSTLN_API ~BlockFileWriter();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        BlockFileWriter(const BlockFileWriter& other) = delete;
+        BlockFileWriter& operator=(const BlockFileWriter& other) = delete;
+        BlockFileWriter(BlockFileWriter&& other) = delete;
+        BlockFileWriter& operator=(BlockFileWriter&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Check if a compression algorithm is available in this build
+         */
+        CNSTLN_API static bool isAvailable(Compression compression);
+
+        /**
+         * @brief Write data
+         *
+         * @note With compression, this blocks if all workers are busy and the maximum number of pending blocks is reached
+         *
+         * @param data Data to write
+         * @throw CompressionError If data could not be compressed or written to the file
+         */
+        CNSTLN_API void write(std::span<const std::byte> data);
+
+        /**
+         * @brief Compress the current incomplete block, wait for all pending blocks and flush the file to disk
+         *
+         * @throw CompressionError If data could not be compressed or written to the file
+         */
+        CNSTLN_API void flush();
+
+        /**
+         * @brief Write all pending blocks and close the file
+         *
+         * @note Calling this function more than once has no effect
+         *
+         * @throw CompressionError If data could not be compressed or written to the file
+         */
+        CNSTLN_API void close();
+
+        /**
+         * @brief Get the statistics of the writer, which remain valid after the writer is destroyed
+         */
+        std::shared_ptr<const CompressionStatistics> getStatistics() const { return statistics_; }
+
+    private:
+        /** Uncompressed block waiting for a worker */
+        struct Block {
+            std::uint64_t sequence;
+            std::vector<std::byte> data;
+        };
+
+        CNSTLN_LOCAL void submit_block();
+        CNSTLN_LOCAL void wait_pending(std::size_t max_pending);
+        CNSTLN_LOCAL void worker_loop(const std::stop_token& stop_token, std::size_t worker);
+        CNSTLN_LOCAL std::vector<std::byte> compress(std::span<const std::byte> data) const;
+        CNSTLN_LOCAL void write_completed();
+        CNSTLN_LOCAL void write_file(std::span<const std::byte> data);
+        CNSTLN_LOCAL void rethrow_error();
+
+    private:
+        std::ofstream file_;
+        Compression compression_;
+        std::size_t block_size_;
+        int level_;
+        bool closed_ {false};
+
+        std::vector<std::byte> current_block_;
+        std::uint64_t next_sequence_ {0};
+
+        // Blocks waiting for compression, compressed blocks waiting to be written, and blocks not yet written
+        std::mutex mutex_;
+        std::condition_variable_any queue_cv_;
+        std::condition_variable written_cv_;
+        std::deque<Block> queue_;
+        std::map<std::uint64_t, std::vector<std::byte>> completed_;
+        std::uint64_t next_write_ {0};
+        std::size_t pending_ {0};
+        std::exception_ptr error_;
+
+        // Serializes writing to the file
+        std::mutex file_mutex_;
+
+        std::shared_ptr<CompressionStatistics> statistics_;
+        std::vector<std::jthread> workers_;
+    };
+
+} // namespace constellation::data
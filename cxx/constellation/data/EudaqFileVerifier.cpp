@@ -0,0 +1,290 @@
+/**
+ * @file
+ * @brief EUDAQ2 native binary file verifier implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "EudaqFileVerifier.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef CNSTLN_DATA_ZSTD
+#include <zstd.h>
+#endif
+
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/string.hpp"
+#include "constellation/data/exceptions.hpp"
+#include "constellation/data/MappedFile.hpp"
+
+using namespace constellation::data;
+using namespace constellation::utils;
+
+namespace {
+    // Limit nesting of sub-events to protect against corrupt files
+    constexpr std::size_t max_event_depth = 8;
+
+    // Decompress all Zstandard frames of a file, an incomplete last frame is kept as far as it could be decoded
+    std::vector<std::byte> decompress(std::span<const std::byte> data, const std::filesystem::path& path, bool& incomplete) {
+#ifdef CNSTLN_DATA_ZSTD
+        const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx {ZSTD_createDCtx(), &ZSTD_freeDCtx};
+        std::vector<std::byte> content {};
+        std::vector<std::byte> chunk(ZSTD_DStreamOutSize());
+
+        ZSTD_inBuffer input {data.data(), data.size(), 0};
+        bool output_full = false;
+        std::size_t ret = 0;
+        while(input.pos < input.size || output_full) {
+            ZSTD_outBuffer output {chunk.data(), chunk.size(), 0};
+            ret = ZSTD_decompressStream(dctx.get(), &output, &input);
+            if(ZSTD_isError(ret) != 0) {
+                throw RawFileError("Failed to decompress " + path.string() + ": " + ZSTD_getErrorName(ret));
+            }
+            content.insert(content.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(output.pos));
+            output_full = (output.pos == output.size);
+        }
+        // Remaining work at the end of the input means the last frame is incomplete
+        incomplete = (ret != 0);
+        return content;
+#else
+        std::ignore = data;
+        std::ignore = incomplete;
+        throw RawFileError("Cannot read " + path.string() + ", Zstandard decompression is not available in this build");
+#endif
+    }
+} // namespace
+
+/** Cursor reading little-endian values from the memory-mapped file */
+class EudaqFileVerifier::Cursor {
+public:
+    Cursor(std::span<const std::byte> data, std::size_t pos) : data_(data), pos_(pos) {}
+
+    std::span<const std::byte> read_bytes(std::size_t size) {
+        if(size > data_.size() - pos_) {
+            throw RawFileError("Unexpected end of file");
+        }
+        const auto bytes = data_.subspan(pos_, size);
+        pos_ += size;
+        return bytes;
+    }
+
+    template <typename T> T read_int() {
+        const auto bytes = read_bytes(sizeof(T));
+        T value {0};
+        for(std::size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(std::to_integer<T>(bytes[i]) << (8 * i));
+        }
+        return value;
+    }
+
+    std::string_view read_str() {
+        const auto length = read_int<std::uint32_t>();
+        const auto bytes = read_bytes(length);
+        return {to_char_ptr(bytes.data()), bytes.size()};
+    }
+
+    std::size_t position() const { return pos_; }
+    bool at_end() const { return pos_ == data_.size(); }
+
+private:
+    std::span<const std::byte> data_;
+    std::size_t pos_;
+};
+
+EudaqFileVerifier::EudaqFileVerifier(const std::filesystem::path& path)
+    : file_(std::make_unique<MappedFile>(path)), data_(file_->data()) {
+    if(path.extension() == ".zst") {
+        decompressed_ = decompress(file_->data(), path, incomplete_frame_);
+        data_ = decompressed_;
+        file_.reset();
+    }
+}
+
+EudaqFileVerifier::~EudaqFileVerifier() = default;
+
+std::uint64_t EudaqFileVerifier::getFileSize() const {
+    return data_.size();
+}
+
+std::uint32_t EudaqFileVerifier::hash(std::string_view str) {
+    // Same as the recursive hash used by EUDAQ, evaluated from the end of the string
+    std::uint32_t value = 5381;
+    for(auto it = str.rbegin(); it != str.rend(); ++it) {
+        value = static_cast<std::uint32_t>((value * 33ULL) ^ static_cast<unsigned long long>(*it));
+    }
+    return value;
+}
+
+void EudaqFileVerifier::add_issue(std::uint64_t offset, std::string message) {
+    issues_.emplace_back(offset, std::move(message));
+}
+
+bool EudaqFileVerifier::verify() {
+    index_.clear();
+    streams_.clear();
+    issues_.clear();
+
+    Cursor cursor {data_, 0};
+    while(!cursor.at_end()) {
+        const auto offset = cursor.position();
+        try {
+            const auto event = parse_event(cursor, 0);
+            check_event(event);
+            index_.emplace_back(event);
+        } catch(const RawFileError& error) {
+            add_issue(offset, "Failed to decode event: " + std::string(error.what()));
+            break;
+        }
+    }
+
+    if(incomplete_frame_) {
+        add_issue(data_.size(), "Compressed file ends within a frame");
+    }
+
+    // Every stream needs to be terminated by an EORE
+    for(const auto& [descriptor, stream] : streams_) {
+        if(!stream.eore_event.has_value()) {
+            add_issue(data_.size(), "No EORE for " + descriptor);
+        }
+    }
+
+    return issues_.empty();
+}
+
+EudaqFileVerifier::Event EudaqFileVerifier::parse_event(Cursor& cursor, std::size_t depth) {
+    Event event {};
+    event.offset = cursor.position();
+
+    const auto type = cursor.read_int<std::uint32_t>();
+    const auto version = cursor.read_int<std::uint32_t>();
+    event.flags = cursor.read_int<std::uint32_t>();
+    cursor.read_int<std::uint32_t>(); // Number of devices
+    cursor.read_int<std::uint32_t>(); // Run sequence
+    event.event_number = cursor.read_int<std::uint32_t>();
+    event.trigger_number = cursor.read_int<std::uint32_t>();
+    const auto extend_word = cursor.read_int<std::uint32_t>();
+    event.timestamp_begin = cursor.read_int<std::uint64_t>();
+    event.timestamp_end = cursor.read_int<std::uint64_t>();
+    event.descriptor = cursor.read_str();
+
+    if(type != hash("RawEvent")) {
+        add_issue(event.offset, "Event type is not RawEvent");
+    }
+    if(version != 0) {
+        add_issue(event.offset, "Unsupported event version " + to_string(version));
+    }
+    if(extend_word != hash(event.descriptor)) {
+        add_issue(event.offset, "Extend word does not match descriptor " + std::string(event.descriptor));
+    }
+
+    // Tags as pairs of strings
+    const auto tags = cursor.read_int<std::uint32_t>();
+    for(std::uint32_t n = 0; n < tags; ++n) {
+        cursor.read_str();
+        cursor.read_str();
+    }
+
+    // Data blocks, keys are the frame numbers
+    event.blocks = cursor.read_int<std::uint32_t>();
+    for(std::uint32_t n = 0; n < event.blocks; ++n) {
+        const auto key = cursor.read_int<std::uint32_t>();
+        const auto size = cursor.read_int<std::uint32_t>();
+        cursor.read_bytes(size);
+        if(key != n) {
+            add_issue(event.offset, "Block " + to_string(n) + " has key " + to_string(key));
+        }
+        streams_[std::string(event.descriptor)].block_bytes += size;
+    }
+
+    // Sub-events repeat the header of the event
+    event.subevents = cursor.read_int<std::uint32_t>();
+    if(event.subevents > 0 && depth + 1 >= max_event_depth) {
+        throw RawFileError("Sub-events nested deeper than " + to_string(max_event_depth) + " levels");
+    }
+    for(std::uint32_t n = 0; n < event.subevents; ++n) {
+        const auto subevent = parse_event(cursor, depth + 1);
+        if(subevent.descriptor != event.descriptor || subevent.event_number != event.event_number) {
+            add_issue(subevent.offset, "Header of sub-event " + to_string(n) + " does not match its event");
+        }
+    }
+
+    event.size = cursor.position() - event.offset;
+    return event;
+}
+
+void EudaqFileVerifier::check_event(const Event& event) {
+    auto& stream = streams_[std::string(event.descriptor)];
+    const auto descriptor = std::string(event.descriptor);
+    const auto number = event.event_number;
+
+    if((event.flags & std::to_underlying(Flags::BORE)) != 0) {
+        if(stream.bore_event.has_value()) {
+            add_issue(event.offset, "Duplicate BORE for " + descriptor);
+        } else if(stream.first_event.has_value()) {
+            add_issue(event.offset, "BORE for " + descriptor + " after data events");
+        }
+        if(event.blocks > 0 || event.subevents > 0) {
+            add_issue(event.offset, "BORE for " + descriptor + " contains data");
+        }
+        stream.bore_event = number;
+        return;
+    }
+
+    if((event.flags & std::to_underlying(Flags::EORE)) != 0) {
+        if(stream.eore_event.has_value()) {
+            add_issue(event.offset, "Duplicate EORE for " + descriptor);
+        }
+        if(stream.last_event.has_value() && number != stream.last_event.value() + 1) {
+            add_issue(event.offset,
+                      "EORE event number " + to_string(number) + " for " + descriptor +
+                          " does not follow last data event " + to_string(stream.last_event.value()));
+        }
+        if(event.blocks > 0 || event.subevents > 0) {
+            add_issue(event.offset, "EORE for " + descriptor + " contains data");
+        }
+        stream.eore_event = number;
+        return;
+    }
+
+    // Data event
+    if(!stream.bore_event.has_value()) {
+        add_issue(event.offset, "Data event for " + descriptor + " before BORE");
+    }
+    if(stream.eore_event.has_value()) {
+        add_issue(event.offset, "Data event for " + descriptor + " after EORE");
+    }
+
+    // Event numbers continue from the BORE or the previous data event
+    const auto previous = stream.last_event.has_value() ? stream.last_event : stream.bore_event;
+    if(previous.has_value()) {
+        if(number <= previous.value()) {
+            add_issue(event.offset,
+                      "Event number " + to_string(number) + " for " + descriptor + " does not increase after " +
+                          to_string(previous.value()));
+        } else if(number > previous.value() + 1) {
+            stream.missing_events += number - previous.value() - 1;
+            add_issue(event.offset,
+                      "Missing events " + to_string(previous.value() + 1) + " to " + to_string(number - 1) + " for " +
+                          descriptor);
+        }
+    }
+
+    if(!stream.first_event.has_value()) {
+        stream.first_event = number;
+    }
+    stream.last_event = number;
+    stream.events++;
+    stream.subevents += event.subevents;
+}
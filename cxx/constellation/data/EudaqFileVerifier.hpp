@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Verifier for EUDAQ2 native binary files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "constellation/build.hpp"
+
+namespace constellation::data {
+
+    class MappedFile;
+
+    /**
+     * @brief Verifier for EUDAQ2 native binary files as written by the `EudaqNativeWriter` satellite
+     *
+     * The file is memory-mapped and every event is decoded and validated against the layout of the EUDAQ2 native binary
+     * format, including the data blocks and sub-events. Events are grouped into streams by their event descriptor, for
+     * which the BORE and EORE events and the continuity of the event numbers are checked. An index with the position of
+     * every event in the file is generated along the way.
+     *
+     * Files with the extension `.zst` as written with Zstandard compression are decompressed into memory first, all
+     * positions and sizes then refer to the decompressed content.
+     */
+    class CNSTLN_API EudaqFileVerifier {
+    public:
+        /** EUDAQ event flags */
+        enum class Flags : std::uint32_t { // NOLINT(performance-enum-size)
+            BORE = 0x1,
+            EORE = 0x2,
+            TRIGGER = 0x10,
+        };
+
+        /** Index entry of an event */
+        struct Event {
+            /** Position of the event in the file */
+            std::uint64_t offset;
+            /** Size of the event including its sub-events */
+            std::uint64_t size;
+            /** Event descriptor, valid as long as the verifier exists */
+            std::string_view descriptor;
+            std::uint32_t flags;
+            std::uint32_t event_number;
+            std::uint32_t trigger_number;
+            /** Timestamp of the event start in nanoseconds */
+            std::uint64_t timestamp_begin;
+            /** Timestamp of the event end in nanoseconds */
+            std::uint64_t timestamp_end;
+            std::uint32_t blocks;
+            std::uint32_t subevents;
+        };
+
+        /** Summary of all events with the same descriptor */
+        struct Stream {
+            /** Number of data events */
+            std::uint64_t events {0};
+            /** Number of sub-events in data events */
+            std::uint64_t subevents {0};
+            /** Size of all data blocks */
+            std::uint64_t block_bytes {0};
+            std::optional<std::uint32_t> first_event;
+            std::optional<std::uint32_t> last_event;
+            /** Number of event numbers skipped between data events */
+            std::uint64_t missing_events {0};
+            std::optional<std::uint32_t> bore_event;
+            std::optional<std::uint32_t> eore_event;
+        };
+
+        /** Problem found in the file */
+        struct Issue {
+            /** Position of the affected event in the file */
+            std::uint64_t offset;
+            std::string message;
+        };
+
+    public:
+        /**
+         * @brief Open an EUDAQ2 native binary file
+         *
+         * @param path Path to the file
+         * @throw RawFileError If the file could not be opened or decompressed
+         */
+        CNSTLN_API explicit EudaqFileVerifier(const std::filesystem::path& path);
+
+        CNSTLN_API ~EudaqFileVerifier();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        EudaqFileVerifier(const EudaqFileVerifier& other) = delete;
+        EudaqFileVerifier& operator=(const EudaqFileVerifier& other) = delete;
+        EudaqFileVerifier(EudaqFileVerifier&& other) = delete;
+        EudaqFileVerifier& operator=(EudaqFileVerifier&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Decode and validate all events in the file
+         *
+         * Decoding stops at the first event which exceeds the end of the file, since the position of further events cannot
+         * be determined. Calling this function again repeats the verification.
+         *
+         * @return True if no issues were found
+         */
+        CNSTLN_API bool verify();
+
+        /**
+         * @brief Get the index of all decoded events in the order of the file
+         */
+        const std::vector<Event>& getIndex() const { return index_; }
+
+        /**
+         * @brief Get the summary of each stream by event descriptor
+         */
+        const std::map<std::string, Stream, std::less<>>& getStreams() const { return streams_; }
+
+        /**
+         * @brief Get all issues found in the file
+         */
+        const std::vector<Issue>& getIssues() const { return issues_; }
+
+        /**
+         * @brief Get the size of the file in bytes, after decompression for compressed files
+         */
+        CNSTLN_API std::uint64_t getFileSize() const;
+
+        /**
+         * @brief Compute the EUDAQ hash of a string as used for event types and descriptors
+         */
+        CNSTLN_API static std::uint32_t hash(std::string_view str);
+
+    private:
+        class Cursor;
+
+        CNSTLN_LOCAL Event parse_event(Cursor& cursor, std::size_t depth);
+        CNSTLN_LOCAL void check_event(const Event& event);
+        CNSTLN_LOCAL void add_issue(std::uint64_t offset, std::string message);
+
+    private:
+        std::unique_ptr<MappedFile> file_;
+        std::vector<std::byte> decompressed_;
+        std::span<const std::byte> data_;
+        bool incomplete_frame_ {false};
+        std::vector<Event> index_;
+        std::map<std::string, Stream, std::less<>> streams_;
+        std::vector<Issue> issues_;
+    };
+
+} // namespace constellation::data
@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @brief Implementation of read-only memory mapping of files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "constellation/data/exceptions.hpp"
+
+using namespace constellation::data;
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    std::ifstream file {path, std::ios_base::binary};
+    if(!file.good()) {
+        throw RawFileError("Failed to open " + path.string());
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = {reinterpret_cast<const std::byte*>(buffer_.data()), buffer_.size()}; // NOLINT(*-reinterpret-cast)
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if(fd < 0) {
+        throw RawFileError("Failed to open " + path.string());
+    }
+    struct stat file_stat {};
+    if(::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        throw RawFileError("Failed to stat " + path.string());
+    }
+    const auto size = static_cast<std::size_t>(file_stat.st_size);
+    if(size > 0) {
+        addr_ = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if(addr_ == MAP_FAILED) {
+            ::close(fd);
+            throw RawFileError("Failed to map " + path.string());
+        }
+        data_ = {static_cast<const std::byte*>(addr_), size};
+    }
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if(!data_.empty()) {
+        ::munmap(addr_, data_.size());
+    }
+#endif
+}
@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @brief Read-only memory mapping of files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "constellation/build.hpp"
+
+namespace constellation::data {
+
+    /**
+     * @brief Read-only memory mapping of a file
+     *
+     * Falls back to reading the complete file into memory where mmap is not available.
+     */
+    class CNSTLN_API MappedFile {
+    public:
+        /**
+         * @brief Map a file into memory
+         *
+         * @param path Path to the file
+         * @throw RawFileError If the file could not be opened or mapped
+         */
+        CNSTLN_API explicit MappedFile(const std::filesystem::path& path);
+
+        CNSTLN_API ~MappedFile();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) = delete;
+        MappedFile& operator=(MappedFile&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Get the content of the file, valid as long as the mapping exists
+         */
+        std::span<const std::byte> data() const { return data_; }
+
+    private:
+        std::span<const std::byte> data_;
+#ifdef _WIN32
+        std::vector<char> buffer_;
+#else
+        void* addr_ {nullptr};
+#endif
+    };
+
+} // namespace constellation::data
@@ -0,0 +1,335 @@
+/**
+ * @file
+ * @brief Raw data file reader implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "RawFileReader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/msgpack.hpp"
+#include "constellation/data/exceptions.hpp"
+#include "constellation/data/MappedFile.hpp"
+#include "constellation/data/raw_file_format.hpp"
+
+using namespace constellation::config;
+using namespace constellation::data;
+using namespace constellation::message;
+using namespace constellation::utils;
+
+namespace {
+
+    /** Cursor reading values from a memory-mapped file */
+    class Cursor {
+    public:
+        Cursor(std::span<const std::byte> data, std::size_t pos) : data_(data), pos_(pos) {}
+
+        std::span<const std::byte> read_bytes(std::size_t size) {
+            if(pos_ > data_.size() || size > data_.size() - pos_) {
+                throw RawFileError("Unexpected end of file");
+            }
+            const auto bytes = data_.subspan(pos_, size);
+            pos_ += size;
+            return bytes;
+        }
+
+        template <typename T> T read() {
+            T value {};
+            std::memcpy(&value, read_bytes(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        std::size_t position() const { return pos_; }
+
+    private:
+        std::span<const std::byte> data_;
+        std::size_t pos_;
+    };
+
+    bool is_contiguous(const std::vector<raw_file::IndexEntry>& entries) {
+        return std::ranges::adjacent_find(entries, [](const auto& lhs, const auto& rhs) {
+                   return rhs.sequence != lhs.sequence + 1;
+               }) == entries.end();
+    }
+
+} // namespace
+
+RawFileReader::RawFileReader(const std::filesystem::path& path)
+    : path_(path), file_(std::make_unique<MappedFile>(path)) {
+    Cursor cursor {file_->data(), 0};
+    raw_file::FileHeader file_header {};
+    try {
+        file_header = cursor.read<raw_file::FileHeader>();
+    } catch(const RawFileError&) {
+        throw RawFileError(path_.string() + " is not a raw data file");
+    }
+    if(file_header.magic != raw_file::file_magic) {
+        throw RawFileError(path_.string() + " is not a raw data file");
+    }
+    if(file_header.version != raw_file::file_version) {
+        throw RawFileError(path_.string() + " has unsupported version " + std::to_string(file_header.version));
+    }
+    if(file_header.byte_order != raw_file::byte_order_mark) {
+        throw RawFileError(path_.string() + " was written on a machine with different byte order");
+    }
+
+    has_index_ = load_index();
+    if(!has_index_) {
+        rebuild_index();
+    }
+}
+
+RawFileReader::~RawFileReader() = default;
+
+bool RawFileReader::load_index() {
+    const auto data = file_->data();
+    if(data.size() < sizeof(raw_file::FileHeader) + sizeof(raw_file::Footer)) {
+        return false;
+    }
+
+    try {
+        Cursor footer_cursor {data, data.size() - sizeof(raw_file::Footer)};
+        const auto footer = footer_cursor.read<raw_file::Footer>();
+        if(footer.magic != raw_file::index_magic || footer.index_offset < sizeof(raw_file::FileHeader) ||
+           footer.index_offset > data.size() - sizeof(raw_file::Footer)) {
+            return false;
+        }
+
+        Cursor cursor {data.first(data.size() - sizeof(raw_file::Footer)), footer.index_offset};
+        const auto chunks = cursor.read<std::uint64_t>();
+        if(chunks > data.size() / sizeof(std::uint64_t)) {
+            throw RawFileError("Invalid number of index chunks");
+        }
+        for(std::uint64_t n = 0; n < chunks; ++n) {
+            read_index_chunk(cursor.read<std::uint64_t>());
+        }
+        for(std::uint64_t n = 0; n < footer.streams; ++n) {
+            const auto name_size = cursor.read<std::uint32_t>();
+            const auto name = cursor.read_bytes(name_size);
+            auto& stream = streams_[std::string(to_char_ptr(name.data()), name.size())];
+            stream.bor_offset = cursor.read<std::uint64_t>();
+            stream.eor_offset = cursor.read<std::uint64_t>();
+        }
+    } catch(const RawFileError&) {
+        streams_.clear();
+        return false;
+    }
+
+    for(auto& [sender, stream] : streams_) {
+        stream.contiguous = is_contiguous(stream.entries);
+    }
+    return true;
+}
+
+void RawFileReader::read_index_chunk(std::uint64_t offset) {
+    const auto data = file_->data();
+    if(offset > data.size()) {
+        throw RawFileError("Invalid index chunk offset");
+    }
+
+    Cursor cursor {data, offset};
+    const auto record_header = cursor.read<raw_file::RecordHeader>();
+    if(record_header.header_size != 0 || record_header.size > data.size() - offset) {
+        throw RawFileError("Invalid index chunk");
+    }
+    cursor = Cursor(data.first(offset + record_header.size), cursor.position());
+
+    // Entries of each chunk follow the entries of the previous chunks of the same sender
+    const auto senders = cursor.read<std::uint64_t>();
+    for(std::uint64_t n = 0; n < senders; ++n) {
+        const auto name_size = cursor.read<std::uint32_t>();
+        const auto name = cursor.read_bytes(name_size);
+        const auto entries = cursor.read<std::uint64_t>();
+        if(entries > record_header.size / sizeof(raw_file::IndexEntry)) {
+            throw RawFileError("Invalid number of index entries");
+        }
+        const auto entry_bytes = cursor.read_bytes(entries * sizeof(raw_file::IndexEntry));
+        auto& stream_entries = streams_[std::string(to_char_ptr(name.data()), name.size())].entries;
+        const auto previous_entries = stream_entries.size();
+        stream_entries.resize(previous_entries + entries);
+        if(entries > 0) {
+            std::memcpy(stream_entries.data() + previous_entries, entry_bytes.data(), entry_bytes.size());
+        }
+    }
+}
+
+void RawFileReader::rebuild_index() {
+    const auto data = file_->data();
+    std::size_t pos = sizeof(raw_file::FileHeader);
+
+    // Read records until the end of the file or an incompletely written record
+    while(pos + sizeof(raw_file::RecordHeader) <= data.size()) {
+        Cursor cursor {data, pos};
+        const auto record_header = cursor.read<raw_file::RecordHeader>();
+        if(record_header.size < sizeof(raw_file::RecordHeader) || record_header.size % raw_file::alignment != 0 ||
+           record_header.size > data.size() - pos) {
+            break;
+        }
+        // Index chunks are skipped since all entries are rebuilt from the message records
+        if(record_header.header_size == 0) {
+            pos += record_header.size;
+            continue;
+        }
+        try {
+            const auto header = CDTP1Message::Header::disassemble(cursor.read_bytes(record_header.header_size));
+            auto& stream = streams_[std::string(header.getSender())];
+            switch(header.getType()) {
+            case CDTP1Message::Type::BOR: stream.bor_offset = pos; break;
+            case CDTP1Message::Type::EOR: stream.eor_offset = pos; break;
+            case CDTP1Message::Type::DATA: {
+                stream.entries.push_back({header.getSequenceNumber(), record_header.time, pos});
+                break;
+            }
+            default: std::unreachable();
+            }
+        } catch(const MessageDecodingError&) {
+            break;
+        } catch(const RawFileError&) {
+            break;
+        }
+        pos += record_header.size;
+    }
+
+    for(auto& [sender, stream] : streams_) {
+        stream.contiguous = is_contiguous(stream.entries);
+    }
+}
+
+const RawFileReader::Stream& RawFileReader::get_stream(std::string_view sender) const {
+    const auto it = streams_.find(sender);
+    if(it == streams_.end()) {
+        throw RawFileError("No messages from " + std::string(sender) + " in " + path_.string());
+    }
+    return it->second;
+}
+
+RawFileReader::Message RawFileReader::read_record(std::uint64_t offset) const {
+    const auto data = file_->data();
+    if(offset > data.size()) {
+        throw RawFileError("Invalid record offset");
+    }
+
+    Cursor cursor {data, offset};
+    const auto record_header = cursor.read<raw_file::RecordHeader>();
+    if(record_header.size > data.size() - offset) {
+        throw RawFileError("Record exceeds end of file");
+    }
+    if(record_header.header_size == 0) {
+        throw RawFileError("Record does not contain a message");
+    }
+    cursor = Cursor(data.first(offset + record_header.size), cursor.position());
+
+    const auto header_bytes = cursor.read_bytes(raw_file::padded(record_header.header_size));
+    auto header = CDTP1Message::Header::disassemble(header_bytes.first(record_header.header_size));
+
+    // Validate the number of frames against the record size before allocating
+    if(record_header.frames > (offset + record_header.size - cursor.position()) / sizeof(std::uint64_t)) {
+        throw RawFileError("Invalid number of frames in record");
+    }
+    std::vector<std::uint64_t> frame_sizes(record_header.frames);
+    for(auto& frame_size : frame_sizes) {
+        frame_size = cursor.read<std::uint64_t>();
+    }
+    std::vector<std::span<const std::byte>> frames {};
+    frames.reserve(frame_sizes.size());
+    for(const auto frame_size : frame_sizes) {
+        frames.emplace_back(cursor.read_bytes(raw_file::padded(frame_size)).first(frame_size));
+    }
+
+    const auto time = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record_header.time)));
+    return {std::move(header), time, std::move(frames)};
+}
+
+std::optional<Dictionary> RawFileReader::read_dictionary(std::uint64_t offset) const {
+    if(offset == raw_file::no_offset) {
+        return std::nullopt;
+    }
+    const auto message = read_record(offset);
+    if(message.frames.empty()) {
+        return std::nullopt;
+    }
+    const auto& frame = message.frames.front();
+    return msgpack_unpack_to<Dictionary>(to_char_ptr(frame.data()), frame.size());
+}
+
+std::vector<std::string> RawFileReader::getSenders() const {
+    std::vector<std::string> senders {};
+    senders.reserve(streams_.size());
+    for(const auto& [sender, stream] : streams_) {
+        senders.emplace_back(sender);
+    }
+    return senders;
+}
+
+std::size_t RawFileReader::size(std::string_view sender) const {
+    return get_stream(sender).entries.size();
+}
+
+std::optional<Dictionary> RawFileReader::getBOR(std::string_view sender) const {
+    return read_dictionary(get_stream(sender).bor_offset);
+}
+
+std::optional<Dictionary> RawFileReader::getEOR(std::string_view sender) const {
+    return read_dictionary(get_stream(sender).eor_offset);
+}
+
+RawFileReader::Message RawFileReader::read(std::string_view sender, std::size_t index) const {
+    const auto& stream = get_stream(sender);
+    if(index >= stream.entries.size()) {
+        throw RawFileError("Message " + std::to_string(index) + " requested but only " +
+                           std::to_string(stream.entries.size()) + " messages from " + std::string(sender) + " stored");
+    }
+    return read_record(stream.entries[index].offset);
+}
+
+std::optional<std::size_t> RawFileReader::findSequence(std::string_view sender, std::uint64_t sequence) const {
+    const auto& stream = get_stream(sender);
+    const auto& entries = stream.entries;
+    if(entries.empty()) {
+        return std::nullopt;
+    }
+
+    // Direct lookup without gaps in the sequence numbers
+    if(stream.contiguous) {
+        const auto first = entries.front().sequence;
+        if(sequence >= first && sequence - first < entries.size()) {
+            return sequence - first;
+        }
+        return std::nullopt;
+    }
+
+    const auto it = std::ranges::lower_bound(entries, sequence, {}, &raw_file::IndexEntry::sequence);
+    if(it != entries.end() && it->sequence == sequence) {
+        return static_cast<std::size_t>(std::distance(entries.begin(), it));
+    }
+    return std::nullopt;
+}
+
+std::size_t RawFileReader::findTime(std::string_view sender, std::chrono::system_clock::time_point time) const {
+    const auto& entries = get_stream(sender).entries;
+    const auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    const auto it = std::ranges::lower_bound(entries, time_ns, {}, &raw_file::IndexEntry::time);
+    return static_cast<std::size_t>(std::distance(entries.begin(), it));
+}
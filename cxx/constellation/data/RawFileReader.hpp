@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Reader for native Constellation raw data files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "constellation/build.hpp"
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/data/raw_file_format.hpp"
+
+namespace constellation::data {
+
+    class MappedFile;
+
+    /**
+     * @brief Reader for raw data files written by `RawFileWriter`
+     *
+     * The file is memory-mapped and the messages are accessed through the index appended to the file, or an index rebuilt
+     * from the records if the file was not closed properly. Seeking to a sequence number is O(1) for streams without gaps
+     * in the sequence numbers and O(log n) otherwise, seeking to a time is O(log n). Payload frames are returned as views on
+     * the memory mapping without copying and are aligned to 8 bytes.
+     */
+    class CNSTLN_API RawFileReader {
+    public:
+        /** Message read from the file */
+        struct Message {
+            /** Decoded CDTP header */
+            message::CDTP1Message::Header header;
+            /** Time at which the message was written */
+            std::chrono::system_clock::time_point time;
+            /** Views on the payload frames, valid as long as the reader exists */
+            std::vector<std::span<const std::byte>> frames;
+        };
+
+    public:
+        /**
+         * @brief Open a raw data file
+         *
+         * @param path Path to the file
+         * @throw RawFileError If the file could not be opened or is not a valid raw data file
+         */
+        CNSTLN_API explicit RawFileReader(const std::filesystem::path& path);
+
+        CNSTLN_API ~RawFileReader();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        RawFileReader(const RawFileReader& other) = delete;
+        RawFileReader& operator=(const RawFileReader& other) = delete;
+        RawFileReader(RawFileReader&& other) = delete;
+        RawFileReader& operator=(RawFileReader&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Return if the index was read from the file or had to be rebuilt from the records
+         */
+        bool hasIndex() const { return has_index_; }
+
+        /**
+         * @brief Get canonical names of all senders in the file
+         */
+        CNSTLN_API std::vector<std::string> getSenders() const;
+
+        /**
+         * @brief Get the number of data messages of a sender
+         *
+         * @param sender Canonical name of the sender
+         * @throw RawFileError If there are no messages from the sender
+         */
+        CNSTLN_API std::size_t size(std::string_view sender) const;
+
+        /**
+         * @brief Get the configuration of a sender stored in its BOR message
+         *
+         * @param sender Canonical name of the sender
+         * @return Configuration dictionary if the BOR message is stored in the file
+         * @throw RawFileError If there are no messages from the sender
+         */
+        CNSTLN_API std::optional<config::Dictionary> getBOR(std::string_view sender) const;
+
+        /**
+         * @brief Get the run metadata of a sender stored in its EOR message
+         *
+         * @param sender Canonical name of the sender
+         * @return Run metadata dictionary if the EOR message is stored in the file
+         * @throw RawFileError If there are no messages from the sender
+         */
+        CNSTLN_API std::optional<config::Dictionary> getEOR(std::string_view sender) const;
+
+        /**
+         * @brief Read a data message of a sender
+         *
+         * @param sender Canonical name of the sender
+         * @param index Position of the data message in the stream of the sender
+         * @return Message with views on the payload frames
+         * @throw RawFileError If there are no messages from the sender, the index is out of range or the record is invalid
+         */
+        CNSTLN_API Message read(std::string_view sender, std::size_t index) const;
+
+        /**
+         * @brief Find a data message of a sender by its sequence number
+         *
+         * @param sender Canonical name of the sender
+         * @param sequence Sequence number of the data message
+         * @return Position of the data message in the stream of the sender if it is stored in the file
+         * @throw RawFileError If there are no messages from the sender
+         */
+        CNSTLN_API std::optional<std::size_t> findSequence(std::string_view sender, std::uint64_t sequence) const;
+
+        /**
+         * @brief Find the first data message of a sender written at or after a given time
+         *
+         * @param sender Canonical name of the sender
+         * @param time Time at which the message was written
+         * @return Position of the data message in the stream of the sender, equal to the size of the stream if none
+         * @throw RawFileError If there are no messages from the sender
+         */
+        CNSTLN_API std::size_t findTime(std::string_view sender, std::chrono::system_clock::time_point time) const;
+
+    private:
+        /** Index of the messages of a sender */
+        struct Stream {
+            std::uint64_t bor_offset {raw_file::no_offset};
+            std::uint64_t eor_offset {raw_file::no_offset};
+            std::vector<raw_file::IndexEntry> entries;
+            /** Whether sequence numbers increase by one without gaps */
+            bool contiguous {true};
+        };
+
+        CNSTLN_LOCAL bool load_index();
+        CNSTLN_LOCAL void read_index_chunk(std::uint64_t offset);
+        CNSTLN_LOCAL void rebuild_index();
+        CNSTLN_LOCAL const Stream& get_stream(std::string_view sender) const;
+        CNSTLN_LOCAL Message read_record(std::uint64_t offset) const;
+        CNSTLN_LOCAL std::optional<config::Dictionary> read_dictionary(std::uint64_t offset) const;
+
+    private:
+        std::filesystem::path path_;
+        std::unique_ptr<MappedFile> file_;
+        std::map<std::string, Stream, std::less<>> streams_;
+        bool has_index_ {false};
+    };
+
+} // namespace constellation::data
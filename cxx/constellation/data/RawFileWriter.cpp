@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @brief Raw data file writer implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "RawFileWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <msgpack.hpp>
+
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/data/exceptions.hpp"
+#include "constellation/data/raw_file_format.hpp"
+
+using namespace constellation::config;
+using namespace constellation::data;
+using namespace constellation::message;
+using namespace constellation::utils;
+
+namespace {
+    template <typename T> std::span<const std::byte> as_bytes(const T& value) {
+        return std::as_bytes(std::span<const T, 1>(&value, 1));
+    }
+} // namespace
+
+RawFileWriter::RawFileWriter(std::ofstream file, std::size_t index_chunk_entries)
+    : file_(std::move(file)), index_chunk_entries_(std::max<std::size_t>(index_chunk_entries, 1)) {
+    const raw_file::FileHeader file_header {
+        .magic = raw_file::file_magic,
+        .version = raw_file::file_version,
+        .byte_order = raw_file::byte_order_mark,
+    };
+    write_bytes(as_bytes(file_header));
+}
+
+RawFileWriter::~RawFileWriter() {
+    try {
+        close();
+    } catch(...) { // NOLINT(bugprone-empty-catch)
+        // The index is rebuilt from the records when reading the file
+    }
+}
+
+void RawFileWriter::write_bytes(std::span<const std::byte> data) {
+    file_.write(to_char_ptr(data.data()), static_cast<std::streamsize>(data.size()));
+    if(!file_.good()) {
+        throw RawFileError("Failed to write to file");
+    }
+    offset_ += data.size();
+}
+
+void RawFileWriter::write_padding() {
+    constexpr std::array<std::byte, raw_file::alignment> zeros {};
+    write_bytes(std::span(zeros).first(raw_file::padded(offset_) - offset_));
+}
+
+void RawFileWriter::write_index_chunk() {
+    std::uint64_t size = sizeof(raw_file::RecordHeader) + sizeof(std::uint64_t);
+    std::uint64_t senders = 0;
+    for(const auto& [sender, stream] : streams_) {
+        if(!stream.entries.empty()) {
+            size += sizeof(std::uint32_t) + sender.size() + sizeof(std::uint64_t) +
+                    (stream.entries.size() * sizeof(raw_file::IndexEntry));
+            ++senders;
+        }
+    }
+
+    const auto offset = offset_;
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    const raw_file::RecordHeader record_header {
+        .size = raw_file::padded(size),
+        .time = time,
+        .header_size = 0,
+        .frames = 0,
+    };
+    write_bytes(as_bytes(record_header));
+    write_bytes(as_bytes(senders));
+    for(auto& [sender, stream] : streams_) {
+        if(stream.entries.empty()) {
+            continue;
+        }
+        write_bytes(as_bytes(static_cast<std::uint32_t>(sender.size())));
+        write_bytes(std::as_bytes(std::span(sender)));
+        write_bytes(as_bytes(static_cast<std::uint64_t>(stream.entries.size())));
+        write_bytes(std::as_bytes(std::span(stream.entries)));
+        stream.entries.clear();
+    }
+    write_padding();
+
+    index_chunks_.push_back(offset);
+    pending_entries_ = 0;
+}
+
+RawFileWriter::Stream& RawFileWriter::get_stream(std::string_view sender) {
+    auto it = streams_.find(sender);
+    if(it == streams_.end()) {
+        it = streams_.emplace(sender, Stream {raw_file::no_offset, raw_file::no_offset, {}}).first;
+    }
+    return it->second;
+}
+
+void RawFileWriter::write(const CDTP1Message& message) {
+    if(closed_) {
+        throw RawFileError("Cannot write to closed file");
+    }
+
+    const auto& header = message.getHeader();
+    const auto& payload = message.getPayload();
+    const auto offset = offset_;
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+
+    // Encode header, the compact encoding is not used since it requires the BOR to be decoded first
+    msgpack::sbuffer header_sbuf {};
+    msgpack::pack(header_sbuf, header);
+
+    std::uint64_t size = sizeof(raw_file::RecordHeader) + raw_file::padded(header_sbuf.size()) +
+                         (payload.size() * sizeof(std::uint64_t));
+    for(const auto& frame : payload) {
+        size += raw_file::padded(frame.span().size());
+    }
+
+    const raw_file::RecordHeader record_header {
+        .size = size,
+        .time = time,
+        .header_size = static_cast<std::uint32_t>(header_sbuf.size()),
+        .frames = static_cast<std::uint32_t>(payload.size()),
+    };
+    write_bytes(as_bytes(record_header));
+    write_bytes({to_byte_ptr(header_sbuf.data()), header_sbuf.size()});
+    write_padding();
+    for(const auto& frame : payload) {
+        write_bytes(as_bytes(static_cast<std::uint64_t>(frame.span().size())));
+    }
+    for(const auto& frame : payload) {
+        write_bytes(frame.span());
+        write_padding();
+    }
+
+    // Add message to index
+    auto& stream = get_stream(header.getSender());
+    switch(header.getType()) {
+    case CDTP1Message::Type::BOR: stream.bor_offset = offset; break;
+    case CDTP1Message::Type::EOR: stream.eor_offset = offset; break;
+    case CDTP1Message::Type::DATA: {
+        stream.entries.push_back({header.getSequenceNumber(), time, offset});
+        ++pending_entries_;
+        break;
+    }
+    default: std::unreachable();
+    }
+
+    // Write index entries to the file regularly to bound the memory used by the index
+    if(pending_entries_ >= index_chunk_entries_) {
+        write_index_chunk();
+    }
+}
+
+void RawFileWriter::write(const CDTP1Message::Header& header, const Dictionary& dictionary) {
+    CDTP1Message message {header, 1};
+    message.addPayload(dictionary.assemble());
+    write(message);
+}
+
+void RawFileWriter::flush() {
+    file_.flush();
+}
+
+void RawFileWriter::close() {
+    if(closed_) {
+        return;
+    }
+    closed_ = true;
+
+    if(pending_entries_ > 0) {
+        write_index_chunk();
+    }
+
+    const auto index_offset = offset_;
+    write_bytes(as_bytes(static_cast<std::uint64_t>(index_chunks_.size())));
+    write_bytes(std::as_bytes(std::span(index_chunks_)));
+    for(const auto& [sender, stream] : streams_) {
+        write_bytes(as_bytes(static_cast<std::uint32_t>(sender.size())));
+        write_bytes(std::as_bytes(std::span(sender)));
+        write_bytes(as_bytes(stream.bor_offset));
+        write_bytes(as_bytes(stream.eor_offset));
+    }
+
+    const raw_file::Footer footer {
+        .index_offset = index_offset,
+        .streams = streams_.size(),
+        .magic = raw_file::index_magic,
+    };
+    write_bytes(as_bytes(footer));
+    file_.close();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @brief Writer for native Constellation raw data files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "constellation/build.hpp"
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/data/raw_file_format.hpp"
+
+namespace constellation::data {
+
+    /**
+     * @brief Writer storing CDTP messages unmodified in a seekable raw data file
+     *
+     * Every message is stored as a record containing the encoded CDTP header and the payload frames, with all frames
+     * aligned to 8 bytes such that they can be accessed in place from a memory mapping of the file. The sequence numbers
+     * and times of the data messages are collected and written as index chunk records in regular intervals, such that the
+     * memory required for the index is bounded. When the file is closed, an index with the BOR and EOR messages and the
+     * offsets of all index chunks is appended. Files which were not closed properly can still be read, the index is then
+     * rebuilt from the records.
+     *
+     * @note This class is not thread-safe
+     */
+    class CNSTLN_API RawFileWriter {
+    public:
+        /** Default number of index entries collected before they are written as index chunk */
+        static constexpr std::size_t default_index_chunk_entries {65536};
+
+    public:
+        /**
+         * @brief Construct a writer and write the file header
+         *
+         * @param file Binary output file stream to write to
+         * @param index_chunk_entries Number of index entries collected before they are written as index chunk
+         * @throw RawFileError If the file header could not be written
+         */
+        CNSTLN_API RawFileWriter(std::ofstream file, std::size_t index_chunk_entries = default_index_chunk_entries);
+
+        /**
+         * @brief Destruct the writer, closing the file
+         */
+        CNSTLN_API ~RawFileWriter();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        RawFileWriter(const RawFileWriter& other) = delete;
+        RawFileWriter& operator=(const RawFileWriter& other) = delete;
+        RawFileWriter(RawFileWriter&& other) = delete;
+        RawFileWriter& operator=(RawFileWriter&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Write a CDTP message to the file
+         *
+         * @param message BOR, DATA or EOR message
+         * @throw RawFileError If the message could not be written or the file is already closed
+         */
+        CNSTLN_API void write(const message::CDTP1Message& message);
+
+        /**
+         * @brief Write a BOR or EOR message to the file from its decoded payload
+         *
+         * @param header Header of the BOR or EOR message
+         * @param dictionary Configuration of the BOR message or run metadata of the EOR message
+         * @throw RawFileError If the message could not be written or the file is already closed
+         */
+        CNSTLN_API void write(const message::CDTP1Message::Header& header, const config::Dictionary& dictionary);
+
+        /**
+         * @brief Flush newly written content to disk
+         */
+        CNSTLN_API void flush();
+
+        /**
+         * @brief Write the remaining index entries, append the index and close the file
+         *
+         * @note Calling this function more than once has no effect
+         *
+         * @throw RawFileError If the index could not be written
+         */
+        CNSTLN_API void close();
+
+        /**
+         * @brief Return the number of bytes written to the file
+         */
+        std::uint64_t bytesWritten() const { return offset_; }
+
+    private:
+        /** Index of the messages of a sender */
+        struct Stream {
+            std::uint64_t bor_offset;
+            std::uint64_t eor_offset;
+            /** Entries of data messages not yet written as index chunk */
+            std::vector<raw_file::IndexEntry> entries;
+        };
+
+        CNSTLN_LOCAL void write_bytes(std::span<const std::byte> data);
+        CNSTLN_LOCAL void write_padding();
+        CNSTLN_LOCAL void write_index_chunk();
+        CNSTLN_LOCAL Stream& get_stream(std::string_view sender);
+
+    private:
+        std::ofstream file_;
+        std::uint64_t offset_ {};
+        bool closed_ {false};
+        std::map<std::string, Stream, std::less<>> streams_;
+        std::size_t index_chunk_entries_;
+        std::size_t pending_entries_ {};
+        std::vector<std::uint64_t> index_chunks_;
+    };
+
+} // namespace constellation::data
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @brief Collection of all data file exceptions
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <string>
+
+#include "constellation/build.hpp"
+#include "constellation/core/utils/exceptions.hpp"
+
+namespace constellation::data {
+
+    /**
+     * @ingroup Exceptions
+     * @brief Error when reading or writing a raw data file
+     */
+    class CNSTLN_API RawFileError : public utils::RuntimeError {
+    public:
+        explicit RawFileError(const std::string& reason) { error_message_ = reason; }
+    };
+
+    /**
+     * @ingroup Exceptions
+     * @brief Error when compressing data or writing compressed data to a file
+     */
+    class CNSTLN_API CompressionError : public utils::RuntimeError {
+    public:
+        explicit CompressionError(const std::string& reason) { error_message_ = reason; }
+    };
+
+} // namespace constellation::data
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief Binary layout of raw data files shared between writer and reader
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace constellation::data::raw_file {
+
+    /*
+     * File layout:
+     * - FileHeader
+     * - Records in order of arrival, each either a CDTP message or an index chunk:
+     *   - RecordHeader
+     *   - For CDTP messages:
+     *     - MessagePack-encoded CDTP header, padded
+     *     - Size of each frame as 64-bit integer
+     *     - Frames, each padded
+     *   - For index chunks, marked by a header size of zero:
+     *     - Number of senders (64-bit)
+     *     - Per sender: name length (32-bit), name, number of entries (64-bit), IndexEntry for each data message written
+     *       since the previous index chunk
+     *     - Padding
+     * - Index, only present if the file was closed properly:
+     *   - Number of index chunks (64-bit) and offset of each index chunk record (64-bit)
+     *   - Per sender: name length (32-bit), name, BOR offset, EOR offset
+     *   - Footer
+     *
+     * All integers are stored in host byte order, which is identified by the byte order mark in the file header. Padding
+     * aligns every frame to 8 bytes relative to the start of the file.
+     */
+
+    constexpr std::array<char, 8> file_magic {'C', 'N', 'S', 'T', 'L', 'R', 'A', 'W'};
+    constexpr std::array<char, 8> index_magic {'C', 'N', 'S', 'T', 'L', 'I', 'D', 'X'};
+    constexpr std::uint32_t file_version {2};
+    constexpr std::uint32_t byte_order_mark {0x01020304};
+
+    /** Alignment of records and frames */
+    constexpr std::size_t alignment {8};
+
+    /** Offset marking a missing BOR or EOR message */
+    constexpr std::uint64_t no_offset {std::numeric_limits<std::uint64_t>::max()};
+
+    struct FileHeader {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t byte_order;
+    };
+    static_assert(sizeof(FileHeader) == 16);
+
+    struct RecordHeader {
+        /** Size of the record including this header and padding */
+        std::uint64_t size;
+        /** Time at which the message was written in nanoseconds since epoch */
+        std::int64_t time;
+        /** Size of the encoded CDTP header without padding, zero for index chunks */
+        std::uint32_t header_size;
+        /** Number of frames, zero for index chunks */
+        std::uint32_t frames;
+    };
+    static_assert(sizeof(RecordHeader) == 24);
+
+    struct IndexEntry {
+        std::uint64_t sequence;
+        std::int64_t time;
+        std::uint64_t offset;
+    };
+    static_assert(sizeof(IndexEntry) == 24);
+
+    struct Footer {
+        std::uint64_t index_offset;
+        std::uint64_t streams;
+        std::array<char, 8> magic;
+    };
+    static_assert(sizeof(Footer) == 24);
+
+    /** Size including padding to the alignment */
+    constexpr std::size_t padded(std::size_t size) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+} // namespace constellation::data::raw_file
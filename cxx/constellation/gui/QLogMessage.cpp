@@ -9,22 +9,61 @@
 
 #include "QLogMessage.hpp"
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <QDateTime>
 #include <QString>
 #include <QVariant>
 
+#include "constellation/core/log/Level.hpp"
 #include "constellation/core/message/CMDP1Message.hpp"
 #include "constellation/core/utils/string.hpp"
 #include "constellation/gui/qt_utils.hpp"
 
 using namespace constellation::gui;
+using namespace constellation::log;
 using namespace constellation::message;
 using namespace constellation::utils;
 
-QLogMessage::QLogMessage(CMDP1LogMessage&& msg) : CMDP1LogMessage(std::move(msg)) {}
+namespace {
+    // Shared string representations of the log levels
+    const QString& level_string(Level level) {
+        static const std::array<QString, 7> level_strings {
+            QString::fromStdString(to_string(Level::TRACE)),
+            QString::fromStdString(to_string(Level::DEBUG)),
+            QString::fromStdString(to_string(Level::INFO)),
+            QString::fromStdString(to_string(Level::WARNING)),
+            QString::fromStdString(to_string(Level::STATUS)),
+            QString::fromStdString(to_string(Level::CRITICAL)),
+            QString::fromStdString(to_string(Level::OFF)),
+        };
+        return level_strings.at(std::to_underlying(level));
+    }
+} // namespace
+
+QLogMessage::QLogMessage(CMDP1LogMessage&& msg)
+    : CMDP1LogMessage(std::move(msg)), time_(from_timepoint(getHeader().getTime())) {
+
+    // Pre-render display columns
+    const auto sender = getHeader().getSender();
+    const auto topic = getLogTopic();
+    columns_[0] = QString::fromUtf8(sender.data(), static_cast<qsizetype>(sender.size()));
+    columns_[1] = level_string(getLogLevel());
+    columns_[2] = QString::fromUtf8(topic.data(), static_cast<qsizetype>(topic.size()));
+
+    // Trim message to first line break, share the full message with the message column for single lines
+    const auto message = getLogMessage();
+    full_message_ = QString::fromUtf8(message.data(), static_cast<qsizetype>(message.size()));
+    const auto pos = message.find_first_of('\n');
+    if(pos != std::string_view::npos) {
+        columns_[3] = QString::fromUtf8(message.data(), static_cast<qsizetype>(pos)) + " [...]";
+    } else {
+        columns_[3] = full_message_;
+    }
+}
 
 int QLogMessage::columnWidth(int column) {
     switch(column) {
@@ -37,23 +76,28 @@ int QLogMessage::columnWidth(int column) {
 }
 
 QVariant QLogMessage::operator[](int column) const {
+    if(column == 0) {
+        return time_;
+    }
+    return getText(column);
+}
+
+const QString& QLogMessage::getText(int column) const {
+    static const QString empty {};
+
     switch(column) {
-    case 0: return from_timepoint(getHeader().getTime());
-    case 1: return QString::fromStdString(std::string(getHeader().getSender()));
-    case 2: return QString::fromStdString(to_string(getLogLevel()));
-    case 3: return QString::fromStdString(std::string(getLogTopic()));
-    case 4: {
-        // Trim string to first line break
-        const auto msg = std::string(getLogMessage());
-        const auto pos = msg.find_first_of('\n');
-        if(pos != std::string::npos) {
-            return QString::fromStdString(msg.substr(0, pos) + " [...]");
+    case 1:
+    case 2:
+    case 3:
+    case 4: return columns_.at(column - 1);
+    case 5: {
+        if(!tags_.has_value()) {
+            tags_ = QString::fromStdString(getHeader().getTags().to_string(false));
         }
-        return QString::fromStdString(msg);
+        return tags_.value();
     }
-    case 5: return QString::fromStdString(getHeader().getTags().to_string(false));
-    case 6: return QString::fromStdString(std::string(getLogMessage()));
-    default: return "";
+    case 6: return full_message_;
+    default: return empty;
     }
 }
 
@@ -10,8 +10,11 @@
 #pragma once
 
 #include <array>
+#include <optional>
 
+#include <QDateTime>
 #include <QRegularExpression>
+#include <QString>
 #include <QVariant>
 
 #include "constellation/build.hpp"
@@ -23,6 +26,10 @@ namespace constellation::gui {
      * @class LogMessage
      * @brief Wrapper class around CMDP1 Log messages which provide additional accessors to make them play nice with the
      * QAbstractListModel they are used in.
+     *
+     * The display columns and the full message are rendered once on construction, the tags are rendered on first access
+     * and cached afterwards. Rendering on access is not thread-safe, accessing the columns should only happen from the GUI
+     * thread. The full message shares its data with the trimmed message column if it consists of a single line.
      */
     class CNSTLN_API QLogMessage : public message::CMDP1LogMessage {
     public:
@@ -41,6 +48,14 @@ namespace constellation::gui {
          */
         QVariant operator[](int column) const;
 
+        /**
+         * @brief Obtain the cached string representation of a text column
+         *
+         * @param column Text column to retrieve, i.e. all columns except the time
+         * @return Reference to the cached string, empty string for the time or invalid columns
+         */
+        const QString& getText(int column) const;
+
         /**
          * @brief Obtain number of info columns this message provides
          * @return Number of columns
@@ -68,6 +83,16 @@ namespace constellation::gui {
         static int columnWidth(int column);
 
     private:
+        // Pre-rendered time and text columns for sender, level, topic and trimmed message
+        QDateTime time_;
+        std::array<QString, 4> columns_;
+
+        // Pre-rendered full message, searched by the log filter
+        QString full_message_;
+
+        // Lazily rendered tags
+        mutable std::optional<QString> tags_;
+
         // Column headers of the log details
         static constexpr std::array<const char*, 7> headers_ {
             "Time", "Sender", "Level", "Topic", "Message", "Tags", "Full Message"};
@@ -0,0 +1,240 @@
+/**
+ * @file
+ * @brief CMDPRecorder implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "CMDPRecorder.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <ios>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/core/chirp/Manager.hpp"
+#include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/utils/enum.hpp"
+#include "constellation/core/utils/string.hpp"
+
+using namespace constellation;
+using namespace constellation::listener;
+using namespace constellation::message;
+using namespace constellation::utils;
+
+CMDPFrames CMDPFrames::disassemble(zmq::multipart_t& frames) {
+    if(frames.size() != CMDPRecordWriter::frames_per_record) {
+        throw MessageDecodingError("CMDP messages consist of three frames, received " + to_string(frames.size()));
+    }
+    return {std::move(frames)};
+}
+
+CMDPRecordWriter::CMDPRecordWriter(std::filesystem::path prefix, std::size_t max_file_size, std::size_t batch_size)
+    : prefix_(std::move(prefix)), max_file_size_(max_file_size), batch_size_(batch_size) {
+    buffer_.reserve(batch_size_ + (batch_size_ / 4));
+}
+
+CMDPRecordWriter::~CMDPRecordWriter() {
+    try {
+        flush();
+    } catch(...) { // NOLINT(bugprone-empty-catch)
+        // Nothing we can do at this point
+    }
+}
+
+void CMDPRecordWriter::write(const zmq::multipart_t& frames) {
+    const std::lock_guard lock {mutex_};
+
+    // Sizes first, then frame contents
+    for(const auto& frame : frames) {
+        append(static_cast<std::uint32_t>(frame.size()));
+    }
+    for(const auto& frame : frames) {
+        const auto* data = static_cast<const std::byte*>(frame.data());
+        buffer_.insert(buffer_.end(), data, data + frame.size());
+    }
+    ++messages_;
+
+    if(buffer_.size() >= batch_size_) {
+        write_buffer();
+    }
+}
+
+void CMDPRecordWriter::flush() {
+    const std::lock_guard lock {mutex_};
+    write_buffer();
+    if(file_.is_open()) {
+        file_.flush();
+    }
+}
+
+void CMDPRecordWriter::append(std::uint32_t value) {
+    std::array<std::byte, sizeof(value)> bytes {};
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+}
+
+void CMDPRecordWriter::write_buffer() {
+    if(buffer_.empty()) {
+        return;
+    }
+
+    // Rotate file before writing if maximum size would be exceeded
+    if(!file_.is_open() || (file_size_ > 0 && file_size_ + buffer_.size() > max_file_size_)) {
+        open_next_file();
+    }
+
+    file_.write(reinterpret_cast<const char*>(buffer_.data()), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                static_cast<std::streamsize>(buffer_.size()));
+    if(!file_.good()) {
+        throw CMDPRecordingError("Failed to write to " + current_path_.string());
+    }
+    file_size_ += buffer_.size();
+    bytes_ += buffer_.size();
+    buffer_.clear();
+}
+
+void CMDPRecordWriter::open_next_file() {
+    if(file_.is_open()) {
+        file_.close();
+    }
+
+    std::ostringstream name {};
+    name << prefix_.filename().string() << "_" << std::setfill('0') << std::setw(4) << file_index_++ << ".cmdp";
+    current_path_ = prefix_.parent_path() / name.str();
+    file_.open(current_path_, std::ios_base::binary | std::ios_base::trunc);
+    if(!file_.good()) {
+        throw CMDPRecordingError("Failed to open " + current_path_.string());
+    }
+
+    file_.write(file_magic.data(), file_magic.size());
+    file_.write(reinterpret_cast<const char*>(&file_version), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                sizeof(file_version));
+    file_size_ = file_magic.size() + sizeof(file_version);
+}
+
+CMDPRecordReader::CMDPRecordReader(const std::filesystem::path& path) : path_(path), file_(path, std::ios_base::binary) {
+    if(!file_.good()) {
+        throw CMDPRecordingError("Failed to open " + path_.string());
+    }
+
+    std::array<char, CMDPRecordWriter::file_magic.size()> magic {};
+    std::uint32_t version {};
+    file_.read(magic.data(), magic.size());
+    file_.read(reinterpret_cast<char*>(&version), sizeof(version)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    if(!file_.good() || magic != CMDPRecordWriter::file_magic || version != CMDPRecordWriter::file_version) {
+        throw CMDPRecordingError(path_.string() + " is not a CMDP recording");
+    }
+    remaining_ = std::filesystem::file_size(path_) - magic.size() - sizeof(version);
+}
+
+std::optional<zmq::multipart_t> CMDPRecordReader::read() {
+    if(remaining_ == 0) {
+        return std::nullopt;
+    }
+
+    std::array<std::uint32_t, CMDPRecordWriter::frames_per_record> sizes {};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file_.read(reinterpret_cast<char*>(sizes.data()), sizeof(sizes));
+    if(file_.gcount() != sizeof(sizes)) {
+        throw CMDPRecordingError("Truncated record in " + path_.string());
+    }
+    remaining_ -= sizeof(sizes);
+
+    // Validate frame sizes against the remaining file before allocating
+    std::uint64_t record_size {0};
+    for(const auto size : sizes) {
+        record_size += size;
+    }
+    if(record_size > remaining_) {
+        throw CMDPRecordingError("Truncated record in " + path_.string());
+    }
+
+    zmq::multipart_t frames {};
+    for(const auto size : sizes) {
+        zmq::message_t frame {size};
+        file_.read(static_cast<char*>(frame.data()), size);
+        if(file_.gcount() != static_cast<std::streamsize>(size)) {
+            throw CMDPRecordingError("Truncated record in " + path_.string());
+        }
+        frames.add(std::move(frame));
+    }
+    remaining_ -= record_size;
+    return frames;
+}
+
+namespace {
+    std::string csv_escape(std::string_view value) {
+        std::string out {"\""};
+        for(const auto c : value) {
+            if(c == '"') {
+                out += '"';
+            }
+            out += c;
+        }
+        out += '"';
+        return out;
+    }
+} // namespace
+
+std::uint64_t CMDPRecordReader::exportMessages(std::ostream& out, bool csv) {
+    std::uint64_t count {0};
+    while(auto frames = read()) {
+        auto msg = CMDP1Message::disassemble(frames.value());
+        const auto time = to_string(msg.getHeader().getTime());
+        const auto sender = std::string(msg.getHeader().getSender());
+
+        if(msg.isLogMessage()) {
+            const auto log_msg = CMDP1LogMessage(std::move(msg));
+            const auto level = to_string(log_msg.getLogLevel());
+            if(csv) {
+                out << time << "," << sender << ",LOG," << csv_escape(log_msg.getLogTopic()) << "," << level << ","
+                    << csv_escape(log_msg.getLogMessage()) << ",\n";
+            } else {
+                out << time << " " << sender << " " << level << " [" << log_msg.getLogTopic() << "] "
+                    << log_msg.getLogMessage() << "\n";
+            }
+        } else if(msg.isStatMessage()) {
+            const auto stat_msg = CMDP1StatMessage(std::move(msg));
+            const auto& metric = stat_msg.getMetric();
+            const auto value = metric.getValue().str();
+            if(csv) {
+                out << time << "," << sender << ",STAT," << csv_escape(metric.getMetric()->name()) << ",,"
+                    << csv_escape(value) << "," << csv_escape(metric.getMetric()->unit()) << "\n";
+            } else {
+                out << time << " " << sender << " STAT " << metric.getMetric()->name() << " = " << value << " "
+                    << metric.getMetric()->unit() << "\n";
+            }
+        }
+        ++count;
+    }
+    return count;
+}
+
+CMDPRecorder::CMDPRecorder(CMDPRecordWriter& writer, std::vector<std::string> topics)
+    : SubscriberPoolT("RECORDER", [&writer](CMDPFrames&& msg) { writer.write(msg.getFrames()); }),
+      topics_(std::move(topics)) {}
+
+void CMDPRecorder::host_connected(const chirp::DiscoveredService& service) {
+    for(const auto& topic : topics_) {
+        SubscriberPoolT::subscribe(service.host_id, topic);
+    }
+}
@@ -0,0 +1,227 @@
+/**
+ * @file
+ * @brief Recorder for raw CMDP messages
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/build.hpp"
+#include "constellation/core/chirp/Manager.hpp"
+#include "constellation/core/pools/SubscriberPool.hpp"
+#include "constellation/core/protocol/CHIRP_definitions.hpp"
+#include "constellation/core/utils/exceptions.hpp"
+
+namespace constellation::listener {
+
+    /**
+     * @ingroup Exceptions
+     * @brief Error when reading or writing CMDP recordings
+     */
+    class CNSTLN_API CMDPRecordingError : public utils::RuntimeError {
+    public:
+        explicit CMDPRecordingError(const std::string& reason) { error_message_ = reason; }
+    };
+
+    /**
+     * @brief Raw frames of a CMDP message
+     *
+     * Message type of the `CMDPRecorder` subscriber pool, passes the received frames on without decoding them.
+     */
+    class CNSTLN_API CMDPFrames {
+    public:
+        /**
+         * @brief Take the frames of a received CMDP message
+         *
+         * @param frames Message frames
+         * @return Raw frames
+         * @throw MessageDecodingError If the message does not consist of topic, header and payload frame
+         */
+        CNSTLN_API static CMDPFrames disassemble(zmq::multipart_t& frames);
+
+        /**
+         * @brief Return the frames of the message
+         */
+        const zmq::multipart_t& getFrames() const { return frames_; }
+
+    private:
+        CMDPFrames(zmq::multipart_t&& frames) : frames_(std::move(frames)) {}
+
+    private:
+        zmq::multipart_t frames_;
+    };
+
+    /**
+     * @brief Writer appending raw CMDP frames to rotating binary files
+     *
+     * Every file starts with magic bytes followed by the format version as 32-bit unsigned integer. Afterwards records
+     * follow directly, each consisting of the sizes of the three CMDP frames (topic, header, payload) as 32-bit unsigned
+     * integers followed by the raw frame contents. All integers are stored in native byte order.
+     *
+     * Records are collected in a buffer and written in batches. Files are named `<prefix>_<index>.cmdp` and rotated once
+     * they would exceed the maximum file size.
+     */
+    class CNSTLN_API CMDPRecordWriter {
+    public:
+        /** Magic bytes at the start of every recording */
+        static constexpr std::array<char, 8> file_magic {'C', 'N', 'S', 'T', 'C', 'M', 'D', 'P'};
+
+        /** Version of the file format */
+        static constexpr std::uint32_t file_version {1};
+
+        /** Number of frames of every record */
+        static constexpr std::size_t frames_per_record {3};
+
+    public:
+        /**
+         * @brief Construct the record writer
+         *
+         * @param prefix Path prefix of the recording files
+         * @param max_file_size Maximum size of a file in bytes before rotating
+         * @param batch_size Size of the write batches in bytes
+         */
+        CNSTLN_API CMDPRecordWriter(std::filesystem::path prefix, std::size_t max_file_size, std::size_t batch_size);
+
+        /**
+         * @brief Destruct the record writer, writing all buffered records
+         */
+        CNSTLN_API ~CMDPRecordWriter();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        CMDPRecordWriter(const CMDPRecordWriter& other) = delete;
+        CMDPRecordWriter& operator=(const CMDPRecordWriter& other) = delete;
+        CMDPRecordWriter(CMDPRecordWriter&& other) = delete;
+        CMDPRecordWriter& operator=(CMDPRecordWriter&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Append a message given as raw frames
+         *
+         * @param frames CMDP message frames
+         * @throw CMDPRecordingError If the batch could not be written
+         */
+        CNSTLN_API void write(const zmq::multipart_t& frames);
+
+        /**
+         * @brief Write all buffered records to disk
+         *
+         * @throw CMDPRecordingError If the buffered records could not be written
+         */
+        CNSTLN_API void flush();
+
+        /**
+         * @brief Return the number of recorded messages
+         */
+        std::uint64_t countMessages() const { return messages_.load(); }
+
+        /**
+         * @brief Return the number of bytes written to disk
+         */
+        std::uint64_t countBytes() const { return bytes_.load(); }
+
+    private:
+        void append(std::uint32_t value);
+        void write_buffer();
+        void open_next_file();
+
+    private:
+        std::filesystem::path prefix_;
+        std::size_t max_file_size_;
+        std::size_t batch_size_;
+
+        std::mutex mutex_;
+        std::vector<std::byte> buffer_;
+        std::ofstream file_;
+        std::filesystem::path current_path_;
+        std::size_t file_size_ {0};
+        std::size_t file_index_ {0};
+
+        std::atomic_uint64_t messages_ {0};
+        std::atomic_uint64_t bytes_ {0};
+    };
+
+    /**
+     * @brief Reader for files written by `CMDPRecordWriter`
+     */
+    class CNSTLN_API CMDPRecordReader {
+    public:
+        /**
+         * @brief Open a recording
+         *
+         * @param path Path to the recording file
+         * @throw CMDPRecordingError If the file could not be opened or is not a CMDP recording
+         */
+        CNSTLN_API CMDPRecordReader(const std::filesystem::path& path);
+
+        /**
+         * @brief Read the next record
+         *
+         * @return Frames of the record or empty optional if the end of the file is reached
+         * @throw CMDPRecordingError If the record is truncated or corrupted
+         */
+        CNSTLN_API std::optional<zmq::multipart_t> read();
+
+        /**
+         * @brief Export all remaining records as text or CSV
+         * @details CSV lines contain time, sender, type, topic, level, value and unit, without a header line
+         *
+         * @param out Output stream
+         * @param csv If CSV should be written instead of text
+         * @return Number of exported messages
+         * @throw CMDPRecordingError If a record is truncated or corrupted
+         */
+        CNSTLN_API std::uint64_t exportMessages(std::ostream& out, bool csv);
+
+    private:
+        std::filesystem::path path_;
+        std::ifstream file_;
+        std::uint64_t remaining_ {0};
+    };
+
+    /**
+     * @brief Subscriber pool recording raw CMDP messages
+     *
+     * Subscribes all discovered monitoring services to the given topics and appends the received frames to a record
+     * writer without decoding them.
+     */
+    class CNSTLN_API CMDPRecorder
+        : public pools::SubscriberPool<CMDPFrames, protocol::CHIRP::ServiceIdentifier::MONITORING> {
+    public:
+        using SubscriberPoolT = pools::SubscriberPool<CMDPFrames, protocol::CHIRP::ServiceIdentifier::MONITORING>;
+
+        /**
+         * @brief Construct CMDPRecorder
+         *
+         * @param writer Record writer to append the messages to, needs to outlive the recorder
+         * @param topics CMDP topics to subscribe to
+         */
+        CNSTLN_API CMDPRecorder(CMDPRecordWriter& writer, std::vector<std::string> topics);
+
+    protected:
+        CNSTLN_API void host_connected(const chirp::DiscoveredService& service) override;
+
+    private:
+        std::vector<std::string> topics_;
+    };
+
+} // namespace constellation::listener
@@ -12,6 +12,8 @@
 #include <functional>
 #include <iomanip>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -25,6 +27,7 @@
 #include "constellation/core/utils/std_future.hpp"
 #include "constellation/core/utils/string.hpp"
 #include "constellation/listener/LogListener.hpp"
+#include "constellation/listener/LogStore.hpp"
 
 #include "CMDPListener.hpp"
 
@@ -35,7 +38,11 @@ using namespace constellation::utils;
 
 LogListener::LogListener(std::string_view log_topic, std::function<void(CMDP1LogMessage&&)> callback)
     : CMDPListener(log_topic,
-                   [callback = std::move(callback)](CMDP1Message&& msg) { callback(CMDP1LogMessage(std::move(msg))); }),
+                   [this, callback = std::move(callback)](CMDP1Message&& msg) {
+                       auto log_msg = CMDP1LogMessage(std::move(msg));
+                       store_message(log_msg);
+                       callback(std::move(log_msg));
+                   }),
       global_log_level_(Level::OFF) {
     // Subscribe to notifications:
     CMDPListener::subscribeTopic("LOG?");
@@ -141,3 +148,23 @@ std::map<std::string, Level> LogListener::getExtraLogTopicSubscriptions(const st
     }
     return log_topic_subscriptions;
 }
+
+void LogListener::setLogStore(std::shared_ptr<LogStore> log_store) {
+    const std::lock_guard lock {log_store_mutex_};
+    log_store_ = std::move(log_store);
+}
+
+void LogListener::store_message(const CMDP1LogMessage& msg) {
+    std::unique_lock lock {log_store_mutex_};
+    const auto log_store = log_store_;
+    lock.unlock();
+
+    if(log_store == nullptr) {
+        return;
+    }
+    try {
+        log_store->append(msg);
+    } catch(const LogStoreError& error) {
+        LOG(BasePoolT::pool_logger_, WARNING) << "Failed to store log message: " << error.what();
+    }
+}
@@ -12,6 +12,8 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -21,6 +23,7 @@
 #include "constellation/core/log/Level.hpp"
 #include "constellation/core/message/CMDP1Message.hpp"
 #include "constellation/listener/CMDPListener.hpp"
+#include "constellation/listener/LogStore.hpp"
 
 namespace constellation::listener {
 
@@ -104,7 +107,18 @@ namespace constellation::listener {
          */
         CNSTLN_API std::map<std::string, log::Level> getExtraLogTopicSubscriptions(const std::string& host);
 
+        /**
+         * @brief Set a log store to which all received log messages are appended before invoking the callback
+         *
+         * @note Messages which could not be stored are logged as warning and still passed on to the callback
+         *
+         * @param log_store Log store, or nullptr to stop storing received log messages
+         */
+        CNSTLN_API void setLogStore(std::shared_ptr<LogStore> log_store);
+
     private:
+        CNSTLN_LOCAL void store_message(const message::CMDP1LogMessage& msg);
+
         CNSTLN_LOCAL static std::vector<std::string> generate_topics(const std::string& log_topic,
                                                                      log::Level level,
                                                                      bool subscribe = true);
@@ -125,6 +139,8 @@ namespace constellation::listener {
 
     private:
         std::atomic<log::Level> global_log_level_;
+        std::mutex log_store_mutex_;
+        std::shared_ptr<LogStore> log_store_;
     };
 
 } // namespace constellation::listener
@@ -0,0 +1,595 @@
+/**
+ * @file
+ * @brief Log store implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "LogStore.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/data/exceptions.hpp"
+#include "constellation/data/MappedFile.hpp"
+
+using namespace constellation::data;
+using namespace constellation::listener;
+using namespace constellation::log;
+using namespace constellation::message;
+
+namespace {
+
+    constexpr std::array<char, 8> store_magic {'C', 'N', 'S', 'T', 'L', 'O', 'G', 'S'};
+    constexpr std::uint32_t store_version {1};
+
+    /** Fixed-size entry in the index file of a segment */
+    struct IndexEntry {
+        std::int64_t time;
+        std::uint64_t offset;
+        std::uint32_t length;
+        std::uint32_t sender;
+        std::uint32_t topic;
+        std::uint32_t level;
+    };
+    static_assert(sizeof(IndexEntry) == 32);
+
+    /** Map a file into memory, translating errors to log store errors */
+    std::unique_ptr<MappedFile> map_file(const std::filesystem::path& path) {
+        try {
+            return std::make_unique<MappedFile>(path);
+        } catch(const RawFileError& error) {
+            throw LogStoreError(error.what());
+        }
+    }
+
+    template <typename T> void write_value(std::ostream& stream, const T& value) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T> bool read_value(std::istream& stream, T& value) {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return static_cast<std::size_t>(stream.gcount()) == sizeof(T);
+    }
+
+    /** Cursor reading values from a memory-mapped file */
+    class Reader {
+    public:
+        explicit Reader(std::span<const std::byte> data) : data_(data) {}
+
+        template <typename T> T read() {
+            if(pos_ + sizeof(T) > data_.size()) {
+                throw LogStoreError("Unexpected end of file");
+            }
+            T value {};
+            std::memcpy(&value, data_.subspan(pos_).data(), sizeof(T));
+            pos_ += sizeof(T);
+            return value;
+        }
+
+        /** Return the number of bytes read so far */
+        std::size_t position() const { return pos_; }
+
+        /** Return a view on a list of 32-bit values, valid as long as the mapping exists */
+        std::span<const std::uint32_t> read_list() {
+            const auto count = read<std::uint32_t>();
+            if(pos_ + (count * sizeof(std::uint32_t)) > data_.size()) {
+                throw LogStoreError("Unexpected end of file");
+            }
+            // Lists are aligned to 32-bit since the file only consists of 32-bit values
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto* list = reinterpret_cast<const std::uint32_t*>(data_.subspan(pos_).data());
+            pos_ += count * sizeof(std::uint32_t);
+            return {list, count};
+        }
+
+    private:
+        std::span<const std::byte> data_;
+        std::size_t pos_ {0};
+    };
+
+    void write_list(std::ostream& stream, std::span<const std::uint32_t> list) {
+        write_value(stream, static_cast<std::uint32_t>(list.size()));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.write(reinterpret_cast<const char*>(list.data()),
+                     static_cast<std::streamsize>(list.size() * sizeof(std::uint32_t)));
+    }
+
+    IndexEntry read_entry(std::span<const std::byte> index, std::size_t entry) {
+        IndexEntry index_entry {};
+        std::memcpy(&index_entry, index.subspan(entry * sizeof(IndexEntry)).data(), sizeof(IndexEntry));
+        return index_entry;
+    }
+
+    std::int64_t to_ns(std::chrono::system_clock::time_point time) {
+        // Saturate since the system clock might have a coarser resolution than nanoseconds
+        constexpr auto max_time = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(std::chrono::nanoseconds::max()));
+        if(time.time_since_epoch() >= max_time) {
+            return std::chrono::nanoseconds::max().count();
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+} // namespace
+
+LogStore::LogStore(std::filesystem::path directory, std::chrono::seconds segment_duration)
+    : directory_(std::move(directory)), segment_duration_(segment_duration) {
+    std::filesystem::create_directories(directory_);
+
+    // Read or write meta data
+    const auto meta_path = directory_ / "store.meta";
+    if(std::filesystem::exists(meta_path)) {
+        std::ifstream meta_file {meta_path, std::ios_base::binary};
+        std::array<char, store_magic.size()> magic {};
+        std::uint32_t version {};
+        std::int64_t duration {};
+        meta_file.read(magic.data(), magic.size());
+        if(!read_value(meta_file, version) || !read_value(meta_file, duration) || magic != store_magic ||
+           version != store_version || duration <= 0) {
+            throw LogStoreError(directory_.string() + " is not a valid log store");
+        }
+        segment_duration_ = std::chrono::seconds(duration);
+    } else {
+        std::ofstream meta_file {meta_path, std::ios_base::binary};
+        meta_file.write(store_magic.data(), store_magic.size());
+        write_value(meta_file, store_version);
+        write_value(meta_file, static_cast<std::int64_t>(segment_duration_.count()));
+        if(!meta_file.good()) {
+            throw LogStoreError("Failed to write " + meta_path.string());
+        }
+    }
+
+    // Read string table, ignoring an incompletely written last string
+    const auto strings_path = directory_ / "strings.dat";
+    std::uint64_t strings_end {0};
+    {
+        std::ifstream strings_file {strings_path, std::ios_base::binary};
+        std::uint32_t length {};
+        while(strings_file.good() && read_value(strings_file, length)) {
+            std::string str(length, '\0');
+            strings_file.read(str.data(), length);
+            if(strings_file.gcount() != length) {
+                break;
+            }
+            string_ids_.emplace(str, static_cast<std::uint32_t>(strings_.size()));
+            strings_.emplace_back(std::move(str));
+            strings_end += sizeof(length) + length;
+        }
+    }
+
+    // Truncate the string table to the last complete string so that appended strings keep their IDs
+    if(std::filesystem::exists(strings_path) && std::filesystem::file_size(strings_path) != strings_end) {
+        std::filesystem::resize_file(strings_path, strings_end);
+    }
+    strings_file_.open(strings_path, std::ios_base::binary | std::ios_base::app);
+
+    // Load existing segments
+    for(const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        if(entry.path().extension() == ".idx") {
+            load_segment(std::stoll(entry.path().stem().string()));
+        }
+    }
+}
+
+LogStore::~LogStore() {
+    try {
+        flush();
+    } catch(...) { // NOLINT(bugprone-empty-catch)
+        // Posting lists are rebuilt from the index when opening the store again
+    }
+}
+
+std::filesystem::path LogStore::segment_path(std::int64_t start, std::string_view extension) const {
+    return directory_ / (std::to_string(start) + std::string(extension));
+}
+
+void LogStore::load_segment(std::int64_t start) {
+    auto& segment = segments_[start];
+    segment.start = start;
+
+    const auto index_path = segment_path(start, ".idx");
+    const auto message_path = segment_path(start, ".log");
+    const auto index_size = std::filesystem::file_size(index_path);
+    const auto message_size = std::filesystem::exists(message_path) ? std::filesystem::file_size(message_path) : 0;
+
+    // Drop entries at the end which were not completely written, e.g. after a crash
+    auto entries = index_size / sizeof(IndexEntry);
+    std::uint64_t message_end {0};
+    if(entries > 0) {
+        const auto index_file = map_file(index_path);
+        for(; entries > 0; --entries) {
+            const auto entry = read_entry(index_file->data(), entries - 1);
+            if(entry.offset + entry.length <= message_size) {
+                message_end = entry.offset + entry.length;
+                break;
+            }
+        }
+    }
+
+    // Truncate files to the last complete entry so that appended entries stay aligned
+    if(entries * sizeof(IndexEntry) != index_size) {
+        std::filesystem::resize_file(index_path, entries * sizeof(IndexEntry));
+    }
+    if(message_end != message_size) {
+        std::filesystem::resize_file(message_path, message_end);
+    }
+    segment.entries = static_cast<std::uint32_t>(entries);
+    segment.message_offset = message_end;
+
+    // Map written posting lists and truncate an incompletely written or outdated last chunk
+    const auto postings_path = segment_path(start, ".pst");
+    const auto postings_end = map_postings(segment);
+    if(std::filesystem::exists(postings_path) && std::filesystem::file_size(postings_path) != postings_end) {
+        segment.postings_file.reset();
+        std::filesystem::resize_file(postings_path, postings_end);
+        map_postings(segment);
+    }
+
+    // Rebuild posting lists of the entries not covered by the written chunks from the index
+    if(segment.postings_entries < segment.entries) {
+        const auto index_file = map_file(index_path);
+        for(auto n = segment.postings_entries; n < segment.entries; ++n) {
+            const auto entry = read_entry(index_file->data(), n);
+            segment.postings.senders[entry.sender].appended.push_back(n);
+            segment.postings.topics[entry.topic].appended.push_back(n);
+            segment.postings.levels.at(entry.level).appended.push_back(n);
+        }
+    }
+}
+
+std::uint64_t LogStore::map_postings(Segment& segment) const {
+    segment.postings = {};
+    segment.postings_file.reset();
+    segment.postings_entries = 0;
+
+    const auto postings_path = segment_path(segment.start, ".pst");
+    if(!std::filesystem::exists(postings_path)) {
+        return 0;
+    }
+
+    std::unique_ptr<MappedFile> postings_file {};
+    try {
+        postings_file = map_file(postings_path);
+    } catch(const LogStoreError&) {
+        return 0;
+    }
+
+    // Read chunks until the end of the file or the first chunk which is incomplete or not covered by the index
+    Reader reader {postings_file->data()};
+    std::uint64_t postings_end {0};
+    while(reader.position() < postings_file->data().size()) {
+        try {
+            const auto first = reader.read<std::uint32_t>();
+            const auto count = reader.read<std::uint32_t>();
+            if(first != segment.postings_entries || count > segment.entries - first) {
+                break;
+            }
+            Postings chunk {};
+            for(auto* map : {&chunk.senders, &chunk.topics}) {
+                const auto keys = reader.read<std::uint32_t>();
+                for(std::uint32_t n = 0; n < keys; ++n) {
+                    const auto key = reader.read<std::uint32_t>();
+                    (*map)[key].map(reader.read_list());
+                }
+            }
+            for(auto& level_list : chunk.levels) {
+                level_list.map(reader.read_list());
+            }
+
+            // Chunk complete, add its lists to the lists of the previous chunks
+            for(const auto& [key, list] : chunk.senders) {
+                segment.postings.senders[key].map(list.mapped.front());
+            }
+            for(const auto& [key, list] : chunk.topics) {
+                segment.postings.topics[key].map(list.mapped.front());
+            }
+            for(std::size_t lvl = 0; lvl < chunk.levels.size(); ++lvl) {
+                segment.postings.levels.at(lvl).map(chunk.levels.at(lvl).mapped.front());
+            }
+            segment.postings_entries += count;
+            postings_end = reader.position();
+        } catch(const LogStoreError&) {
+            break;
+        }
+    }
+
+    segment.postings_file = std::move(postings_file);
+    return postings_end;
+}
+
+void LogStore::write_postings(Segment& segment) const {
+    // Append posting lists of the entries written since the last chunk, the previous chunks stay mapped
+    const auto postings_path = segment_path(segment.start, ".pst");
+    {
+        std::ofstream postings_file {postings_path, std::ios_base::binary | std::ios_base::app};
+        write_value(postings_file, segment.postings_entries);
+        write_value(postings_file, segment.entries - segment.postings_entries);
+        for(const auto* map : {&segment.postings.senders, &segment.postings.topics}) {
+            const auto keys = std::ranges::count_if(*map, [](const auto& entry) { return !entry.second.appended.empty(); });
+            write_value(postings_file, static_cast<std::uint32_t>(keys));
+            for(const auto& [key, list] : *map) {
+                if(!list.appended.empty()) {
+                    write_value(postings_file, key);
+                    write_list(postings_file, list.appended);
+                }
+            }
+        }
+        for(const auto& level_list : segment.postings.levels) {
+            write_list(postings_file, level_list.appended);
+        }
+        postings_file.flush();
+        if(!postings_file.good()) {
+            throw LogStoreError("Failed to write posting lists for segment " + std::to_string(segment.start));
+        }
+    }
+
+    // Map the written chunk to release the appended entries from memory
+    map_postings(segment);
+}
+
+LogStore::Segment& LogStore::get_segment(std::int64_t start) {
+    auto& segment = segments_[start];
+    segment.start = start;
+
+    if(!segment.index_file) {
+        // Usually no more messages arrive for the previous segments, write their posting lists
+        for(auto& [other_start, other_segment] : segments_) {
+            if(other_segment.postings_entries < other_segment.entries) {
+                write_postings(other_segment);
+            }
+        }
+
+        constexpr auto mode = std::ios_base::binary | std::ios_base::app;
+        segment.index_file = std::make_unique<std::ofstream>(segment_path(start, ".idx"), mode);
+        segment.message_file = std::make_unique<std::ofstream>(segment_path(start, ".log"), mode);
+        if(!segment.index_file->good() || !segment.message_file->good()) {
+            throw LogStoreError("Failed to open segment " + std::to_string(start));
+        }
+    }
+
+    return segment;
+}
+
+std::uint32_t LogStore::intern(std::string_view str) {
+    const auto it = string_ids_.find(str);
+    if(it != string_ids_.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<std::uint32_t>(strings_.size());
+    write_value(strings_file_, static_cast<std::uint32_t>(str.size()));
+    strings_file_.write(str.data(), static_cast<std::streamsize>(str.size()));
+    strings_file_.flush();
+    if(!strings_file_.good()) {
+        throw LogStoreError("Failed to write string table");
+    }
+
+    strings_.emplace_back(str);
+    string_ids_.emplace(str, id);
+    return id;
+}
+
+std::optional<std::uint32_t> LogStore::find_string(std::string_view str) const {
+    const auto it = string_ids_.find(str);
+    if(it != string_ids_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void LogStore::append(const CMDP1LogMessage& msg) {
+    const auto time = msg.getHeader().getTime();
+    const auto start =
+        std::chrono::floor<std::chrono::seconds>(time.time_since_epoch()).count() / segment_duration_.count() *
+        segment_duration_.count();
+    const auto message = msg.getLogMessage();
+
+    const std::lock_guard lock {mutex_};
+    auto& segment = get_segment(start);
+
+    const IndexEntry entry {
+        .time = to_ns(time),
+        .offset = segment.message_offset,
+        .length = static_cast<std::uint32_t>(message.size()),
+        .sender = intern(msg.getHeader().getSender()),
+        .topic = intern(msg.getLogTopic()),
+        .level = static_cast<std::uint32_t>(std::to_underlying(msg.getLogLevel())),
+    };
+
+    segment.message_file->write(message.data(), static_cast<std::streamsize>(message.size()));
+    write_value(*segment.index_file, entry);
+    if(!segment.message_file->good() || !segment.index_file->good()) {
+        throw LogStoreError("Failed to write segment " + std::to_string(start));
+    }
+
+    // Update posting lists
+    const auto n = segment.entries++;
+    segment.postings.senders[entry.sender].appended.push_back(n);
+    segment.postings.topics[entry.topic].appended.push_back(n);
+    segment.postings.levels.at(entry.level).appended.push_back(n);
+    segment.message_offset += message.size();
+
+    // Write posting lists regularly to keep the memory of long-running stores bounded
+    if(segment.entries - segment.postings_entries >= postings_chunk_entries) {
+        write_postings(segment);
+    }
+}
+
+void LogStore::flush() {
+    const std::lock_guard lock {mutex_};
+    strings_file_.flush();
+    for(auto& [start, segment] : segments_) {
+        if(segment.index_file) {
+            segment.message_file->flush();
+            segment.index_file->flush();
+        }
+        if(segment.postings_entries < segment.entries) {
+            write_postings(segment);
+        }
+    }
+}
+
+std::size_t LogStore::size() {
+    const std::lock_guard lock {mutex_};
+    std::size_t count {0};
+    for(const auto& [start, segment] : segments_) {
+        count += segment.entries;
+    }
+    return count;
+}
+
+std::vector<LogStore::Record> LogStore::query(const Query& query) {
+    const std::lock_guard lock {mutex_};
+    std::vector<Record> records {};
+
+    // Look up sender and topic, if not known nothing can match
+    std::optional<std::uint32_t> sender_id {};
+    std::optional<std::uint32_t> topic_id {};
+    if(query.sender.has_value()) {
+        sender_id = find_string(query.sender.value());
+        if(!sender_id.has_value()) {
+            return records;
+        }
+    }
+    if(query.topic.has_value()) {
+        topic_id = find_string(query.topic.value());
+        if(!topic_id.has_value()) {
+            return records;
+        }
+    }
+
+    const auto begin_ns = to_ns(query.begin);
+    const auto end_ns = to_ns(query.end);
+    const auto min_level = std::to_underlying(query.level);
+    const auto segment_duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(segment_duration_).count();
+
+    // Segments are ordered by time and do not overlap, thus the query can stop once the limit is reached
+    for(auto& [start, segment] : segments_) {
+        if(records.size() >= query.limit) {
+            break;
+        }
+
+        // Skip segments not overlapping with the time range
+        const auto segment_begin_ns = start * 1'000'000'000;
+        if(segment.entries == 0 || segment_begin_ns >= end_ns || segment_begin_ns + segment_duration_ns <= begin_ns) {
+            continue;
+        }
+
+        // Select the smallest candidate list from the posting lists
+        const PostingList* candidates = nullptr;
+        const auto select = [&](const PostingList* list) {
+            if(candidates == nullptr || list->size() < candidates->size()) {
+                candidates = list;
+            }
+        };
+        static const PostingList empty_list {};
+        const auto lookup = [&](const auto& map, std::uint32_t key) {
+            const auto it = map.find(key);
+            return it != map.end() ? &it->second : &empty_list;
+        };
+        if(sender_id.has_value()) {
+            select(lookup(segment.postings.senders, sender_id.value()));
+        }
+        if(topic_id.has_value()) {
+            select(lookup(segment.postings.topics, topic_id.value()));
+        }
+
+        // Levels are only used if more selective, requires merging the lists of all selected levels
+        PostingList level_candidates {};
+        if(min_level > std::to_underlying(Level::TRACE)) {
+            std::size_t level_count {0};
+            for(auto lvl = min_level; lvl < std::to_underlying(Level::OFF); ++lvl) {
+                level_count += segment.postings.levels.at(lvl).size();
+            }
+            if(candidates == nullptr || level_count < candidates->size()) {
+                level_candidates.appended.reserve(level_count);
+                for(auto lvl = min_level; lvl < std::to_underlying(Level::OFF); ++lvl) {
+                    const auto& level_list = segment.postings.levels.at(lvl);
+                    for(const auto list : level_list.mapped) {
+                        level_candidates.appended.insert(level_candidates.appended.end(), list.begin(), list.end());
+                    }
+                    level_candidates.appended.insert(
+                        level_candidates.appended.end(), level_list.appended.begin(), level_list.appended.end());
+                }
+                candidates = &level_candidates;
+            }
+        }
+        if(candidates != nullptr && candidates->size() == 0) {
+            continue;
+        }
+
+        // Make sure all data of the segment is on disk before mapping
+        if(segment.index_file) {
+            segment.message_file->flush();
+            segment.index_file->flush();
+        }
+        const auto index_file = map_file(segment_path(start, ".idx"));
+        const auto message_file = map_file(segment_path(start, ".log"));
+
+        // Collect matching index entries, without any selective filter all entries are candidates
+        std::vector<IndexEntry> matches {};
+        const auto check = [&](std::uint32_t n) {
+            const auto entry = read_entry(index_file->data(), n);
+            if(entry.time >= begin_ns && entry.time < end_ns && static_cast<int>(entry.level) >= min_level &&
+               (!sender_id.has_value() || entry.sender == sender_id.value()) &&
+               (!topic_id.has_value() || entry.topic == topic_id.value())) {
+                matches.push_back(entry);
+            }
+        };
+        if(candidates == nullptr) {
+            for(std::uint32_t n = 0; n < segment.entries; ++n) {
+                check(n);
+            }
+        } else {
+            for(const auto list : candidates->mapped) {
+                std::ranges::for_each(list, check);
+            }
+            std::ranges::for_each(candidates->appended, check);
+        }
+
+        // Only read the messages of the earliest matches within the limit, entries with equal time in order of arrival
+        const auto order = [](const IndexEntry& entry) { return std::pair(entry.time, entry.offset); };
+        const auto remaining = query.limit - records.size();
+        if(matches.size() > remaining) {
+            std::ranges::partial_sort(matches, matches.begin() + static_cast<std::ptrdiff_t>(remaining), {}, order);
+            matches.resize(remaining);
+        } else {
+            std::ranges::sort(matches, {}, order);
+        }
+
+        for(const auto& entry : matches) {
+            const auto message = message_file->data().subspan(entry.offset, entry.length);
+            records.push_back({
+                .time = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(entry.time))),
+                .sender = strings_.at(entry.sender),
+                .level = static_cast<Level>(entry.level),
+                .topic = strings_.at(entry.topic),
+                .message = {reinterpret_cast<const char*>(message.data()), message.size()}, // NOLINT(*-reinterpret-cast)
+            });
+        }
+    }
+
+    return records;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file
+ * @brief Persistent indexed store for log messages
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "constellation/build.hpp"
+#include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/core/utils/exceptions.hpp"
+#include "constellation/data/MappedFile.hpp"
+
+namespace constellation::listener {
+
+    /**
+     * @ingroup Exceptions
+     * @brief Error when reading or writing the log store
+     */
+    class CNSTLN_API LogStoreError : public utils::RuntimeError {
+    public:
+        explicit LogStoreError(const std::string& reason) { error_message_ = reason; }
+    };
+
+    /**
+     * @brief Append-only, indexed store for log messages on local disk
+     *
+     * Messages are stored in segments covering a fixed time span each. Every segment consists of a file containing the log
+     * messages, a file with fixed-size index entries and a file with per-sender, per-level and per-topic posting lists of
+     * the index entries. Sender and topic names are interned in a string table shared by all segments. Queries only visit
+     * the segments overlapping with the requested time range and only the index entries from the most selective posting
+     * list, the segment files and the written posting lists are memory-mapped for reading.
+     *
+     * Posting lists are appended in chunks to the posting file of a segment, whenever a number of new entries has been
+     * collected, a new segment is started or the store is flushed. This keeps the memory of long-running stores bounded.
+     *
+     * Incompletely written entries at the end of a segment, e.g. after a crash, are truncated when opening the store.
+     * The store can be attached to a `LogListener` via `LogListener::setLogStore()`.
+     */
+    class CNSTLN_API LogStore {
+    public:
+        /** Query for log messages */
+        struct Query {
+            /** Sender to select, all senders if empty */
+            std::optional<std::string> sender;
+            /** Lowest log level to select */
+            log::Level level {log::Level::TRACE};
+            /** Log topic to select, all topics if empty */
+            std::optional<std::string> topic;
+            /** Start of the time range (inclusive) */
+            std::chrono::system_clock::time_point begin {};
+            /** End of the time range (exclusive) */
+            std::chrono::system_clock::time_point end {std::chrono::system_clock::time_point::max()};
+            /** Maximum number of messages to return */
+            std::size_t limit {std::numeric_limits<std::size_t>::max()};
+        };
+
+        /** Log message returned from a query */
+        struct Record {
+            std::chrono::system_clock::time_point time;
+            std::string sender;
+            log::Level level;
+            std::string topic;
+            std::string message;
+        };
+
+    public:
+        /**
+         * @brief Open or create a log store
+         *
+         * @param directory Directory of the store, created if it does not exist
+         * @param segment_duration Time span covered by a segment, ignored when opening an existing store
+         * @throw LogStoreError If the store could not be opened
+         */
+        CNSTLN_API LogStore(std::filesystem::path directory,
+                            std::chrono::seconds segment_duration = std::chrono::hours(1));
+
+        /**
+         * @brief Destruct the log store, flushing all pending writes
+         */
+        CNSTLN_API ~LogStore();
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        LogStore(const LogStore& other) = delete;
+        LogStore& operator=(const LogStore& other) = delete;
+        LogStore(LogStore&& other) = delete;
+        LogStore& operator=(LogStore&& other) = delete;
+        /// @endcond
+
+        /**
+         * @brief Append a log message to the store
+         *
+         * @param msg Log message
+         * @throw LogStoreError If the message could not be written
+         */
+        CNSTLN_API void append(const message::CMDP1LogMessage& msg);
+
+        /**
+         * @brief Write all pending data including posting lists to disk
+         *
+         * @throw LogStoreError If the data could not be written
+         */
+        CNSTLN_API void flush();
+
+        /**
+         * @brief Query log messages from the store
+         *
+         * @details Segments are visited in time order and the query stops once the limit is reached
+         *
+         * @param query Query with the selection criteria
+         * @return Selected log messages ordered by time
+         * @throw LogStoreError If the store could not be read
+         */
+        CNSTLN_API std::vector<Record> query(const Query& query);
+
+        /**
+         * @brief Return the number of stored messages
+         */
+        CNSTLN_API std::size_t size();
+
+    private:
+        /** Posting list with index entry numbers, entries written to disk are memory-mapped chunk by chunk */
+        struct PostingList {
+            std::vector<std::span<const std::uint32_t>> mapped;
+            std::size_t mapped_size {};
+            std::vector<std::uint32_t> appended;
+            void map(std::span<const std::uint32_t> list) {
+                mapped.push_back(list);
+                mapped_size += list.size();
+            }
+            std::size_t size() const { return mapped_size + appended.size(); }
+        };
+
+        /** Posting lists of a segment */
+        struct Postings {
+            std::map<std::uint32_t, PostingList> senders;
+            std::array<PostingList, std::to_underlying(log::Level::OFF)> levels;
+            std::map<std::uint32_t, PostingList> topics;
+        };
+
+        /** Segment of the store covering a time span */
+        struct Segment {
+            std::int64_t start {};
+            std::uint32_t entries {};
+            std::unique_ptr<data::MappedFile> postings_file;
+            Postings postings;
+            std::uint32_t postings_entries {};
+            std::unique_ptr<std::ofstream> index_file;
+            std::unique_ptr<std::ofstream> message_file;
+            std::uint64_t message_offset {};
+        };
+
+        std::filesystem::path segment_path(std::int64_t start, std::string_view extension) const;
+        Segment& get_segment(std::int64_t start);
+        void load_segment(std::int64_t start);
+        std::uint64_t map_postings(Segment& segment) const;
+        void write_postings(Segment& segment) const;
+        std::uint32_t intern(std::string_view str);
+        std::optional<std::uint32_t> find_string(std::string_view str) const;
+
+    private:
+        /** Number of entries after which the posting lists of a segment are written to disk */
+        static constexpr std::uint32_t postings_chunk_entries {1U << 20U};
+
+        std::filesystem::path directory_;
+        std::chrono::seconds segment_duration_;
+
+        std::mutex mutex_;
+        std::map<std::int64_t, Segment> segments_;
+
+        std::vector<std::string> strings_;
+        std::map<std::string, std::uint32_t, std::less<>> string_ids_;
+        std::ofstream strings_file_;
+    };
+
+} // namespace constellation::listener
@@ -0,0 +1,234 @@
+/**
+ * @file
+ * @brief MetricsHistory implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "MetricsHistory.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "constellation/core/metrics/Metric.hpp"
+
+using namespace constellation::listener;
+using namespace constellation::metrics;
+
+namespace {
+    template <typename T> std::optional<double> to_double(const T& value) {
+        if constexpr(std::is_same_v<T, bool> || std::is_same_v<T, std::int64_t> || std::is_same_v<T, double>) {
+            return static_cast<double>(value);
+        } else {
+            return std::nullopt;
+        }
+    }
+} // namespace
+
+template <typename T> void MetricsHistory::RingBuffer<T>::push_back(const T& value) {
+    if(size_ == capacity_) {
+        // Overwrite oldest element
+        buffer_[first_] = value;
+        first_ = (first_ + 1) % capacity_;
+        truncated_ = true;
+        return;
+    }
+    const auto pos = (first_ + size_) % capacity_;
+    if(pos == buffer_.size()) {
+        buffer_.push_back(value);
+    } else {
+        buffer_[pos] = value;
+    }
+    ++size_;
+}
+
+template <typename T> void MetricsHistory::RingBuffer<T>::pop_front() {
+    first_ = (first_ + 1) % capacity_;
+    --size_;
+    truncated_ = true;
+}
+
+MetricsHistory::Series::Series(const Retention& retention, std::string unit)
+    : unit(std::move(unit)), raw(std::max<std::size_t>(retention.raw_samples, 1)),
+      seconds(std::max<std::size_t>(retention.seconds, 1)), minutes(std::max<std::size_t>(retention.minutes, 1)) {}
+
+MetricsHistory::MetricsHistory() : MetricsHistory(Retention()) {}
+
+MetricsHistory::MetricsHistory(Retention retention) : retention_(retention) {}
+
+MetricsHistory::Series& MetricsHistory::get_series(std::string_view sender, std::string_view metric, std::string_view unit) {
+    auto sender_it = series_.find(sender);
+    if(sender_it == series_.end()) {
+        sender_it = series_.emplace(sender, std::map<std::string, Series, std::less<>>()).first;
+    }
+    auto metric_it = sender_it->second.find(metric);
+    if(metric_it == sender_it->second.end()) {
+        metric_it = sender_it->second.try_emplace(std::string(metric), retention_, std::string(unit)).first;
+    } else if(!unit.empty()) {
+        metric_it->second.unit = unit;
+    }
+    return metric_it->second;
+}
+
+void MetricsHistory::append_to(Series& series, std::chrono::system_clock::time_point time, double value) const {
+    // Raw samples: drop samples older than the raw time span relative to the most recent sample
+    const auto latest = series.raw.empty() ? time : std::max(time, series.raw.back().first);
+    while(!series.raw.empty() && series.raw.front().first < latest - retention_.raw_duration) {
+        series.raw.pop_front();
+    }
+    if(time >= latest - retention_.raw_duration) {
+        series.raw.push_back({time, value});
+    }
+
+    // Aggregates: start a new aggregate or merge into the most recent one
+    const auto aggregate = [&](RingBuffer<Aggregate>& tier, std::chrono::system_clock::time_point start) {
+        if(tier.empty() || start > tier.back().start) {
+            tier.push_back({start, value, value, value, 1});
+        } else {
+            auto& last = tier.back();
+            last.min = std::min(last.min, value);
+            last.max = std::max(last.max, value);
+            last.sum += value;
+            ++last.count;
+        }
+    };
+    aggregate(series.seconds, std::chrono::floor<std::chrono::seconds>(time));
+    aggregate(series.minutes, std::chrono::floor<std::chrono::minutes>(time));
+}
+
+bool MetricsHistory::append(std::string_view sender,
+                            std::chrono::system_clock::time_point time,
+                            const MetricValue& metric_value) {
+    const auto value = std::visit([](const auto& val) { return to_double(val); }, metric_value.getValue());
+    if(!value.has_value()) {
+        return false;
+    }
+
+    const auto& metric = metric_value.getMetric();
+    const std::lock_guard lock {mutex_};
+    append_to(get_series(sender, metric->name(), metric->unit()), time, value.value());
+    return true;
+}
+
+void MetricsHistory::append(std::string_view sender,
+                            std::string_view metric,
+                            std::chrono::system_clock::time_point time,
+                            double value) {
+    const std::lock_guard lock {mutex_};
+    append_to(get_series(sender, metric, {}), time, value);
+}
+
+const MetricsHistory::Series* MetricsHistory::find_series(std::string_view sender, std::string_view metric) const {
+    const auto sender_it = series_.find(sender);
+    if(sender_it == series_.end()) {
+        return nullptr;
+    }
+    const auto metric_it = sender_it->second.find(metric);
+    return metric_it != sender_it->second.end() ? &metric_it->second : nullptr;
+}
+
+std::vector<MetricsHistory::Point> MetricsHistory::query(std::string_view sender,
+                                                         std::string_view metric,
+                                                         std::chrono::system_clock::time_point begin,
+                                                         std::chrono::system_clock::time_point end,
+                                                         std::optional<Resolution> resolution) const {
+    std::vector<Point> points {};
+    const std::lock_guard lock {mutex_};
+    const auto* series = find_series(sender, metric);
+    if(series == nullptr) {
+        return points;
+    }
+
+    // Select finest tier which either has not discarded any data yet or still covers the start of the range
+    if(!resolution.has_value()) {
+        if(!series->raw.empty() && (!series->raw.truncated() || series->raw.front().first <= begin)) {
+            resolution = Resolution::RAW;
+        } else if(!series->seconds.truncated() || series->seconds.front().start <= begin) {
+            resolution = Resolution::SECOND;
+        } else {
+            resolution = Resolution::MINUTE;
+        }
+    }
+
+    if(resolution.value() == Resolution::RAW) {
+        for(std::size_t pos = 0; pos < series->raw.size(); ++pos) {
+            const auto& [time, value] = series->raw[pos];
+            if(time >= begin && time < end) {
+                points.push_back({time, value, value, value, 1});
+            }
+        }
+        // Raw samples are stored in arrival order
+        std::ranges::stable_sort(points, {}, &Point::time);
+        return points;
+    }
+
+    const auto second_tier = (resolution.value() == Resolution::SECOND);
+    const auto& tier = second_tier ? series->seconds : series->minutes;
+    const std::chrono::system_clock::duration width = second_tier ? std::chrono::seconds(1) : std::chrono::minutes(1);
+    for(std::size_t pos = 0; pos < tier.size(); ++pos) {
+        const auto& aggregate = tier[pos];
+        // Include aggregates overlapping with the time range
+        if(aggregate.start + width > begin && aggregate.start < end) {
+            points.push_back({aggregate.start,
+                              aggregate.min,
+                              aggregate.max,
+                              aggregate.sum / static_cast<double>(aggregate.count),
+                              aggregate.count});
+        }
+    }
+    return points;
+}
+
+std::optional<MetricsHistory::Point> MetricsHistory::getLatest(std::string_view sender, std::string_view metric) const {
+    const std::lock_guard lock {mutex_};
+    const auto* series = find_series(sender, metric);
+    if(series == nullptr || series->raw.empty()) {
+        return std::nullopt;
+    }
+    const auto& [time, value] = series->raw.back();
+    return Point({time, value, value, value, 1});
+}
+
+std::string MetricsHistory::getUnit(std::string_view sender, std::string_view metric) const {
+    const std::lock_guard lock {mutex_};
+    const auto* series = find_series(sender, metric);
+    return series != nullptr ? series->unit : std::string();
+}
+
+std::map<std::string, std::set<std::string>> MetricsHistory::getMetrics() const {
+    std::map<std::string, std::set<std::string>> metrics {};
+    const std::lock_guard lock {mutex_};
+    for(const auto& [sender, sender_series] : series_) {
+        auto& names = metrics[sender];
+        for(const auto& [name, series] : sender_series) {
+            names.insert(name);
+        }
+    }
+    return metrics;
+}
+
+void MetricsHistory::removeSender(std::string_view sender) {
+    const std::lock_guard lock {mutex_};
+    const auto sender_it = series_.find(sender);
+    if(sender_it != series_.end()) {
+        series_.erase(sender_it);
+    }
+}
+
+void MetricsHistory::clear() {
+    const std::lock_guard lock {mutex_};
+    series_.clear();
+}
@@ -0,0 +1,223 @@
+/**
+ * @file
+ * @brief Time series storage for metric values with downsampling tiers
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "constellation/build.hpp"
+#include "constellation/core/metrics/Metric.hpp"
+
+namespace constellation::listener {
+
+    /**
+     * @brief Bounded time series storage for metric values
+     *
+     * Values are stored per sender and metric in three tiers of fixed-size ring buffers:
+     * - raw samples for the most recent time span (one minute by default),
+     * - one-second aggregates with minimum, maximum and mean,
+     * - one-minute aggregates with minimum, maximum and mean.
+     *
+     * Every sample is added to all tiers on arrival, such that appending is O(1) and memory usage is bounded by the
+     * retention settings independent of the sample rate. Time spans are evaluated against the sample times provided by the
+     * senders. Samples arriving out of order are merged into the most recent aggregate.
+     */
+    class CNSTLN_API MetricsHistory {
+    public:
+        /** Tier of the time series */
+        enum class Resolution : std::uint8_t {
+            /** Raw samples */
+            RAW,
+            /** One-second aggregates */
+            SECOND,
+            /** One-minute aggregates */
+            MINUTE,
+        };
+
+        /** Retention settings of the tiers */
+        struct Retention {
+            /** Time span for which raw samples are kept */
+            std::chrono::seconds raw_duration {60};
+            /** Maximum number of raw samples kept per metric */
+            std::size_t raw_samples {6000};
+            /** Number of one-second aggregates kept per metric */
+            std::size_t seconds {3600};
+            /** Number of one-minute aggregates kept per metric */
+            std::size_t minutes {1440};
+        };
+
+        /** Point of a time series, aggregates are identified by their start time */
+        struct Point {
+            std::chrono::system_clock::time_point time;
+            double min;
+            double max;
+            double mean;
+            std::size_t count;
+        };
+
+    public:
+        /**
+         * @brief Construct metrics history with default retention settings
+         */
+        CNSTLN_API MetricsHistory();
+
+        /**
+         * @brief Construct metrics history
+         *
+         * @param retention Retention settings of the tiers
+         */
+        CNSTLN_API MetricsHistory(Retention retention);
+
+        /**
+         * @brief Add a metric value to the history
+         *
+         * @note Only boolean and numeric values are stored
+         *
+         * @param sender Canonical name of the sender
+         * @param time Time at which the value was sampled
+         * @param metric_value Metric value
+         * @return True if the value was stored, false if the value is not numeric
+         */
+        CNSTLN_API bool append(std::string_view sender,
+                               std::chrono::system_clock::time_point time,
+                               const metrics::MetricValue& metric_value);
+
+        /**
+         * @brief Add a numeric value to the history
+         *
+         * @param sender Canonical name of the sender
+         * @param metric Name of the metric
+         * @param time Time at which the value was sampled
+         * @param value Value
+         */
+        CNSTLN_API void append(std::string_view sender,
+                               std::string_view metric,
+                               std::chrono::system_clock::time_point time,
+                               double value);
+
+        /**
+         * @brief Query a time series
+         *
+         * If no resolution is given, the finest tier which still covers the start of the requested time range is used.
+         *
+         * @param sender Canonical name of the sender
+         * @param metric Name of the metric
+         * @param begin Start of the time range (inclusive)
+         * @param end End of the time range (exclusive)
+         * @param resolution Tier to query
+         * @return Points of the time series ordered by time, empty if the metric is not known
+         */
+        CNSTLN_API std::vector<Point> query(std::string_view sender,
+                                            std::string_view metric,
+                                            std::chrono::system_clock::time_point begin,
+                                            std::chrono::system_clock::time_point end,
+                                            std::optional<Resolution> resolution = std::nullopt) const;
+
+        /**
+         * @brief Get the most recent value of a metric
+         *
+         * @param sender Canonical name of the sender
+         * @param metric Name of the metric
+         * @return Most recent raw sample if the metric is known
+         */
+        CNSTLN_API std::optional<Point> getLatest(std::string_view sender, std::string_view metric) const;
+
+        /**
+         * @brief Get the unit of a metric
+         *
+         * @param sender Canonical name of the sender
+         * @param metric Name of the metric
+         * @return Unit of the metric, empty if not known
+         */
+        CNSTLN_API std::string getUnit(std::string_view sender, std::string_view metric) const;
+
+        /**
+         * @brief Get all stored metrics
+         *
+         * @return Map with sender names and the names of their stored metrics
+         */
+        CNSTLN_API std::map<std::string, std::set<std::string>> getMetrics() const;
+
+        /**
+         * @brief Remove all stored metrics of a sender
+         *
+         * @param sender Canonical name of the sender
+         */
+        CNSTLN_API void removeSender(std::string_view sender);
+
+        /**
+         * @brief Remove all stored metrics
+         */
+        CNSTLN_API void clear();
+
+    private:
+        /** Fixed-capacity ring buffer overwriting the oldest element */
+        template <typename T> class RingBuffer {
+        public:
+            explicit RingBuffer(std::size_t capacity) : capacity_(capacity) { buffer_.reserve(capacity_); }
+            std::size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            T& operator[](std::size_t pos) { return buffer_[(first_ + pos) % capacity_]; }
+            const T& operator[](std::size_t pos) const { return buffer_[(first_ + pos) % capacity_]; }
+            T& back() { return (*this)[size_ - 1]; }
+            const T& back() const { return (*this)[size_ - 1]; }
+            const T& front() const { return (*this)[0]; }
+            /** Whether elements have been discarded since the buffer was created */
+            bool truncated() const { return truncated_; }
+            void push_back(const T& value);
+            void pop_front();
+
+        private:
+            std::vector<T> buffer_;
+            std::size_t capacity_;
+            std::size_t first_ {};
+            std::size_t size_ {};
+            bool truncated_ {false};
+        };
+
+        /** Aggregate over a time span */
+        struct Aggregate {
+            std::chrono::system_clock::time_point start;
+            double min;
+            double max;
+            double sum;
+            std::size_t count;
+        };
+
+        /** Time series of a single metric */
+        struct Series {
+            Series(const Retention& retention, std::string unit);
+            std::string unit;
+            RingBuffer<std::pair<std::chrono::system_clock::time_point, double>> raw;
+            RingBuffer<Aggregate> seconds;
+            RingBuffer<Aggregate> minutes;
+        };
+
+        CNSTLN_LOCAL Series& get_series(std::string_view sender, std::string_view metric, std::string_view unit);
+        CNSTLN_LOCAL void append_to(Series& series, std::chrono::system_clock::time_point time, double value) const;
+        CNSTLN_LOCAL const Series* find_series(std::string_view sender, std::string_view metric) const;
+
+    private:
+        Retention retention_;
+        mutable std::mutex mutex_;
+        std::map<std::string, std::map<std::string, Series, std::less<>>, std::less<>> series_;
+    };
+
+} // namespace constellation::listener
@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @brief MetricsListener implementation
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "MetricsListener.hpp"
+
+#include <cctype>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "constellation/core/log/log.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/core/utils/string.hpp"
+#include "constellation/listener/MetricsHistory.hpp"
+
+#include "CMDPListener.hpp"
+
+using namespace constellation::listener;
+using namespace constellation::message;
+using namespace constellation::utils;
+
+MetricsListener::MetricsListener(std::string_view log_topic, MetricsHistory::Retention retention)
+    : CMDPListener(log_topic, [this](CMDP1Message&& msg) { handle_message(std::move(msg)); }), history_(retention) {
+    // Subscribe to notifications:
+    CMDPListener::subscribeTopic("STAT?");
+}
+
+std::string MetricsListener::metric_topic(const std::string& metric) {
+    return "STAT/" + transform(metric, ::toupper);
+}
+
+void MetricsListener::subscribeMetric(const std::string& metric) {
+    LOG(BasePoolT::pool_logger_, DEBUG) << "Subscribing to metric " << std::quoted(metric);
+    CMDPListener::subscribeTopic(metric_topic(metric));
+}
+
+void MetricsListener::unsubscribeMetric(const std::string& metric) {
+    LOG(BasePoolT::pool_logger_, DEBUG) << "Unsubscribing from metric " << std::quoted(metric);
+    CMDPListener::unsubscribeTopic(metric_topic(metric));
+}
+
+void MetricsListener::handle_message(CMDP1Message&& msg) {
+    const auto stat_msg = CMDP1StatMessage(std::move(msg));
+    const auto& header = stat_msg.getHeader();
+    if(!history_.append(header.getSender(), header.getTime(), stat_msg.getMetric())) {
+        LOG(BasePoolT::pool_logger_, TRACE) << "Ignoring non-numeric value for metric "
+                                            << std::quoted(stat_msg.getMetric().getMetric()->name()) << " from "
+                                            << header.getSender();
+    }
+}
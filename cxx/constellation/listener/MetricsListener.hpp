@@ -0,0 +1,73 @@
+/**
+ * @file
+ * @brief Subscriber pool for CMDP metrics with time series storage
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "constellation/build.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/listener/CMDPListener.hpp"
+#include "constellation/listener/MetricsHistory.hpp"
+
+namespace constellation::listener {
+
+    /**
+     * @brief Listener storing received metric values in a downsampled time series history
+     *
+     * The history can be queried from any thread, e.g. for plotting in GUIs or for printing in command line tools.
+     */
+    class CNSTLN_API MetricsListener : public CMDPListener {
+    public:
+        /**
+         * @brief Construct metrics listener
+         *
+         * @param log_topic Logger topic to be used for this component
+         * @param retention Retention settings of the history tiers
+         */
+        CNSTLN_API MetricsListener(std::string_view log_topic, MetricsHistory::Retention retention = {});
+
+        /**
+         * @brief Subscribe to a metric
+         *
+         * @param metric Name of the metric, empty to subscribe to all metrics
+         */
+        CNSTLN_API void subscribeMetric(const std::string& metric);
+
+        /**
+         * @brief Unsubscribe from a metric
+         *
+         * @param metric Name of the metric, empty to unsubscribe from the subscription to all metrics
+         */
+        CNSTLN_API void unsubscribeMetric(const std::string& metric);
+
+        /**
+         * @brief Get the time series history of the received metrics
+         *
+         * @return Reference to the metrics history
+         */
+        CNSTLN_API MetricsHistory& getHistory() { return history_; }
+
+        /**
+         * @brief Get the time series history of the received metrics
+         *
+         * @return Const reference to the metrics history
+         */
+        CNSTLN_API const MetricsHistory& getHistory() const { return history_; }
+
+    private:
+        CNSTLN_LOCAL void handle_message(message::CMDP1Message&& msg);
+        CNSTLN_LOCAL static std::string metric_topic(const std::string& metric);
+
+    private:
+        MetricsHistory history_;
+    };
+
+} // namespace constellation::listener
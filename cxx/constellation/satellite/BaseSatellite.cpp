@@ -9,10 +9,13 @@
 
 #include "BaseSatellite.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
+#include <future>
 #include <map>
 #include <optional>
 #include <ranges>
@@ -34,6 +37,8 @@
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/heartbeat/HeartbeatManager.hpp"
 #include "constellation/core/log/log.hpp"
+#include "constellation/core/metrics/Metric.hpp"
+#include "constellation/core/metrics/stat.hpp"
 #include "constellation/core/message/CSCP1Message.hpp"
 #include "constellation/core/message/exceptions.hpp"
 #include "constellation/core/message/PayloadBuffer.hpp"
@@ -48,9 +53,8 @@
 #include "constellation/core/utils/std_future.hpp"
 #include "constellation/core/utils/string.hpp"
 #include "constellation/core/utils/thread.hpp"
+#include "constellation/core/utils/timers.hpp"
 #include "constellation/satellite/exceptions.hpp"
-#include "constellation/satellite/ReceiverSatellite.hpp"
-#include "constellation/satellite/TransmitterSatellite.hpp"
 
 using namespace constellation::config;
 using namespace constellation::heartbeat;
@@ -96,8 +100,30 @@ BaseSatellite::BaseSatellite(std::string_view type, std::string_view name)
     cscp_thread_ = std::jthread(std::bind_front(&BaseSatellite::cscp_loop, this));
     set_thread_name(cscp_thread_, "CSCP");
 
+    // Register metrics for transition timing
+    auto& metrics_manager = ManagerLocator::getMetricsManager();
+    metrics_manager.registerMetric(
+        "STARTING_USER_TIME", "ms", MetricType::LAST_VALUE, "Time spent in the user starting function");
+    metrics_manager.registerMetric(
+        "STARTING_FRAMEWORK_TIME", "ms", MetricType::LAST_VALUE, "Time spent in framework components during starting");
+    metrics_manager.registerMetric(
+        "STOPPING_USER_TIME", "ms", MetricType::LAST_VALUE, "Time spent in the user stopping function");
+    metrics_manager.registerMetric(
+        "STOPPING_FRAMEWORK_TIME", "ms", MetricType::LAST_VALUE, "Time spent in framework components during stopping");
+
     // Register state callback for extrasystoles
     fsm_.registerStateCallback("extrasystoles", [&](CSCP::State) { heartbeat_manager_.sendExtrasystole(); });
+
+    // Announce completion of asynchronous user commands
+    user_commands_.setJobCallback([&](std::uint64_t job_id, const CommandRegistry::JobResult& result) {
+        if(result.status == CommandRegistry::JobStatus::FINISHED) {
+            LOG(cscp_logger_, INFO) << "Command job " << job_id << " (" << result.command
+                                    << ") finished, returned: " << result.value.str();
+        } else {
+            LOG(cscp_logger_, WARNING) << "Command job " << job_id << " (" << result.command
+                                       << ") failed: " << result.error;
+        }
+    });
 }
 
 std::string BaseSatellite::getCanonicalName() const {
@@ -108,6 +134,10 @@ void BaseSatellite::join() {
     if(cscp_thread_.joinable()) {
         cscp_thread_.join();
     }
+
+    // Asynchronous commands might call members of derived classes, thus stop them before the satellite is destroyed
+    user_commands_.stopWorkers();
+
     fsm_.unregisterStateCallback("extrasystoles");
     ManagerLocator::getMetricsManager().unregisterMetrics();
 }
@@ -161,7 +191,7 @@ void BaseSatellite::send_reply(std::pair<CSCP1Message::Type, std::string> reply_
 }
 
 std::optional<std::tuple<std::pair<CSCP1Message::Type, std::string>, PayloadBuffer, Dictionary>>
-BaseSatellite::handle_standard_command(std::string_view command) {
+BaseSatellite::handle_standard_command(std::string_view command, const PayloadBuffer& payload) {
     std::pair<CSCP1Message::Type, std::string> return_verb {};
     PayloadBuffer return_payload {};
     Dictionary return_tags {};
@@ -234,6 +264,8 @@ BaseSatellite::handle_standard_command(std::string_view command) {
                                        "with the remote host ID as key and a list of services as value)";
         command_dict["_get_services"] = "Get services provided by the satellite (returned in payload as dictionary with the "
                                         "service identifier as key and the port on which it is offered as value)";
+        command_dict["_get_result"] = "Get result of an asynchronous command (payload: job identifier as MessagePack "
+                                      "integer, result returned in payload if finished)";
 
         // Append user commands
         const auto user_commands = user_commands_.describeCommands();
@@ -307,6 +339,47 @@ BaseSatellite::handle_standard_command(std::string_view command) {
         }
         break;
     }
+    case _get_result: {
+        std::optional<CommandRegistry::JobResult> result {};
+        std::uint64_t job_id {};
+        try {
+            job_id = Value::disassemble(payload).get<std::uint64_t>();
+            result = user_commands_.getResult(job_id);
+        } catch(const std::exception&) {
+            return_verb = {CSCP1Message::Type::INCOMPLETE, "Could not convert command payload to job identifier"};
+            break;
+        }
+
+        if(!result.has_value()) {
+            return_verb = {CSCP1Message::Type::INVALID, "Unknown command job " + to_string(job_id)};
+            break;
+        }
+
+        return_tags["command"] = result->command;
+        return_tags["finished"] = result->status != CommandRegistry::JobStatus::RUNNING;
+
+        using enum CommandRegistry::JobStatus;
+        switch(result->status) {
+        case RUNNING: {
+            return_verb = {CSCP1Message::Type::SUCCESS, "Command job " + to_string(job_id) + " still running"};
+            break;
+        }
+        case FINISHED: {
+            // Return the call value as payload only if it is not std::monostate
+            if(!std::holds_alternative<std::monostate>(result->value)) {
+                return_payload = result->value.assemble();
+            }
+            return_verb = {CSCP1Message::Type::SUCCESS, "Command returned: " + result->value.str()};
+            break;
+        }
+        case FAILED: {
+            return_verb = {CSCP1Message::Type::ERROR, "Command failed: " + result->error};
+            break;
+        }
+        default: std::unreachable();
+        }
+        break;
+    }
     case shutdown: {
         if(CSCP::is_shutdown_allowed(fsm_.getState())) {
             return_verb = {CSCP1Message::Type::SUCCESS, "Shutting down satellite"};
@@ -337,6 +410,15 @@ BaseSatellite::handle_user_command(std::string_view command, const PayloadBuffer
         }
 
         auto retval = user_commands_.call(fsm_.getState(), std::string(command), args);
+
+        // Asynchronous commands return the job identifier
+        if(user_commands_.isAsync(std::string(command))) {
+            LOG(cscp_logger_, DEBUG) << "User command \"" << command << "\" queued as job " << retval.str();
+            return_payload = retval.assemble();
+            return_verb = {CSCP1Message::Type::SUCCESS, "Command queued as job " + retval.str()};
+            return std::make_pair(return_verb, std::move(return_payload));
+        }
+
         LOG(cscp_logger_, DEBUG) << "User command \"" << command << "\" succeeded, packing return value.";
 
         // Return the call value as payload only if it is not std::monostate
@@ -396,12 +478,21 @@ void BaseSatellite::cscp_loop(const std::stop_token& stop_token) {
             // Try to decode as transition
             auto transition_command = enum_cast<CSCP::TransitionCommand>(command_string);
             if(transition_command.has_value()) {
+                // Asynchronous commands restricted to specific states need to complete before the state can change
+                const auto state_bound_jobs = user_commands_.countStateBoundJobs();
+                if(state_bound_jobs > 0) {
+                    std::string jobs_info {"Transition " + to_string(transition_command.value()) + " not possible while " +
+                                           to_string(state_bound_jobs) + " asynchronous command jobs are running"};
+                    LOG(cscp_logger_, WARNING) << jobs_info;
+                    send_reply({CSCP1Message::Type::INVALID, std::move(jobs_info)});
+                    continue;
+                }
                 send_reply(fsm_.reactCommand(transition_command.value(), message.getPayload()));
                 continue;
             }
 
             // Try to decode as other builtin (non-transition) commands
-            auto standard_command_reply = handle_standard_command(command_string);
+            auto standard_command_reply = handle_standard_command(command_string, message.getPayload());
             if(standard_command_reply.has_value()) {
                 send_reply(std::get<0>(standard_command_reply.value()),
                            std::move(std::get<1>(standard_command_reply.value())),
@@ -488,6 +579,89 @@ void BaseSatellite::apply_internal_config(const Configuration& config) {
     if(config.has("_allow_departure")) {
         heartbeat_manager_.allowDeparture(config.get<bool>("_allow_departure"));
     }
+
+    if(config.has("_parallel_starting")) {
+        parallel_starting_ = config.get<bool>("_parallel_starting");
+        LOG(logger_, DEBUG) << (parallel_starting_ ? "Enabled" : "Disabled")
+                            << " preparation of framework components in parallel to starting";
+    }
+}
+
+void BaseSatellite::register_role(RoleHooks hooks) {
+    LOG(logger_, DEBUG) << "Registering framework hooks of role " << hooks.name;
+    const auto role_name = hooks.name;
+
+    // Resolve ordering constraints, keeping the registration order where unconstrained
+    auto pending = roles_;
+    pending.push_back(std::move(hooks));
+    std::vector<RoleHooks> sorted {};
+    sorted.reserve(pending.size());
+    while(!pending.empty()) {
+        const auto is_pending = [&](const std::string& name) {
+            return std::ranges::any_of(pending, [&](const RoleHooks& role) { return role.name == name; });
+        };
+        const auto ready_it = std::ranges::find_if(
+            pending, [&](const RoleHooks& role) { return std::ranges::none_of(role.after, is_pending); });
+        if(ready_it == pending.end()) {
+            throw RuntimeError("Cyclic ordering constraints between satellite roles");
+        }
+        sorted.push_back(std::move(*ready_it));
+        pending.erase(ready_it);
+    }
+    roles_ = std::move(sorted);
+
+    // Register metrics for timing of the role
+    const auto role_upper = transform(role_name, ::toupper);
+    auto& metrics_manager = ManagerLocator::getMetricsManager();
+    metrics_manager.registerMetric("STARTING_" + role_upper + "_TIME",
+                                   "ms",
+                                   MetricType::LAST_VALUE,
+                                   "Time spent in " + role_name + " components during starting");
+    metrics_manager.registerMetric("STOPPING_" + role_upper + "_TIME",
+                                   "ms",
+                                   MetricType::LAST_VALUE,
+                                   "Time spent in " + role_name + " components during stopping");
+}
+
+template <auto Hook, typename... Args>
+void BaseSatellite::execute_role_hooks(std::string_view transition,
+                                       std::vector<std::chrono::nanoseconds>& durations,
+                                       Args&... args) {
+    durations.resize(roles_.size());
+    for(std::size_t idx = 0; idx < roles_.size(); ++idx) {
+        const auto& hook = roles_[idx].*Hook;
+        if(!hook) {
+            continue;
+        }
+        LOG(logger_, TRACE) << "Executing " << transition << " hook of role " << roles_[idx].name;
+        StopwatchTimer timer {};
+        timer.start();
+        hook(args...);
+        timer.stop();
+        durations[idx] += timer.duration();
+    }
+}
+
+void BaseSatellite::report_transition_timing(std::string_view transition,
+                                             std::chrono::nanoseconds user_duration,
+                                             const std::vector<std::chrono::nanoseconds>& role_durations) {
+    const auto transition_upper = transform(transition, ::toupper);
+    std::chrono::nanoseconds framework_duration {};
+    std::string breakdown {};
+    for(std::size_t idx = 0; idx < role_durations.size(); ++idx) {
+        const auto role_ms = std::chrono::duration_cast<std::chrono::milliseconds>(role_durations[idx]);
+        framework_duration += role_durations[idx];
+        breakdown += (breakdown.empty() ? "" : ", ") + roles_[idx].name + ": " + to_string(role_ms);
+        STAT(transition_upper + "_" + transform(roles_[idx].name, ::toupper) + "_TIME", role_ms.count());
+    }
+
+    const auto user_ms = std::chrono::duration_cast<std::chrono::milliseconds>(user_duration);
+    const auto framework_ms = std::chrono::duration_cast<std::chrono::milliseconds>(framework_duration);
+    LOG(logger_, DEBUG) << "Transition " << transition << " took " << user_ms << " in user code and " << framework_ms
+                        << " in framework components" << (breakdown.empty() ? "" : " (" + breakdown + ")");
+
+    STAT(transition_upper + "_USER_TIME", user_ms.count());
+    STAT(transition_upper + "_FRAMEWORK_TIME", framework_ms.count());
 }
 
 void BaseSatellite::initializing_wrapper(Configuration&& config) {
@@ -495,15 +669,8 @@ void BaseSatellite::initializing_wrapper(Configuration&& config) {
 
     initializing(config);
 
-    auto* receiver_ptr = dynamic_cast<ReceiverSatellite*>(this);
-    if(receiver_ptr != nullptr) {
-        receiver_ptr->ReceiverSatellite::initializing_receiver(config);
-    }
-
-    auto* transmitter_ptr = dynamic_cast<TransmitterSatellite*>(this);
-    if(transmitter_ptr != nullptr) {
-        transmitter_ptr->TransmitterSatellite::initializing_transmitter(config);
-    }
+    std::vector<std::chrono::nanoseconds> role_durations {};
+    execute_role_hooks<&RoleHooks::initializing>("initializing", role_durations, config);
 
     // Store config after initializing
     store_config(std::move(config));
@@ -522,50 +689,76 @@ void BaseSatellite::reconfiguring_wrapper(const Configuration& partial_config) {
 
     reconfiguring(partial_config);
 
-    auto* receiver_ptr = dynamic_cast<ReceiverSatellite*>(this);
-    if(receiver_ptr != nullptr) {
-        receiver_ptr->ReceiverSatellite::reconfiguring_receiver(partial_config);
-    }
-
-    auto* transmitter_ptr = dynamic_cast<TransmitterSatellite*>(this);
-    if(transmitter_ptr != nullptr) {
-        transmitter_ptr->TransmitterSatellite::reconfiguring_transmitter(partial_config);
-    }
+    std::vector<std::chrono::nanoseconds> role_durations {};
+    execute_role_hooks<&RoleHooks::reconfiguring>("reconfiguring", role_durations, partial_config);
 
     // Update stored config after reconfigure
     update_config(partial_config);
 }
 
 void BaseSatellite::starting_wrapper(std::string run_identifier) {
-    starting(run_identifier);
+    const std::string_view run_identifier_view = run_identifier;
+    std::vector<std::chrono::nanoseconds> role_durations {};
 
-    auto* receiver_ptr = dynamic_cast<ReceiverSatellite*>(this);
-    if(receiver_ptr != nullptr) {
-        receiver_ptr->ReceiverSatellite::starting_receiver();
-    }
+    // Framework preparations independent of the user starting function
+    const auto prepare_framework = [&]() {
+        execute_role_hooks<&RoleHooks::prepare_starting>(
+            "starting", role_durations, run_identifier_view, config_, parallel_starting_);
+    };
+
+    // Reset run state which the user starting function might modify before anything runs in parallel to it
+    execute_role_hooks<&RoleHooks::pre_starting>("starting", role_durations, run_identifier_view);
+
+    StopwatchTimer user_timer {};
 
-    auto* transmitter_ptr = dynamic_cast<TransmitterSatellite*>(this);
-    if(transmitter_ptr != nullptr) {
-        transmitter_ptr->TransmitterSatellite::starting_transmitter(run_identifier, config_);
+    if(parallel_starting_) {
+        LOG(logger_, DEBUG) << "Starting: preparing framework components in parallel";
+        auto framework_future = std::async(std::launch::async, prepare_framework);
+        try {
+            user_timer.start();
+            starting(run_identifier);
+            user_timer.stop();
+            framework_future.get();
+        } catch(...) {
+            // Wait for framework preparations and release held messages before propagating exception
+            if(framework_future.valid()) {
+                framework_future.wait();
+            }
+            execute_role_hooks<&RoleHooks::release_starting>("starting", role_durations);
+            throw;
+        }
+        // Pass messages received in the meantime to the user
+        execute_role_hooks<&RoleHooks::release_starting>("starting", role_durations);
+    } else {
+        user_timer.start();
+        starting(run_identifier);
+        user_timer.stop();
+        prepare_framework();
     }
 
+    // Hooks after user starting, e.g. BOR is sent after user starting since BOR tags might be set there
+    execute_role_hooks<&RoleHooks::starting>("starting", role_durations);
+
+    report_transition_timing("starting", user_timer.duration(), role_durations);
+
     // Store run identifier
     run_identifier_ = std::move(run_identifier);
 }
 
 void BaseSatellite::stopping_wrapper() {
-    // stopping from receiver needs to come first to wait for all EORs
-    auto* receiver_ptr = dynamic_cast<ReceiverSatellite*>(this);
-    if(receiver_ptr != nullptr) {
-        receiver_ptr->ReceiverSatellite::stopping_receiver();
-    }
+    StopwatchTimer user_timer {};
+    std::vector<std::chrono::nanoseconds> role_durations {};
+
+    // Hooks before user stopping, e.g. stopping from receiver needs to come first to wait for all EORs
+    execute_role_hooks<&RoleHooks::pre_stopping>("stopping", role_durations);
 
+    user_timer.start();
     stopping();
+    user_timer.stop();
 
-    auto* transmitter_ptr = dynamic_cast<TransmitterSatellite*>(this);
-    if(transmitter_ptr != nullptr) {
-        transmitter_ptr->TransmitterSatellite::stopping_transmitter();
-    }
+    execute_role_hooks<&RoleHooks::stopping>("stopping", role_durations);
+
+    report_transition_timing("stopping", user_timer.duration(), role_durations);
 }
 
 void BaseSatellite::running_wrapper(const std::stop_token& stop_token) {
@@ -573,28 +766,21 @@ void BaseSatellite::running_wrapper(const std::stop_token& stop_token) {
 }
 
 void BaseSatellite::interrupting_wrapper(CSCP::State previous_state) {
-    // Interrupting from receiver needs to come first to wait for all EORs
-    auto* receiver_ptr = dynamic_cast<ReceiverSatellite*>(this);
-    if(receiver_ptr != nullptr) {
-        LOG(logger_, DEBUG) << "Interrupting: execute interrupting_receiver";
-        receiver_ptr->ReceiverSatellite::interrupting_receiver(previous_state);
-    }
+    std::vector<std::chrono::nanoseconds> role_durations {};
+
+    // Hooks before user interrupting, e.g. interrupting from receiver needs to come first to wait for all EORs
+    execute_role_hooks<&RoleHooks::pre_interrupting>("interrupting", role_durations, previous_state);
 
     interrupting(previous_state);
 
-    auto* transmitter_ptr = dynamic_cast<TransmitterSatellite*>(this);
-    if(transmitter_ptr != nullptr) {
-        LOG(logger_, DEBUG) << "Interrupting: execute interrupting_transmitter";
-        transmitter_ptr->TransmitterSatellite::interrupting_transmitter(previous_state);
-    }
+    execute_role_hooks<&RoleHooks::interrupting>("interrupting", role_durations, previous_state);
 }
 
 void BaseSatellite::failure_wrapper(CSCP::State previous_state) {
-    // failure from receiver needs to come first to stop BasePool thread
-    auto* receiver_ptr = dynamic_cast<ReceiverSatellite*>(this);
-    if(receiver_ptr != nullptr) {
-        receiver_ptr->ReceiverSatellite::failure_receiver();
-    }
+    std::vector<std::chrono::nanoseconds> role_durations {};
+
+    // Hooks before user failure, e.g. failure from receiver needs to come first to stop BasePool thread
+    execute_role_hooks<&RoleHooks::pre_failure>("failure", role_durations);
 
     failure(previous_state);
 }
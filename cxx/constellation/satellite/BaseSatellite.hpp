@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <optional>
 #include <stop_token>
 #include <string>
@@ -16,6 +18,7 @@
 #include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <zmq.hpp>
 
@@ -37,6 +40,55 @@ namespace constellation::satellite {
     protected:
         BaseSatellite(std::string_view type, std::string_view name);
 
+        /**
+         * @brief Framework hooks of a satellite role
+         *
+         * Satellite roles such as data receivers or data transmitters provide framework components which are executed by
+         * the transition wrappers around the user transition functions. Each hook is optional and is executed either before
+         * or after the corresponding user function. Hooks of different roles are executed in registration order unless
+         * constrained via `after`.
+         */
+        struct RoleHooks {
+            /** Name of the role, used for logging and timing metrics */
+            std::string name;
+            /** Names of roles whose hooks have to be executed before the hooks of this role */
+            std::vector<std::string> after {};
+            /** Executed after the user initializing function */
+            std::function<void(config::Configuration&)> initializing {};
+            /** Executed after the user reconfiguring function */
+            std::function<void(const config::Configuration&)> reconfiguring {};
+            /** Executed before the user starting function, also if preparations are executed in parallel to it */
+            std::function<void(std::string_view run_identifier)> pre_starting {};
+            /** Executed after the user starting function, or in parallel to it if `parallel` is true */
+            std::function<void(std::string_view run_identifier, const config::Configuration& config, bool parallel)>
+                prepare_starting {};
+            /** Executed after the parallel preparations and the user starting function finished or failed */
+            std::function<void()> release_starting {};
+            /** Executed after the user starting function and the preparations finished */
+            std::function<void()> starting {};
+            /** Executed before the user stopping function */
+            std::function<void()> pre_stopping {};
+            /** Executed after the user stopping function */
+            std::function<void()> stopping {};
+            /** Executed before the user interrupting function */
+            std::function<void(protocol::CSCP::State)> pre_interrupting {};
+            /** Executed after the user interrupting function */
+            std::function<void(protocol::CSCP::State)> interrupting {};
+            /** Executed before the user failure function */
+            std::function<void()> pre_failure {};
+        };
+
+        /**
+         * @brief Register the framework hooks of a satellite role
+         *
+         * The execution order of all registered roles is resolved once on registration. Roles are required to register
+         * their hooks in their constructor.
+         *
+         * @param hooks Hooks of the role
+         * @throw RuntimeError If the ordering constraints between roles are cyclic
+         */
+        void register_role(RoleHooks hooks);
+
     public:
         /**
          * @brief Destruct base satellite
@@ -118,7 +170,8 @@ namespace constellation::satellite {
         /**
          * @brief Join CSCP processing thread
          *
-         * Join the CSCP processing thread, which happens when the satellite is shut down or terminated.
+         * Join the CSCP processing thread, which happens when the satellite is shut down or terminated. Afterwards, the
+         * workers of asynchronous user commands are stopped. This needs to be called before the satellite is destroyed.
          */
         void join();
 
@@ -150,11 +203,12 @@ namespace constellation::satellite {
          * @brief Handle standard CSCP commands
          *
          * @param command Command string to try to handle as standard command
+         * @param payload CSCP message payload sent with command
          * @return CSCP reply verb and message payload if a standard command
          */
         std::optional<
             std::tuple<std::pair<message::CSCP1Message::Type, std::string>, message::PayloadBuffer, config::Dictionary>>
-        handle_standard_command(std::string_view command);
+        handle_standard_command(std::string_view command, const message::PayloadBuffer& payload);
 
         /**
          * @brief Handle user CSCP commands
@@ -188,6 +242,29 @@ namespace constellation::satellite {
          */
         void update_config(const config::Configuration& partial_config);
 
+        /**
+         * @brief Execute a hook of all registered roles
+         *
+         * @param transition Name of the transitional state
+         * @param durations Time spent per role, accumulated for every executed hook
+         * @param args Arguments passed to the hooks
+         */
+        template <auto Hook, typename... Args>
+        void execute_role_hooks(std::string_view transition,
+                                std::vector<std::chrono::nanoseconds>& durations,
+                                Args&... args);
+
+        /**
+         * @brief Report the time spent in user code and in framework components during a transition
+         *
+         * @param transition Name of the transitional state
+         * @param user_duration Time spent in the user transition function
+         * @param role_durations Time spent in the framework components per role
+         */
+        void report_transition_timing(std::string_view transition,
+                                      std::chrono::nanoseconds user_duration,
+                                      const std::vector<std::chrono::nanoseconds>& role_durations);
+
         /**
          * @brief Set a new status message
          */
@@ -231,12 +308,15 @@ namespace constellation::satellite {
         log::Logger cscp_logger_;
         std::jthread cscp_thread_;
         bool support_reconfigure_ {false};
+        bool parallel_starting_ {false};
         std::string status_;
         config::Configuration config_;
         std::string run_identifier_;
 
         CommandRegistry user_commands_;
         heartbeat::HeartbeatManager heartbeat_manager_;
+
+        std::vector<RoleHooks> roles_;
     };
 
 } // namespace constellation::satellite
@@ -9,13 +9,25 @@
 
 #include "CommandRegistry.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
 
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/config/Value.hpp"
 #include "constellation/core/protocol/CSCP_definitions.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/thread.hpp"
 #include "constellation/satellite/exceptions.hpp"
 
 using namespace constellation;
@@ -43,10 +55,158 @@ config::Value CommandRegistry::call(State state, const std::string& name, const
         throw MissingUserCommandArguments(name_lc, cmd->second.nargs, args.size());
     }
 
+    // Queue asynchronous commands and return job identifier:
+    if(cmd->second.async) {
+        return config::Value::set(queue_job(name_lc, cmd->second.func, args));
+    }
+
     // Call the command:
     return cmd->second.func(args);
 }
 
+bool CommandRegistry::isAsync(const std::string& name) const {
+    const auto cmd = commands_.find(transform(name, ::tolower));
+    return cmd != commands_.end() && cmd->second.async;
+}
+
+std::optional<CommandRegistry::JobResult> CommandRegistry::getResult(std::uint64_t job_id) {
+    const std::lock_guard jobs_lock {jobs_mutex_};
+    const auto result_it = job_results_.find(job_id);
+    if(result_it == job_results_.end()) {
+        return std::nullopt;
+    }
+
+    auto result = result_it->second;
+
+    // Remove results of completed jobs once retrieved
+    if(result.status != JobStatus::RUNNING) {
+        job_results_.erase(result_it);
+    }
+    return result;
+}
+
+std::size_t CommandRegistry::countStateBoundJobs() {
+    const std::lock_guard jobs_lock {jobs_mutex_};
+    return std::ranges::count_if(job_results_, [this](const auto& job_result) {
+        if(job_result.second.status != JobStatus::RUNNING) {
+            return false;
+        }
+        const auto cmd = commands_.find(job_result.second.command);
+        return cmd != commands_.end() && !cmd->second.valid_states.empty();
+    });
+}
+
+void CommandRegistry::setJobCallback(JobCallback callback) {
+    const std::lock_guard jobs_lock {jobs_mutex_};
+    job_callback_ = std::move(callback);
+}
+
+std::uint64_t CommandRegistry::queue_job(const std::string& name, Call func, config::List args) {
+    std::unique_lock jobs_lock {jobs_mutex_};
+
+    // Jobs cannot be executed anymore once the workers are stopped
+    if(workers_stopped_) {
+        const auto job_id = ++next_job_id_;
+        job_results_.emplace(job_id, JobResult {name, JobStatus::FAILED, {}, "Command workers are stopped"});
+        return job_id;
+    }
+
+    // Start worker threads on first use
+    if(workers_.empty()) {
+        for(std::size_t n = 0; n < async_workers_; ++n) {
+            auto& worker = workers_.emplace_back(std::bind_front(&CommandRegistry::worker_loop, this));
+            set_thread_name(worker, "CmdWorker" + to_string(n));
+        }
+    }
+
+    // Drop oldest completed results to keep the number of stored results bounded
+    for(auto result_it = job_results_.begin(); job_results_.size() >= max_job_results_ && result_it != job_results_.end();) {
+        if(result_it->second.status != JobStatus::RUNNING) {
+            result_it = job_results_.erase(result_it);
+        } else {
+            ++result_it;
+        }
+    }
+
+    const auto job_id = ++next_job_id_;
+    job_results_.emplace(job_id, JobResult {name, JobStatus::RUNNING, {}, {}});
+    job_queue_.emplace_back(job_id, std::move(func), std::move(args));
+    jobs_lock.unlock();
+
+    jobs_cv_.notify_one();
+    return job_id;
+}
+
+void CommandRegistry::stopWorkers() {
+    std::unique_lock jobs_lock {jobs_mutex_};
+    workers_stopped_ = true;
+
+    // Queued jobs which did not start yet are discarded
+    for(const auto& job : job_queue_) {
+        auto result_it = job_results_.find(std::get<0>(job));
+        if(result_it != job_results_.end()) {
+            result_it->second.status = JobStatus::FAILED;
+            result_it->second.error = "Command workers are stopped";
+        }
+    }
+    job_queue_.clear();
+    auto workers = std::move(workers_);
+    workers_.clear();
+    jobs_lock.unlock();
+
+    // Request stop and wait for running jobs to complete
+    for(auto& worker : workers) {
+        worker.request_stop();
+    }
+    workers.clear();
+}
+
+void CommandRegistry::worker_loop(const std::stop_token& stop_token) {
+    while(!stop_token.stop_requested()) {
+        std::unique_lock jobs_lock {jobs_mutex_};
+
+        // Wait for a job or a stop request
+        if(!jobs_cv_.wait(jobs_lock, stop_token, [this]() { return !job_queue_.empty(); })) {
+            break;
+        }
+
+        auto [job_id, func, args] = std::move(job_queue_.front());
+        job_queue_.pop_front();
+        jobs_lock.unlock();
+
+        // Execute the command outside the lock
+        auto status = JobStatus::FINISHED;
+        config::Value value {};
+        std::string error {};
+        try {
+            value = func(args);
+        } catch(const std::exception& e) {
+            status = JobStatus::FAILED;
+            error = e.what();
+        } catch(...) {
+            status = JobStatus::FAILED;
+            error = "Unknown exception";
+        }
+
+        // Store result and notify
+        jobs_lock.lock();
+        auto result_it = job_results_.find(job_id);
+        if(result_it == job_results_.end()) {
+            continue;
+        }
+        result_it->second.status = status;
+        result_it->second.value = std::move(value);
+        result_it->second.error = std::move(error);
+        const auto result = result_it->second;
+        const auto callback = job_callback_;
+        jobs_lock.unlock();
+
+        if(callback) {
+            callback(job_id, result);
+        }
+    }
+}
+
 std::map<std::string, std::string> CommandRegistry::describeCommands() const {
     std::map<std::string, std::string> cmds {};
 
@@ -59,6 +219,12 @@ std::map<std::string, std::string> CommandRegistry::describeCommands() const {
         description += to_string(cmd.second.nargs);
         description += " arguments.";
 
+        // Note asynchronous execution
+        if(cmd.second.async) {
+            description += "\nThis command is executed asynchronously, it returns a job identifier which can be passed to "
+                           "_get_result to retrieve the result.";
+        }
+
         // Append allowed states (empty means allowed from all states)
         if(!cmd.second.valid_states.empty()) {
             description += "\nThis command can only be called in the following states: ";
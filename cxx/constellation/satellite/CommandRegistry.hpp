@@ -10,15 +10,24 @@
 #pragma once
 
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <initializer_list>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "constellation/build.hpp"
 #include "constellation/core/config/Dictionary.hpp"
@@ -34,9 +43,52 @@ namespace constellation::satellite {
      * Class to allow registration and execution of arbitrary commands based on their name. The commands can require any
      * number of arguments that can be converted from std::string. Return values are also possible as long as a conversion
      * to std::string is possible.
+     *
+     * Commands can be registered as asynchronous. Such commands are executed on a small pool of worker threads and their
+     * call returns a job identifier immediately, which can be used to retrieve the result later via `getResult()`.
      */
     class CommandRegistry {
     public:
+        /** Status of an asynchronous command job */
+        enum class JobStatus : std::uint8_t {
+            RUNNING,
+            FINISHED,
+            FAILED,
+        };
+
+        /**
+         * @struct JobResult
+         * @brief Struct holding the status and result of an asynchronous command job
+         */
+        struct JobResult {
+            /** Name of the command executed in this job */
+            std::string command;
+
+            /** Status of the job */
+            JobStatus status;
+
+            /** Return value of the command if finished */
+            config::Value value;
+
+            /** Error message if failed */
+            std::string error;
+        };
+
+        /** Callback invoked when an asynchronous command job has completed */
+        using JobCallback = std::function<void(std::uint64_t, const JobResult&)>;
+
+    public:
+        CommandRegistry() = default;
+        ~CommandRegistry() = default;
+
+        // No copy/move constructor/assignment
+        /// @cond doxygen_suppress
+        CommandRegistry(const CommandRegistry& other) = delete;
+        CommandRegistry& operator=(const CommandRegistry& other) = delete;
+        CommandRegistry(CommandRegistry&& other) = delete;
+        CommandRegistry& operator=(CommandRegistry&& other) = delete;
+        /// @endcond
+
         /**
          * @brief Register a command with arbitrary arguments from a functional
          *
@@ -44,6 +96,7 @@ namespace constellation::satellite {
          * @param description Description of the command
          * @param states States of the finite state machine in which this command can be called
          * @param func Functional containing the callable object
+         * @param async If the command should be executed asynchronously on the worker pool
          * @tparam R Return type
          * @tparam Args Argument types
          */
@@ -51,7 +104,8 @@ namespace constellation::satellite {
         void add(const std::string& name,
                  std::string description,
                  std::initializer_list<protocol::CSCP::State> states,
-                 std::function<R(Args...)> func);
+                 std::function<R(Args...)> func,
+                 bool async = false);
 
         /**
          * @brief Register a command with arbitrary arguments from a member function pointer and object pointer
@@ -61,6 +115,7 @@ namespace constellation::satellite {
          * @param states States of the finite state machine in which this command can be called
          * @param func Pointer to the member function of t to be called
          * @param t Pointer to the called object
+         * @param async If the command should be executed asynchronously on the worker pool
          * @tparam T Type of the called object
          * @tparam R Return type
          * @tparam Args Argument types
@@ -70,11 +125,13 @@ namespace constellation::satellite {
                  std::string description,
                  std::initializer_list<protocol::CSCP::State> states,
                  R (T::*func)(Args...),
-                 T* t);
+                 T* t,
+                 bool async = false);
 
         /**
          * @brief Calls a registered function with its arguments
-         * This method calls a registered function and returns the output of the function, or an empty string.
+         * This method calls a registered function and returns the output of the function, or an empty string. For
+         * asynchronous commands, the function is queued for execution on the worker pool and the job identifier is returned.
          *
          * @param state Current state of the finite state machine when this call was made
          * @param name Name of the command to be called
@@ -88,6 +145,49 @@ namespace constellation::satellite {
          */
         CNSTLN_API config::Value call(protocol::CSCP::State state, const std::string& name, const config::List& args);
 
+        /**
+         * @brief Check if a registered command is executed asynchronously
+         *
+         * @param name Name of the command
+         * @return True if the command is registered as asynchronous command, false otherwise
+         */
+        CNSTLN_API bool isAsync(const std::string& name) const;
+
+        /**
+         * @brief Retrieve the result of an asynchronous command job
+         *
+         * Results of finished or failed jobs are removed from the registry once they have been retrieved.
+         *
+         * @param job_id Identifier of the job as returned by `call()`
+         * @return Job result if the job is known, empty optional otherwise
+         */
+        CNSTLN_API std::optional<JobResult> getResult(std::uint64_t job_id);
+
+        /**
+         * @brief Count the queued or running asynchronous jobs of commands restricted to specific states
+         *
+         * Such commands rely on the state of the finite state machine in which they were called, which must not change
+         * until they have completed.
+         *
+         * @return Number of queued or running jobs of commands with a list of allowed states
+         */
+        CNSTLN_API std::size_t countStateBoundJobs();
+
+        /**
+         * @brief Set callback invoked from the worker thread when an asynchronous command job has completed
+         *
+         * @param callback Callback receiving the job identifier and the job result
+         */
+        CNSTLN_API void setJobCallback(JobCallback callback);
+
+        /**
+         * @brief Stop the worker threads of asynchronous commands
+         *
+         * This waits for running jobs to complete and discards queued jobs. Since commands usually call members of the
+         * satellite, this needs to be called before the satellite is destroyed. Jobs queued afterwards fail immediately.
+         */
+        CNSTLN_API void stopWorkers();
+
         /**
          * @brief Generate map of commands with comprehensive description
          *
@@ -113,8 +213,26 @@ namespace constellation::satellite {
             std::size_t nargs;
             std::string description;
             std::set<protocol::CSCP::State> valid_states;
+            bool async;
         };
 
+        /**
+         * @brief Queue an asynchronous call on the worker pool
+         *
+         * @param name Name of the command
+         * @param func Command function to call
+         * @param args List of arguments
+         * @return Identifier of the queued job
+         */
+        std::uint64_t queue_job(const std::string& name, Call func, config::List args);
+
+        /**
+         * @brief Worker loop executing queued asynchronous jobs
+         *
+         * @param stop_token Stop token to interrupt the thread
+         */
+        void worker_loop(const std::stop_token& stop_token);
+
         template <typename T> static inline T to_argument(const config::Value& value);
         template <typename T> static inline config::Value convert(const T& value);
 
@@ -152,6 +270,22 @@ namespace constellation::satellite {
     private:
         // Map of registered commands
         std::unordered_map<std::string, Command> commands_;
+
+        // Number of worker threads and maximum number of results kept for asynchronous commands
+        static constexpr std::size_t async_workers_ {2};
+        static constexpr std::size_t max_job_results_ {64};
+
+        // Queue and results of asynchronous command jobs
+        std::mutex jobs_mutex_;
+        std::condition_variable_any jobs_cv_;
+        std::deque<std::tuple<std::uint64_t, Call, config::List>> job_queue_;
+        std::map<std::uint64_t, JobResult> job_results_;
+        std::uint64_t next_job_id_ {0};
+        JobCallback job_callback_;
+
+        // Worker threads, started when the first asynchronous job is queued (needs to be destroyed first)
+        std::vector<std::jthread> workers_;
+        bool workers_stopped_ {false};
     };
 
 } // namespace constellation::satellite
@@ -48,7 +48,8 @@ namespace constellation::satellite {
     inline void CommandRegistry::add(const std::string& name,
                                      std::string description,
                                      std::initializer_list<protocol::CSCP::State> states,
-                                     std::function<R(Args...)> func) {
+                                     std::function<R(Args...)> func,
+                                     bool async) {
         const auto name_lc = utils::transform(name, ::tolower);
         if(!protocol::CSCP::is_valid_command_name(name_lc)) {
             throw utils::LogicError("Command name is invalid");
@@ -63,7 +64,7 @@ namespace constellation::satellite {
         }
 
         const auto [it, success] = commands_.emplace(
-            name_lc, Command {generate_call(std::move(func)), sizeof...(Args), std::move(description), states});
+            name_lc, Command {generate_call(std::move(func)), sizeof...(Args), std::move(description), states, async});
 
         if(!success) {
             throw utils::LogicError("Command \"" + name_lc + "\" is already registered");
@@ -75,13 +76,17 @@ namespace constellation::satellite {
                                      std::string description,
                                      std::initializer_list<protocol::CSCP::State> states,
                                      R (T::*func)(Args...),
-                                     T* t) {
+                                     T* t,
+                                     bool async) {
         if(!func || !t) {
             throw utils::LogicError("Object and member function pointers must not be nullptr");
         }
-        add(name, std::move(description), states, std::function<R(Args...)>([=](Args... args) {
-                return (t->*func)(args...);
-            }));
+        add(
+            name,
+            std::move(description),
+            states,
+            std::function<R(Args...)>([=](Args... args) { return (t->*func)(args...); }),
+            async);
     }
 
 } // namespace constellation::satellite
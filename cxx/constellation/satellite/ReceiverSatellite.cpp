@@ -10,11 +10,16 @@
 #include "ReceiverSatellite.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <ios>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <ranges>
@@ -23,24 +28,39 @@
 #include <string_view>
 #include <thread>
 #include <utility>
+#include <vector>
+
+#include <asio/ip/address_v4.hpp>
+#include <asio/system_error.hpp>
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
 
 #include "constellation/core/chirp/Manager.hpp"
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/config/exceptions.hpp"
 #include "constellation/core/config/Value.hpp"
 #include "constellation/core/log/log.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
 #include "constellation/core/message/CHIRPMessage.hpp"
+#include "constellation/core/message/DataFeedback.hpp"
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/message/RetransmitBuffer.hpp"
 #include "constellation/core/metrics/Metric.hpp"
 #include "constellation/core/metrics/stat.hpp"
+#include "constellation/core/networking/asio_helpers.hpp"
+#include "constellation/core/networking/Datagram.hpp"
 #include "constellation/core/networking/exceptions.hpp"
+#include "constellation/core/networking/Port.hpp"
+#include "constellation/core/networking/zmq_helpers.hpp"
 #include "constellation/core/pools/BasePool.hpp"
 #include "constellation/core/protocol/CDTP_definitions.hpp"
 #include "constellation/core/protocol/CSCP_definitions.hpp"
+#include "constellation/core/utils/casts.hpp"
 #include "constellation/core/utils/enum.hpp"
 #include "constellation/core/utils/std_future.hpp"
 #include "constellation/core/utils/string.hpp"
-#include "constellation/core/utils/timers.hpp"
+#include "constellation/core/utils/thread.hpp"
 #include "constellation/satellite/exceptions.hpp"
 #include "constellation/satellite/Satellite.hpp"
 
@@ -57,7 +77,8 @@ using namespace std::chrono_literals;
 
 ReceiverSatellite::ReceiverSatellite(std::string_view type, std::string_view name)
     : Satellite(type, name),
-      BasePool("CDTP", [this](CDTP1Message&& message) { this->handle_cdtp_message(std::move(message)); }),
+      BasePool(
+          "CDTP", [this](CDTP1Message&& message) { this->handle_cdtp_message(std::move(message)); }, true),
       cdtp_logger_("CDTP") {
 
     register_timed_metric("BYTES_RECEIVED",
@@ -67,6 +88,76 @@ ReceiverSatellite::ReceiverSatellite(std::string_view type, std::string_view nam
                           10s,
                           {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
                           [this]() { return bytes_received_.load(); });
+    register_timed_metric("PAYLOAD_REALIGNMENTS",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Number of payload frames copied to aligned memory in the current run",
+                          10s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() { return payload_realignments_.load(); });
+    register_timed_metric("MESSAGES_RECOVERED",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Number of missing data messages recovered via retransmission in the current run",
+                          10s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() { return messages_recovered_.load(); });
+    register_timed_metric("QUEUE_DEPTH",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Number of data messages sent but not yet processed for each data transmitter",
+                          3s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() {
+                              return collect_data_transmitter_states<std::int64_t>([](const auto& data_transmitter_state) {
+                                  return static_cast<std::int64_t>(data_transmitter_state.queue_depth);
+                              });
+                          });
+    register_timed_metric("PROCESSING_LATENCY",
+                          "us",
+                          MetricType::LAST_VALUE,
+                          "Average processing time of recent messages for each data transmitter",
+                          3s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() {
+                              return collect_data_transmitter_states<std::int64_t>([](const auto& data_transmitter_state) {
+                                  return static_cast<std::int64_t>(
+                                      std::chrono::duration_cast<std::chrono::microseconds>(data_transmitter_state.latency)
+                                          .count());
+                              });
+                          });
+    register_timed_metric("LAGGING_TRANSMITTERS",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Data transmitters whose messages are queued longer than the lagging timeout",
+                          3s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() {
+                              const std::lock_guard data_transmitter_states_lock {data_transmitter_states_mutex_};
+                              std::vector<std::string> lagging_transmitters {};
+                              for(const auto& [data_transmitter, data_transmitter_state] : data_transmitter_states_) {
+                                  if(data_transmitter_state.lagging) {
+                                      lagging_transmitters.push_back(data_transmitter);
+                                  }
+                              }
+                              return lagging_transmitters;
+                          });
+
+    // Register receiver components as framework hooks
+    RoleHooks hooks {};
+    hooks.name = "receiver";
+    hooks.initializing = [this](Configuration& config) { initializing_receiver(config); };
+    hooks.reconfiguring = [this](const Configuration& partial_config) { reconfiguring_receiver(partial_config); };
+    hooks.prepare_starting = [this](std::string_view /*run_identifier*/, const Configuration& /*config*/, bool parallel) {
+        starting_receiver(parallel);
+    };
+    hooks.release_starting = [this]() { release_receiver(); };
+    // Stopping and interrupting need to come first to wait for all EORs
+    hooks.pre_stopping = [this]() { stopping_receiver(); };
+    hooks.pre_interrupting = [this](CSCP::State previous_state) { interrupting_receiver(previous_state); };
+    // Failure needs to come first to stop the BasePool thread
+    hooks.pre_failure = [this]() { failure_receiver(); };
+    register_role(std::move(hooks));
 }
 
 void ReceiverSatellite::validate_output_directory(const std::filesystem::path& path) {
@@ -183,13 +274,38 @@ void ReceiverSatellite::register_diskspace_metric(const std::filesystem::path& p
 }
 
 void ReceiverSatellite::running(const std::stop_token& stop_token) {
-    while(!stop_token.stop_requested()) {
-        // Check and rethrow exception from BasePool
-        checkPoolException();
+    // Wait until stop is requested or the BasePool thread threw an exception
+    std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
+    data_transmitter_states_cv_.wait(data_transmitter_states_lock, stop_token, [this]() { return pool_exception_; });
+    data_transmitter_states_lock.unlock();
+
+    // Check and rethrow exception from BasePool or datagram threads
+    check_receiver_exception();
+}
+
+void ReceiverSatellite::check_receiver_exception() {
+    std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
+    const auto datagram_exception = datagram_exception_;
+    data_transmitter_states_lock.unlock();
 
-        // Wait a bit to avoid hot loop
-        std::this_thread::sleep_for(100ms);
+    if(datagram_exception) {
+        // Stop remaining datagram threads and disconnect all connected sockets before propagating
+        stopPool();
+        datagram_threads_.clear();
+        std::rethrow_exception(datagram_exception);
     }
+    checkPoolException();
+}
+
+CDTP1Message ReceiverSatellite::decode_message(zmq::multipart_t& frames) {
+    return CDTP1Message::disassemble(frames, &sender_registry_);
+}
+
+void ReceiverSatellite::pool_exception_raised() {
+    std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
+    pool_exception_ = true;
+    data_transmitter_states_lock.unlock();
+    data_transmitter_states_cv_.notify_all();
 }
 
 bool ReceiverSatellite::should_connect(const chirp::DiscoveredService& service) {
@@ -197,6 +313,58 @@ bool ReceiverSatellite::should_connect(const chirp::DiscoveredService& service)
                                [=](const auto& data_tramsitter) { return service.host_id == MD5Hash(data_tramsitter); });
 }
 
+void ReceiverSatellite::message_handled(const chirp::DiscoveredService& service,
+                                        std::chrono::nanoseconds latency,
+                                        bool pending) {
+    const auto now = std::chrono::steady_clock::now();
+    const std::lock_guard data_transmitter_states_lock {data_transmitter_states_mutex_};
+    const auto data_transmitter_it = std::ranges::find_if(data_transmitter_states_, [&](const auto& data_transmitter_p) {
+        return data_transmitter_p.second.host_id == service.host_id;
+    });
+    if(data_transmitter_it == data_transmitter_states_.end()) {
+        return;
+    }
+    auto& data_transmitter_state = data_transmitter_it->second;
+
+    // Exponential moving average over recent messages
+    data_transmitter_state.latency += (latency - data_transmitter_state.latency) / 8;
+
+    // This receiver lags behind if messages are queued continuously for longer than the lagging timeout
+    if(!pending) {
+        data_transmitter_state.queued_since.reset();
+    } else if(!data_transmitter_state.queued_since.has_value()) {
+        data_transmitter_state.queued_since = now;
+    }
+    const auto lagging = data_transmitter_state.queued_since.has_value() &&
+                         now - data_transmitter_state.queued_since.value() > lagging_timeout_;
+    const auto lagging_changed = std::exchange(data_transmitter_state.lagging, lagging) != lagging;
+    LOG_IF(cdtp_logger_, WARNING, lagging_changed && lagging)
+        << "Lagging behind data stream of " << data_transmitter_it->first << ", messages queued for more than "
+        << lagging_timeout_;
+    LOG_IF(cdtp_logger_, INFO, lagging_changed && !lagging)
+        << "Caught up with data stream of " << data_transmitter_it->first;
+
+    // Exchange feedback regularly and immediately when starting or stopping to lag behind, members of a receiver group
+    // also report whenever their queue runs empty such that the transmitter knows how many messages they received
+    if(lagging_changed || now - data_transmitter_state.last_feedback >= DataFeedback::interval ||
+       (data_transmitter_state.group_size > 1 && !pending)) {
+        data_transmitter_state.last_feedback = now;
+        exchange_feedback(data_transmitter_it->first, data_transmitter_state);
+    }
+}
+
+template <typename T, typename F> std::vector<T> ReceiverSatellite::collect_data_transmitter_states(F projection) {
+    const std::lock_guard data_transmitter_states_lock {data_transmitter_states_mutex_};
+    std::vector<T> values {};
+    values.reserve(data_transmitters_.size());
+    for(const auto& data_transmitter : data_transmitters_) {
+        const auto data_transmitter_it = data_transmitter_states_.find(data_transmitter);
+        values.push_back(data_transmitter_it != data_transmitter_states_.end() ? projection(data_transmitter_it->second)
+                                                                                 : T());
+    }
+    return values;
+}
+
 void ReceiverSatellite::initializing_receiver(Configuration& config) {
     data_eor_timeout_ = std::chrono::seconds(config.get<std::uint64_t>("_eor_timeout", 10));
     LOG(cdtp_logger_, DEBUG) << "Timeout for EOR message " << data_eor_timeout_;
@@ -207,6 +375,17 @@ void ReceiverSatellite::initializing_receiver(Configuration& config) {
 
     allow_overwriting_ = config.get<bool>("_allow_overwriting", false);
     LOG(cdtp_logger_, DEBUG) << (allow_overwriting_ ? "Not allowing" : "Allowing") << " overwriting of files";
+
+    configure_payload_alignment(config);
+
+    retransmit_timeout_ = std::chrono::milliseconds(config.get<std::uint64_t>("_retransmit_timeout", 1000));
+    LOG(cdtp_logger_, DEBUG) << "Timeout for retransmission of missing messages " << retransmit_timeout_;
+
+    lagging_timeout_ = std::chrono::milliseconds(config.get<std::uint64_t>("_lagging_timeout", 1000));
+    LOG(cdtp_logger_, DEBUG) << "Timeout for queued messages before lagging behind " << lagging_timeout_;
+
+    udp_max_message_size_ = config.get<std::size_t>("_udp_max_message_size", DatagramReceiver::default_max_message_size);
+    LOG(cdtp_logger_, DEBUG) << "Maximum size of messages received via UDP " << udp_max_message_size_ << " bytes";
 }
 
 void ReceiverSatellite::reconfiguring_receiver(const Configuration& partial_config) {
@@ -221,36 +400,72 @@ void ReceiverSatellite::reconfiguring_receiver(const Configuration& partial_conf
         reset_data_transmitter_states();
         LOG(cdtp_logger_, INFO) << "Reconfigured to receive data from " << range_to_string(data_transmitters_);
     }
+
+    if(partial_config.has("_payload_alignment")) {
+        configure_payload_alignment(partial_config);
+    }
+
+    if(partial_config.has("_retransmit_timeout")) {
+        retransmit_timeout_ = std::chrono::milliseconds(partial_config.get<std::uint64_t>("_retransmit_timeout"));
+        LOG(cdtp_logger_, DEBUG) << "Reconfigured timeout for retransmission of missing messages: " << retransmit_timeout_;
+    }
+
+    if(partial_config.has("_lagging_timeout")) {
+        lagging_timeout_ = std::chrono::milliseconds(partial_config.get<std::uint64_t>("_lagging_timeout"));
+        LOG(cdtp_logger_, DEBUG) << "Reconfigured timeout for queued messages before lagging behind: " << lagging_timeout_;
+    }
+
+    if(partial_config.has("_udp_max_message_size")) {
+        udp_max_message_size_ = partial_config.get<std::size_t>("_udp_max_message_size");
+        LOG(cdtp_logger_, DEBUG) << "Reconfigured maximum size of messages received via UDP: " << udp_max_message_size_
+                                 << " bytes";
+    }
+}
+
+void ReceiverSatellite::configure_payload_alignment(const Configuration& config) {
+    const auto alignment = config.get<std::size_t>("_payload_alignment", 0);
+    if(alignment == 0) {
+        realign_pool_.reset();
+        LOG(cdtp_logger_, DEBUG) << "Not realigning payload frames";
+        return;
+    }
+    if(!std::has_single_bit(alignment)) {
+        throw InvalidValueError(config, "_payload_alignment", "alignment needs to be a power of two");
+    }
+    realign_pool_ = std::make_unique<AlignedBufferPool>(alignment);
+    LOG(cdtp_logger_, DEBUG) << "Realigning payload frames to " << alignment << " bytes";
 }
 
-void ReceiverSatellite::starting_receiver() {
+void ReceiverSatellite::starting_receiver(bool hold) {
+    // Hold back messages until released if requested
+    messages_released_ = !hold;
+
     // Reset all transmitters to not connected
     reset_data_transmitter_states();
 
-    // Reset bytes received metric
+    // Reset bytes received and payload realignment metrics
     bytes_received_ = 0;
     STAT("BYTES_RECEIVED", 0);
+    payload_realignments_ = 0;
+    STAT("PAYLOAD_REALIGNMENTS", 0);
+    messages_recovered_ = 0;
+    STAT("MESSAGES_RECOVERED", 0);
+
+    // Close retransmission, feedback and datagram connections of the previous run, the pool thread is not running
+    retransmit_sockets_.clear();
+    feedback_sockets_.clear();
+    datagram_threads_.clear();
 
     // Start BasePool thread
     startPool();
 }
 
-void ReceiverSatellite::stopping_receiver() {
-    // Wait until no more events returned by poller
-    while(pollerEvents() > 0) {
-        // Check any exceptions that prevents poller from continuing
-        checkPoolException();
-
-        LOG(cdtp_logger_, TRACE) << "Poller still returned events, waiting before checking for EOR arrivals";
-
-        // Wait a bit to avoid hot loop
-        std::this_thread::sleep_for(100ms);
-    }
-    // Now start EOR timer
-    LOG(cdtp_logger_, DEBUG) << "Starting timeout for EOR arrivals (" << data_eor_timeout_ << ")";
-    TimeoutTimer timer {data_eor_timeout_};
-    timer.reset();
+void ReceiverSatellite::release_receiver() {
+    messages_released_ = true;
+    messages_released_.notify_all();
+}
 
+void ReceiverSatellite::stopping_receiver() {
     // Warn about transmitters that never sent a BOR message
     if(cdtp_logger_.shouldLog(WARNING)) {
         const std::lock_guard data_transmitter_states_lock {data_transmitter_states_mutex_};
@@ -272,60 +487,75 @@ void ReceiverSatellite::stopping_receiver() {
             << ", data might be incomplete";
     }
 
-    // Loop until all data transmitters that sent a BOR also sent an EOR
+    // Wait until all data transmitters that sent a BOR also sent an EOR, woken up by the BasePool thread on every EOR
+    LOG(cdtp_logger_, DEBUG) << "Waiting for EOR arrivals (timeout " << data_eor_timeout_ << ")";
+    std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
     while(true) {
-        std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
-        const auto missing_eors = std::ranges::count_if(data_transmitter_states_, [](const auto& data_transmitter_p) {
-            return data_transmitter_p.second.state == TransmitterState::BOR_RECEIVED;
-        });
-        data_transmitter_states_lock.unlock();
+        const auto all_eors_received =
+            data_transmitter_states_cv_.wait_for(data_transmitter_states_lock, data_eor_timeout_, [this]() {
+                return pool_exception_ || count_missing_eors() == 0;
+            });
+
+        // Propagate exceptions that prevent the poller or datagram threads from continuing, no more EORs can arrive
+        if(pool_exception_) {
+            data_transmitter_states_lock.unlock();
+            check_receiver_exception();
+            // Exceptions are stored before the flag is raised, thus this is only reached if the exception got lost
+            throw SatelliteError("Receiving data stopped while waiting for EOR messages");
+        }
 
-        // Check if EOR messages are missing
-        if(missing_eors == 0) {
+        if(all_eors_received) {
             break;
         }
 
-        // If timeout reached, throw
-        if(timer.timeoutReached()) {
-            // Stop BasePool thread and disconnect all connected sockets
-            stopPool();
-
-            // Filter for data transmitters that did not send an EOR
-            auto data_transmitter_no_eor =
-                std::ranges::views::filter(data_transmitter_states_, [](const auto& data_transmitter_p) {
-                    return data_transmitter_p.second.state == TransmitterState::BOR_RECEIVED;
-                });
-
-            // Note: we do not have a bidirectional range so the content needs to be copied to a vector
-            const auto data_transmitter_no_eor_str =
-                range_to_string(std::ranges::to<std::vector>(std::ranges::views::keys(data_transmitter_no_eor)));
-            LOG(cdtp_logger_, WARNING) << "Not all EOR messages received, emitting substitute EOR messages for "
-                                       << data_transmitter_no_eor_str;
-
-            for(const auto& data_transmitter : data_transmitter_no_eor) {
-                LOG(cdtp_logger_, DEBUG) << "Creating substitute EOR for " << data_transmitter.first;
-                auto run_metadata = Dictionary();
-                run_metadata["run_id"] = getRunIdentifier();
-                auto condition_code = CDTP::RunCondition::ABORTED;
-                if(data_transmitter.second.missed > 0) {
-                    condition_code |= CDTP::RunCondition::INCOMPLETE;
-                }
-                run_metadata["condition_code"] = condition_code;
-                run_metadata["condition"] = enum_name(condition_code);
-                receive_eor({data_transmitter.first, 0, CDTP1Message::Type::EOR}, std::move(run_metadata));
-            }
+        // The timeout only counts once all pending messages have been read, restart it if the poller still returns events
+        if(pollerEvents() > 0) {
+            LOG(cdtp_logger_, TRACE) << "Poller still returned events, restarting timeout for EOR arrivals";
+            continue;
+        }
+
+        // Timeout reached, unlock before stopping BasePool thread since it might wait for the lock
+        data_transmitter_states_lock.unlock();
+
+        // Stop BasePool thread and disconnect all connected sockets, then stop receiving datagrams
+        stopPool();
+        datagram_threads_.clear();
+
+        // Filter for data transmitters that did not send an EOR
+        auto data_transmitter_no_eor =
+            std::ranges::views::filter(data_transmitter_states_, [](const auto& data_transmitter_p) {
+                return data_transmitter_p.second.state == TransmitterState::BOR_RECEIVED;
+            });
 
-            throw RecvTimeoutError("EOR messages missing from " + data_transmitter_no_eor_str, data_eor_timeout_);
+        // Note: we do not have a bidirectional range so the content needs to be copied to a vector
+        const auto data_transmitter_no_eor_str =
+            range_to_string(std::ranges::to<std::vector>(std::ranges::views::keys(data_transmitter_no_eor)));
+        LOG(cdtp_logger_, WARNING) << "Not all EOR messages received, emitting substitute EOR messages for "
+                                   << data_transmitter_no_eor_str;
+
+        for(const auto& data_transmitter : data_transmitter_no_eor) {
+            LOG(cdtp_logger_, DEBUG) << "Creating substitute EOR for " << data_transmitter.first;
+            auto run_metadata = Dictionary();
+            run_metadata["run_id"] = getRunIdentifier();
+            auto condition_code = CDTP::RunCondition::ABORTED;
+            if(data_transmitter.second.missed > 0) {
+                condition_code |= CDTP::RunCondition::INCOMPLETE;
+            }
+            run_metadata["condition_code"] = condition_code;
+            run_metadata["condition"] = enum_name(condition_code);
+            receive_eor({data_transmitter.first, 0, CDTP1Message::Type::EOR}, std::move(run_metadata));
         }
 
-        // Wait a bit before re-locking
-        std::this_thread::sleep_for(50ms);
+        throw RecvTimeoutError("EOR messages missing from " + data_transmitter_no_eor_str, data_eor_timeout_);
     }
+    data_transmitter_states_lock.unlock();
 
     LOG(cdtp_logger_, DEBUG) << "All EOR messages received";
 
     // Stop BasePool thread and disconnect all connected sockets
     stopPool();
+    datagram_threads_.clear();
+    sender_registry_.clear();
 }
 
 void ReceiverSatellite::interrupting_receiver(CSCP::State previous_state) {
@@ -340,19 +570,44 @@ void ReceiverSatellite::interrupting_receiver(CSCP::State previous_state) {
 }
 
 void ReceiverSatellite::failure_receiver() {
-    // Stop BasePool thread and disconnect all connected sockets
+    // Stop BasePool thread and disconnect all connected sockets, then stop receiving datagrams
     stopPool();
+    datagram_threads_.clear();
 }
 
 void ReceiverSatellite::reset_data_transmitter_states() {
     const std::lock_guard data_transmitter_states_lock {data_transmitter_states_mutex_};
     data_transmitter_states_.clear();
+    sender_registry_.clear();
+    pool_exception_ = false;
+    datagram_exception_ = nullptr;
     for(const auto& data_transmitter : data_transmitters_) {
-        data_transmitter_states_.emplace(data_transmitter, TransmitterStateSeq(TransmitterState::NOT_CONNECTED, 0, 0));
+        data_transmitter_states_.emplace(
+            data_transmitter, TransmitterStateSeq(TransmitterState::NOT_CONNECTED, 0, 0, 1, MD5Hash(data_transmitter)));
     }
 }
 
+std::size_t ReceiverSatellite::count_missing_eors() const {
+    return static_cast<std::size_t>(std::ranges::count_if(data_transmitter_states_, [](const auto& data_transmitter_p) {
+        return data_transmitter_p.second.state == TransmitterState::BOR_RECEIVED;
+    }));
+}
+
 void ReceiverSatellite::handle_cdtp_message(CDTP1Message&& message) {
+    // Wait until messages are released if held back during starting
+    messages_released_.wait(false);
+
+    // Data messages received via datagrams are handled before the EOR, missing ones are counted as missed
+    if(message.getHeader().getType() == CDTP1Message::Type::EOR) {
+        const auto datagram_thread_it = datagram_threads_.find(message.getHeader().getSender());
+        if(datagram_thread_it != datagram_threads_.end()) {
+            datagram_threads_.erase(datagram_thread_it);
+        }
+    }
+
+    // Data messages of different transmitters might be received in parallel via datagrams
+    const std::lock_guard receive_lock {receive_mutex_};
+
     using enum CDTP1Message::Type;
     switch(message.getHeader().getType()) {
     case BOR: {
@@ -384,9 +639,106 @@ void ReceiverSatellite::handle_bor_message(CDTP1Message bor_message) {
         throw InvalidCDTPMessageType(CDTP1Message::Type::BOR, "already received BOR");
     }
     data_transmitter_it->second.state = TransmitterState::BOR_RECEIVED;
+    // Transmitters distributing data over a group of receivers send only part of the messages to this receiver
+    if(bor_message.getHeader().hasTag("receiver_group_size")) {
+        data_transmitter_it->second.group_size =
+            std::max<std::uint64_t>(bor_message.getHeader().getTag<std::uint64_t>("receiver_group_size"), 1);
+        LOG(cdtp_logger_, DEBUG) << "Receiving data from " << data_transmitter_it->first << " as one of a group of "
+                                 << data_transmitter_it->second.group_size << " receivers";
+    } else {
+        // Missing messages can only be recovered if all messages are sent to this receiver
+        connect_transmitter_service(bor_message.getHeader(), "retransmit_port", retransmit_sockets_);
+    }
+    // Feedback identifies this receiver such that the transmitter can account the messages received by each member
+    connect_transmitter_service(bor_message.getHeader(), "feedback_port", feedback_sockets_, getCanonicalName());
+    // Compact headers are only requested if the sender ID of the transmitter does not collide with another sender
+    data_transmitter_it->second.compact_header = sender_registry_.add(data_transmitter_it->first);
+    LOG_IF(cdtp_logger_, WARNING, !data_transmitter_it->second.compact_header)
+        << "Sender ID of " << data_transmitter_it->first
+        << " collides with another sender, requesting MessagePack headers for its data messages";
     data_transmitter_states_lock.unlock();
 
-    receive_bor(bor_message.getHeader(), {Dictionary::disassemble(bor_message.getPayload().at(0)), true});
+    // Open the datagram socket before passing on the BOR such that no datagram is lost in the meantime
+    std::unique_ptr<DatagramReceiver> datagram_receiver {};
+    const auto& header = bor_message.getHeader();
+    if(header.hasTag("udp_port")) {
+        const auto sender = to_string(header.getSender());
+        const auto port = header.getTag<Port>("udp_port");
+        // Fragments are validated against the datagram size of the transmitter
+        const auto datagram_size = header.hasTag("udp_datagram_size")
+                                       ? header.getTag<std::uint64_t>("udp_datagram_size")
+                                       : DatagramSender::default_datagram_size;
+        try {
+            const auto address = asio::ip::make_address_v4(header.getTag<std::string>("udp_address"));
+            datagram_receiver = std::make_unique<DatagramReceiver>(
+                address, port, CDTP1Message::Header::sender_id(sender), datagram_size, udp_max_message_size_);
+            LOG(cdtp_logger_, INFO) << "Receiving data from " << sender << " lossy via UDP at "
+                                    << to_uri(address, port, "udp");
+        } catch(const asio::system_error& e) {
+            throw NetworkError("Invalid UDP address announced by " + sender + ": " + e.what());
+        }
+    }
+
+    receive_bor(header, {Dictionary::disassemble(bor_message.getPayload().at(0)), true});
+
+    if(datagram_receiver) {
+        auto sender = to_string(header.getSender());
+        auto datagram_thread =
+            std::jthread(std::bind_front(&ReceiverSatellite::datagram_loop, this), sender, std::move(datagram_receiver));
+        set_thread_name(datagram_thread, "CDTP_datagram");
+        datagram_threads_.insert_or_assign(std::move(sender), std::move(datagram_thread));
+    }
+}
+
+void ReceiverSatellite::datagram_loop(const std::stop_token& stop_token,
+                                      const std::string& sender,
+                                      const std::unique_ptr<DatagramReceiver>& receiver) {
+    // Receive a single message, returns false if no message was completed
+    const auto receive = [&](std::chrono::steady_clock::duration timeout) {
+        auto frames = receiver->recv(timeout);
+        if(!frames.has_value()) {
+            return false;
+        }
+        auto data_message = CDTP1Message::disassemble(frames.value(), &sender_registry_);
+        LOG(cdtp_logger_, TRACE) << "Received data message " << data_message.getHeader().getSequenceNumber()
+                                 << " from " << sender << " via UDP";
+        const std::lock_guard receive_lock {receive_mutex_};
+        bytes_received_ += data_message.countPayloadBytes();
+        handle_data_message(std::move(data_message));
+        return true;
+    };
+
+    try {
+        while(true) {
+            try {
+                // Wake up regularly to check if the loop should be stopped, then process datagrams which already arrived
+                if(!stop_token.stop_requested()) {
+                    receive(50ms);
+                } else if(!receive(0ms)) {
+                    break;
+                }
+            } catch(const MessageDecodingError& e) {
+                LOG(cdtp_logger_, WARNING) << "Received invalid datagram from " << sender << ": " << e.what();
+            } catch(const NetworkError& e) {
+                LOG(cdtp_logger_, WARNING) << "Error receiving datagrams from " << sender << ": " << e.what();
+                if(stop_token.stop_requested()) {
+                    break;
+                }
+            }
+        }
+    } catch(...) {
+        // Raise exception like exceptions of the BasePool thread
+        std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
+        datagram_exception_ = std::current_exception();
+        pool_exception_ = true;
+        data_transmitter_states_lock.unlock();
+        data_transmitter_states_cv_.notify_all();
+        return;
+    }
+
+    LOG_IF(cdtp_logger_, WARNING, receiver->countIncomplete() > 0)
+        << "Dropped " << receiver->countIncomplete() << " incomplete messages from " << sender
+        << " since not all datagrams arrived";
 }
 
 void ReceiverSatellite::handle_data_message(CDTP1Message data_message) {
@@ -396,14 +748,270 @@ void ReceiverSatellite::handle_data_message(CDTP1Message data_message) {
     if(data_transmitter_it->second.state != TransmitterState::BOR_RECEIVED) [[unlikely]] {
         throw InvalidCDTPMessageType(CDTP1Message::Type::DATA, "did not receive BOR");
     }
-    // Store sequence number and missed messages
-    data_transmitter_it->second.missed += data_message.getHeader().getSequenceNumber() - 1 - data_transmitter_it->second.seq;
-    data_transmitter_it->second.seq = data_message.getHeader().getSequenceNumber();
+    auto& data_transmitter_state = data_transmitter_it->second;
+
+    // Messages following missing ones are held back until the retransmission completed
+    if(data_transmitter_state.recovery.has_value()) {
+        data_transmitter_state.held_messages.push_back(std::move(data_message));
+        return;
+    }
+
+    // Store sequence number, in a receiver group the transmitter reports missed messages in the EOR since the messages
+    // are not distributed in a fixed order
+    const auto seq = data_message.getHeader().getSequenceNumber();
+    const auto last_seq = data_transmitter_state.seq;
+    if(data_transmitter_state.group_size == 1 && seq > last_seq + 1) {
+        // Attempt to recover missing messages before passing on this message, otherwise store them as missed
+        if(request_retransmission(data_transmitter_it->first, data_transmitter_state, last_seq + 1, seq - 1)) {
+            data_transmitter_state.held_messages.push_back(std::move(data_message));
+            return;
+        }
+        data_transmitter_state.missed += seq - 1 - last_seq;
+    }
+    data_transmitter_state.seq = seq;
+    ++data_transmitter_state.received;
     data_transmitter_states_lock.unlock();
 
+    realign_payload(data_message);
     receive_data(std::move(data_message));
 }
 
+void ReceiverSatellite::connect_transmitter_service(const CDTP1Message::Header& header,
+                                                    const std::string& port_tag,
+                                                    string_hash_map<zmq::socket_t>& sockets,
+                                                    const std::string& routing_id) {
+    if(!header.hasTag(port_tag)) {
+        return;
+    }
+    const auto sender = to_string(header.getSender());
+
+    // The services of the transmitter run on the same host as its data service
+    const auto& pool_sockets = get_sockets();
+    const auto service_it = std::ranges::find_if(
+        pool_sockets, [host_id = MD5Hash(sender)](const auto& socket_p) { return socket_p.first.host_id == host_id; });
+    if(service_it == pool_sockets.end()) {
+        return;
+    }
+    const auto uri =
+        "tcp://" + service_it->first.address.to_string() + ":" + std::to_string(header.getTag<Port>(port_tag));
+
+    try {
+        zmq::socket_t socket {*global_zmq_context(), zmq::socket_type::dealer};
+        if(!routing_id.empty()) {
+            socket.set(zmq::sockopt::routing_id, routing_id);
+        }
+        socket.connect(uri);
+        sockets.insert_or_assign(sender, std::move(socket));
+        LOG(cdtp_logger_, DEBUG) << "Connected to " << sender << " at " << uri << " announced as " << port_tag;
+    } catch(const zmq::error_t& e) {
+        LOG(cdtp_logger_, WARNING) << "Could not connect to " << sender << " at " << uri << ": " << e.what();
+    }
+}
+
+void ReceiverSatellite::exchange_feedback(std::string_view sender, TransmitterStateSeq& data_transmitter_state) {
+    const auto socket_it = feedback_sockets_.find(sender);
+    if(socket_it == feedback_sockets_.end()) {
+        return;
+    }
+    auto& socket = socket_it->second;
+
+    try {
+        // Replies contain the sequence number of the last message created by the transmitter
+        zmq::multipart_t reply {};
+        while(reply.recv(socket, static_cast<int>(zmq::recv_flags::dontwait))) {
+            // Members of a receiver group receive the EOR via feedback since the data socket might skip them
+            if(reply.size() != DataFeedback::frames) {
+                auto eor_message = CDTP1Message::disassemble(reply, &sender_registry_);
+                if(eor_message.getHeader().getType() != CDTP1Message::Type::EOR ||
+                   eor_message.getHeader().getSender() != sender) [[unlikely]] {
+                    LOG(cdtp_logger_, WARNING) << "Received unexpected " << to_string(eor_message.getHeader().getType())
+                                               << " message via feedback from " << sender;
+                    continue;
+                }
+                LOG(cdtp_logger_, DEBUG) << "Received EOR message from " << sender << " via feedback";
+                data_transmitter_state.group_eor.emplace(std::move(eor_message));
+                continue;
+            }
+            const auto seq = DataFeedback::disassemble(reply).getSequenceNumber();
+            data_transmitter_state.queue_depth =
+                (seq - std::min(seq, data_transmitter_state.seq)) / data_transmitter_state.group_size;
+        }
+
+        // Report last processed message, feedback is dropped if it cannot be queued
+        DataFeedback(data_transmitter_state.seq,
+                     data_transmitter_state.lagging,
+                     data_transmitter_state.compact_header,
+                     data_transmitter_state.received)
+            .assemble()
+            .send(socket, static_cast<int>(zmq::send_flags::dontwait));
+    } catch(const MessageDecodingError& e) {
+        LOG(cdtp_logger_, WARNING) << "Invalid feedback from " << sender << ": " << e.what();
+    } catch(const zmq::error_t& e) {
+        LOG(cdtp_logger_, WARNING) << "Error exchanging feedback with " << sender << ": " << e.what();
+    }
+}
+
+bool ReceiverSatellite::request_retransmission(std::string_view sender,
+                                               TransmitterStateSeq& data_transmitter_state,
+                                               std::uint64_t begin,
+                                               std::uint64_t end) {
+    const auto socket_it = retransmit_sockets_.find(sender);
+    if(socket_it == retransmit_sockets_.end()) {
+        return false;
+    }
+
+    LOG(cdtp_logger_, DEBUG) << "Requesting retransmission of messages " << begin << " to " << end << " from " << sender;
+    try {
+        if(!socket_it->second.send(RetransmitBuffer::encode_range(begin, end), zmq::send_flags::dontwait)) {
+            LOG(cdtp_logger_, WARNING) << "Could not request retransmission from " << sender;
+            return false;
+        }
+    } catch(const zmq::error_t& e) {
+        LOG(cdtp_logger_, WARNING) << "Error requesting retransmission from " << sender << ": " << e.what();
+        return false;
+    }
+
+    data_transmitter_state.recovery = Recovery(begin, end, std::chrono::steady_clock::now() + retransmit_timeout_);
+    return true;
+}
+
+std::vector<CDTP1Message> ReceiverSatellite::receive_retransmission(std::string_view sender,
+                                                                    TransmitterStateSeq& data_transmitter_state) {
+    auto& recovery = data_transmitter_state.recovery.value();
+    std::vector<CDTP1Message> data_messages {};
+    auto completed = false;
+
+    try {
+        auto& socket = retransmit_sockets_.find(sender)->second;
+        zmq::multipart_t reply {};
+        while(!completed && reply.recv(socket, static_cast<int>(zmq::recv_flags::dontwait))) {
+            // Skip replies to earlier requests which timed out
+            const auto range = RetransmitBuffer::decode_range({to_byte_ptr(reply.front().data()), reply.front().size()});
+            if(range != std::make_pair(recovery.begin, recovery.end)) {
+                continue;
+            }
+            reply.pop();
+
+            // Reply without message marks the end of the retransmission
+            if(reply.empty()) {
+                completed = true;
+                break;
+            }
+
+            auto data_message = CDTP1Message::disassemble(reply, &sender_registry_);
+            LOG(cdtp_logger_, TRACE) << "Recovered data message " << data_message.getHeader().getSequenceNumber() << " from "
+                                     << sender;
+            bytes_received_ += data_message.countPayloadBytes();
+            data_messages.push_back(std::move(data_message));
+        }
+    } catch(const MessageDecodingError& e) {
+        LOG(cdtp_logger_, WARNING) << "Invalid retransmission reply from " << sender << ": " << e.what();
+        completed = true;
+    } catch(const zmq::error_t& e) {
+        LOG(cdtp_logger_, WARNING) << "Error receiving retransmission from " << sender << ": " << e.what();
+        completed = true;
+    }
+
+    recovery.recovered += data_messages.size();
+    data_transmitter_state.received += data_messages.size();
+    messages_recovered_ += data_messages.size();
+
+    if(!completed && std::chrono::steady_clock::now() >= recovery.deadline) {
+        LOG(cdtp_logger_, WARNING) << "Retransmission of messages " << recovery.begin << " to " << recovery.end << " from "
+                                   << sender << " timed out";
+        completed = true;
+    }
+
+    // Messages which were not recovered are counted as missed
+    if(completed) {
+        const auto requested = recovery.end - recovery.begin + 1;
+        LOG(cdtp_logger_, DEBUG) << "Recovered " << recovery.recovered << " of " << requested << " missing messages from "
+                                 << sender;
+        data_transmitter_state.missed += requested - std::min(requested, recovery.recovered);
+        data_transmitter_state.seq = recovery.end;
+        data_transmitter_state.recovery.reset();
+    }
+
+    return data_messages;
+}
+
+void ReceiverSatellite::poll_completed() {
+    const auto now = std::chrono::steady_clock::now();
+    const std::lock_guard receive_lock {receive_mutex_};
+    std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
+
+    for(auto& [sender, data_transmitter_state] : data_transmitter_states_) {
+        // Keep exchanging feedback while no messages arrive such that the transmitter does not discard this receiver
+        if(data_transmitter_state.state == TransmitterState::BOR_RECEIVED &&
+           now - data_transmitter_state.last_feedback >= DataFeedback::interval) {
+            data_transmitter_state.last_feedback = now;
+            exchange_feedback(sender, data_transmitter_state);
+        }
+
+        // The EOR received via feedback overtakes data messages still queued on the data socket
+        if(data_transmitter_state.group_eor.has_value() && messages_released_ &&
+           !has_queued_messages(data_transmitter_state.host_id)) {
+            auto eor_message = std::move(data_transmitter_state.group_eor.value());
+            data_transmitter_state.group_eor.reset();
+            data_transmitter_states_lock.unlock();
+            LOG(cdtp_logger_, DEBUG) << "Handling EOR message from " << sender << " received via feedback";
+            handle_eor_message(std::move(eor_message));
+            data_transmitter_states_lock.lock();
+            continue;
+        }
+
+        if(!data_transmitter_state.recovery.has_value()) {
+            continue;
+        }
+
+        // Pass on recovered messages in order before the held back messages
+        auto data_messages = receive_retransmission(sender, data_transmitter_state);
+        data_transmitter_states_lock.unlock();
+        for(auto& data_message : data_messages) {
+            realign_payload(data_message);
+            receive_data(std::move(data_message));
+        }
+        data_transmitter_states_lock.lock();
+
+        // Handle held back messages until the next gap requires another retransmission
+        while(!data_transmitter_state.recovery.has_value() && !data_transmitter_state.held_messages.empty()) {
+            auto message = std::move(data_transmitter_state.held_messages.front());
+            data_transmitter_state.held_messages.pop_front();
+            data_transmitter_states_lock.unlock();
+            if(message.getHeader().getType() == CDTP1Message::Type::EOR) {
+                handle_eor_message(std::move(message));
+            } else {
+                handle_data_message(std::move(message));
+            }
+            data_transmitter_states_lock.lock();
+        }
+    }
+}
+
+bool ReceiverSatellite::has_queued_messages(const MD5Hash& host_id) {
+    const auto& pool_sockets = get_sockets();
+    const auto service_it = std::ranges::find_if(
+        pool_sockets, [&](const auto& socket_p) { return socket_p.first.host_id == host_id; });
+    if(service_it == pool_sockets.end()) {
+        return false;
+    }
+    // Reading the events processes pending commands, afterwards pollin shows queued messages
+    return (service_it->second.get(zmq::sockopt::events) & ZMQ_POLLIN) != 0;
+}
+
+void ReceiverSatellite::realign_payload(CDTP1Message& data_message) {
+    if(!realign_pool_) {
+        return;
+    }
+    // Frames point into ZeroMQ message memory, only copy those which do not happen to be aligned
+    for(auto& frame : data_message.getPayload()) {
+        if(!frame.is_aligned(realign_pool_->alignment())) {
+            frame = PayloadBuffer(realign_pool_->copy(frame.span()));
+            ++payload_realignments_;
+        }
+    }
+}
+
 void ReceiverSatellite::handle_eor_message(CDTP1Message eor_message) {
     std::unique_lock data_transmitter_states_lock {data_transmitter_states_mutex_};
     auto data_transmitter_it = data_transmitter_states_.find(eor_message.getHeader().getSender());
@@ -411,6 +1019,29 @@ void ReceiverSatellite::handle_eor_message(CDTP1Message eor_message) {
     if(data_transmitter_it->second.state != TransmitterState::BOR_RECEIVED) [[unlikely]] {
         throw InvalidCDTPMessageType(CDTP1Message::Type::EOR, "did not receive BOR");
     }
+
+    // The EOR is held back like data messages until a pending retransmission completed
+    if(data_transmitter_it->second.recovery.has_value()) {
+        data_transmitter_it->second.held_messages.push_back(std::move(eor_message));
+        return;
+    }
+
+    // Recover messages missing at the end of the run, in a receiver group the transmitter reports the messages missed by
+    // the group as a whole since it cannot be determined which member should have received them
+    const auto last_seq = data_transmitter_it->second.seq;
+    const auto eor_seq = eor_message.getHeader().getSequenceNumber();
+    if(data_transmitter_it->second.group_size > 1) {
+        if(eor_message.getHeader().hasTag("receiver_group_missed")) {
+            data_transmitter_it->second.missed += eor_message.getHeader().getTag<std::uint64_t>("receiver_group_missed");
+        }
+    } else if(eor_seq > last_seq + 1) {
+        if(request_retransmission(data_transmitter_it->first, data_transmitter_it->second, last_seq + 1, eor_seq - 1)) {
+            data_transmitter_it->second.held_messages.push_back(std::move(eor_message));
+            return;
+        }
+        data_transmitter_it->second.missed += eor_seq - 1 - last_seq;
+    }
+
     auto metadata = Dictionary::disassemble(eor_message.getPayload().at(0));
 
     // Mark run as incomplete if there are missed messages:
@@ -429,7 +1060,12 @@ void ReceiverSatellite::handle_eor_message(CDTP1Message eor_message) {
     }
 
     data_transmitter_it->second.state = TransmitterState::EOR_RECEIVED;
+    // No further messages are expected from the transmitter in this run
+    sender_registry_.remove(data_transmitter_it->first);
     data_transmitter_states_lock.unlock();
 
+    // Wake up EOR wait in stopping
+    data_transmitter_states_cv_.notify_all();
+
     receive_eor(eor_message.getHeader(), std::move(metadata));
 }
@@ -11,14 +11,20 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include <zmq.hpp>
@@ -28,7 +34,10 @@
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/log/Logger.hpp"
+#include "constellation/core/message/AlignedBuffer.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/CHIRPMessage.hpp"
+#include "constellation/core/networking/Datagram.hpp"
 #include "constellation/core/pools/BasePool.hpp"
 #include "constellation/core/protocol/CHIRP_definitions.hpp"
 #include "constellation/core/protocol/CSCP_definitions.hpp"
@@ -49,6 +58,19 @@ namespace constellation::satellite {
             BOR_RECEIVED,
             EOR_RECEIVED,
         };
+        struct Recovery {
+            /** First missing sequence number */
+            std::uint64_t begin;
+
+            /** Last missing sequence number */
+            std::uint64_t end;
+
+            /** Time after which messages which were not retransmitted are counted as missed */
+            std::chrono::steady_clock::time_point deadline;
+
+            /** Number of retransmitted messages */
+            std::uint64_t recovered {};
+        };
         struct TransmitterStateSeq {
             /** State of the CDTP connection */
             TransmitterState state;
@@ -58,6 +80,42 @@ namespace constellation::satellite {
 
             /** Number of missed messages */
             std::uint64_t missed;
+
+            /** Number of receivers sharing the data stream of the transmitter */
+            std::uint64_t group_size;
+
+            /** Host ID of the transmitter to identify its data service */
+            message::MD5Hash host_id;
+
+            /** Number of received data messages, including recovered ones */
+            std::uint64_t received {};
+
+            /** Processing time of messages averaged over recent messages */
+            std::chrono::nanoseconds latency {};
+
+            /** Time since which messages are queued continuously */
+            std::optional<std::chrono::steady_clock::time_point> queued_since {};
+
+            /** Whether this receiver lags behind the data stream of the transmitter */
+            bool lagging {false};
+
+            /** Number of messages sent by the transmitter but not processed yet, as of the last feedback */
+            std::uint64_t queue_depth {};
+
+            /** Time at which the last feedback was sent to the transmitter */
+            std::chrono::steady_clock::time_point last_feedback {};
+
+            /** Whether compact headers of the transmitter can be resolved, announced to the transmitter via feedback */
+            bool compact_header {false};
+
+            /** Pending retransmission of missing messages */
+            std::optional<Recovery> recovery {};
+
+            /** Messages received while a retransmission is pending, handled once it completed */
+            std::deque<message::CDTP1Message> held_messages {};
+
+            /** EOR received via feedback as member of a receiver group, handled once no data messages are queued */
+            std::optional<message::CDTP1Message> group_eor {};
         };
 
     protected:
@@ -157,16 +215,39 @@ namespace constellation::satellite {
          */
         bool should_connect(const chirp::DiscoveredService& service) final;
 
-    private:
-        // Needs access to receiver specific functions
-        friend BaseSatellite;
+        /**
+         * @brief Wake up threads waiting for EOR messages or in the run loop when the BasePool thread threw an exception
+         */
+        void pool_exception_raised() final;
+
+        /**
+         * @brief Decode CDTP messages resolving compact headers via the senders registered in the current run
+         */
+        message::CDTP1Message decode_message(zmq::multipart_t& frames) final;
 
+        /**
+         * @brief Update processing latency and lagging state of a transmitter and exchange feedback with it
+         */
+        void message_handled(const chirp::DiscoveredService& service, std::chrono::nanoseconds latency, bool pending) final;
+
+        /**
+         * @brief Exchange feedback with transmitters from which no messages arrived recently, handle the EOR received via
+         *        feedback in a receiver group, pass on retransmitted messages and the messages held back meanwhile, and give
+         *        up on timed out retransmissions
+         */
+        void poll_completed() final;
+
+    private:
         /**
          * @brief Initialize receiver components of satellite
          *
          * Reads the following config parameters:
          * * `_eor_timeout`
          * * `_data_transmitters`
+         * * `_payload_alignment`
+         * * `_retransmit_timeout`
+         * * `_lagging_timeout`
+         * * `_udp_max_message_size`
          *
          * @param config Configuration of the satellite
          */
@@ -178,6 +259,10 @@ namespace constellation::satellite {
          * Supports reconfiguring of the following config parameters:
          * * `_eor_timeout`
          * * `_data_transmitters`
+         * * `_payload_alignment`
+         * * `_retransmit_timeout`
+         * * `_lagging_timeout`
+         * * `_udp_max_message_size`
          *
          * @param partial_config Changes to the configuration of the satellite
          */
@@ -187,13 +272,23 @@ namespace constellation::satellite {
          * @brief Start receiver components of satellite
          *
          * This functions starts the BasePool thread to receive CDTP messages.
+         *
+         * @param hold If true, received messages are held back until `release_receiver()` is called
+         */
+        void starting_receiver(bool hold = false);
+
+        /**
+         * @brief Release messages held back since `starting_receiver()`
+         *
+         * This is used when the receiver components are started in parallel to the user starting function, such that no
+         * message is passed to the user before starting has finished.
          */
-        void starting_receiver();
+        void release_receiver();
 
         /**
          * @brief Stop receiver components of satellite
          *
-         * This function stops the BasePool thread and waits for the EOR messages.
+         * This function waits for the EOR messages and stops the BasePool thread and the threads receiving datagrams.
          *
          * @throw RecvTimeoutError If EOR of sallites that send a BOR is not received after timeout
          */
@@ -209,7 +304,7 @@ namespace constellation::satellite {
         /**
          * @brief Failure function for receiver components of satellite
          *
-         * This function stops the BasePool thread.
+         * This function stops the BasePool thread and the threads receiving datagrams.
          */
         void failure_receiver();
 
@@ -218,6 +313,13 @@ namespace constellation::satellite {
          */
         void reset_data_transmitter_states();
 
+        /**
+         * @brief Count the data transmitters that sent a BOR but no EOR yet
+         *
+         * @warning Requires `data_transmitter_states_mutex_` to be locked
+         */
+        std::size_t count_missing_eors() const;
+
         /**
          * @brief Callback function for BasePool to handle CDTP messages
          *
@@ -228,8 +330,12 @@ namespace constellation::satellite {
         /**
          * @brief Handle BOR message before passing it to `receive_bor()`
          *
+         * If the transmitter announces a UDP address and port, a thread receiving its data messages via datagrams is
+         * started after `receive_bor()` returned.
+         *
          * @param bor_message Received CDTP BOR message
          * @throw InvalidCDTPMessageType If already a BOR received
+         * @throw NetworkError If the datagram socket could not be opened
          */
         void handle_bor_message(message::CDTP1Message bor_message);
 
@@ -241,6 +347,120 @@ namespace constellation::satellite {
          */
         void handle_data_message(message::CDTP1Message data_message);
 
+        /**
+         * @brief Loop receiving data messages of a transmitter via datagrams and passing them to `handle_data_message()`
+         *
+         * When stopped, datagrams which already arrived are still processed. Exceptions other than invalid datagrams are
+         * stored and raised in the same way as exceptions of the BasePool thread.
+         *
+         * @param stop_token Token to stop the loop
+         * @param sender Canonical name of the transmitter
+         * @param receiver Datagram receiver bound to the address and port announced by the transmitter
+         */
+        void datagram_loop(const std::stop_token& stop_token,
+                           const std::string& sender,
+                           const std::unique_ptr<networking::DatagramReceiver>& receiver);
+
+        /**
+         * @brief Rethrow exceptions of the datagram threads or the BasePool thread
+         */
+        void check_receiver_exception();
+
+        /**
+         * @brief Connect to a service of a transmitter if its port is announced in the BOR message
+         *
+         * @warning Requires `sockets_mutex_` to be locked, which is the case in the BasePool thread
+         *
+         * @param header Header of the BOR message
+         * @param port_tag Tag of the BOR message containing the port of the service
+         * @param sockets Sockets to which the socket connected to the service is added
+         * @param routing_id Routing ID identifying the socket at the transmitter, assigned by the transmitter if empty
+         */
+        void connect_transmitter_service(const message::CDTP1Message::Header& header,
+                                         const std::string& port_tag,
+                                         utils::string_hash_map<zmq::socket_t>& sockets,
+                                         const std::string& routing_id = {});
+
+        /**
+         * @brief Check whether messages from a transmitter are queued on its data socket
+         *
+         * @warning Requires `sockets_mutex_` to be locked, which is the case in the BasePool thread
+         *
+         * @param host_id Host ID of the transmitter
+         * @return True if messages are queued, false otherwise
+         */
+        bool has_queued_messages(const message::MD5Hash& host_id);
+
+        /**
+         * @brief Read the replies to previous feedback and send the current feedback to a transmitter
+         *
+         * Members of a receiver group also receive the EOR via this connection, it is stored until handled in
+         * `poll_completed()`.
+         *
+         * @warning Requires `data_transmitter_states_mutex_` to be locked
+         *
+         * @param sender Canonical name of the transmitter
+         * @param data_transmitter_state State of the transmitter, the queue depth is updated from the replies
+         */
+        void exchange_feedback(std::string_view sender, TransmitterStateSeq& data_transmitter_state);
+
+        /**
+         * @brief Collect a value of every data transmitter in the order of the `_data_transmitters` parameter
+         *
+         * @param projection Function obtaining the value from the state of a data transmitter
+         * @return Values of all data transmitters
+         */
+        template <typename T, typename F> std::vector<T> collect_data_transmitter_states(F projection);
+
+        /**
+         * @brief Request missing data messages from a transmitter
+         *
+         * While the retransmission is pending, further messages of the transmitter are held back. The replies are read in
+         * `poll_completed()` such that messages of other transmitters are not blocked.
+         *
+         * @warning Requires `data_transmitter_states_mutex_` to be locked
+         *
+         * @param sender Canonical name of the transmitter
+         * @param data_transmitter_state State of the transmitter storing the pending retransmission
+         * @param begin First missing sequence number
+         * @param end Last missing sequence number
+         * @return True if the retransmission was requested, false if the transmitter does not offer retransmission
+         */
+        bool request_retransmission(std::string_view sender,
+                                    TransmitterStateSeq& data_transmitter_state,
+                                    std::uint64_t begin,
+                                    std::uint64_t end);
+
+        /**
+         * @brief Read the replies to a pending retransmission without waiting
+         *
+         * Once the retransmission completed or timed out, messages which were not recovered are counted as missed and the
+         * pending retransmission is cleared.
+         *
+         * @warning Requires `data_transmitter_states_mutex_` to be locked
+         *
+         * @param sender Canonical name of the transmitter
+         * @param data_transmitter_state State of the transmitter with a pending retransmission
+         * @return Recovered data messages in order
+         */
+        std::vector<message::CDTP1Message> receive_retransmission(std::string_view sender,
+                                                                  TransmitterStateSeq& data_transmitter_state);
+
+        /**
+         * @brief Configure copying of misaligned payload frames to aligned memory
+         *
+         * @param config Configuration containing the `_payload_alignment` parameter
+         * @throw InvalidValueError If the alignment is not a power of two
+         */
+        void configure_payload_alignment(const config::Configuration& config);
+
+        /**
+         * @brief Copy payload frames which are not aligned to aligned buffers from the pool
+         *
+         * @param data_message Received CDTP DATA message
+         */
+        void realign_payload(message::CDTP1Message& data_message);
+
         /**
          * @brief Handle EOR message before passing it to `receive_eor()`
          *
@@ -262,7 +482,22 @@ namespace constellation::satellite {
         std::vector<std::string> data_transmitters_;
         utils::string_hash_map<TransmitterStateSeq> data_transmitter_states_;
         std::mutex data_transmitter_states_mutex_;
+        message::CDTP1Message::SenderRegistry sender_registry_;
+        std::condition_variable_any data_transmitter_states_cv_;
+        bool pool_exception_ {false};
         std::atomic_size_t bytes_received_;
+        std::unique_ptr<message::AlignedBufferPool> realign_pool_;
+        std::atomic_size_t payload_realignments_;
+        std::chrono::milliseconds retransmit_timeout_ {};
+        utils::string_hash_map<zmq::socket_t> retransmit_sockets_;
+        std::atomic_size_t messages_recovered_;
+        std::chrono::milliseconds lagging_timeout_ {};
+        std::size_t udp_max_message_size_ {networking::DatagramReceiver::default_max_message_size};
+        utils::string_hash_map<zmq::socket_t> feedback_sockets_;
+        std::atomic_bool messages_released_ {true};
+        std::mutex receive_mutex_;
+        utils::string_hash_map<std::jthread> datagram_threads_;
+        std::exception_ptr datagram_exception_;
     };
 
 } // namespace constellation::satellite
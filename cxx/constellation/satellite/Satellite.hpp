@@ -210,14 +210,17 @@ namespace constellation::satellite {
          * @param states States of the finite state machine in which this command can be called
          * @param func Pointer to the member function to be called
          * @param t Pointer to the satellite object
+         * @param async If the command should be executed asynchronously, returning a job identifier immediately. Transitions
+         *              are rejected while asynchronous jobs of commands with a list of allowed states are running.
          */
         template <typename T, typename R, typename... Args>
         void register_command(const std::string& name,
                               std::string description,
                               std::initializer_list<protocol::CSCP::State> states,
                               R (T::*func)(Args...),
-                              T* t) {
-            user_commands_.add(name, std::move(description), states, func, t);
+                              T* t,
+                              bool async = false) {
+            user_commands_.add(name, std::move(description), states, func, t, async);
         }
 
         /**
@@ -227,13 +230,16 @@ namespace constellation::satellite {
          * @param description Comprehensive description of the command
          * @param states States of the finite state machine in which this command can be called
          * @param func Function to be called
+         * @param async If the command should be executed asynchronously, returning a job identifier immediately. Transitions
+         *              are rejected while asynchronous jobs of commands with a list of allowed states are running.
          */
         template <typename R, typename... Args>
         void register_command(const std::string& name,
                               std::string description,
                               std::initializer_list<protocol::CSCP::State> states,
-                              std::function<R(Args...)> func) {
-            user_commands_.add(name, std::move(description), states, func);
+                              std::function<R(Args...)> func,
+                              bool async = false) {
+            user_commands_.add(name, std::move(description), states, func, async);
         }
     };
 
@@ -9,26 +9,48 @@
 
 #include "TransmitterSatellite.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 
+#include <asio/ip/address_v4.hpp>
+#include <asio/system_error.hpp>
 #include <zmq.hpp>
+#include <zmq_addon.hpp>
 
 #include "constellation/build.hpp"
 #include "constellation/core/config/Configuration.hpp"
+#include "constellation/core/config/exceptions.hpp"
 #include "constellation/core/log/log.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/DataFeedback.hpp"
+#include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/message/InFlightBudget.hpp"
+#include "constellation/core/message/RetransmitBuffer.hpp"
 #include "constellation/core/metrics/Metric.hpp"
 #include "constellation/core/metrics/stat.hpp"
+#include "constellation/core/networking/asio_helpers.hpp"
+#include "constellation/core/networking/Datagram.hpp"
 #include "constellation/core/networking/exceptions.hpp"
 #include "constellation/core/networking/zmq_helpers.hpp"
 #include "constellation/core/protocol/CDTP_definitions.hpp"
 #include "constellation/core/protocol/CHIRP_definitions.hpp"
 #include "constellation/core/protocol/CSCP_definitions.hpp"
+#include "constellation/core/utils/casts.hpp"
 #include "constellation/core/utils/enum.hpp"
 #include "constellation/core/utils/ManagerLocator.hpp"
+#include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/thread.hpp"
 
 #include "Satellite.hpp"
 
@@ -43,7 +65,14 @@ using namespace std::chrono_literals;
 
 TransmitterSatellite::TransmitterSatellite(std::string_view type, std::string_view name)
     : Satellite(type, name), cdtp_push_socket_(*global_zmq_context(), zmq::socket_type::push),
-      cdtp_port_(bind_ephemeral_port(cdtp_push_socket_)), cdtp_logger_("CDTP") {
+      cdtp_port_(bind_ephemeral_port(cdtp_push_socket_)),
+      cdtp_feedback_socket_(*global_zmq_context(), zmq::socket_type::router),
+      cdtp_feedback_port_(bind_ephemeral_port(cdtp_feedback_socket_)),
+      inflight_budget_(std::make_shared<InFlightBudget>()),
+      sender_id_(CDTP1Message::Header::sender_id(getCanonicalName())), cdtp_logger_("CDTP") {
+
+    // Payload frames share ownership of the budget since ZeroMQ might release them after this satellite is destroyed
+    inflight_release_ = [budget = inflight_budget_](std::size_t bytes) { budget->release(bytes); };
 
     register_timed_metric("BYTES_TRANSMITTED",
                           "B",
@@ -61,19 +90,139 @@ TransmitterSatellite::TransmitterSatellite(std::string_view type, std::string_vi
                           {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
                           [this]() { return frames_transmitted_.load(); });
 
+    register_timed_metric("INFLIGHT_BYTES",
+                          "B",
+                          MetricType::LAST_VALUE,
+                          "Number of payload bytes sent but not yet released by the network layer",
+                          3s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() { return inflight_budget_->bytes(); });
+
+    register_timed_metric("MESSAGES_RETRANSMITTED",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Number of data messages retransmitted on request of receivers in the current run",
+                          10s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() { return messages_retransmitted_.load(); });
+
+    register_timed_metric("RECEIVER_BACKLOG",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Number of data messages sent but not yet processed by the slowest receiver",
+                          3s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() { return receiver_backlog_.load(); });
+
+    register_timed_metric("RECEIVERS_LAGGING",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Whether any receiver lags behind the data stream",
+                          3s,
+                          {CSCP::State::starting, CSCP::State::RUN, CSCP::State::stopping},
+                          [this]() { return receivers_lagging_.load(); });
+
     try {
         // Only send to completed connections
         cdtp_push_socket_.set(zmq::sockopt::immediate, true);
+
+        // Monitor completed connections to count the receivers, unique per instance since it uses an inproc endpoint
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        cdtp_monitor_.init(cdtp_push_socket_,
+                           "inproc://cdtp-monitor-" + std::to_string(reinterpret_cast<std::uintptr_t>(this)),
+                           ZMQ_EVENT_HANDSHAKE_SUCCEEDED | ZMQ_EVENT_HANDSHAKE_FAILED_NO_DETAIL |
+                               ZMQ_EVENT_HANDSHAKE_FAILED_PROTOCOL | ZMQ_EVENT_HANDSHAKE_FAILED_AUTH |
+                               ZMQ_EVENT_DISCONNECTED);
+
+        // Wake up regularly to check if feedback thread should be stopped
+        cdtp_feedback_socket_.set(zmq::sockopt::rcvtimeo, 50);
+        // Receivers identify themselves by their canonical name, which is taken over when reconnecting in the next run
+        cdtp_feedback_socket_.set(zmq::sockopt::router_handover, true);
     } catch(const zmq::error_t& e) {
         throw NetworkError(e.what());
     }
 
+    // Start thread answering retransmission requests and feedback
+    feedback_thread_ = std::jthread(std::bind_front(&TransmitterSatellite::feedback_loop, this));
+    set_thread_name(feedback_thread_, "CDTP_feedback");
+
     // Announce service via CHIRP
     auto* chirp_manager = ManagerLocator::getCHIRPManager();
     if(chirp_manager != nullptr) {
         chirp_manager->registerService(CHIRP::DATA, cdtp_port_);
     }
     LOG(cdtp_logger_, INFO) << "Data will be sent on port " << cdtp_port_;
+
+    // Register transmitter components as framework hooks
+    RoleHooks hooks {};
+    hooks.name = "transmitter";
+    hooks.initializing = [this](Configuration& config) { initializing_transmitter(config); };
+    hooks.reconfiguring = [this](const Configuration& partial_config) { reconfiguring_transmitter(partial_config); };
+    // Run metadata is reset before user starting since it might be modified there, e.g. by marking the run tainted
+    hooks.pre_starting = [this](std::string_view run_identifier) { reset_run(run_identifier); };
+    // Waiting for receivers to connect does not depend on the user starting function and can run in parallel to it
+    hooks.prepare_starting = [this](std::string_view /*run_identifier*/, const Configuration& config, bool /*parallel*/) {
+        prepare_bor(config);
+        await_receivers();
+    };
+    // BOR is sent after user starting since BOR tags might be set there
+    hooks.starting = [this]() { send_bor(); };
+    // EOR is sent after user stopping and interrupting since EOR tags might be set there
+    hooks.stopping = [this]() { stopping_transmitter(); };
+    hooks.interrupting = [this](CSCP::State previous_state) { interrupting_transmitter(previous_state); };
+    register_role(std::move(hooks));
+}
+
+std::size_t TransmitterSatellite::ReceiverMonitor::countReceivers() {
+    const std::lock_guard lock {mutex_};
+    while(check_event(0)) {
+        // Process all pending events
+    }
+    return receivers_;
+}
+
+bool TransmitterSatellite::ReceiverMonitor::awaitReceivers(std::size_t count, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(countReceivers() < count) {
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if(remaining <= 0ms) {
+            return false;
+        }
+        // Wait in short intervals to not block the feedback thread
+        const std::lock_guard lock {mutex_};
+        check_event(static_cast<int>(std::min(remaining, 50ms).count()));
+    }
+    return true;
+}
+
+void TransmitterSatellite::ReceiverMonitor::on_event_handshake_succeeded(const zmq_event_t& /*event*/,
+                                                                         const char* /*addr*/) {
+    ++receivers_;
+}
+
+void TransmitterSatellite::ReceiverMonitor::on_event_handshake_failed_no_detail(const zmq_event_t& /*event*/,
+                                                                               const char* /*addr*/) {
+    ++failed_handshakes_;
+}
+
+void TransmitterSatellite::ReceiverMonitor::on_event_handshake_failed_protocol(const zmq_event_t& /*event*/,
+                                                                              const char* /*addr*/) {
+    ++failed_handshakes_;
+}
+
+void TransmitterSatellite::ReceiverMonitor::on_event_handshake_failed_auth(const zmq_event_t& /*event*/,
+                                                                          const char* /*addr*/) {
+    ++failed_handshakes_;
+}
+
+void TransmitterSatellite::ReceiverMonitor::on_event_disconnected(const zmq_event_t& /*event*/, const char* /*addr*/) {
+    // Disconnects are also reported for connections which failed the handshake and were never counted
+    if(failed_handshakes_ > 0) {
+        --failed_handshakes_;
+    } else if(receivers_ > 0) {
+        --receivers_;
+    }
 }
 
 void TransmitterSatellite::set_send_timeout(std::chrono::milliseconds timeout) {
@@ -91,39 +240,215 @@ TransmitterSatellite::DataMessage TransmitterSatellite::newDataMessage(std::size
 
 bool TransmitterSatellite::trySendDataMessage(TransmitterSatellite::DataMessage& message) {
     // Send data but do not wait for receiver
-    LOG(cdtp_logger_, TRACE) << "Sending data message " << message.getHeader().getSequenceNumber();
+    const auto sent = send_data_message(message, zmq::send_flags::dontwait);
+    LOG_IF(cdtp_logger_, DEBUG, !sent) << "Could not send message " << message.getHeader().getSequenceNumber();
+    return sent;
+}
 
+void TransmitterSatellite::sendDataMessage(TransmitterSatellite::DataMessage& message) {
+    const auto sent = send_data_message(message, zmq::send_flags::none);
+    if(!sent) {
+        throw SendTimeoutError("data message", data_msg_timeout_);
+    }
+}
+
+bool TransmitterSatellite::acquire_inflight_budget(std::size_t bytes, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(!inflight_budget_->acquire(bytes)) {
+        // Dropping retained messages releases their payload if ZeroMQ already sent them
+        if(retransmit_buffer_.dropOldest()) {
+            continue;
+        }
+
+        // Wait in short periods since messages might be retained again by other threads sending meanwhile
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if(remaining <= 0ms) {
+            return false;
+        }
+        if(inflight_budget_->acquire(bytes, std::min<std::chrono::milliseconds>(remaining, 10ms))) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool TransmitterSatellite::send_data_message(TransmitterSatellite::DataMessage& message, zmq::send_flags flags) {
+    LOG(cdtp_logger_, TRACE) << "Sending data message " << message.getHeader().getSequenceNumber();
     try {
         const auto payload_bytes = message.countPayloadBytes();
         const auto payload_frames = message.countPayloadFrames();
-        const auto sent = message.assemble().send(cdtp_push_socket_, static_cast<int>(zmq::send_flags::dontwait));
+
+        // Wait for previously sent payload to be released if the budget is exhausted, unless sending without waiting
+        const auto budget_timeout = (flags == zmq::send_flags::dontwait) ? 0ms : data_msg_timeout_;
+        if(!acquire_inflight_budget(payload_bytes, budget_timeout)) {
+            LOG(cdtp_logger_, DEBUG) << "Payload of " << payload_bytes << " bytes exceeds in-flight budget, "
+                                     << inflight_budget_->bytes() << " bytes in flight";
+            return false;
+        }
+
+        // Payload bytes are returned to the budget once ZeroMQ releases the frames
+        // Compact headers are only used once all connected receivers announced support for them
+        auto frames = message.assemble(isCompactHeaderUsed(), inflight_release_);
+
+        // Datagrams are sent directly from the frames, payload is released when the frames go out of scope
+        if(datagram_sender_) {
+            const auto sent = datagram_sender_->send(
+                sender_id_, message.getHeader().getSequenceNumber(), frames, flags != zmq::send_flags::dontwait);
+            if(sent) {
+                bytes_transmitted_ += payload_bytes;
+                frames_transmitted_ += payload_frames;
+            }
+            return sent;
+        }
+
+        // Retain frames sharing the payload, such that the message can be sent again on request
+        auto retained_frames = retransmit_buffer_.enabled() ? RetransmitBuffer::share(frames) : zmq::multipart_t();
+
+        const auto sent = frames.send(cdtp_push_socket_, static_cast<int>(flags));
         if(sent) {
             bytes_transmitted_ += payload_bytes;
             frames_transmitted_ += payload_frames;
-        } else {
-            LOG(cdtp_logger_, DEBUG) << "Could not send message " << message.getHeader().getSequenceNumber();
+            if(retransmit_buffer_.enabled()) {
+                retransmit_buffer_.store(message.getHeader().getSequenceNumber(), std::move(retained_frames));
+            }
         }
-
         return sent;
     } catch(const zmq::error_t& e) {
         throw NetworkError(e.what());
     }
 }
 
-void TransmitterSatellite::sendDataMessage(TransmitterSatellite::DataMessage& message) {
-    LOG(cdtp_logger_, TRACE) << "Sending data message " << message.getHeader().getSequenceNumber();
-    try {
-        const auto payload_bytes = message.countPayloadBytes();
-        const auto payload_frames = message.countPayloadFrames();
-        const auto sent = message.assemble().send(cdtp_push_socket_);
-        if(!sent) {
-            throw SendTimeoutError("data message", data_msg_timeout_);
+void TransmitterSatellite::feedback_loop(const std::stop_token& stop_token) {
+    while(!stop_token.stop_requested()) {
+        // Run tasks which need the feedback socket, they store their result or exception in their future
+        std::unique_lock feedback_tasks_lock {feedback_tasks_mutex_};
+        auto feedback_tasks = std::exchange(feedback_tasks_, {});
+        feedback_tasks_lock.unlock();
+        for(auto& feedback_task : feedback_tasks) {
+            feedback_task();
         }
-        bytes_transmitted_ += payload_bytes;
-        frames_transmitted_ += payload_frames;
-    } catch(const zmq::error_t& e) {
-        throw NetworkError(e.what());
+
+        try {
+            // Requests consist of the routing ID of the receiver followed by the request frames
+            zmq::multipart_t request {};
+            if(!request.recv(cdtp_feedback_socket_)) {
+                // Discard feedback of receivers which disappeared even if no other receiver sends feedback
+                update_receiver_feedback();
+                continue;
+            }
+            auto routing_id = request.pop();
+
+            // Retransmission requests consist of a single frame, feedback is distinguished by its number of frames
+            if(request.size() == 1) {
+                handle_retransmit_request(routing_id, request);
+            } else if(request.size() == DataFeedback::frames) {
+                handle_feedback(routing_id, request);
+            } else {
+                LOG(cdtp_logger_, WARNING) << "Received invalid request from receiver with " << request.size() << " frames";
+            }
+        } catch(const MessageDecodingError& e) {
+            LOG(cdtp_logger_, WARNING) << "Received invalid request from receiver: " << e.what();
+        } catch(const zmq::error_t& e) {
+            LOG(cdtp_logger_, WARNING) << "Error answering request from receiver: " << e.what();
+        }
+    }
+}
+
+void TransmitterSatellite::handle_retransmit_request(zmq::message_t& routing_id, const zmq::multipart_t& request) {
+    const auto range = RetransmitBuffer::decode_range({to_byte_ptr(request[0].data()), request[0].size()});
+    const auto begin = range.first;
+    const auto end = range.second;
+
+    auto messages = retransmit_buffer_.retrieve(begin, end);
+    LOG(cdtp_logger_, DEBUG) << "Retransmitting " << messages.size() << " of " << end - begin + 1
+                             << " requested messages " << begin << " to " << end;
+
+    // Each reply is preceded by the routing ID and the requested range
+    const auto send_reply = [&](zmq::multipart_t&& reply) {
+        reply.push(RetransmitBuffer::encode_range(begin, end));
+        zmq::message_t reply_routing_id {};
+        reply_routing_id.copy(routing_id);
+        reply.push(std::move(reply_routing_id));
+        reply.send(cdtp_feedback_socket_);
+    };
+    for(auto& message : messages) {
+        send_reply(std::move(message.second));
     }
+    messages_retransmitted_ += messages.size();
+
+    // Final reply without message marks the end of the retransmission
+    send_reply({});
+}
+
+void TransmitterSatellite::handle_feedback(zmq::message_t& routing_id, const zmq::multipart_t& request) {
+    const auto feedback = DataFeedback::disassemble(request);
+
+    std::unique_lock receiver_feedback_lock {receiver_feedback_mutex_};
+    auto receiver = routing_id.to_string();
+    // Receivers only connect for feedback after receiving the BOR, their feedback thus identifies the group members
+    receiver_group_members_.insert(receiver);
+    receiver_feedback_.insert_or_assign(std::move(receiver), ReceiverFeedback(feedback, std::chrono::steady_clock::now()));
+    receiver_feedback_lock.unlock();
+
+    const auto lagging = update_receiver_feedback();
+
+    // Reply with the current sequence number such that the receiver can determine its queue depth
+    auto reply = DataFeedback(seq_.load(), lagging).assemble();
+    reply.push(std::move(routing_id));
+    reply.send(cdtp_feedback_socket_);
+}
+
+bool TransmitterSatellite::update_receiver_feedback() {
+    // Feedback not renewed within a few intervals belongs to receivers which disconnected or stopped receiving
+    constexpr auto feedback_expiry = DataFeedback::interval * 5;
+
+    const auto seq = seq_.load();
+    const auto now = std::chrono::steady_clock::now();
+
+    std::unique_lock receiver_feedback_lock {receiver_feedback_mutex_};
+    std::erase_if(receiver_feedback_, [&](const auto& receiver_feedback_p) {
+        const auto& [receiver, receiver_feedback] = receiver_feedback_p;
+        if(now - receiver_feedback.time < feedback_expiry) {
+            return false;
+        }
+        LOG(cdtp_logger_, DEBUG) << "No feedback from receiver " << receiver << " for " << feedback_expiry
+                                 << ", discarding its feedback";
+        // Messages received by a member of a receiver group remain accounted for
+        discarded_feedback_received_ += receiver_feedback.feedback.getReceived();
+        return true;
+    });
+
+    // The backlog is determined by the slowest receiver, any receiver can signal that it lags behind
+    std::uint64_t backlog = 0;
+    bool lagging = false;
+    std::size_t compact_header_receivers = 0;
+    for(const auto& [receiver, receiver_feedback] : receiver_feedback_) {
+        backlog = std::max(backlog, seq - std::min(seq, receiver_feedback.feedback.getSequenceNumber()));
+        lagging = lagging || receiver_feedback.feedback.isLagging();
+        compact_header_receivers += receiver_feedback.feedback.supportsCompactHeader() ? 1 : 0;
+    }
+    receiver_feedback_lock.unlock();
+
+    // Receivers not sending feedback at all, e.g. older versions, do not support compact headers
+    const auto compact_header =
+        compact_header_receivers > 0 && compact_header_receivers >= cdtp_monitor_.countReceivers();
+    const auto was_compact_header = receivers_compact_header_.exchange(compact_header);
+    LOG_IF(cdtp_logger_, DEBUG, compact_header_ && compact_header != was_compact_header)
+        << (compact_header ? "All receivers support compact headers, using compact header for DATA messages"
+                           : "Not all receivers support compact headers, using MessagePack header for DATA messages");
+
+    const auto watermark = backpressure_watermark_.load();
+    if(watermark > 0 && backlog > watermark) {
+        lagging = true;
+    }
+    receiver_backlog_ = backlog;
+    const auto was_lagging = receivers_lagging_.exchange(lagging);
+    LOG_IF(cdtp_logger_, WARNING, lagging && !was_lagging)
+        << "Receivers are lagging behind, " << backlog << " messages sent but not yet processed";
+    LOG_IF(cdtp_logger_, INFO, !lagging && was_lagging) << "Receivers caught up with the data stream";
+
+    return lagging;
 }
 
 void TransmitterSatellite::initializing_transmitter(Configuration& config) {
@@ -132,6 +457,24 @@ void TransmitterSatellite::initializing_transmitter(Configuration& config) {
     data_msg_timeout_ = std::chrono::seconds(config.get<std::uint64_t>("_data_timeout", 10));
     LOG(cdtp_logger_, DEBUG) << "Timeout for BOR message " << data_bor_timeout_ << ", for EOR message " << data_eor_timeout_
                              << ", for DATA message " << data_msg_timeout_;
+    compact_header_ = config.get<bool>("_compact_header", false);
+    LOG_IF(cdtp_logger_, DEBUG, compact_header_) << "Using compact header for DATA messages if supported by all receivers";
+
+    // Reset transport to its defaults, which are only overwritten by parameters present in the configuration
+    data_transport_ = CDTP::Transport::TCP;
+    udp_address_ = asio::ip::address_v4::loopback();
+    udp_port_ = 0;
+    udp_interface_ = asio::ip::address_v4::any();
+    udp_datagram_size_ = DatagramSender::default_datagram_size;
+    datagram_sender_.reset();
+
+    configure_receiver_group(config);
+    configure_retransmit_buffer(config);
+    backpressure_watermark_ = config.get<std::uint64_t>("_backpressure_watermark", 0);
+    LOG_IF(cdtp_logger_, DEBUG, backpressure_watermark_ > 0)
+        << "Considering receivers lagging with more than " << backpressure_watermark_.load() << " messages queued";
+    configure_inflight_budget(config);
+    configure_transport(config);
 }
 
 void TransmitterSatellite::reconfiguring_transmitter(const Configuration& partial_config) {
@@ -147,9 +490,103 @@ void TransmitterSatellite::reconfiguring_transmitter(const Configuration& partia
         data_msg_timeout_ = std::chrono::seconds(partial_config.get<std::uint64_t>("_data_timeout"));
         LOG(cdtp_logger_, DEBUG) << "Reconfigured timeout for DATA message: " << data_msg_timeout_;
     }
+    if(partial_config.has("_compact_header")) {
+        compact_header_ = partial_config.get<bool>("_compact_header");
+        LOG(cdtp_logger_, DEBUG) << "Reconfigured compact header for DATA messages: " << compact_header_;
+    }
+    if(partial_config.has("_receiver_group_size")) {
+        configure_receiver_group(partial_config);
+    }
+    if(partial_config.has("_retransmit_buffer") || partial_config.has("_retransmit_time")) {
+        configure_retransmit_buffer(partial_config);
+    }
+    if(partial_config.has("_backpressure_watermark")) {
+        backpressure_watermark_ = partial_config.get<std::uint64_t>("_backpressure_watermark");
+        LOG(cdtp_logger_, DEBUG) << "Reconfigured backpressure watermark: " << backpressure_watermark_.load();
+    }
+    if(partial_config.has("_max_inflight_bytes")) {
+        configure_inflight_budget(partial_config);
+    }
+    if(partial_config.has("_data_transport") || partial_config.has("_udp_address") || partial_config.has("_udp_port") ||
+       partial_config.has("_udp_interface") || partial_config.has("_udp_datagram_size")) {
+        configure_transport(partial_config);
+    }
 }
 
-void TransmitterSatellite::starting_transmitter(std::string_view run_identifier, const config::Configuration& config) {
+void TransmitterSatellite::configure_retransmit_buffer(const Configuration& config) {
+    const auto max_messages = config.get<std::size_t>("_retransmit_buffer", 0);
+    const auto max_age = std::chrono::seconds(config.get<std::uint64_t>("_retransmit_time", 10));
+    retransmit_buffer_.configure(max_messages, max_age);
+    LOG_IF(cdtp_logger_, INFO, retransmit_buffer_.enabled())
+        << "Retaining up to " << max_messages << " data messages for " << max_age << " for retransmission";
+}
+
+void TransmitterSatellite::configure_inflight_budget(const Configuration& config) {
+    const auto max_bytes = config.get<std::size_t>("_max_inflight_bytes", 0);
+    inflight_budget_->configure(max_bytes);
+    LOG_IF(cdtp_logger_, INFO, inflight_budget_->enabled()) << "Limiting payload in flight to " << max_bytes << " bytes";
+}
+
+void TransmitterSatellite::configure_transport(const Configuration& config) {
+    const auto get_address = [&](const std::string& key, const asio::ip::address_v4& current) {
+        if(!config.has(key)) {
+            return current;
+        }
+        try {
+            return asio::ip::make_address_v4(config.get<std::string>(key));
+        } catch(const asio::system_error&) {
+            throw InvalidValueError(config, key, "not a valid IPv4 address");
+        }
+    };
+
+    const auto data_transport = config.get<CDTP::Transport>("_data_transport", data_transport_);
+    const auto udp_address = get_address("_udp_address", udp_address_);
+    const auto udp_port = config.get<Port>("_udp_port", udp_port_);
+    const auto udp_interface = get_address("_udp_interface", udp_interface_);
+    const auto udp_datagram_size = config.get<std::size_t>("_udp_datagram_size", udp_datagram_size_);
+
+    std::unique_ptr<DatagramSender> datagram_sender {};
+    if(data_transport == CDTP::Transport::UDP) {
+        // Datagrams are not distributed round-robin, every receiver joining the address would receive all messages
+        if(receiver_group_size_ > 1) {
+            throw InvalidValueError(
+                std::string(enum_name(data_transport)), "_data_transport", "receiver groups require the TCP transport");
+        }
+        if(udp_port == 0) {
+            throw MissingKeyError("_udp_port");
+        }
+        if(udp_datagram_size <= DatagramHeader::size || udp_datagram_size > DatagramSender::max_datagram_size) {
+            throw InvalidValueError(
+                to_string(udp_datagram_size), "_udp_datagram_size", "not between header size and maximum UDP payload");
+        }
+        datagram_sender = std::make_unique<DatagramSender>(udp_address, udp_port, udp_interface, udp_datagram_size);
+    }
+
+    data_transport_ = data_transport;
+    udp_address_ = udp_address;
+    udp_port_ = udp_port;
+    udp_interface_ = udp_interface;
+    udp_datagram_size_ = udp_datagram_size;
+    datagram_sender_ = std::move(datagram_sender);
+    LOG_IF(cdtp_logger_, INFO, datagram_sender_ != nullptr)
+        << "Data messages will be sent lossy via UDP to " << to_uri(udp_address_, udp_port_, "udp")
+        << " in datagrams of up to " << udp_datagram_size_ << " bytes";
+}
+
+void TransmitterSatellite::configure_receiver_group(const Configuration& config) {
+    const auto receiver_group_size = config.get<std::size_t>("_receiver_group_size", 1);
+    if(receiver_group_size == 0) {
+        throw InvalidValueError(config, "_receiver_group_size", "group needs at least one receiver");
+    }
+    if(receiver_group_size > 1 && data_transport_ == CDTP::Transport::UDP) {
+        throw InvalidValueError(config, "_receiver_group_size", "receiver groups require the TCP transport");
+    }
+    receiver_group_size_ = receiver_group_size;
+    LOG_IF(cdtp_logger_, INFO, receiver_group_size_ > 1)
+        << "Distributing data over a group of " << receiver_group_size_ << " receivers";
+}
+
+void TransmitterSatellite::reset_run(std::string_view run_identifier) {
     // Reset bytes and frames transmitted metrics
     bytes_transmitted_ = 0;
     frames_transmitted_ = 0;
@@ -164,22 +601,76 @@ void TransmitterSatellite::starting_transmitter(std::string_view run_identifier,
     set_run_metadata_tag("version_full", "Constellation " CNSTLN_VERSION_FULL);
     set_run_metadata_tag("run_id", run_identifier);
     set_run_metadata_tag("time_start", std::chrono::system_clock::now());
+}
+
+void TransmitterSatellite::prepare_bor(const config::Configuration& config) {
+    // Reset retransmission buffer and metric
+    retransmit_buffer_.clear();
+    messages_retransmitted_ = 0;
+    STAT("MESSAGES_RETRANSMITTED", 0);
+
+    // Reset feedback from receivers of the previous run
+    std::unique_lock receiver_feedback_lock {receiver_feedback_mutex_};
+    receiver_feedback_.clear();
+    discarded_feedback_received_ = 0;
+    receiver_group_members_.clear();
+    receiver_feedback_lock.unlock();
+    receiver_backlog_ = 0;
+    receivers_lagging_ = false;
+    receivers_compact_header_ = false;
+    STAT("RECEIVER_BACKLOG", 0);
+    STAT("RECEIVERS_LAGGING", false);
 
-    // Create CDTP1 message for BOR
-    CDTP1Message msg {{getCanonicalName(), seq_, CDTP1Message::Type::BOR, bor_tags_}, 1};
-    msg.addPayload(config.getDictionary().assemble());
+    // Pre-assemble configuration for BOR
+    bor_payload_ = config.getDictionary().assemble();
+}
+
+void TransmitterSatellite::await_receivers() {
+    // Every member of a receiver group needs to be connected to receive a copy of the BOR
+    const auto receivers = std::max<std::size_t>(receiver_group_size_, 1);
+    LOG(cdtp_logger_, DEBUG) << "Waiting for " << receivers << " receivers to connect (timeout " << data_bor_timeout_
+                             << ")";
+    if(!cdtp_monitor_.awaitReceivers(receivers, data_bor_timeout_)) {
+        throw SendTimeoutError(receivers > 1 ? "BOR message to " + std::to_string(receivers) + " receivers"
+                                             : "BOR message",
+                               data_bor_timeout_);
+    }
+    LOG_IF(cdtp_logger_, WARNING, receiver_group_size_ > 1 && cdtp_monitor_.countReceivers() > receiver_group_size_)
+        << "More receivers than configured in the receiver group connected, not all of them will receive the BOR";
+}
+
+void TransmitterSatellite::send_bor() {
+    // Create CDTP1 message for BOR, tags might have been set during starting
+    CDTP1Message msg {{getCanonicalName(), seq_.load(), CDTP1Message::Type::BOR, bor_tags_}, 1};
+    msg.addPayload(std::move(bor_payload_));
+
+    // Announce port for feedback and, if enabled, for retransmission requests
+    msg.getHeader().setTag("feedback_port", cdtp_feedback_port_);
+    if(retransmit_buffer_.enabled() && !datagram_sender_) {
+        msg.getHeader().setTag("retransmit_port", cdtp_feedback_port_);
+    }
+
+    // Announce address, port and size of the datagrams, BOR and EOR are still sent reliably via the CDTP socket
+    if(datagram_sender_) {
+        msg.getHeader().setTag("udp_address", udp_address_.to_string());
+        msg.getHeader().setTag("udp_port", udp_port_);
+        msg.getHeader().setTag("udp_datagram_size", udp_datagram_size_);
+    }
+
+    // Receivers are already connected, see await_receivers()
+    if(receiver_group_size_ > 1) {
+        msg.getHeader().setTag("receiver_group_size", receiver_group_size_);
+    }
 
     // Send BOR
     LOG(cdtp_logger_, DEBUG) << "Sending BOR message (timeout " << data_bor_timeout_ << ")";
     // Note: this is not interruptible, thus we set a send timeout to hang if no data receiver
     set_send_timeout(data_bor_timeout_);
-    try {
-        const auto sent = msg.assemble().send(cdtp_push_socket_);
-        if(!sent) {
-            throw SendTimeoutError("BOR message", data_bor_timeout_);
-        }
-    } catch(const zmq::error_t& e) {
-        throw networking::NetworkError(e.what());
+    if(!send_run_message(msg, receiver_group_size_)) {
+        throw SendTimeoutError("BOR message", data_bor_timeout_);
+    }
+    if(receiver_group_size_ > 1) {
+        await_receiver_group_members();
     }
     LOG(cdtp_logger_, DEBUG) << "Sent BOR message";
 
@@ -190,6 +681,111 @@ void TransmitterSatellite::starting_transmitter(std::string_view run_identifier,
     bor_tags_ = {};
 }
 
+bool TransmitterSatellite::send_run_message(CDTP1Message& msg, std::size_t copies) {
+    try {
+        auto frames = msg.assemble();
+        for(std::size_t copy = 1; copy < copies; ++copy) {
+            if(!frames.clone().send(cdtp_push_socket_)) {
+                return false;
+            }
+        }
+        return frames.send(cdtp_push_socket_);
+    } catch(const zmq::error_t& e) {
+        throw networking::NetworkError(e.what());
+    }
+}
+
+void TransmitterSatellite::await_receiver_group_members() {
+    const auto count_members = [&]() {
+        const std::lock_guard receiver_feedback_lock {receiver_feedback_mutex_};
+        return receiver_group_members_.size();
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() + data_bor_timeout_;
+    auto members = count_members();
+    while(members < receiver_group_size_ && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+        members = count_members();
+    }
+    if(members < receiver_group_size_) {
+        throw SendTimeoutError("BOR message to " + std::to_string(receiver_group_size_) + " receivers, only " +
+                                   std::to_string(members) + " confirmed it",
+                               data_bor_timeout_);
+    }
+}
+
+std::size_t TransmitterSatellite::send_group_message(CDTP1Message& msg) {
+    std::unique_lock receiver_feedback_lock {receiver_feedback_mutex_};
+    const auto members = receiver_group_members_;
+    receiver_feedback_lock.unlock();
+
+    const auto frames = msg.assemble();
+    std::size_t sent = 0;
+    std::packaged_task<void()> send_task {[&]() {
+        // Fail instead of dropping the message silently if a member disconnected or its queue is full
+        cdtp_feedback_socket_.set(zmq::sockopt::router_mandatory, true);
+        for(const auto& member : members) {
+            auto member_frames = frames.clone();
+            member_frames.push(zmq::message_t(member.data(), member.size()));
+            try {
+                if(member_frames.send(cdtp_feedback_socket_, static_cast<int>(zmq::send_flags::dontwait))) {
+                    ++sent;
+                    continue;
+                }
+                LOG(cdtp_logger_, WARNING) << "Could not send message to receiver group member " << member
+                                           << ", its queue is full";
+            } catch(const zmq::error_t& e) {
+                LOG(cdtp_logger_, WARNING) << "Could not send message to receiver group member " << member << ": "
+                                           << e.what();
+            }
+        }
+        cdtp_feedback_socket_.set(zmq::sockopt::router_mandatory, false);
+    }};
+
+    // Wait until the feedback thread sent the message
+    auto send_future = send_task.get_future();
+    std::unique_lock feedback_tasks_lock {feedback_tasks_mutex_};
+    feedback_tasks_.push_back(std::move(send_task));
+    feedback_tasks_lock.unlock();
+    try {
+        send_future.get();
+    } catch(const zmq::error_t& e) {
+        throw networking::NetworkError(e.what());
+    }
+    return sent;
+}
+
+std::uint64_t TransmitterSatellite::await_receiver_group(std::uint64_t sent) {
+    const auto count_received = [&]() {
+        const std::lock_guard receiver_feedback_lock {receiver_feedback_mutex_};
+        std::uint64_t received = discarded_feedback_received_;
+        for(const auto& [receiver, receiver_feedback] : receiver_feedback_) {
+            received += receiver_feedback.feedback.getReceived();
+        }
+        return received;
+    };
+
+    // Members report their progress when their queue runs empty
+    LOG(cdtp_logger_, DEBUG) << "Waiting for receiver group to report " << sent << " messages as received";
+    const auto deadline = std::chrono::steady_clock::now() + data_eor_timeout_;
+    auto received = count_received();
+    while(received < sent && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+        received = count_received();
+    }
+
+    const auto missed = sent - std::min(sent, received);
+    std::unique_lock receiver_feedback_lock {receiver_feedback_mutex_};
+    for(const auto& [receiver, receiver_feedback] : receiver_feedback_) {
+        LOG(cdtp_logger_, DEBUG) << "Receiver group member " << receiver << " received "
+                                 << receiver_feedback.feedback.getReceived() << " messages";
+    }
+    receiver_feedback_lock.unlock();
+    LOG_IF(cdtp_logger_, WARNING, missed > 0)
+        << "Receiver group reported only " << received << " of " << sent << " messages as received";
+    return missed;
+}
+
 void TransmitterSatellite::send_eor() {
     set_run_metadata_tag("time_end", std::chrono::system_clock::now());
 
@@ -197,17 +793,27 @@ void TransmitterSatellite::send_eor() {
     CDTP1Message msg {{getCanonicalName(), ++seq_, CDTP1Message::Type::EOR, eor_tags_}, 1};
     msg.addPayload(run_metadata_.assemble());
 
+    // Members of a receiver group cannot determine missed messages from the sequence numbers they received
+    if(receiver_group_size_ > 1) {
+        msg.getHeader().setTag("receiver_group_missed", await_receiver_group(msg.getHeader().getSequenceNumber() - 1));
+    }
+
     // Send EOR
     LOG(cdtp_logger_, DEBUG) << "Sending EOR message (" << data_eor_timeout_ << ")";
-    // Note: this is not interruptible, thus we set a send timeout to prevent hang if no data receiver
-    set_send_timeout(data_eor_timeout_);
-    try {
-        const auto sent = msg.assemble().send(cdtp_push_socket_);
-        if(!sent) {
+    if(receiver_group_size_ > 1) {
+        // Members of a receiver group which disconnected cannot receive the EOR anyway
+        const auto sent = send_group_message(msg);
+        LOG_IF(cdtp_logger_, WARNING, sent < receiver_group_size_)
+            << "Sent EOR message to only " << sent << " of " << receiver_group_size_ << " receivers";
+        if(sent == 0) {
+            throw SendTimeoutError("EOR message", data_eor_timeout_);
+        }
+    } else {
+        // Note: this is not interruptible, thus we set a send timeout to prevent hang if no data receiver
+        set_send_timeout(data_eor_timeout_);
+        if(!send_run_message(msg)) {
             throw SendTimeoutError("EOR message", data_eor_timeout_);
         }
-    } catch(const zmq::error_t& e) {
-        throw networking::NetworkError(e.what());
     }
     LOG(cdtp_logger_, DEBUG) << "Sent EOR message";
 
@@ -13,21 +13,37 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <stop_token>
 #include <string_view>
+#include <thread>
 #include <utility>
 
+#include <asio/ip/address_v4.hpp>
 #include <zmq.hpp>
 
 #include "constellation/build.hpp"
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/log/Logger.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/DataFeedback.hpp"
+#include "constellation/core/message/FrameView.hpp"
+#include "constellation/core/message/InFlightBudget.hpp"
 #include "constellation/core/message/PayloadBuffer.hpp"
+#include "constellation/core/message/RetransmitBuffer.hpp"
+#include "constellation/core/networking/Datagram.hpp"
 #include "constellation/core/networking/Port.hpp"
+#include "constellation/core/protocol/CDTP_definitions.hpp"
 #include "constellation/core/protocol/CSCP_definitions.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/string_hash_map.hpp"
 #include "constellation/satellite/BaseSatellite.hpp"
 #include "constellation/satellite/Satellite.hpp"
 
@@ -57,6 +73,15 @@ namespace constellation::satellite {
              */
             template <typename T> void addTag(const std::string& key, const T& value) { getHeader().setTag(key, value); }
 
+            /**
+             * @brief Tag the element type of the frames in the message
+             *
+             * This allows receivers to check the element type when obtaining typed views via `message::frame_view()`.
+             */
+            template <config::typed_array_element T> void addFrameType() {
+                getHeader().setTag(std::string(message::frame_dtype_tag), message::frame_dtype<T>());
+            }
+
             /**
              * @brief Obtain current number of frames in this message
              *
@@ -75,6 +100,54 @@ namespace constellation::satellite {
                 : message::CDTP1Message({std::move(sender), seq, message::CDTP1Message::Type::DATA}, frames) {}
         };
 
+        /**
+         * @brief Monitor of the CDTP socket counting the connected receivers
+         *
+         * Only connections which completed the handshake are counted. Connections failing the handshake are reported with a
+         * failure event before their disconnect, which is used to skip their disconnect since handshake events do not
+         * identify the connection.
+         *
+         * Events are processed by the satellite and the feedback thread, access is synchronized by the monitor.
+         */
+        class ReceiverMonitor : public zmq::monitor_t {
+        public:
+            /**
+             * @brief Process pending socket events
+             *
+             * @return Number of currently connected receivers
+             */
+            std::size_t countReceivers();
+
+            /**
+             * @brief Wait until a given number of receivers is connected
+             *
+             * @param count Number of receivers to wait for
+             * @param timeout Timeout after which to stop waiting
+             * @return True if the number of receivers is connected, false if the timeout was reached
+             */
+            bool awaitReceivers(std::size_t count, std::chrono::milliseconds timeout);
+
+        private:
+            void on_event_handshake_succeeded(const zmq_event_t& event, const char* addr) final;
+            void on_event_handshake_failed_no_detail(const zmq_event_t& event, const char* addr) final;
+            void on_event_handshake_failed_protocol(const zmq_event_t& event, const char* addr) final;
+            void on_event_handshake_failed_auth(const zmq_event_t& event, const char* addr) final;
+            void on_event_disconnected(const zmq_event_t& event, const char* addr) final;
+
+        private:
+            std::mutex mutex_;
+            std::size_t receivers_ {0};
+            std::size_t failed_handshakes_ {0};
+        };
+
+        /**
+         * @brief Feedback of a receiver together with the time it was received
+         */
+        struct ReceiverFeedback {
+            message::DataFeedback feedback;
+            std::chrono::steady_clock::time_point time;
+        };
+
     public:
         /**
          * @brief Create new message for attaching data frames
@@ -92,6 +165,9 @@ namespace constellation::satellite {
          * @note The return value of this function *has* to be checked. If it is `false`, one should take action such as
          *       discarding the message, trying to send it again or throwing an exception.
          *
+         * @note If the `_max_inflight_bytes` parameter is set, sending fails if the payload would exceed the limit. The
+         *       message is left untouched in this case and can be sent again.
+         *
          * @param message Reference to data message
          * @return True if the message was successfully sent/queued, false otherwise
          */
@@ -101,7 +177,8 @@ namespace constellation::satellite {
          * @brief Send data message created with `newDataMessage()`
          *
          * @note This method will block until the message has been sent *or* the timeout for sending data messages has been
-         *       reached. In the latter case, a SendTimeoutError exception is thrown.
+         *       reached. In the latter case, a SendTimeoutError exception is thrown. If the `_max_inflight_bytes` parameter
+         *       is set, this includes waiting for previously sent payload to be released.
          *
          * @param message Reference to data message
          * @throw SendTimeoutError If data send timeout is reached
@@ -129,6 +206,46 @@ namespace constellation::satellite {
             eor_tags_[utils::transform(key, ::tolower)] = value;
         }
 
+        /**
+         * @brief Check if receivers signal that they lag behind the data stream
+         *
+         * Receivers regularly report the last processed message and whether messages are queued up continuously. This
+         * allows to adapt the data rate before sending blocks or data is lost, e.g. by only sending a fraction of the
+         * events. The receivers are also considered lagging if the number of messages sent but not yet processed exceeds
+         * the `_backpressure_watermark` parameter.
+         *
+         * @return True if any receiver lags behind, false otherwise
+         */
+        bool isReceiverLagging() const { return receivers_lagging_.load(); }
+
+        /**
+         * @brief Check if DATA messages are sent with the compact header
+         *
+         * The compact header is used if enabled via the `_compact_header` parameter and all connected receivers announced
+         * support for it in their feedback.
+         *
+         * @return True if the compact header is used, false if the MessagePack header is used
+         */
+        bool isCompactHeaderUsed() const { return compact_header_ && receivers_compact_header_.load(); }
+
+        /**
+         * @brief Get the number of messages sent but not yet processed by the slowest receiver
+         *
+         * @note This value is updated whenever receivers report their progress, i.e. it is only approximate.
+         *
+         * @return Number of messages queued for the slowest receiver
+         */
+        std::uint64_t getReceiverBacklog() const { return receiver_backlog_.load(); }
+
+        /**
+         * @brief Get the number of payload bytes sent but not yet released by the network layer
+         *
+         * Payload is released once it has been written to the network and is no longer retained for retransmission.
+         *
+         * @return Number of payload bytes in flight
+         */
+        std::size_t getInFlightBytes() const { return inflight_budget_->bytes(); }
+
         /**
          * @brief Return the ephemeral port number to which the CDTP socket is bound to
          */
@@ -144,9 +261,6 @@ namespace constellation::satellite {
         TransmitterSatellite(std::string_view type, std::string_view name);
 
     private:
-        // Needs access to transmitter specific functions
-        friend BaseSatellite;
-
         /**
          * @brief Initialize transmitter components of satellite
          *
@@ -154,6 +268,17 @@ namespace constellation::satellite {
          * * `_bor_timeout`
          * * `_eor_timeout
          * * `_data_timeout`
+         * * `_compact_header`
+         * * `_receiver_group_size`
+         * * `_retransmit_buffer`
+         * * `_retransmit_time`
+         * * `_backpressure_watermark`
+         * * `_max_inflight_bytes`
+         * * `_data_transport`
+         * * `_udp_address`
+         * * `_udp_port`
+         * * `_udp_interface`
+         * * `_udp_datagram_size`
          *
          * @param config Configuration of the satellite
          */
@@ -166,21 +291,57 @@ namespace constellation::satellite {
          * * `_bor_timeout`
          * * `_eor_timeout`
          * * `_data_timeout`
+         * * `_compact_header`
+         * * `_receiver_group_size`
+         * * `_retransmit_buffer`
+         * * `_retransmit_time`
+         * * `_backpressure_watermark`
+         * * `_max_inflight_bytes`
+         * * `_data_transport`
+         * * `_udp_address`
+         * * `_udp_port`
+         * * `_udp_interface`
+         * * `_udp_datagram_size`
          *
          * @param partial_config Changes to the configuration of the satellite
          */
         void reconfiguring_transmitter(const config::Configuration& partial_config);
 
         /**
-         * @brief Start transmitter components of satellite
+         * @brief Reset run metadata, sequence counter and metrics for a new run
          *
-         * This functions sends the BOR message.
+         * This function is executed before the user starting function, since the run metadata might be modified there.
          *
          * @param run_identifier Run identifier for the upcoming run
+         */
+        void reset_run(std::string_view run_identifier);
+
+        /**
+         * @brief Prepare transmitter components for a new run
+         *
+         * This function resets the retransmission buffer and receiver feedback and pre-assembles the BOR payload. It does
+         * not depend on any action of the user starting function and can thus be executed in parallel to it.
+         *
          * @param config Configuration to send in BOR message
-         * @throw SendTimeoutError If BOR send timeout is reached
          */
-        void starting_transmitter(std::string_view run_identifier, const config::Configuration& config);
+        void prepare_bor(const config::Configuration& config);
+
+        /**
+         * @brief Wait until all receivers of the BOR message are connected
+         *
+         * This waits for a single receiver or for all members of the receiver group. Like `prepare_bor()`, it is executed
+         * in parallel to the user starting function if enabled.
+         *
+         * @throw SendTimeoutError If not all receivers connected within the BOR timeout
+         */
+        void await_receivers();
+
+        /**
+         * @brief Send the BOR message prepared with `prepare_bor()`
+         *
+         * @throw SendTimeoutError If BOR send timeout is reached or not all members of the receiver group confirmed the BOR
+         */
+        void send_bor();
 
         /**
          * @brief Stop transmitter components of satellite and send the EOR
@@ -207,6 +368,145 @@ namespace constellation::satellite {
          */
         void set_send_timeout(std::chrono::milliseconds timeout = std::chrono::milliseconds(-1));
 
+        /**
+         * @brief Configure the number of receivers sharing the data stream
+         *
+         * @param config Configuration containing the `_receiver_group_size` parameter
+         * @throw InvalidValueError If the group size is zero
+         */
+        void configure_receiver_group(const config::Configuration& config);
+
+        /**
+         * @brief Configure the bounds of the retransmission buffer
+         *
+         * @param config Configuration containing the `_retransmit_buffer` and `_retransmit_time` parameters
+         */
+        void configure_retransmit_buffer(const config::Configuration& config);
+
+        /**
+         * @brief Configure the limit of payload bytes in flight
+         *
+         * @param config Configuration containing the `_max_inflight_bytes` parameter
+         */
+        void configure_inflight_budget(const config::Configuration& config);
+
+        /**
+         * @brief Configure the transport of data messages
+         *
+         * Parameters missing in the configuration keep their current value, such that the transport can be reconfigured
+         * with a partial configuration.
+         *
+         * @param config Configuration containing the `_data_transport` and `_udp_*` parameters
+         * @throw InvalidValueError If the UDP transport is misconfigured or combined with a receiver group
+         * @throw NetworkError If the UDP socket could not be opened
+         */
+        void configure_transport(const config::Configuration& config);
+
+        /**
+         * @brief Acquire payload bytes from the in-flight budget
+         *
+         * Messages retained for retransmission keep their payload in flight until they are evicted. If the budget is
+         * exhausted, the oldest retained messages are dropped before waiting for ZeroMQ to release payload, such that
+         * retained messages can never block sending.
+         *
+         * @param bytes Number of payload bytes to acquire
+         * @param timeout Maximum time to wait for payload to be released
+         * @return True if the bytes were acquired, false if the timeout was reached
+         */
+        bool acquire_inflight_budget(std::size_t bytes, std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Assemble and send a data message, and retain it for retransmission if enabled
+         *
+         * The payload bytes of the message are acquired from the in-flight budget before sending and released again once
+         * ZeroMQ released the payload frames. If the budget is exhausted, the message is not sent. With the UDP transport,
+         * the message is sent as datagrams and not retained for retransmission.
+         *
+         * @param message Reference to data message
+         * @param flags Flags for sending the message
+         * @return True if the message was successfully sent/queued, false otherwise
+         */
+        bool send_data_message(DataMessage& message, zmq::send_flags flags);
+
+        /**
+         * @brief Loop answering retransmission requests and feedback from receivers
+         *
+         * The loop also runs the tasks queued in `feedback_tasks_`, since the feedback socket must only be used from this
+         * thread.
+         *
+         * @param stop_token Token to stop the loop
+         */
+        void feedback_loop(const std::stop_token& stop_token);
+
+        /**
+         * @brief Send the retained messages of a requested range of sequence numbers to a receiver
+         *
+         * @param routing_id Routing ID of the requesting receiver
+         * @param request Frames of the request without routing ID
+         * @throw MessageDecodingError If the request could not be decoded
+         */
+        void handle_retransmit_request(zmq::message_t& routing_id, const zmq::multipart_t& request);
+
+        /**
+         * @brief Store the feedback of a receiver and reply with the current sequence number
+         *
+         * @param routing_id Routing ID of the receiver
+         * @param request Frames of the feedback without routing ID
+         * @throw MessageDecodingError If the feedback could not be decoded
+         */
+        void handle_feedback(zmq::message_t& routing_id, const zmq::multipart_t& request);
+
+        /**
+         * @brief Discard feedback of receivers which stopped sending it and update the backlog and lagging state
+         *
+         * @return Whether the receivers are considered lagging behind
+         */
+        bool update_receiver_feedback();
+
+        /**
+         * @brief Wait until the members of the receiver group reported all sent messages as received
+         *
+         * Since data messages are distributed by the socket, messages missed by a group can only be determined from the sum
+         * of the messages each member reported as received in its feedback. Waits at most for the EOR timeout.
+         *
+         * @param sent Number of data messages sent in the current run
+         * @return Number of data messages not received by any member of the group
+         */
+        std::uint64_t await_receiver_group(std::uint64_t sent);
+
+        /**
+         * @brief Send a BOR or EOR message via the CDTP socket
+         *
+         * Since the socket distributes messages round-robin over the connected receivers which can accept them, sending one
+         * copy per receiver delivers the BOR to each member of a receiver group, whose connections are still empty.
+         *
+         * @param msg BOR or EOR message to send
+         * @param copies Number of receivers to send the message to
+         * @return True if all copies were sent, false if the send timeout was reached
+         */
+        bool send_run_message(message::CDTP1Message& msg, std::size_t copies = 1);
+
+        /**
+         * @brief Wait until every member of the receiver group confirmed the BOR
+         *
+         * Members connect to the feedback service announced in the BOR, thus their first feedback confirms that they
+         * received the BOR and identifies them for `send_group_message()`. Waits at most for the BOR timeout.
+         *
+         * @throw SendTimeoutError If not all members confirmed the BOR within the BOR timeout
+         */
+        void await_receiver_group_members();
+
+        /**
+         * @brief Send a message to each member of the receiver group via its feedback connection
+         *
+         * Members are addressed explicitly, such that each of them obtains exactly one copy even if the CDTP socket skips
+         * members which stopped reading. The message is sent from the feedback thread which owns the feedback socket.
+         *
+         * @param msg Message to send
+         * @return Number of members to which the message was sent
+         */
+        std::size_t send_group_message(message::CDTP1Message& msg);
+
         /**
          * @brief Send the EOR message
          *
@@ -223,18 +523,46 @@ namespace constellation::satellite {
 
     private:
         zmq::socket_t cdtp_push_socket_;
+        ReceiverMonitor cdtp_monitor_;
         networking::Port cdtp_port_;
+        zmq::socket_t cdtp_feedback_socket_;
+        networking::Port cdtp_feedback_port_;
+        message::RetransmitBuffer retransmit_buffer_;
+        std::shared_ptr<message::InFlightBudget> inflight_budget_;
+        message::PayloadBuffer::ReleaseCallback inflight_release_;
+        protocol::CDTP::Transport data_transport_ {protocol::CDTP::Transport::TCP};
+        asio::ip::address_v4 udp_address_;
+        networking::Port udp_port_ {0};
+        asio::ip::address_v4 udp_interface_;
+        std::size_t udp_datagram_size_ {networking::DatagramSender::default_datagram_size};
+        std::unique_ptr<networking::DatagramSender> datagram_sender_;
+        std::uint64_t sender_id_;
         log::Logger cdtp_logger_;
         std::chrono::seconds data_bor_timeout_ {};
         std::chrono::seconds data_eor_timeout_ {};
         std::chrono::seconds data_msg_timeout_ {};
-        std::uint64_t seq_ {};
+        bool compact_header_ {false};
+        std::size_t receiver_group_size_ {1};
+        std::atomic_uint64_t seq_;
         config::Dictionary bor_tags_;
+        message::PayloadBuffer bor_payload_;
         config::Dictionary eor_tags_;
         config::Dictionary run_metadata_;
         bool mark_run_tainted_ {false};
         std::atomic_size_t bytes_transmitted_;
         std::atomic_size_t frames_transmitted_;
+        std::atomic_size_t messages_retransmitted_;
+        std::atomic_uint64_t backpressure_watermark_;
+        utils::string_hash_map<ReceiverFeedback> receiver_feedback_;
+        std::uint64_t discarded_feedback_received_ {};
+        std::set<std::string> receiver_group_members_;
+        std::mutex receiver_feedback_mutex_;
+        std::atomic_uint64_t receiver_backlog_;
+        std::atomic_bool receivers_lagging_;
+        std::atomic_bool receivers_compact_header_;
+        std::deque<std::packaged_task<void()>> feedback_tasks_;
+        std::mutex feedback_tasks_mutex_;
+        std::jthread feedback_thread_;
     };
 
 } // namespace constellation::satellite
@@ -96,12 +96,8 @@ void LogStatusBar::countMessage(Level level) {
 void LogItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
     auto options = option;
 
-    // Get sibling for column 2 (where the log level is stored) for current row:
-    const QModelIndex lvl_index = index.sibling(index.row(), 2);
-
-    // Get log level color
-    const auto level_str = lvl_index.data().toString().toStdString();
-    const auto level = enum_cast<Level>(level_str).value_or(WARNING);
+    // Get log level color, the level is provided by the model as integer in the user role
+    const auto level = enum_cast<Level>(index.data(Qt::UserRole).toInt()).value_or(WARNING);
 
     const auto color = get_log_level_color(level);
     if(level > Level::INFO) {
@@ -122,11 +118,14 @@ QString LogItemDelegate::displayText(const QVariant& value, const QLocale& local
     return QStyledItemDelegate::displayText(value, locale);
 }
 
-Observatory::Observatory(std::string_view group_name) : logger_("UI") {
+Observatory::Observatory(std::string_view group_name, std::size_t max_messages) : logger_("UI") {
 
     qRegisterMetaType<QModelIndex>("QModelIndex");
     setupUi(this);
 
+    // Set message retention before any message is received
+    log_listener_.setMaxMessages(max_messages);
+
     setWindowTitle("Constellation Observatory " CNSTLN_VERSION_FULL);
 
     // Connect signals:
@@ -286,6 +285,12 @@ namespace {
         // Console log level (-l)
         parser.add_argument("-l", "--level").help("log level").default_value("INFO");
 
+        // Maximum number of retained log messages (-m)
+        parser.add_argument("-m", "--max-messages")
+            .help("maximum number of log messages retained")
+            .scan<'u', std::size_t>()
+            .default_value(QLogListener::default_max_messages);
+
         // Broadcast address (--brd)
         parser.add_argument("--brd").help("broadcast address");
 
@@ -412,8 +417,16 @@ int main(int argc, char** argv) {
         // Register CMDP in CHIRP and set sender name for CMDP
         ManagerLocator::getSinkManager().enableCMDPSending(logger_name);
 
+        // Get message retention
+        std::size_t max_messages {};
+        try {
+            max_messages = parser.get<std::size_t>("max-messages");
+        } catch(const std::exception&) {
+            std::unreachable();
+        }
+
         try {
-            Observatory gui(group_name);
+            Observatory gui(group_name, max_messages);
             gui.show();
             return QCoreApplication::exec();
         } catch(const QException&) {
@@ -93,9 +93,10 @@ public:
      * @brief Observatory Constructor
      *
      * @param group_name Constellation group name to connect to
+     * @param max_messages Maximum number of log messages retained in the view
      */
 
-    Observatory(std::string_view group_name);
+    Observatory(std::string_view group_name, std::size_t max_messages = QLogListener::default_max_messages);
 
 public:
     /**
@@ -9,8 +9,17 @@
 
 #include "QLogFilter.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include <QMetaObject>
 #include <QModelIndex>
 #include <QObject>
 #include <QSortFilterProxyModel>
@@ -19,12 +28,15 @@
 #include "constellation/core/log/Level.hpp"
 #include "constellation/core/log/log.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/core/utils/thread.hpp"
 #include "constellation/gui/QLogMessage.hpp"
 
 #include "QLogListener.hpp"
 
+using namespace constellation::gui;
 using namespace constellation::log;
 using namespace constellation::utils;
+using namespace std::chrono_literals;
 
 QLogFilter::QLogFilter(QObject* parent) : QSortFilterProxyModel(parent), logger_("QLGRCV"), filter_level_(Level::WARNING) {
     // Make filtering case-insensitive
@@ -35,17 +47,167 @@ bool QLogFilter::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent
     const auto src_index = sourceModel()->index(sourceRow, 0, sourceParent);
     const auto* listener = dynamic_cast<QLogListener*>(sourceModel());
     const auto& msg = listener->getMessage(src_index);
+    const auto sequence = listener->getSequence(sourceRow);
 
-    const auto match = filter_message_.match(QString::fromStdString(std::string(msg.getLogMessage())));
+    // Look up log level, sender and topic filters, check directly if inserted after last filter change
+    const auto index_pos = sequence - index_first_sequence_;
+    const auto index_accepted = (sequence >= index_first_sequence_ && index_pos < index_accepted_.size())
+                                    ? index_accepted_[index_pos]
+                                    : index_filter_accepts(msg);
+    if(!index_accepted) {
+        return false;
+    }
+
+    // Look up text search results, check directly if inserted after the search started
+    if(filter_message_.pattern().isEmpty()) {
+        return true;
+    }
+    if(sequence >= text_end_sequence_) {
+        return filter_message_.match(msg.getText(6)).hasMatch();
+    }
+    return sequence >= text_first_sequence_ && text_matched_[sequence - text_first_sequence_];
+}
+
+bool QLogFilter::lessThan(const QModelIndex& left, const QModelIndex& right) const {
+    const auto* listener = dynamic_cast<QLogListener*>(sourceModel());
+    const auto& left_msg = listener->getMessage(left);
+    const auto& right_msg = listener->getMessage(right);
+
+    // Compare time points directly, other columns via their cached string representation
+    if(left.column() == 0) {
+        return left_msg.getHeader().getTime() < right_msg.getHeader().getTime();
+    }
+    return left_msg.getText(left.column()).compare(right_msg.getText(right.column()), sortCaseSensitivity()) < 0;
+}
+
+bool QLogFilter::index_filter_accepts(const QLogMessage& msg) const {
     return (msg.getLogLevel() >= filter_level_) &&
            (msg.getHeader().getSender() == filter_sender_ || "- All -" == filter_sender_) &&
-           (msg.getLogTopic() == filter_topic_ || "- All -" == filter_topic_) && match.hasMatch();
+           (msg.getLogTopic() == filter_topic_ || "- All -" == filter_topic_);
+}
+
+void QLogFilter::update_index_filter() {
+    const auto* listener = dynamic_cast<QLogListener*>(sourceModel());
+    index_first_sequence_ = listener->getFirstSequence();
+    const auto count = static_cast<std::size_t>(listener->getNextSequence() - index_first_sequence_);
+
+    // Count for every message how many filters it passes, accept if it passes all of them
+    std::vector<std::uint8_t> passed(count, 0);
+    std::uint8_t required {1};
+    const auto count_passed = [&](const QLogListener::SequenceIndex& index) {
+        for(const auto sequence : index) {
+            ++passed[sequence - index_first_sequence_];
+        }
+    };
+
+    for(auto level = std::to_underlying(filter_level_); level <= std::to_underlying(Level::CRITICAL); ++level) {
+        count_passed(listener->getLevelIndex(Level(level)));
+    }
+    if(filter_sender_ != "- All -") {
+        ++required;
+        count_passed(listener->getSenderIndex(filter_sender_));
+    }
+    if(filter_topic_ != "- All -") {
+        ++required;
+        count_passed(listener->getTopicIndex(filter_topic_));
+    }
+
+    index_accepted_.assign(count, false);
+    for(std::size_t pos = 0; pos < count; ++pos) {
+        index_accepted_[pos] = (passed[pos] == required);
+    }
+}
+
+void QLogFilter::start_text_search() {
+    // Stop running search and discard its pending results
+    text_search_thread_ = {};
+    ++text_search_generation_;
+
+    const auto* listener = dynamic_cast<QLogListener*>(sourceModel());
+    text_first_sequence_ = listener->getFirstSequence();
+    text_end_sequence_ = listener->getNextSequence();
+    text_searched_sequence_ = text_first_sequence_;
+    text_matched_.assign(static_cast<std::size_t>(text_end_sequence_ - text_first_sequence_), false);
+
+    if(filter_message_.pattern().isEmpty() || text_matched_.empty()) {
+        text_searched_sequence_ = text_end_sequence_;
+        return;
+    }
+
+    // Take shallow copies of the pre-rendered messages, which share the stored data but stay valid after eviction
+    std::vector<QString> messages {};
+    messages.reserve(text_matched_.size());
+    for(int row = 0; row < static_cast<int>(text_matched_.size()); ++row) {
+        messages.emplace_back(listener->getMessage(listener->index(row)).getText(6));
+    }
+
+    LOG(logger_, DEBUG) << "Starting text search over " << messages.size() << " messages";
+    text_search_thread_ = std::jthread(std::bind_front(&QLogFilter::text_search_loop, this),
+                                       std::move(messages),
+                                       filter_message_,
+                                       text_search_generation_,
+                                       text_first_sequence_);
+    set_thread_name(text_search_thread_, "QLogFilter");
+}
+
+void QLogFilter::text_search_loop(const std::stop_token& stop_token,
+                                  std::vector<QString> messages,
+                                  QRegularExpression pattern, // NOLINT(performance-unnecessary-value-param)
+                                  std::uint64_t generation,
+                                  std::uint64_t first_sequence) {
+    std::vector<std::uint64_t> matches {};
+    auto last_update = std::chrono::steady_clock::now();
+
+    for(std::size_t pos = 0; pos < messages.size(); ++pos) {
+        if(stop_token.stop_requested()) {
+            return;
+        }
+
+        const auto sequence = first_sequence + pos;
+        if(pattern.match(messages[pos]).hasMatch()) {
+            matches.push_back(sequence);
+        }
+
+        // Stream results to GUI thread at most every 100ms and after the last message
+        const auto now = std::chrono::steady_clock::now();
+        if(pos + 1 == messages.size() || now - last_update > 100ms) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, end_sequence = sequence + 1, matches = std::move(matches)]() {
+                    add_text_matches(generation, end_sequence, matches);
+                },
+                Qt::QueuedConnection);
+            matches = {};
+            last_update = now;
+        }
+    }
+}
+
+void QLogFilter::add_text_matches(std::uint64_t generation,
+                                  std::uint64_t end_sequence,
+                                  const std::vector<std::uint64_t>& matches) {
+    // Discard results from outdated searches
+    if(generation != text_search_generation_) {
+        return;
+    }
+
+    for(const auto sequence : matches) {
+        text_matched_[sequence - text_first_sequence_] = true;
+    }
+    text_searched_sequence_ = end_sequence;
+    LOG(logger_, TRACE) << "Text search progressed to " << (text_searched_sequence_ - text_first_sequence_) << " of "
+                        << text_matched_.size() << " messages, " << matches.size() << " new matches";
+
+    if(!matches.empty()) {
+        invalidateFilter();
+    }
 }
 
 void QLogFilter::setFilterLevel(Level level) {
     if(filter_level_ != level) {
         LOG(logger_, DEBUG) << "Updating filter level to " << to_string(level);
         filter_level_ = level;
+        update_index_filter();
         invalidateFilter();
     }
 }
@@ -55,6 +217,7 @@ void QLogFilter::setFilterSender(const std::string& sender) {
     if(sender == "- All -" || listener->isSenderAvailable(sender)) {
         LOG(logger_, DEBUG) << "Updating filter sender to " << sender;
         filter_sender_ = sender;
+        update_index_filter();
         invalidateFilter();
     }
 }
@@ -64,6 +227,7 @@ void QLogFilter::setFilterTopic(const std::string& topic) {
     if(topic == "- All -" || listener->isTopicAvailable(topic)) {
         LOG(logger_, DEBUG) << "Updating filter topic to " << topic;
         filter_topic_ = topic;
+        update_index_filter();
         invalidateFilter();
     }
 }
@@ -71,5 +235,6 @@ void QLogFilter::setFilterTopic(const std::string& topic) {
 void QLogFilter::setFilterMessage(const QString& pattern) {
     LOG(logger_, DEBUG) << "Updating filter pattern for message to " << pattern.toStdString();
     filter_message_.setPattern(pattern);
+    start_text_search();
     invalidateFilter();
 }
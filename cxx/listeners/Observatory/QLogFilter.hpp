@@ -10,15 +10,21 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <QModelIndex>
 #include <QObject>
 #include <QRegularExpression>
 #include <QSortFilterProxyModel>
+#include <QString>
 
 #include "constellation/core/log/Level.hpp"
 #include "constellation/core/log/Logger.hpp"
+#include "constellation/gui/QLogMessage.hpp"
 
 class QLogFilter : public QSortFilterProxyModel {
 
@@ -29,8 +35,10 @@ public:
 
     /**
      * @brief Method to filter rows
-     * @details In this method, all currently set filters are allied to the given row of the source model. It checks for
-     * log level, sender, topic match and compares the message to the filter regular expression.
+     * @details In this method, all currently set filters are allied to the given row of the source model. Log level,
+     * sender and topic filters are looked up from the acceptance computed from the listener indices, the message is
+     * looked up from the results of the background text search. Messages inserted after the last filter change are
+     * checked directly.
      *
      * @param sourceRow Row of the respective message in the source model
      * @param sourceParent QModelIndex of the parent item
@@ -39,6 +47,17 @@ public:
      */
     bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
 
+    /**
+     * @brief Method to sort rows
+     * @details Compares the time of the messages or the cached string representation of the respective column
+     *
+     * @param left QModelIndex of the left item in the source model
+     * @param right QModelIndex of the right item in the source model
+     *
+     * @return True if the left item is less than the right item, false otherwise
+     */
+    bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
+
     /**
      * @brief Set a new log level filter value
      *
@@ -95,14 +114,51 @@ public:
 
 private:
     /**
-     * @brief Helper to determine if a message at the given index should be displayed currently.
+     * @brief Compute the acceptance of all currently stored messages for log level, sender and topic filters
+     * @details The acceptance is obtained by intersecting the per-level, per-sender and per-topic indices of the listener
+     * without accessing the messages themselves.
+     */
+    void update_index_filter();
+
+    /**
+     * @brief Start a new background search for the message filter pattern over all currently stored messages
+     * @details A running search is stopped. Until the search results arrived, messages are not displayed.
+     */
+    void start_text_search();
+
+    /**
+     * @brief Loop of the background text search, streams the results back to the GUI thread
      *
-     * This evaluates the currently-configured filters.
+     * @param stop_token Stop token to interrupt the search
+     * @param messages Messages to search in, sharing their data with the stored messages
+     * @param pattern Pattern to search for
+     * @param generation Generation of the search to discard results from outdated searches
+     * @param first_sequence Sequence number of the first message
+     */
+    void text_search_loop(const std::stop_token& stop_token,
+                          std::vector<QString> messages,
+                          QRegularExpression pattern,
+                          std::uint64_t generation,
+                          std::uint64_t first_sequence);
+
+    /**
+     * @brief Add results of the background text search and refilter
      *
-     * @param index Index of the message in the message storage
-     * @return True if the message is to be displayed, false otherwise
+     * @param generation Generation of the search the results belong to
+     * @param end_sequence Sequence number after the last message that has been searched
+     * @param matches Sequence numbers of matching messages
      */
-    bool is_message_displayed(std::size_t index) const;
+    void add_text_matches(std::uint64_t generation,
+                          std::uint64_t end_sequence,
+                          const std::vector<std::uint64_t>& matches);
+
+    /**
+     * @brief Helper to directly determine if a message passes log level, sender and topic filters
+     *
+     * @param msg Message to check
+     * @return True if the message passes the filters, false otherwise
+     */
+    bool index_filter_accepts(const constellation::gui::QLogMessage& msg) const;
 
 private:
     /** Logger to use */
@@ -113,4 +169,18 @@ private:
     std::string filter_sender_ {"- All -"};
     std::string filter_topic_ {"- All -"};
     QRegularExpression filter_message_;
+
+    /** Acceptance for log level, sender and topic filters starting from the given sequence number */
+    std::vector<bool> index_accepted_;
+    std::uint64_t index_first_sequence_ {0};
+
+    /** Results of the text search for messages in the given sequence range and progress of the search */
+    std::vector<bool> text_matched_;
+    std::uint64_t text_first_sequence_ {0};
+    std::uint64_t text_end_sequence_ {0};
+    std::uint64_t text_searched_sequence_ {0};
+    std::uint64_t text_search_generation_ {0};
+
+    /** Background text search thread */
+    std::jthread text_search_thread_;
 };
@@ -9,17 +9,23 @@
 
 #include "QLogListener.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
-#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include <QAbstractListModel>
 #include <QDateTime>
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
 #include <QVariant>
 
 #include "constellation/core/chirp/Manager.hpp"
@@ -33,40 +39,143 @@ using namespace constellation::gui;
 using namespace constellation::log;
 using namespace constellation::pools;
 
+namespace {
+    // Index returned for unknown senders or topics
+    const QLogListener::SequenceIndex empty_index {};
+
+    // Obtain index for a key, inserting an empty index if not present
+    QLogListener::SequenceIndex& index_for(std::map<std::string, QLogListener::SequenceIndex, std::less<>>& indices,
+                                           std::string_view key) {
+        auto it = indices.find(key);
+        if(it == indices.end()) {
+            it = indices.emplace(key, QLogListener::SequenceIndex()).first;
+        }
+        return it->second;
+    }
+} // namespace
+
 QLogListener::QLogListener(QObject* parent)
     : QAbstractListModel(parent),
-      constellation::listener::LogListener("LOG", [this](auto&& arg) { add_message(std::forward<decltype(arg)>(arg)); }) {}
+      constellation::listener::LogListener("LOG", [this](auto&& arg) { add_message(std::forward<decltype(arg)>(arg)); }) {
+    // Insert pending messages periodically from the GUI thread
+    connect(&flush_timer_, &QTimer::timeout, this, &QLogListener::flush_pending_messages);
+    flush_timer_.start(flush_interval_ms);
+}
 
 void QLogListener::clearMessages() {
-    message_count_.store(0);
-    const std::scoped_lock message_lock {message_read_mutex_, message_write_mutex_};
-    if(!messages_.empty()) {
-        beginRemoveRows(QModelIndex(), 0, static_cast<int>(messages_.size() - 1));
+    {
+        const std::lock_guard pending_lock {pending_messages_mutex_};
+        pending_messages_.clear();
+    }
+    if(message_count_ > 0) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(message_count_ - 1));
         messages_.clear();
+        message_first_ = 0;
+        message_first_sequence_ += message_count_;
+        message_count_ = 0;
+        std::ranges::for_each(level_index_, [](auto& index) { index.clear(); });
+        std::ranges::for_each(sender_index_, [](auto& index_p) { index_p.second.clear(); });
+        std::ranges::for_each(topic_index_, [](auto& index_p) { index_p.second.clear(); });
         endRemoveRows();
     }
 }
 
+void QLogListener::setMaxMessages(std::size_t max_messages) {
+    max_messages = std::max<std::size_t>(max_messages, 1);
+
+    // Evict oldest messages exceeding the new retention
+    if(message_count_ > max_messages) {
+        evict_messages(message_count_ - max_messages);
+    }
+
+    // Move remaining messages to the front of the storage such that the ring buffer can grow or shrink
+    std::vector<QLogMessage> messages {};
+    messages.reserve(message_count_);
+    for(std::size_t row = 0; row < message_count_; ++row) {
+        messages.emplace_back(std::move(messages_[(message_first_ + row) % max_messages_.load()]));
+    }
+    messages_ = std::move(messages);
+    message_first_ = 0;
+
+    const std::lock_guard pending_lock {pending_messages_mutex_};
+    max_messages_.store(max_messages);
+    while(pending_messages_.size() > max_messages) {
+        pending_messages_.pop_front();
+    }
+}
+
 void QLogListener::add_message(CMDP1LogMessage&& msg) {
+    const std::lock_guard pending_lock {pending_messages_mutex_};
 
-    const auto level = msg.getLogLevel();
+    // Drop oldest pending message if more messages than can be retained are pending
+    if(pending_messages_.size() >= max_messages_.load()) {
+        pending_messages_.pop_front();
+    }
+    pending_messages_.emplace_back(std::move(msg));
+}
 
-    // Add new message to the end of the deque
-    std::size_t messages_size {};
+void QLogListener::evict_messages(std::size_t count) {
+    // Evicted messages remain in the storage until overwritten by new messages
+    beginRemoveRows(QModelIndex(), 0, static_cast<int>(count - 1));
+    message_first_ = (message_first_ + count) % max_messages_.load();
+    message_first_sequence_ += count;
+    message_count_ -= count;
+
+    // Drop evicted sequence numbers from the indices
+    const auto prune = [this](SequenceIndex& index) {
+        while(!index.empty() && index.front() < message_first_sequence_) {
+            index.pop_front();
+        }
+    };
+    std::ranges::for_each(level_index_, prune);
+    std::ranges::for_each(sender_index_, [&](auto& index_p) { prune(index_p.second); });
+    std::ranges::for_each(topic_index_, [&](auto& index_p) { prune(index_p.second); });
+    endRemoveRows();
+}
+
+void QLogListener::flush_pending_messages() {
+    // Take all pending messages for less time with mutex
+    std::deque<QLogMessage> pending {};
     {
-        const std::lock_guard message_lock {message_write_mutex_};
-        messages_.emplace_back(std::move(msg));
-        messages_size = messages_.size();
+        const std::lock_guard pending_lock {pending_messages_mutex_};
+        pending.swap(pending_messages_);
+    }
+    if(pending.empty()) {
+        return;
+    }
+
+    // Evict oldest messages to make space for the pending ones
+    const auto max_messages = max_messages_.load();
+    if(message_count_ + pending.size() > max_messages) {
+        evict_messages(message_count_ + pending.size() - max_messages);
     }
-    message_count_.store(messages_size);
 
-    // Call insert rows afterwards for less time with mutex
-    const auto pos = static_cast<int>(messages_size - 1);
-    beginInsertRows(QModelIndex(), pos, pos);
+    // Insert all pending messages at once
+    const auto first_row = message_count_;
+    beginInsertRows(QModelIndex(), static_cast<int>(first_row), static_cast<int>(first_row + pending.size() - 1));
+    for(auto& msg : pending) {
+        // The storage grows until the retention is reached, afterwards evicted slots are overwritten
+        const auto pos = (message_first_ + message_count_) % max_messages;
+
+        // Update indices
+        const auto sequence = message_first_sequence_ + message_count_;
+        level_index_.at(std::to_underlying(msg.getLogLevel())).push_back(sequence);
+        index_for(sender_index_, msg.getHeader().getSender()).push_back(sequence);
+        index_for(topic_index_, msg.getLogTopic()).push_back(sequence);
+
+        if(pos == messages_.size()) {
+            messages_.emplace_back(std::move(msg));
+        } else {
+            messages_[pos] = std::move(msg);
+        }
+        ++message_count_;
+    }
     endInsertRows();
 
-    // Send signal
-    emit newMessage(createIndex(pos, 0), level);
+    // Send signals
+    for(std::size_t row = first_row; row < message_count_; ++row) {
+        emit newMessage(createIndex(static_cast<int>(row), 0), message_at(row).getLogLevel());
+    }
 }
 
 void QLogListener::host_connected(const DiscoveredService& service) {
@@ -104,24 +213,38 @@ void QLogListener::topics_changed(std::string_view /*sender*/) {
     // emit newSenderTopics(QString::fromStdString(std::string(sender)), {});
 }
 
+const QLogListener::SequenceIndex& QLogListener::getSenderIndex(std::string_view sender) const {
+    const auto it = sender_index_.find(sender);
+    return it != sender_index_.end() ? it->second : empty_index;
+}
+
+const QLogListener::SequenceIndex& QLogListener::getTopicIndex(std::string_view topic) const {
+    const auto it = topic_index_.find(topic);
+    return it != topic_index_.end() ? it->second : empty_index;
+}
+
 QVariant QLogListener::data(const QModelIndex& index, int role) const {
-    if(role != Qt::DisplayRole || !index.isValid()) {
+    if(!index.isValid() || index.column() >= QLogMessage::countColumns() ||
+       index.row() >= static_cast<int>(message_count_)) {
         return {};
     }
 
-    if(index.column() < QLogMessage::countColumns()) {
-        const std::shared_lock message_lock {message_read_mutex_};
-        if(index.row() < static_cast<int>(messages_.size())) {
-            return messages_[index.row()][index.column()];
-        }
+    const auto& msg = message_at(static_cast<std::size_t>(index.row()));
+
+    // Log level as integer for the item delegate to avoid parsing the level column
+    if(role == Qt::UserRole) {
+        return std::to_underlying(msg.getLogLevel());
+    }
+
+    if(role == Qt::DisplayRole) {
+        return msg[index.column()];
     }
 
     return {};
 }
 
 const QLogMessage& QLogListener::getMessage(const QModelIndex& index) const {
-    const std::shared_lock message_lock {message_read_mutex_};
-    return messages_[index.row()];
+    return message_at(static_cast<std::size_t>(index.row()));
 }
 
 QVariant QLogListener::headerData(int column, Qt::Orientation orientation, int role) const {
@@ -9,16 +9,24 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
-#include <shared_mutex>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <QAbstractListModel>
 #include <QObject>
 #include <QRegularExpression>
 #include <QString>
+#include <QTimer>
 #include <QVariant>
 
 #include "constellation/core/chirp/Manager.hpp"
@@ -31,6 +39,9 @@ class QLogListener : public QAbstractListModel, public constellation::listener::
     Q_OBJECT
 
 public:
+    /** Ascending sequence numbers of messages, see `getSequence` */
+    using SequenceIndex = std::deque<std::uint64_t>;
+
     /**
      * @brief Constructor of QLogListener
      *
@@ -38,6 +49,12 @@ public:
      */
     explicit QLogListener(QObject* parent = nullptr);
 
+    /** Default number of messages retained in the model */
+    static constexpr std::size_t default_max_messages {100000};
+
+    /** Interval in milliseconds in which received messages are inserted into the model, about one GUI frame */
+    static constexpr int flush_interval_ms {16};
+
     /**
      * @brief Obtain a message from a given QModelIndex
      *
@@ -51,10 +68,78 @@ public:
      */
     void clearMessages();
 
+    /**
+     * @brief Set the maximum number of messages retained in the model
+     * @details When the retention is reached, the oldest messages are evicted and their rows are removed from the model.
+     * Reducing the retention immediately evicts the oldest messages exceeding it.
+     *
+     * @param max_messages Maximum number of messages, at least one message is always retained
+     */
+    void setMaxMessages(std::size_t max_messages);
+
+    /**
+     * @brief Return the maximum number of messages retained in the model
+     * @return Maximum number of messages
+     */
+    std::size_t getMaxMessages() const { return max_messages_.load(); }
+
+    /**
+     * @brief Obtain the sequence number of the message in a given row
+     * @details Sequence numbers are assigned in order of insertion and are not affected by eviction of older messages
+     *
+     * @param row Row of the message
+     * @return Sequence number of the message
+     */
+    std::uint64_t getSequence(int row) const { return message_first_sequence_ + static_cast<std::uint64_t>(row); }
+
+    /**
+     * @brief Obtain the row of the message with a given sequence number
+     *
+     * @param sequence Sequence number of a retained message
+     * @return Row of the message
+     */
+    int getRow(std::uint64_t sequence) const { return static_cast<int>(sequence - message_first_sequence_); }
+
+    /**
+     * @brief Return the sequence number of the oldest retained message
+     */
+    std::uint64_t getFirstSequence() const { return message_first_sequence_; }
+
+    /**
+     * @brief Return the sequence number the next inserted message will receive
+     */
+    std::uint64_t getNextSequence() const { return message_first_sequence_ + message_count_; }
+
+    /**
+     * @brief Obtain the sequence numbers of all retained messages with a given log level
+     *
+     * @param level Log level
+     * @return Index of sequence numbers
+     */
+    const SequenceIndex& getLevelIndex(constellation::log::Level level) const {
+        return level_index_.at(std::to_underlying(level));
+    }
+
+    /**
+     * @brief Obtain the sequence numbers of all retained messages from a given sender
+     *
+     * @param sender Canonical name of the sender
+     * @return Index of sequence numbers, empty if no message from the sender has been received
+     */
+    const SequenceIndex& getSenderIndex(std::string_view sender) const;
+
+    /**
+     * @brief Obtain the sequence numbers of all retained messages with a given topic
+     *
+     * @param topic Log topic
+     * @return Index of sequence numbers, empty if no message with the topic has been received
+     */
+    const SequenceIndex& getTopicIndex(std::string_view topic) const;
+
     /// @cond doxygen_suppress
 
     /* Qt accessor methods */
-    int rowCount(const QModelIndex& /*parent*/) const override { return static_cast<int>(message_count_.load()); }
+    int rowCount(const QModelIndex& /*parent*/) const override { return static_cast<int>(message_count_); }
     int columnCount(const QModelIndex& /*parent*/) const override { return constellation::gui::QLogMessage::countColumns(); }
     QVariant data(const QModelIndex& index, int role) const override;
     QVariant headerData(int column, Qt::Orientation orientation, int role) const override;
@@ -92,13 +177,38 @@ signals:
 private:
     /**
      * @brief Callback registered for receiving log messages from the subscription pool
-     * This function inserts the message into storage, checks for new topics or sender names to register, and emits a
-     * newMessage signal with the inserted index when the message is displayed.
+     * This function only queues the message, it is inserted into the model with the next flush of pending messages.
+     * If more messages than the retention are pending, the oldest pending messages are dropped.
      *
      * @param msg Received log message
      */
     void add_message(constellation::message::CMDP1LogMessage&& msg);
 
+    /**
+     * @brief Insert all pending messages into the model
+     * @details This function is called periodically from the GUI thread. It evicts the oldest messages if the retention
+     * is exceeded and inserts all pending messages with a single row insertion. For every inserted message a newMessage
+     * signal is emitted.
+     */
+    void flush_pending_messages();
+
+    /**
+     * @brief Access stored message by row in the model
+     *
+     * @param row Row of the message
+     * @return Reference to the message
+     */
+    const constellation::gui::QLogMessage& message_at(std::size_t row) const {
+        return messages_[(message_first_ + row) % max_messages_.load()];
+    }
+
+    /**
+     * @brief Evict the oldest messages from the model
+     *
+     * @param count Number of messages to evict
+     */
+    void evict_messages(std::size_t count);
+
     void host_connected(const constellation::chirp::DiscoveredService& service) override;
     void host_disconnected(const constellation::chirp::DiscoveredService& service) override;
 
@@ -106,9 +216,24 @@ private:
     void sender_connected(std::string_view sender) override;
 
 private:
-    /** Log messages & access mutex*/
-    std::deque<constellation::gui::QLogMessage> messages_;
-    std::atomic_size_t message_count_;
-    mutable std::shared_mutex message_read_mutex_;
-    mutable std::mutex message_write_mutex_;
+    /** Ring buffer of log messages, only accessed from the GUI thread */
+    std::vector<constellation::gui::QLogMessage> messages_;
+    std::size_t message_first_ {0};
+    std::size_t message_count_ {0};
+    std::atomic_size_t max_messages_ {default_max_messages};
+
+    /** Sequence number of the oldest retained message */
+    std::uint64_t message_first_sequence_ {0};
+
+    /** Indices of message sequence numbers per level, sender and topic, maintained at insertion and eviction */
+    std::array<SequenceIndex, std::to_underlying(constellation::log::Level::OFF) + 1> level_index_;
+    std::map<std::string, SequenceIndex, std::less<>> sender_index_;
+    std::map<std::string, SequenceIndex, std::less<>> topic_index_;
+
+    /** Messages received but not yet inserted into the model & access mutex */
+    std::deque<constellation::gui::QLogMessage> pending_messages_;
+    std::mutex pending_messages_mutex_;
+
+    /** Timer for periodic insertion of pending messages */
+    QTimer flush_timer_;
 };
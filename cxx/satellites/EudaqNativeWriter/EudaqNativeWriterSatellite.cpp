@@ -14,6 +14,8 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -21,17 +23,24 @@
 
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/config/exceptions.hpp"
 #include "constellation/core/log/log.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/metrics/Metric.hpp"
 #include "constellation/core/protocol/CSCP_definitions.hpp"
+#include "constellation/core/utils/string.hpp"
 #include "constellation/core/utils/timers.hpp"
+#include "constellation/data/BlockFileWriter.hpp"
 #include "constellation/satellite/ReceiverSatellite.hpp"
 
 using namespace constellation::config;
+using namespace constellation::data;
 using namespace constellation::message;
+using namespace constellation::metrics;
 using namespace constellation::protocol;
 using namespace constellation::satellite;
 using namespace constellation::utils;
+using namespace std::chrono_literals;
 
 EudaqNativeWriterSatellite::EudaqNativeWriterSatellite(std::string_view type, std::string_view name)
     : ReceiverSatellite(type, name) {}
@@ -41,6 +50,56 @@ void EudaqNativeWriterSatellite::initializing(Configuration& config) {
     validate_output_directory(base_path_);
 
     flush_timer_ = TimeoutTimer(std::chrono::seconds(config.get<std::size_t>("flush_interval", 3)));
+
+    // Compression settings
+    compression_ = config.get<Compression>("compression", Compression::NONE);
+    if(!BlockFileWriter::isAvailable(compression_)) {
+        throw InvalidValueError(config, "compression", "compression is not available in this build");
+    }
+    compression_level_ = config.get<int>("compression_level", 3);
+    compression_workers_ = config.get<std::size_t>("compression_workers", 2);
+    if(compression_workers_ == 0) {
+        throw InvalidValueError(config, "compression_workers", "at least one worker is required");
+    }
+    compression_block_size_ = config.get<std::size_t>("compression_block_size", 1024) * 1024;
+    if(compression_block_size_ == 0) {
+        throw InvalidValueError(config, "compression_block_size", "block size needs to be larger than zero");
+    }
+
+    if(compression_ != Compression::NONE) {
+        register_compression_metrics();
+    }
+}
+
+void EudaqNativeWriterSatellite::register_compression_metrics() {
+    const std::set<CSCP::State> allowed_states {CSCP::State::RUN, CSCP::State::stopping};
+
+    register_timed_metric("COMPRESSION_RATIO",
+                          "",
+                          MetricType::LAST_VALUE,
+                          "Ratio of uncompressed to compressed bytes written in the current run",
+                          10s,
+                          allowed_states,
+                          [this]() -> std::optional<double> {
+                              const auto statistics = compression_statistics_.load();
+                              return statistics ? std::optional(statistics->getCompressionRatio()) : std::nullopt;
+                          });
+
+    for(std::size_t worker = 0; worker < compression_workers_; ++worker) {
+        register_timed_metric("COMPRESSION_THROUGHPUT_" + to_string(worker),
+                              "MB/s",
+                              MetricType::LAST_VALUE,
+                              "Throughput of compression worker " + to_string(worker) + " while busy in the current run",
+                              10s,
+                              allowed_states,
+                              [this, worker]() -> std::optional<double> {
+                                  const auto statistics = compression_statistics_.load();
+                                  if(!statistics || worker >= statistics->getWorkers()) {
+                                      return std::nullopt;
+                                  }
+                                  return statistics->getWorkerThroughput(worker);
+                              });
+    }
 }
 
 void EudaqNativeWriterSatellite::starting(std::string_view run_identifier) {
@@ -54,17 +113,23 @@ void EudaqNativeWriterSatellite::starting(std::string_view run_identifier) {
         LOG(DEBUG) << "Could not determine run sequence from run identifier, assuming 0";
     }
 
-    // Open target file
-    auto file = create_output_file(base_path_, "data_" + std::string(run_identifier), "raw", true);
+    // Open target file, compressed files can be decompressed to the native format with the respective tool
+    const auto extension = (compression_ == Compression::ZSTD ? "raw.zst" : "raw");
+    auto file = create_output_file(base_path_, "data_" + std::string(run_identifier), extension, true);
+    auto writer = std::make_unique<BlockFileWriter>(
+        std::move(file), compression_, compression_workers_, compression_block_size_, compression_level_);
+    compression_statistics_ = writer->getStatistics();
 
     LOG(STATUS) << "Starting run with identifier " << run_identifier << ", sequence " << sequence;
-    serializer_ = std::make_unique<FileSerializer>(std::move(file), sequence);
+    serializer_ = std::make_unique<FileSerializer>(std::move(writer), sequence);
 
     // Start timer for flushing data to file
     flush_timer_.reset();
 }
 
 void EudaqNativeWriterSatellite::stopping() {
+    // Flush explicitly to report errors when writing the last blocks
+    serializer_->flush();
     serializer_.reset();
 }
 
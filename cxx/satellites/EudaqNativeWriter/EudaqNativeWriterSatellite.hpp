@@ -10,11 +10,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <memory>
 #include <span>
 #include <string>
@@ -28,6 +28,7 @@
 #include "constellation/core/protocol/CSCP_definitions.hpp"
 #include "constellation/core/utils/string_hash_map.hpp"
 #include "constellation/core/utils/timers.hpp"
+#include "constellation/data/BlockFileWriter.hpp"
 #include "constellation/satellite/ReceiverSatellite.hpp"
 
 class EudaqNativeWriterSatellite final : public constellation::satellite::ReceiverSatellite {
@@ -39,17 +40,17 @@ class EudaqNativeWriterSatellite final : public constellation::satellite::Receiv
         TRIGGER = 0x10,
     };
 
+public:
     /** Serializer class for EUDAQ native binary files */
     class FileSerializer {
     public:
         /**
          * @brief Constructor for file serializer
-         * This attempts to open the file and checks if the path already exists
          *
-         * @param file Output file stream to write to
+         * @param writer Block file writer to write to, which optionally compresses the output
          * @param run_sequence Sequence portion of the run identifier, used to store in EUDAQ event header
          */
-        FileSerializer(std::ofstream file, std::uint32_t run_sequence);
+        FileSerializer(std::unique_ptr<constellation::data::BlockFileWriter> writer, std::uint32_t run_sequence);
 
         /**
          * @brief Destructor which flushes data to file and closes the file
@@ -105,7 +106,7 @@ class EudaqNativeWriterSatellite final : public constellation::satellite::Receiv
          * @param flags EUDAQ flags to mark the event with
          */
         void serialize_header(const constellation::message::CDTP1Message::Header& header,
-                              const constellation::config::Dictionary& tags,
+                              const constellation::config::FlatDictionary& tags,
                               std::uint32_t flags = 0x0);
 
         /** Set eudaq event descriptors and frame handling from BOR tags */
@@ -132,10 +133,10 @@ class EudaqNativeWriterSatellite final : public constellation::satellite::Receiv
         }
 
         /** Write a string to file */
-        void write_str(const std::string& t);
+        void write_str(std::string_view t);
 
         /** Write a dictionary to file */
-        void write_tags(const constellation::config::Dictionary& dict);
+        void write_tags(const constellation::config::FlatDictionary& dict);
 
         /** Helper function to hash a string into EUDAQ event identifiers */
         constexpr std::uint32_t cstr2hash(const char* str, std::uint32_t h = 0) { // NOLINT(misc-no-recursion)
@@ -143,7 +144,7 @@ class EudaqNativeWriterSatellite final : public constellation::satellite::Receiv
         }
 
     private:
-        std::ofstream file_;
+        std::unique_ptr<constellation::data::BlockFileWriter> writer_;
         std::uint32_t run_sequence_;
 
         constellation::utils::string_hash_map<std::string> eudaq_event_descriptors_;
@@ -169,6 +170,10 @@ public:
     /** Transition function for failure transition to ERROR mode */
     void failure(constellation::protocol::CSCP::State previous_state) final;
 
+private:
+    /** Register compression ratio and per-worker throughput metrics */
+    void register_compression_metrics();
+
 protected:
     /** Callback for receiving a BOR message */
     void receive_bor(const constellation::message::CDTP1Message::Header& header,
@@ -185,4 +190,10 @@ private:
     std::unique_ptr<FileSerializer> serializer_;
     std::filesystem::path base_path_;
     constellation::utils::TimeoutTimer flush_timer_ {std::chrono::seconds(3)};
+
+    constellation::data::Compression compression_ {constellation::data::Compression::NONE};
+    int compression_level_ {3};
+    std::size_t compression_workers_ {2};
+    std::size_t compression_block_size_ {1024 * 1024};
+    std::atomic<std::shared_ptr<const constellation::data::CompressionStatistics>> compression_statistics_;
 };
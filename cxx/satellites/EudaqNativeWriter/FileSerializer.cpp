@@ -9,10 +9,10 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <iomanip>
-#include <ios>
+#include <memory>
 #include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -21,43 +21,38 @@
 #include "constellation/core/message/CDTP1Message.hpp"
 #include "constellation/core/message/PayloadBuffer.hpp"
 #include "constellation/core/utils/casts.hpp"
-#include "constellation/satellite/exceptions.hpp"
+#include "constellation/data/BlockFileWriter.hpp"
 
 #include "EudaqNativeWriterSatellite.hpp"
 
 using namespace constellation::config;
+using namespace constellation::data;
 using namespace constellation::message;
-using namespace constellation::satellite;
 using namespace constellation::utils;
 
-EudaqNativeWriterSatellite::FileSerializer::FileSerializer(std::ofstream file, std::uint32_t run_sequence)
-    : file_(std::move(file)), run_sequence_(run_sequence) {}
+EudaqNativeWriterSatellite::FileSerializer::FileSerializer(std::unique_ptr<BlockFileWriter> writer,
+                                                           std::uint32_t run_sequence)
+    : writer_(std::move(writer)), run_sequence_(run_sequence) {}
 
 EudaqNativeWriterSatellite::FileSerializer::~FileSerializer() {
-    if(file_.is_open()) {
-        file_.close();
-    }
+    // Writer compresses pending blocks and closes the file
+    writer_.reset();
 }
 
 void EudaqNativeWriterSatellite::FileSerializer::flush() {
-    if(file_.is_open()) {
-        file_.flush();
-    }
+    writer_->flush();
 }
 
 void EudaqNativeWriterSatellite::FileSerializer::write(std::span<const std::byte> data) {
-    file_.write(to_char_ptr(data.data()), static_cast<std::streamsize>(data.size_bytes()));
-    if(!file_.good()) {
-        throw SatelliteError("Error writing to file");
-    }
+    writer_->write(data);
 }
 
-void EudaqNativeWriterSatellite::FileSerializer::write_str(const std::string& t) {
+void EudaqNativeWriterSatellite::FileSerializer::write_str(std::string_view t) {
     write_int(static_cast<std::uint32_t>(t.length()));
     write({to_byte_ptr(t.data()), t.length()});
 }
 
-void EudaqNativeWriterSatellite::FileSerializer::write_tags(const Dictionary& dict) {
+void EudaqNativeWriterSatellite::FileSerializer::write_tags(const FlatDictionary& dict) {
     LOG(DEBUG) << "Writing " << dict.size() << " event tags";
 
     write_int(static_cast<std::uint32_t>(dict.size()));
@@ -85,7 +80,7 @@ void EudaqNativeWriterSatellite::FileSerializer::write_block(std::uint32_t key,
 }
 
 void EudaqNativeWriterSatellite::FileSerializer::serialize_header(const constellation::message::CDTP1Message::Header& header,
-                                                                  const constellation::config::Dictionary& tags,
+                                                                  const constellation::config::FlatDictionary& tags,
                                                                   std::uint32_t flags) {
     LOG(DEBUG) << "Writing event header";
 
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief Implementation of native raw data writer satellite
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include "RawWriterSatellite.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "constellation/core/config/Configuration.hpp"
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/log/log.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/protocol/CSCP_definitions.hpp"
+#include "constellation/core/utils/timers.hpp"
+#include "constellation/data/RawFileWriter.hpp"
+#include "constellation/satellite/ReceiverSatellite.hpp"
+
+using namespace constellation::config;
+using namespace constellation::data;
+using namespace constellation::message;
+using namespace constellation::protocol;
+using namespace constellation::satellite;
+using namespace constellation::utils;
+
+RawWriterSatellite::RawWriterSatellite(std::string_view type, std::string_view name) : ReceiverSatellite(type, name) {}
+
+void RawWriterSatellite::initializing(Configuration& config) {
+    base_path_ = config.getPath("output_directory");
+    validate_output_directory(base_path_);
+
+    flush_timer_ = TimeoutTimer(std::chrono::seconds(config.get<std::size_t>("flush_interval", 3)));
+}
+
+void RawWriterSatellite::starting(std::string_view run_identifier) {
+    // Open target file
+    auto file = create_output_file(base_path_, "data_" + std::string(run_identifier), "cdtp", true);
+
+    LOG(STATUS) << "Starting run with identifier " << run_identifier;
+    writer_ = std::make_unique<RawFileWriter>(std::move(file));
+
+    // Start timer for flushing data to file
+    flush_timer_.reset();
+}
+
+void RawWriterSatellite::stopping() {
+    // Close explicitly to report errors when appending the index
+    writer_->close();
+    writer_.reset();
+}
+
+void RawWriterSatellite::interrupting(CSCP::State /*previous_state*/) {
+    // The file is only open when interrupting from RUN
+    if(writer_) {
+        writer_->close();
+        writer_.reset();
+    }
+}
+
+void RawWriterSatellite::failure(CSCP::State /*previous_state*/) {
+    writer_.reset();
+}
+
+void RawWriterSatellite::receive_bor(const CDTP1Message::Header& header, Configuration config) {
+    LOG(INFO) << "Received BOR from " << header.getSender() << " with config" << config.getDictionary().to_string();
+    writer_->write(header, config.getDictionary());
+}
+
+void RawWriterSatellite::receive_data(CDTP1Message data_message) {
+    LOG(TRACE) << "Received data message from " << data_message.getHeader().getSender();
+    writer_->write(data_message);
+
+    // Flush if necessary and reset timer
+    if(flush_timer_.timeoutReached()) {
+        writer_->flush();
+        flush_timer_.reset();
+    }
+}
+
+void RawWriterSatellite::receive_eor(const CDTP1Message::Header& header, Dictionary run_metadata) {
+    LOG(INFO) << "Received EOR from " << header.getSender() << " with metadata" << run_metadata.to_string();
+    writer_->write(header, run_metadata);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief Satellite receiving data and storing it in native Constellation raw data files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+#include "constellation/core/config/Configuration.hpp"
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/protocol/CSCP_definitions.hpp"
+#include "constellation/core/utils/timers.hpp"
+#include "constellation/data/RawFileWriter.hpp"
+#include "constellation/satellite/ReceiverSatellite.hpp"
+
+class RawWriterSatellite final : public constellation::satellite::ReceiverSatellite {
+public:
+    /** Satellite constructor */
+    RawWriterSatellite(std::string_view type, std::string_view name);
+
+    /** Transition function for initialize command */
+    void initializing(constellation::config::Configuration& config) final;
+
+    /** Transition function for start command */
+    void starting(std::string_view run_identifier) final;
+
+    /** Transition function for stop command */
+    void stopping() final;
+
+    /** Transition function for interrupt transition to SAFE mode */
+    void interrupting(constellation::protocol::CSCP::State previous_state) final;
+
+    /** Transition function for failure transition to ERROR mode */
+    void failure(constellation::protocol::CSCP::State previous_state) final;
+
+protected:
+    /** Callback for receiving a BOR message */
+    void receive_bor(const constellation::message::CDTP1Message::Header& header,
+                     constellation::config::Configuration config) final;
+
+    /** Callback for receiving a DATA message */
+    void receive_data(constellation::message::CDTP1Message data_message) final;
+
+    /** Callback for receiving a EOR message */
+    void receive_eor(const constellation::message::CDTP1Message::Header& header,
+                     constellation::config::Dictionary run_metadata) final;
+
+private:
+    std::unique_ptr<constellation::data::RawFileWriter> writer_;
+    std::filesystem::path base_path_;
+    constellation::utils::TimeoutTimer flush_timer_ {std::chrono::seconds(3)};
+};
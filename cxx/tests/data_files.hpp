@@ -0,0 +1,26 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string_view>
+
+// Path of a file in the temporary directory of a test, removing files left over from previous test runs
+inline std::filesystem::path test_file_path(std::string_view test, std::string_view name) {
+    const auto directory = std::filesystem::temp_directory_path() / test;
+    std::filesystem::create_directories(directory);
+    const auto path = directory / name;
+    std::filesystem::remove(path);
+    return path;
+}
+
+// Open a file for binary writing
+inline std::ofstream open_file(const std::filesystem::path& path) {
+    return {path, std::ios_base::binary};
+}
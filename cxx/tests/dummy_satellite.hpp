@@ -41,6 +41,8 @@ public:
             "my_cmd_invalid_return", "Invalid User Command", {}, &DummySatelliteNR::usr_cmd_invalid_return, this);
         SatelliteT::register_command(
             "my_cmd_void", "Command without arguments & return", {}, &DummySatelliteNR::usr_cmd_void, this);
+        SatelliteT::register_command(
+            "my_cmd_async", "Asynchronous User Command", {}, &DummySatelliteNR::usr_cmd_arg, this, true);
         SatelliteT::register_command("my_cmd_state",
                                      "Command for RUN state only",
                                      {constellation::protocol::CSCP::State::RUN},
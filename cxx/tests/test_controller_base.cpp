@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <tuple>
 
@@ -18,6 +19,7 @@
 #include <msgpack.hpp>
 
 #include "constellation/controller/Controller.hpp"
+#include "constellation/controller/ControllerConfiguration.hpp"
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/message/CSCP1Message.hpp"
 #include "constellation/core/protocol/CHIRP_definitions.hpp"
@@ -429,6 +431,72 @@ TEST_CASE("Controller sends command with different payloads", "[controller]") {
     ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
 }
 
+TEST_CASE("Controller reconfigures satellites with changed configuration only", "[controller]") {
+    // Create CHIRP manager for control service discovery
+    create_chirp_manager();
+
+    // Create and start controller
+    DummyController controller {"ctrl"};
+    controller.start();
+
+    // Create and start satellite
+    DummySatellite satelliteA {"a"};
+    DummySatellite satelliteB {"b"};
+    satelliteA.mockChirpService(CHIRP::CONTROL);
+    satelliteA.mockChirpService(CHIRP::HEARTBEAT);
+    satelliteB.mockChirpService(CHIRP::CONTROL);
+    satelliteB.mockChirpService(CHIRP::HEARTBEAT);
+
+    // Await connection
+    while(controller.getConnectionCount() < 2) {
+        std::this_thread::sleep_for(50ms);
+    }
+
+    // Initialize and launch satellites
+    const std::string_view toml_string1 = "[satellites.Dummy.a]\n_heartbeat_interval = 3\n"
+                                          "[satellites.Dummy.b]\n_heartbeat_interval = 5\n";
+    const ControllerConfiguration config1 {toml_string1};
+    auto payloads = std::map<std::string, Controller::CommandPayload>();
+    for(const auto& name : controller.getConnections()) {
+        payloads.emplace(name, config1.getSatelliteConfiguration(name));
+    }
+    controller.sendCommands("initialize", payloads);
+    satelliteA.progressFsm();
+    satelliteB.progressFsm();
+    controller.waitReachedState(CSCP::State::INIT, true);
+    controller.sendCommands("launch");
+    satelliteA.progressFsm();
+    satelliteB.progressFsm();
+    controller.waitReachedState(CSCP::State::ORBIT, true);
+
+    // Unchanged configuration does not send any command
+    REQUIRE(controller.sendReconfigure(config1).empty());
+
+    // Only satellite with changed configuration is reconfigured
+    const std::string_view toml_string2 = "[satellites.Dummy.a]\n_heartbeat_interval = 4\n"
+                                          "[satellites.Dummy.b]\n_heartbeat_interval = 5\n";
+    const ControllerConfiguration config2 {toml_string2};
+    const auto msgs = controller.sendReconfigure(config2);
+    REQUIRE(msgs.size() == 1);
+    REQUIRE(msgs.contains("Dummy.a"));
+    REQUIRE(msgs.at("Dummy.a").getVerb().first == CSCP1Message::Type::SUCCESS);
+    satelliteA.progressFsm();
+    controller.waitReachedState(CSCP::State::ORBIT, true);
+
+    // Check that satellite received the new configuration:
+    const auto rply = controller.sendCommand("Dummy.a", "get_config");
+    REQUIRE(Dictionary::disassemble(rply.getPayload()).at("_heartbeat_interval").get<std::int64_t>() == 4);
+
+    // Applied configuration is tracked
+    REQUIRE(controller.sendReconfigure(config2).empty());
+
+    // Stop controller and exit satellites
+    controller.stop();
+    satelliteA.exit();
+    satelliteB.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
 TEST_CASE("Erroneous attempts to send commands", "[controller]") {
     // Create CHIRP manager for control service discovery
     create_chirp_manager();
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: EUPL-1.2
  */
 
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -14,11 +16,15 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 
 #include "constellation/controller/ControllerConfiguration.hpp"
 #include "constellation/controller/exceptions.hpp"
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/config/TypedArray.hpp"
 
 using namespace Catch::Matchers;
+using namespace constellation::config;
 using namespace constellation::controller;
 
 namespace {
@@ -98,4 +104,73 @@ TEST_CASE("No global section", "[controller]") {
     REQUIRE(global_config.empty());
 }
 
+TEST_CASE("Cached parsing", "[controller]") {
+    const std::string_view toml_string = "[satellites.Dummy.D1]\nkey = 1\n";
+
+    // Parsing the same content again yields identical configurations
+    const ControllerConfiguration config1 {toml_string};
+    const ControllerConfiguration config2 {toml_string};
+    REQUIRE(config1.getSatelliteConfiguration("Dummy.D1") == config2.getSatelliteConfiguration("Dummy.D1"));
+    REQUIRE(config2.hasSatelliteConfiguration("Dummy.D1"));
+
+    // Modifications do not affect later configurations with the same content
+    ControllerConfiguration config3 {toml_string};
+    config3.addSatelliteConfiguration("dummy.d1", {});
+    const ControllerConfiguration config4 {toml_string};
+    REQUIRE(config4.getSatelliteConfiguration("Dummy.D1").at("key").get<int>() == 1);
+
+    // Content of the same size is not mistaken for cached content, also after older entries were evicted
+    for(int value = 0; value < 10; ++value) {
+        const auto toml_value = "[satellites.Dummy.D1]\nkey = " + std::to_string(value) + "\n";
+        const ControllerConfiguration config5 {std::string_view(toml_value)};
+        REQUIRE(config5.getSatelliteConfiguration("Dummy.D1").at("key").get<int>() == value);
+    }
+    const ControllerConfiguration config6 {toml_string};
+    REQUIRE(config6.getSatelliteConfiguration("Dummy.D1").at("key").get<int>() == 1);
+}
+
+TEST_CASE("Configuration diff", "[controller]") {
+    const std::string_view toml_string1 = "[satellites]\na = 1\nb = \"x\"\nc = [1, 2]\n";
+    const std::string_view toml_string2 = "[satellites]\na = 1\nb = \"y\"\nc = [1, 2, 3]\nd = true\n";
+    const ControllerConfiguration config1 {toml_string1};
+    const ControllerConfiguration config2 {toml_string2};
+
+    const auto previous = config1.getSatelliteConfiguration("Dummy.D1");
+    const auto current = config2.getSatelliteConfiguration("Dummy.D1");
+
+    // Unchanged configuration
+    REQUIRE(ControllerConfiguration::diff(previous, previous).empty());
+
+    // Changed and added keys
+    const auto changes = ControllerConfiguration::diff(previous, current);
+    REQUIRE(changes.size() == 3);
+    REQUIRE_FALSE(changes.contains("a"));
+    REQUIRE(changes.at("b").get<std::string>() == "y");
+    REQUIRE(changes.at("c").get<std::vector<int>>() == std::vector<int>({1, 2, 3}));
+    REQUIRE(changes.at("d").get<bool>());
+
+    // Removed keys are not contained
+    const auto reverse_changes = ControllerConfiguration::diff(current, previous);
+    REQUIRE(reverse_changes.size() == 2);
+    REQUIRE_FALSE(reverse_changes.contains("d"));
+}
+
+TEST_CASE("Typed arrays as TOML", "[controller]") {
+    const std::string_view toml_string = "# Config without satellites";
+    ControllerConfiguration config {toml_string};
+
+    Dictionary dict {};
+    dict["mask"] = TypedArray(std::vector<std::uint64_t>({1, 2}));
+    dict["table"] = TypedArray(std::vector<float>({0.5F}));
+    config.addSatelliteConfiguration("Dummy.D1", dict);
+    const auto toml = config.getAsTOML();
+    REQUIRE_THAT(toml, ContainsSubstring("mask = [ 1, 2 ]"));
+    REQUIRE_THAT(toml, ContainsSubstring("table = [ 0.5 ]"));
+
+    // Unsigned values beyond the range of TOML integers cannot be converted
+    dict["mask"] = TypedArray(std::vector<std::uint64_t>({std::numeric_limits<std::uint64_t>::max()}));
+    config.addSatelliteConfiguration("Dummy.D1", dict);
+    REQUIRE_THROWS_AS(config.getAsTOML(), ConfigFileTypeError);
+}
+
 // NOLINTEND(cert-err58-cpp,misc-use-anonymous-namespace)
@@ -10,6 +10,8 @@
 #include <cstdint>
 #include <filesystem>
 #include <limits>
+#include <map>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -17,6 +19,7 @@
 #include <variant>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
@@ -26,8 +29,11 @@
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/config/exceptions.hpp"
+#include "constellation/core/config/TypedArray.hpp"
 #include "constellation/core/config/Value.hpp"
+#include "constellation/core/utils/casts.hpp"
 #include "constellation/core/utils/msgpack.hpp"
+#include "constellation/core/utils/string.hpp"
 
 using namespace Catch::Matchers;
 using namespace constellation::config;
@@ -102,6 +108,55 @@ TEST_CASE("Keys Are Case-Insensitive", "[core][core::config]") {
     REQUIRE(config.get<std::int64_t>("INT64") == 63);
 }
 
+TEST_CASE("Case-Insensitive Key Updates", "[core][core::config]") {
+    Configuration config {};
+
+    // Overwriting with different case keeps a single lower-case key
+    config.set("MyKey", 1);
+    config.set("MYKEY", 2);
+    REQUIRE(config.size() == 1);
+    REQUIRE(config.get<int>("mykey") == 2);
+    REQUIRE(config.getDictionary().contains("mykey"));
+    REQUIRE(config.getText("myKEY") == "2");
+    REQUIRE(config.count({"MYKEY", "mykey", "other"}) == 2);
+
+    // Aliases are stored in lower case
+    config.setAlias("NewKey", "MyKey");
+    REQUIRE(config.getDictionary().contains("newkey"));
+    REQUIRE(config.get<int>("NEWKEY") == 2);
+
+    // Ordering is case-insensitive
+    const auto less = case_insensitive_less();
+    REQUIRE(less("ABC", "abd"));
+    REQUIRE_FALSE(less("ABC", "abc"));
+    REQUIRE_FALSE(less("abc", "ABC"));
+    REQUIRE(less("_a", "a"));
+}
+
+TEST_CASE("Case-Insensitive Key Lookup", "[core][core::config][.benchmark]") {
+    // Configuration-sized set of keys
+    std::map<std::string, Value> transformed {};
+    std::map<std::string, Value, case_insensitive_less> compared {};
+    Configuration config {};
+    for(int n = 0; n < 200; ++n) {
+        const auto key = "satellite_parameter_" + std::to_string(n);
+        transformed.emplace(key, Value::set(n));
+        compared.emplace(key, Value::set(n));
+        config.set(key, n);
+    }
+    const std::string key = "Satellite_Parameter_123";
+
+    BENCHMARK("Lower-case copy of key") {
+        return transformed.find(transform(key, ::tolower))->second.get<int>();
+    };
+    BENCHMARK("Case-insensitive comparator") {
+        return compared.find(key)->second.get<int>();
+    };
+    BENCHMARK("Configuration::get") {
+        return config.get<int>(key);
+    };
+}
+
 TEST_CASE("Enum Values Are Case-Insensitive", "[core][core::config]") {
     Configuration config {};
 
@@ -608,6 +663,118 @@ TEST_CASE("Pack & Unpack Dictionary to MsgPack", "[core][core::config]") {
             std::vector<std::chrono::system_clock::time_point>({tp, tp, tp}));
 }
 
+TEST_CASE("Pack & Unpack FlatDictionary to MsgPack", "[core][core::config]") {
+    // Create flat dictionary with keys out of order
+    FlatDictionary dict {{"string", std::string("a")}, {"bool", true}};
+    dict["int64"] = std::int64_t(63);
+    dict.emplace("array_double", std::vector<double>({1.3, 3.1}));
+    REQUIRE(dict.size() == 4);
+    REQUIRE(dict.begin()->first == "array_double");
+    REQUIRE_FALSE(dict.emplace("bool", false).second);
+    REQUIRE(dict.at("bool").get<bool>() == true);
+    REQUIRE_THROWS_AS(dict.at("missing"), std::out_of_range);
+
+    // Wire format is identical to Dictionary
+    msgpack::sbuffer sbuf {};
+    msgpack::pack(sbuf, dict);
+    auto dict_unpacked = msgpack_unpack_to<Dictionary>(sbuf.data(), sbuf.size());
+    REQUIRE(dict_unpacked.size() == 4);
+    REQUIRE(dict_unpacked["string"].get<std::string>() == "a");
+    REQUIRE(dict_unpacked["array_double"].get<std::vector<double>>() == std::vector<double>({1.3, 3.1}));
+
+    msgpack::sbuffer sbuf_dict {};
+    msgpack::pack(sbuf_dict, dict_unpacked);
+    const auto flat_unpacked = msgpack_unpack_to<FlatDictionary>(sbuf_dict.data(), sbuf_dict.size());
+    REQUIRE(flat_unpacked.size() == 4);
+    REQUIRE(flat_unpacked.at("int64").get<std::int64_t>() == 63);
+    REQUIRE(flat_unpacked.contains("bool"));
+    REQUIRE_FALSE(flat_unpacked.contains("Bool"));
+
+    // Keys are interned
+    REQUIRE(flat_unpacked.find("string")->first.data() == dict.find("string")->first.data());
+    REQUIRE(FlatDictionary::intern(std::string("int64"))->data() == FlatDictionary::intern("int64")->data());
+
+    // Conversion and removal
+    const Dictionary dict_converted = flat_unpacked;
+    REQUIRE(dict_converted.size() == 4);
+    REQUIRE(dict.erase("bool") == 1);
+    REQUIRE(dict.erase("bool") == 0);
+    REQUIRE_THAT(dict.to_string(), EndsWith("\n int64: 63\n string: a"));
+}
+
+TEST_CASE("Pack & Unpack TypedArray to MsgPack", "[core][core::config]") {
+    std::vector<std::uint16_t> mask(4096);
+    for(std::size_t n = 0; n < mask.size(); ++n) {
+        mask[n] = static_cast<std::uint16_t>(n);
+    }
+    const auto table = std::vector<float>({0.5F, 1.5F, -2.F});
+
+    Dictionary dict {};
+    dict["mask"] = TypedArray(mask);
+    dict["table"] = TypedArray(table);
+    dict["empty"] = TypedArray(std::vector<std::int32_t>());
+
+    msgpack::sbuffer sbuf {};
+    msgpack::pack(sbuf, dict);
+
+    // Elements are encoded as a single extension object
+    REQUIRE(sbuf.size() < mask.size() * sizeof(std::uint16_t) + 64);
+
+    auto dict_unpacked = msgpack_unpack_to<Dictionary>(sbuf.data(), sbuf.size());
+    const auto& mask_unpacked = dict_unpacked["mask"].get<TypedArray>();
+    REQUIRE(mask_unpacked.getDType() == DType::UINT16);
+    REQUIRE(mask_unpacked.size() == 4096);
+    REQUIRE(mask_unpacked.span<std::uint16_t>()[4095] == 4095);
+    REQUIRE_THROWS_AS(mask_unpacked.span<std::int16_t>(), std::bad_variant_access);
+    REQUIRE(mask_unpacked == TypedArray(mask));
+    REQUIRE(dict_unpacked["table"].get<TypedArray>().span<float>()[2] == -2.F);
+    REQUIRE(dict_unpacked["empty"].get<TypedArray>().empty());
+
+    // Conversion to vectors
+    REQUIRE(dict_unpacked["table"].get<std::vector<double>>() == std::vector<double>({0.5, 1.5, -2.}));
+    REQUIRE(dict_unpacked["mask"].get<std::vector<std::int64_t>>().back() == 4095);
+    REQUIRE(dict_unpacked["table"].str() == "[0.5, 1.5, -2]");
+
+    // Zero-copy view into the assembled payload, element data is aligned relative to the start of the buffer
+    dict["doubles"] = TypedArray(std::vector<double>({0.25, 4.}));
+    const auto payload = dict.assemble();
+    const auto payload_span = payload.span();
+    const auto reference = [](msgpack::type::object_type /*type*/, std::size_t /*size*/, void* /*user_data*/) {
+        return true;
+    };
+    const auto msgpack_handle = msgpack::unpack(to_char_ptr(payload_span.data()), payload_span.size(), reference);
+    const auto msgpack_map = msgpack_handle.get().via.map;
+    const auto in_payload = [&](const void* ptr) {
+        return ptr >= payload_span.data() && ptr < payload_span.data() + payload_span.size();
+    };
+    std::size_t views {0};
+    for(const auto& msgpack_kv : std::span(msgpack_map.ptr, msgpack_map.size)) {
+        const auto key = msgpack_kv.key.as<std::string>();
+        if(key == "table") {
+            const auto view = TypedArray::view<float>(msgpack_kv.val);
+            REQUIRE(view.has_value());
+            REQUIRE(in_payload(view->data()));
+            REQUIRE(view->size() == 3);
+            REQUIRE(view.value()[0] == 0.5F);
+            REQUIRE_FALSE(TypedArray::view<double>(msgpack_kv.val).has_value());
+            ++views;
+        } else if(key == "mask") {
+            const auto view = TypedArray::view<std::uint16_t>(msgpack_kv.val);
+            REQUIRE(view.has_value());
+            REQUIRE(in_payload(view->data()));
+            REQUIRE(view.value()[4095] == 4095);
+            ++views;
+        } else if(key == "doubles") {
+            const auto view = TypedArray::view<double>(msgpack_kv.val);
+            REQUIRE(view.has_value());
+            REQUIRE(in_payload(view->data()));
+            REQUIRE(view.value()[1] == 4.);
+            ++views;
+        }
+    }
+    REQUIRE(views == 3);
+}
+
 TEST_CASE("Generate Configurations from Dictionary", "[core][core::config]") {
     // Create dictionary
     Dictionary dict {};
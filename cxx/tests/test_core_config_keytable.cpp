@@ -0,0 +1,54 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+// Filling the process-wide key table affects all dictionaries of the process, hence this test runs in its own executable
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <msgpack.hpp>
+
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/utils/msgpack.hpp"
+
+using namespace constellation::config;
+using namespace constellation::utils;
+
+// NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
+
+TEST_CASE("Bounded FlatDictionary key table", "[core][core::config]") {
+    // Fill the key table, e.g. with keys from the network
+    for(std::size_t n = 0; n < FlatDictionary::max_interned_keys; ++n) {
+        FlatDictionary::intern("key_table_" + std::to_string(n));
+    }
+    REQUIRE_FALSE(FlatDictionary::intern("key_table_overflow").has_value());
+    REQUIRE(FlatDictionary::intern("key_table_0").has_value());
+
+    // Keys which are not interned are stored in the dictionary and shared with copies
+    FlatDictionary dict {};
+    dict["key_table_overflow"] = std::int64_t(1);
+    dict["key_table_0"] = std::int64_t(2);
+    REQUIRE_FALSE(FlatDictionary::intern("key_table_overflow").has_value());
+
+    auto copy = dict;
+    dict.clear();
+    copy["key_table_overflow_2"] = std::int64_t(3);
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy.at("key_table_overflow").get<std::int64_t>() == 1);
+    REQUIRE(copy.begin()->first == "key_table_0");
+
+    msgpack::sbuffer sbuf {};
+    msgpack::pack(sbuf, copy);
+    const auto unpacked = msgpack_unpack_to<FlatDictionary>(sbuf.data(), sbuf.size());
+    REQUIRE(unpacked.at("key_table_overflow_2").get<std::int64_t>() == 3);
+
+    REQUIRE(copy.erase("key_table_overflow") == 1);
+    REQUIRE_FALSE(copy.contains("key_table_overflow"));
+}
+
+// NOLINTEND(cert-err58-cpp,misc-use-anonymous-namespace)
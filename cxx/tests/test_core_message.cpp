@@ -4,26 +4,48 @@
  * SPDX-License-Identifier: EUPL-1.2
  */
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <numbers>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include <asio/buffer.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/address_v4.hpp>
+#include <asio/ip/udp.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <msgpack.hpp>
 #include <zmq.hpp>
+#include <zmq_addon.hpp>
 
 #include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/AlignedBuffer.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
 #include "constellation/core/message/CMDP1Message.hpp"
 #include "constellation/core/message/CSCP1Message.hpp"
+#include "constellation/core/message/DataFeedback.hpp"
 #include "constellation/core/message/exceptions.hpp"
+#include "constellation/core/message/FrameView.hpp"
+#include "constellation/core/message/InFlightBudget.hpp"
+#include "constellation/core/message/PayloadBuffer.hpp"
+#include "constellation/core/message/RetransmitBuffer.hpp"
+#include "constellation/core/networking/Datagram.hpp"
+#include "constellation/core/networking/exceptions.hpp"
 #include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/exceptions.hpp"
 #include "constellation/core/utils/msgpack.hpp"
 #include "constellation/core/utils/string.hpp"
 
@@ -31,7 +53,9 @@ using namespace Catch::Matchers;
 using namespace constellation::config;
 using namespace constellation::log;
 using namespace constellation::message;
+using namespace constellation::networking;
 using namespace constellation::utils;
+using namespace std::chrono_literals;
 using namespace std::string_literals;
 
 // NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
@@ -236,11 +260,15 @@ TEST_CASE("Message Assembly / Disassembly (CSCP1)", "[core][core::message]") {
 }
 
 TEST_CASE("Message Assembly / Disassembly (CDTP1)", "[core][core::message]") {
+    const auto compact_header = GENERATE(false, true);
+    CDTP1Message::SenderRegistry registry {};
+    REQUIRE(registry.add("senderCDTP"));
+
     CDTP1Message cdtp1_msg {{"senderCDTP", 1234, CDTP1Message::Type::DATA}, 1};
     REQUIRE(cdtp1_msg.getPayload().empty());
 
-    auto frames = cdtp1_msg.assemble();
-    auto cdtp1_msg2 = CDTP1Message::disassemble(frames);
+    auto frames = cdtp1_msg.assemble(compact_header);
+    auto cdtp1_msg2 = CDTP1Message::disassemble(frames, &registry);
 
     REQUIRE_THAT(cdtp1_msg2.getHeader().to_string(), ContainsSubstring("Sender: senderCDTP"));
     REQUIRE(cdtp1_msg2.getPayload().empty());
@@ -315,6 +343,10 @@ TEST_CASE("Message Payload (CSCP1, too many frames)", "[core][core::message]") {
 }
 
 TEST_CASE("Message Payload (CDTP1)", "[core][core::message]") {
+    const auto compact_header = GENERATE(false, true);
+    CDTP1Message::SenderRegistry registry {};
+    REQUIRE(registry.add("senderCDTP"));
+
     CDTP1Message cdtp1_msg {{"senderCDTP", 1234, CDTP1Message::Type::DATA}, 3};
 
     // Add payload frame
@@ -327,8 +359,8 @@ TEST_CASE("Message Payload (CDTP1)", "[core][core::message]") {
     REQUIRE(cdtp1_msg.countPayloadBytes() == 39);
 
     // Assemble and disassemble message
-    auto frames = cdtp1_msg.assemble();
-    auto cdtp1_msg2 = CDTP1Message::disassemble(frames);
+    auto frames = cdtp1_msg.assemble(compact_header);
+    auto cdtp1_msg2 = CDTP1Message::disassemble(frames, &registry);
 
     // Retrieve payload
     const auto& data = cdtp1_msg2.getPayload();
@@ -354,4 +386,414 @@ TEST_CASE("Packing / Unpacking (CDTP1)", "[core][core::message]") {
     REQUIRE(cdtp1_header_unpacked.getSequenceNumber() == seq_no);
 }
 
+TEST_CASE("Compact Header (CDTP1)", "[core][core::message]") {
+    // BOR message never uses the compact header, its sender is added to the registry of the receiver
+    CDTP1Message bor_msg {{"senderCompact", 0, CDTP1Message::Type::BOR}, 1};
+    bor_msg.addPayload("config"s);
+    auto bor_frames = bor_msg.assemble(true);
+    REQUIRE(std::to_integer<std::uint8_t>(*to_byte_ptr(bor_frames.front().data())) != CDTP1Message::Header::compact_marker);
+    CDTP1Message::SenderRegistry registry {};
+    REQUIRE(registry.add(CDTP1Message::disassemble(bor_frames).getHeader().getSender()));
+
+    // Without tags only the fixed-size part is sent
+    CDTP1Message::Header header {"senderCompact", 1234, CDTP1Message::Type::DATA};
+    msgpack::sbuffer sbuf {};
+    header.compact_pack(sbuf);
+    REQUIRE(sbuf.size() == CDTP1Message::Header::compact_size);
+
+    auto header_unpacked = CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry);
+    REQUIRE(header_unpacked.getSender() == "senderCompact");
+    REQUIRE(header_unpacked.getType() == CDTP1Message::Type::DATA);
+    REQUIRE(header_unpacked.getSequenceNumber() == 1234);
+    REQUIRE(header_unpacked.getTags().empty());
+
+    // Tags are appended if present
+    header.setTag("trigger", 42);
+    sbuf.clear();
+    header.compact_pack(sbuf);
+    REQUIRE(sbuf.size() > CDTP1Message::Header::compact_size);
+    header_unpacked = CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry);
+    REQUIRE(header_unpacked.getTag<int>("trigger") == 42);
+
+    // Compact header is smaller than the MessagePack header
+    msgpack::sbuffer sbuf_msgpack {};
+    msgpack::pack(sbuf_msgpack, header);
+    REQUIRE(sbuf.size() < sbuf_msgpack.size());
+
+    // BOR and EOR cannot use the compact header
+    const CDTP1Message::Header eor_header {"senderCompact", 1235, CDTP1Message::Type::EOR};
+    REQUIRE_THROWS_AS(eor_header.compact_pack(sbuf), IncorrectMessageType);
+
+    // Unknown sender
+    const CDTP1Message::Header unknown_header {"senderUnknown", 1, CDTP1Message::Type::DATA};
+    sbuf.clear();
+    unknown_header.compact_pack(sbuf);
+    REQUIRE_THROWS_MATCHES(
+        CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry),
+        MessageDecodingError,
+        Message("Error decoding message: Compact header with unknown sender ID, no BOR message received from sender"));
+
+    // Sender removed from the registry
+    sbuf.clear();
+    header.compact_pack(sbuf);
+    registry.remove("senderCompact");
+    REQUIRE_THROWS_AS(CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry),
+                      MessageDecodingError);
+
+    // Without registry compact headers cannot be decoded
+    REQUIRE(registry.add("senderCompact"));
+    REQUIRE_NOTHROW(CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry));
+    REQUIRE_THROWS_AS(CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}), MessageDecodingError);
+
+    // Truncated header
+    REQUIRE_THROWS_AS(CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), 8}, &registry), MessageDecodingError);
+}
+
+TEST_CASE("Compact Header Sender Registry (CDTP1)", "[core][core::message]") {
+    // Senders with colliding 64-bit FNV-1a hash
+    constexpr std::string_view sender_a = "Sat.ee9f69bd06bf7cdc";
+    constexpr std::string_view sender_b = "Sat.6f4a6c413f809be1";
+    REQUIRE(CDTP1Message::Header::sender_id(sender_a) == CDTP1Message::Header::sender_id(sender_b));
+
+    // Registering the same sender again succeeds, a colliding sender is rejected
+    CDTP1Message::SenderRegistry registry {};
+    REQUIRE(registry.add(sender_a));
+    REQUIRE(registry.add(sender_a));
+    REQUIRE_FALSE(registry.add(sender_b));
+
+    // Removing the colliding sender does not remove the registered sender
+    registry.remove(sender_b);
+    REQUIRE_FALSE(registry.add(sender_b));
+
+    // Registries of different receivers are independent
+    CDTP1Message::SenderRegistry other_registry {};
+    REQUIRE(other_registry.add(sender_b));
+
+    // Compact headers resolve to the first registered sender, whose name is shared between decoded headers
+    const CDTP1Message::Header header {std::string(sender_a), 1, CDTP1Message::Type::DATA};
+    msgpack::sbuffer sbuf {};
+    header.compact_pack(sbuf);
+    const auto header1 = CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry);
+    const auto header2 = CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &registry);
+    REQUIRE(header1.getSender() == sender_a);
+    REQUIRE(header1.getSender().data() == header2.getSender().data());
+
+    // Copies of a decoded header keep the shared sender name
+    const auto header3 = header1; // NOLINT(performance-unnecessary-copy-initialization)
+    REQUIRE(header3.getSender().data() == header1.getSender().data());
+
+    // Other registry resolves to its own sender, cleared registry to none
+    REQUIRE(CDTP1Message::Header::disassemble({to_byte_ptr(sbuf.data()), sbuf.size()}, &other_registry).getSender() ==
+            sender_b);
+    registry.clear();
+    REQUIRE(registry.resolve(CDTP1Message::Header::sender_id(sender_a)) == nullptr);
+}
+
+TEST_CASE("Aligned Payload Buffer", "[core][core::message]") {
+    const auto alignment = GENERATE(AlignedBuffer::cache_line, AlignedBuffer::page);
+
+    AlignedBuffer buffer {100, alignment};
+    REQUIRE(buffer.size() == 100);
+    REQUIRE(AlignedBuffer::is_aligned(buffer.data(), alignment));
+    buffer.span()[0] = std::byte(0x42);
+
+    // Move into payload buffer without copying
+    const auto* data_ptr = buffer.data();
+    const PayloadBuffer payload {std::move(buffer)};
+    REQUIRE(payload.span().data() == data_ptr);
+    REQUIRE(payload.span().size() == 100);
+    REQUIRE(payload.is_aligned(alignment));
+    REQUIRE(payload.span()[0] == std::byte(0x42));
+
+    // Invalid alignment
+    REQUIRE_THROWS_AS(AlignedBuffer(100, 48), LogicError);
+}
+
+TEST_CASE("Aligned Buffer Pool", "[core][core::message]") {
+    AlignedBufferPool pool {AlignedBuffer::page, 1};
+    REQUIRE(pool.idle() == 0);
+
+    // Copy misaligned data into pooled buffer
+    std::vector<std::byte> data(33, std::byte(0x17));
+    const auto misaligned = std::span(data).subspan(1);
+    const std::byte* buffer_ptr = nullptr;
+    {
+        PayloadBuffer payload {pool.copy(misaligned)};
+        REQUIRE(payload.is_aligned(AlignedBuffer::page));
+        REQUIRE(payload.span().size() == 32);
+        REQUIRE(std::ranges::equal(payload.span(), misaligned));
+        buffer_ptr = payload.span().data();
+    }
+
+    // Buffer is returned to the pool and reused
+    REQUIRE(pool.idle() == 1);
+    const auto buffer = pool.acquire(16);
+    REQUIRE(pool.idle() == 0);
+    REQUIRE(buffer->data() == buffer_ptr);
+    REQUIRE(buffer->size() == 16);
+
+    // Pool does not keep more than the maximum number of buffers
+    {
+        const auto buffer1 = pool.acquire(8);
+        const auto buffer2 = pool.acquire(8);
+    }
+    REQUIRE(pool.idle() == 1);
+}
+
+TEST_CASE("Typed Frame Views (CDTP1)", "[core][core::message]") {
+    CDTP1Message cdtp1_msg {{"senderCDTP", 1, CDTP1Message::Type::DATA}, 2};
+    cdtp1_msg.getHeader().setTag(std::string(frame_dtype_tag), frame_dtype<float>());
+    cdtp1_msg.addPayload(std::vector<float>({1.5F, -2.0F, 3.25F}));
+
+    // Struct of arrays with 3 records of uint32 and uint16 columns
+    AlignedBuffer soa_buffer {18};
+    const std::vector<std::uint32_t> ids {1, 2, 3};
+    const std::vector<std::uint16_t> adcs {10, 20, 30};
+    std::ranges::copy(std::as_bytes(std::span(ids)), soa_buffer.data());
+    std::ranges::copy(std::as_bytes(std::span(adcs)), soa_buffer.data() + 12);
+    cdtp1_msg.addPayload(std::move(soa_buffer));
+
+    // Assemble and disassemble message
+    auto frames = cdtp1_msg.assemble();
+    const auto cdtp1_msg2 = CDTP1Message::disassemble(frames);
+
+    // View on received frame without copy
+    const auto samples = frame_view<float>(cdtp1_msg2, 0);
+    REQUIRE(samples.data() == static_cast<const void*>(cdtp1_msg2.getPayload()[0].span().data()));
+    REQUIRE(std::ranges::equal(samples, std::vector<float>({1.5F, -2.0F, 3.25F})));
+
+    // Columns
+    const auto [ids_view, adcs_view] = frame_columns<std::uint32_t, std::uint16_t>(cdtp1_msg2.getPayload()[1]);
+    REQUIRE(std::ranges::equal(ids_view, ids));
+    REQUIRE(std::ranges::equal(adcs_view, adcs));
+
+    // Element type does not match tag
+    REQUIRE_THROWS_WITH(frame_view<std::int32_t>(cdtp1_msg2, 0),
+                        Equals("Frames tagged with element type FLOAT cannot be viewed as INT32"));
+
+    // Frame does not exist
+    REQUIRE_THROWS_AS(frame_view<float>(cdtp1_msg2, 2), InvalidPayload);
+
+    // Frame size is not a multiple of the element or record size
+    REQUIRE_THROWS_AS(frame_view<double>(cdtp1_msg2.getPayload()[0]), InvalidPayload);
+    REQUIRE_THROWS_AS((frame_columns<std::uint32_t, std::uint32_t>(cdtp1_msg2.getPayload()[1])), InvalidPayload);
+
+    // Misaligned frame
+    const auto misaligned = cdtp1_msg2.getPayload()[0].span().subspan(1, 4);
+    REQUIRE_THROWS_AS(frame_view<float>(misaligned), InvalidPayload);
+}
+
+TEST_CASE("Retransmit Buffer", "[core][core::message]") {
+    RetransmitBuffer buffer {3};
+    REQUIRE(buffer.enabled());
+
+    for(std::uint64_t seq = 1; seq <= 5; ++seq) {
+        auto msg = CDTP1Message({"senderCDTP", seq, CDTP1Message::Type::DATA}, 1);
+        msg.addPayload(std::vector<std::uint64_t>(1024, seq));
+        auto frames = msg.assemble();
+        const auto* payload_data = frames.back().data();
+        auto shared = RetransmitBuffer::share(frames);
+        // Shared frames reference the same content
+        REQUIRE(shared.back().data() == payload_data);
+        buffer.store(seq, std::move(shared));
+    }
+
+    // Only the last three messages are retained
+    REQUIRE(buffer.size() == 3);
+    auto messages = buffer.retrieve(1, 4);
+    REQUIRE(messages.size() == 2);
+    REQUIRE(messages.front().first == 3);
+    auto msg = CDTP1Message::disassemble(messages.back().second);
+    REQUIRE(msg.getHeader().getSequenceNumber() == 4);
+
+    // Oldest messages can be dropped early
+    REQUIRE(buffer.dropOldest());
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer.retrieve(1, 5).front().first == 4);
+
+    // Range encoding
+    const auto range = RetransmitBuffer::encode_range(3, 7);
+    const auto [begin, end] = RetransmitBuffer::decode_range({to_byte_ptr(range.data()), range.size()});
+    REQUIRE(begin == 3);
+    REQUIRE(end == 7);
+    REQUIRE_THROWS_AS(RetransmitBuffer::decode_range({}), MessageDecodingError);
+
+    // Messages expire after the maximum age
+    buffer.configure(3, 0s);
+    REQUIRE(buffer.size() == 0);
+    buffer.store(6, {});
+    std::this_thread::sleep_for(1ms);
+    REQUIRE(buffer.retrieve(0, 10).empty());
+
+    // Disabled buffer does not retain messages
+    buffer.configure(0, 10s);
+    REQUIRE_FALSE(buffer.enabled());
+    buffer.store(7, {});
+    REQUIRE(buffer.size() == 0);
+}
+
+TEST_CASE("Data Feedback", "[core][core::message]") {
+    const DataFeedback feedback {1234, true, true, 567};
+    auto frames = feedback.assemble();
+    REQUIRE(frames.size() == DataFeedback::frames);
+
+    const auto feedback2 = DataFeedback::disassemble(frames);
+    REQUIRE(feedback2.getSequenceNumber() == 1234);
+    REQUIRE(feedback2.isLagging());
+    REQUIRE(feedback2.supportsCompactHeader());
+    REQUIRE(feedback2.getReceived() == 567);
+
+    // Compact header support is not announced by default
+    REQUIRE_FALSE(DataFeedback::disassemble(DataFeedback(1, false).assemble()).supportsCompactHeader());
+
+    // Retransmission requests with a single frame are not valid feedback
+    frames.pop();
+    frames.pop();
+    frames.pop();
+    REQUIRE_THROWS_AS(DataFeedback::disassemble(frames), MessageDecodingError);
+}
+
+TEST_CASE("In-Flight Budget", "[core][core::message]") {
+    InFlightBudget budget {4096};
+    REQUIRE(budget.enabled());
+
+    // Payload is returned to the budget once ZeroMQ released all frames sharing it
+    auto msg = CDTP1Message({"senderCDTP", 1, CDTP1Message::Type::DATA}, 1);
+    msg.addPayload(std::vector<std::uint64_t>(256, 1));
+    const auto payload_bytes = msg.countPayloadBytes();
+    REQUIRE(budget.acquire(payload_bytes));
+    auto frames = msg.assemble(false, [&](std::size_t bytes) { budget.release(bytes); });
+    auto shared = RetransmitBuffer::share(frames);
+    REQUIRE(budget.bytes() == payload_bytes);
+
+    // Budget is exhausted while the payload is in flight
+    REQUIRE_FALSE(budget.acquire(1));
+    frames.clear();
+    REQUIRE(budget.bytes() == payload_bytes);
+
+    // Waiting acquisition succeeds once the payload is released
+    auto release_thread = std::thread([&]() {
+        std::this_thread::sleep_for(10ms);
+        shared.clear();
+    });
+    REQUIRE(budget.acquire(1, 1s));
+    release_thread.join();
+    REQUIRE(budget.bytes() == 1);
+    budget.release(1);
+
+    // Single acquisition larger than the limit is possible if nothing else is in flight
+    REQUIRE(budget.acquire(8192));
+    REQUIRE_FALSE(budget.acquire(1, 1ms));
+    budget.release(8192);
+
+    // Disabled budget only counts bytes
+    budget.configure(0);
+    REQUIRE_FALSE(budget.enabled());
+    REQUIRE(budget.acquire(8192));
+    REQUIRE(budget.acquire(8192));
+    REQUIRE(budget.bytes() == 16384);
+    budget.release(8192);
+    REQUIRE(budget.bytes() == 8192);
+}
+
+TEST_CASE("Datagram Transport (CDTP1)", "[core][core::message]") {
+    const auto loopback = asio::ip::address_v4::loopback();
+    const auto sender_id = CDTP1Message::Header::sender_id("senderCDTP");
+    constexpr std::size_t datagram_size = 256;
+    constexpr std::size_t payload_size = datagram_size - DatagramHeader::size;
+    auto receiver = DatagramReceiver(loopback, 0, sender_id, datagram_size, 64 * 1024);
+    auto sender = DatagramSender(loopback, receiver.getPort(), asio::ip::address_v4::any(), datagram_size);
+
+    // Datagram size needs to fit header and payload
+    REQUIRE_THROWS_AS(DatagramReceiver(loopback, 0, sender_id, DatagramHeader::size), NetworkError);
+
+    // Raw socket to send single fragments
+    asio::io_context io_context {};
+    auto raw_socket = asio::ip::udp::socket(io_context, asio::ip::udp::v4());
+    const auto endpoint = asio::ip::udp::endpoint(loopback, receiver.getPort());
+    const auto send_fragment = [&](const DatagramHeader& header, std::size_t length) {
+        const auto header_data = header.pack();
+        const auto payload = std::vector<std::byte>(length);
+        raw_socket.send_to(std::array {asio::buffer(header_data), asio::buffer(payload)}, endpoint);
+    };
+
+    const auto make_frames = [](std::uint64_t seq) {
+        auto msg = CDTP1Message({"senderCDTP", seq, CDTP1Message::Type::DATA}, 2);
+        msg.addPayload(std::vector<std::uint64_t>(1024, seq));
+        msg.addPayload("tail"s);
+        return msg.assemble();
+    };
+
+    // Message larger than a datagram is fragmented and reassembled
+    REQUIRE(sender.send(sender_id, 1, make_frames(1)));
+    auto frames = receiver.recv(1s);
+    REQUIRE(frames.has_value());
+    auto msg = CDTP1Message::disassemble(frames.value());
+    REQUIRE(msg.getHeader().getSequenceNumber() == 1);
+    REQUIRE(msg.getPayload().size() == 2);
+    REQUIRE(msg.getPayload()[0].span().size() == 1024 * sizeof(std::uint64_t));
+    REQUIRE(std::ranges::equal(msg.getPayload()[0].span(), std::as_bytes(std::span(std::vector<std::uint64_t>(1024, 1)))));
+    REQUIRE(msg.getPayload()[1].to_string_view() == "tail");
+
+    // Messages of other senders are ignored
+    REQUIRE(sender.send(sender_id + 1, 2, make_frames(2)));
+    REQUIRE_FALSE(receiver.recv(50ms).has_value());
+
+    // Incomplete message is dropped once a later message is completed
+    auto header = DatagramHeader {.fragment_index = 0,
+                                  .fragment_count = 2,
+                                  .sender_id = sender_id,
+                                  .seq = 3,
+                                  .offset = 0,
+                                  .body_size = 2 * payload_size};
+    send_fragment(header, payload_size);
+    REQUIRE_FALSE(receiver.recv(50ms).has_value());
+    REQUIRE(sender.send(sender_id, 4, make_frames(4)));
+    frames = receiver.recv(1s);
+    REQUIRE(frames.has_value());
+    REQUIRE(CDTP1Message::disassemble(frames.value()).getHeader().getSequenceNumber() == 4);
+    REQUIRE(receiver.countIncomplete() == 1);
+
+    // Messages arriving after a later message are dropped
+    REQUIRE(sender.send(sender_id, 3, make_frames(3)));
+    REQUIRE_FALSE(receiver.recv(50ms).has_value());
+
+    // Invalid datagrams throw
+    raw_socket.send_to(asio::buffer("invalid"s), endpoint);
+    REQUIRE_THROWS_MATCHES(receiver.recv(1s),
+                           MessageDecodingError,
+                           Message("Error decoding message: Datagram too short"));
+
+    // Fragments not matching the datagram size throw
+    header.seq = 5;
+    header.fragment_count = 3;
+    send_fragment(header, payload_size);
+    REQUIRE_THROWS_MATCHES(
+        receiver.recv(1s), MessageDecodingError, Message("Error decoding message: Invalid fragment 0 of message 5"));
+    header.fragment_count = 2;
+    header.fragment_index = 1;
+    header.offset = payload_size - 1;
+    send_fragment(header, payload_size);
+    REQUIRE_THROWS_MATCHES(
+        receiver.recv(1s), MessageDecodingError, Message("Error decoding message: Invalid fragment 1 of message 5"));
+    header.offset = payload_size;
+    send_fragment(header, payload_size - 1);
+    REQUIRE_THROWS_MATCHES(
+        receiver.recv(1s), MessageDecodingError, Message("Error decoding message: Invalid fragment 1 of message 5"));
+
+    // Messages exceeding the maximum message size throw before allocating memory
+    header = DatagramHeader {.fragment_index = 0,
+                             .fragment_count = 1024,
+                             .sender_id = sender_id,
+                             .seq = 6,
+                             .offset = 0,
+                             .body_size = 1024 * payload_size};
+    send_fragment(header, payload_size);
+    REQUIRE_THROWS_MATCHES(receiver.recv(1s),
+                           MessageDecodingError,
+                           Message("Error decoding message: Message 6 of " + to_string(1024 * payload_size) +
+                                   " bytes exceeds maximum message size of 65536 bytes"));
+    REQUIRE(receiver.countIncomplete() == 1);
+}
+
 // NOLINTEND(cert-err58-cpp,misc-use-anonymous-namespace)
@@ -0,0 +1,153 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<zstd.h>)
+#include <zstd.h>
+#endif
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include "constellation/data/BlockFileWriter.hpp"
+#include "constellation/data/exceptions.hpp"
+
+#include "data_files.hpp"
+
+using namespace Catch::Matchers;
+using namespace constellation::data;
+
+namespace {
+    std::filesystem::path file_path(std::string_view name) {
+        return test_file_path("test_data_blockfile", name);
+    }
+
+    std::vector<std::byte> read_file(const std::filesystem::path& path) {
+        std::ifstream file {path, std::ios_base::binary};
+        std::vector<char> content {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        return {std::as_bytes(std::span(content)).begin(), std::as_bytes(std::span(content)).end()};
+    }
+
+    // Data with some redundancy, written in chunks not aligned to the block size
+    std::vector<std::byte> test_data() {
+        std::vector<std::byte> data(1000003);
+        for(std::size_t n = 0; n < data.size(); ++n) {
+            data[n] = static_cast<std::byte>((n * 7) % 251);
+        }
+        return data;
+    }
+
+    void write_chunked(BlockFileWriter& writer, std::span<const std::byte> data) {
+        constexpr std::size_t chunk_size = 777;
+        for(std::size_t offset = 0; offset < data.size(); offset += chunk_size) {
+            writer.write(data.subspan(offset, std::min(chunk_size, data.size() - offset)));
+        }
+    }
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
+
+TEST_CASE("Write uncompressed block file", "[data]") {
+    const auto path = file_path("uncompressed.raw");
+    const auto data = test_data();
+    {
+        BlockFileWriter writer {open_file(path)};
+        write_chunked(writer, data);
+        REQUIRE(writer.getStatistics()->getCompressionRatio() == 1.0);
+        REQUIRE(writer.getStatistics()->getWorkers() == 0);
+    }
+
+    // Output is identical to the written data
+    REQUIRE(read_file(path) == data);
+}
+
+TEST_CASE("Write compressed block file", "[data]") {
+    if(!BlockFileWriter::isAvailable(Compression::ZSTD)) {
+        SKIP("Zstandard compression not available");
+    }
+
+    const auto path = file_path("compressed.raw.zst");
+    const auto data = test_data();
+    {
+        BlockFileWriter writer {open_file(path), Compression::ZSTD, 4, 4096};
+        write_chunked(writer, data);
+
+        // Flush in between to write an incomplete block
+        writer.flush();
+        writer.write(std::span(data).first(10));
+        writer.close();
+
+        const auto statistics = writer.getStatistics();
+        REQUIRE(statistics->getCompressionRatio() > 1.0);
+        REQUIRE(statistics->getWorkers() == 4);
+        for(std::size_t worker = 0; worker < statistics->getWorkers(); ++worker) {
+            REQUIRE(statistics->getWorkerThroughput(worker) >= 0.0);
+        }
+    }
+
+    const auto compressed = read_file(path);
+    REQUIRE(compressed.size() < data.size());
+
+#if __has_include(<zstd.h>)
+    // Blocks are decompressed as a stream of frames in the original order
+    std::vector<std::byte> decompressed(data.size() + 10);
+    const auto size = ZSTD_decompress(decompressed.data(), decompressed.size(), compressed.data(), compressed.size());
+    REQUIRE(ZSTD_isError(size) == 0);
+    REQUIRE(size == decompressed.size());
+    REQUIRE(std::ranges::equal(std::span(decompressed).first(data.size()), data));
+    REQUIRE(std::ranges::equal(std::span(decompressed).last(10), std::span(data).first(10)));
+#endif
+}
+
+TEST_CASE("Invalid block file writer", "[data]") {
+    const auto path = file_path("invalid.raw");
+
+    BlockFileWriter writer {open_file(path)};
+    writer.close();
+    REQUIRE_THROWS_WITH(writer.write(std::as_bytes(std::span("abc"))), Equals("Cannot write to closed file"));
+
+    if(BlockFileWriter::isAvailable(Compression::ZSTD)) {
+        REQUIRE_THROWS_WITH(BlockFileWriter(open_file(path), Compression::ZSTD, 0),
+                            Equals("At least one compression worker is required"));
+    } else {
+        REQUIRE_THROWS_AS(BlockFileWriter(open_file(path), Compression::ZSTD), CompressionError);
+    }
+}
+
+TEST_CASE("Block file compression throughput", "[data][.benchmark]") {
+    if(!BlockFileWriter::isAvailable(Compression::ZSTD)) {
+        SKIP("Zstandard compression not available");
+    }
+
+    const auto path = file_path("throughput.raw.zst");
+    const auto data = test_data();
+
+    BENCHMARK("Compress 1 MB with 1 worker") {
+        BlockFileWriter writer {open_file(path), Compression::ZSTD, 1, 64 * 1024};
+        writer.write(data);
+        writer.close();
+        return writer.getStatistics()->getCompressionRatio();
+    };
+
+    BENCHMARK("Compress 1 MB with 4 workers") {
+        BlockFileWriter writer {open_file(path), Compression::ZSTD, 4, 64 * 1024};
+        writer.write(data);
+        writer.close();
+        return writer.getStatistics()->getCompressionRatio();
+    };
+}
+
+// NOLINTEND(cert-err58-cpp,misc-use-anonymous-namespace)
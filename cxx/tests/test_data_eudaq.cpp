@@ -0,0 +1,291 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/data/BlockFileWriter.hpp"
+#include "constellation/data/EudaqFileVerifier.hpp"
+#include "constellation/data/exceptions.hpp"
+
+#include "data_files.hpp"
+#include "EudaqNativeWriterSatellite.hpp"
+
+using namespace constellation::data;
+using namespace constellation::message;
+
+namespace {
+    std::filesystem::path file_path(std::string_view name) {
+        return test_file_path("test_data_eudaq", name);
+    }
+
+    // Sample file written by the file serializer of the EudaqNativeWriter satellite
+    class SampleFile {
+    public:
+        explicit SampleFile(std::filesystem::path path,
+                            Compression compression = Compression::NONE,
+                            std::size_t block_size = 1024 * 1024)
+            : path_(std::move(path)),
+              serializer_(std::make_unique<BlockFileWriter>(open_file(path_), compression, 1, block_size), 1) {}
+
+        void bor(const std::string& sender, const std::string& eudaq_event, bool frames_as_blocks = true) {
+            CDTP1Message::Header header {sender, 0, CDTP1Message::Type::BOR};
+            header.setTag("eudaq_event", eudaq_event);
+            header.setTag("frames_as_blocks", frames_as_blocks);
+            serializer_.serializeDelimiterMsg(header, {});
+        }
+
+        void eor(const std::string& sender, std::uint64_t seq) {
+            serializer_.serializeDelimiterMsg({sender, seq, CDTP1Message::Type::EOR}, {});
+        }
+
+        // Data message with the given number of frames, written as blocks or sub-events depending on the BOR
+        void data(const std::string& sender, std::uint64_t seq, std::size_t frames) {
+            CDTP1Message msg {{sender, seq, CDTP1Message::Type::DATA}, frames};
+            msg.getHeader().setTag("timestamp_begin", std::uint64_t(1000000));
+            msg.getHeader().setTag("timestamp_end", std::uint64_t(2000000));
+            for(std::size_t n = 0; n < frames; ++n) {
+                msg.addPayload(std::vector<char>({'p', 'a', 'y', 'l', 'o', 'a', 'd'}));
+            }
+            serializer_.serializeDataMsg(msg);
+        }
+
+        // Write all events to disk and return the file size, which is the position of the next event
+        std::uint64_t mark() {
+            serializer_.flush();
+            return std::filesystem::file_size(path_);
+        }
+
+    private:
+        std::filesystem::path path_;
+        EudaqNativeWriterSatellite::FileSerializer serializer_;
+    };
+
+    // Assemble a file from the events of another file in the given order, events are delimited by their positions
+    void assemble(const std::filesystem::path& source,
+                  const std::vector<std::uint64_t>& marks,
+                  const std::vector<std::size_t>& order,
+                  const std::filesystem::path& path) {
+        std::ifstream in {source, std::ios_base::binary};
+        const std::vector<char> content {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        auto out = open_file(path);
+        for(const auto event : order) {
+            out.write(std::next(content.data(), static_cast<std::ptrdiff_t>(marks.at(event))),
+                      static_cast<std::streamsize>(marks.at(event + 1) - marks.at(event)));
+        }
+    }
+
+    // Overwrite a 32-bit integer in a file
+    void patch(const std::filesystem::path& path, std::uint64_t offset, std::uint32_t value) {
+        std::fstream file {path, std::ios_base::binary | std::ios_base::in | std::ios_base::out};
+        file.seekp(static_cast<std::streamoff>(offset));
+        for(std::size_t i = 0; i < sizeof(value); ++i) {
+            file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    bool has_issue(const EudaqFileVerifier& verifier, const std::string& message) {
+        for(const auto& issue : verifier.getIssues()) {
+            if(issue.message.find(message) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
+
+TEST_CASE("Verify valid EUDAQ file", "[data]") {
+    const auto path = file_path("valid.raw");
+    {
+        SampleFile file {path};
+        file.bor("Sputnik.s1", "Sputnik");
+        file.bor("TLU.tlu", "TluRawDataEvent", false);
+        for(std::uint32_t n = 1; n <= 10; ++n) {
+            // Frames as blocks and as sub-events
+            file.data("Sputnik.s1", n, 2);
+            file.data("TLU.tlu", n, 3);
+        }
+        file.eor("Sputnik.s1", 11);
+        file.eor("TLU.tlu", 11);
+    }
+
+    EudaqFileVerifier verifier {path};
+    REQUIRE(verifier.verify());
+    REQUIRE(verifier.getIssues().empty());
+
+    // Index contains all top-level events in file order
+    const auto& index = verifier.getIndex();
+    REQUIRE(index.size() == 24);
+    REQUIRE(index.front().offset == 0);
+    REQUIRE(index.back().offset + index.back().size == verifier.getFileSize());
+    REQUIRE(index.at(2).descriptor == "Sputnik");
+    REQUIRE(index.at(2).event_number == 1);
+    REQUIRE(index.at(2).trigger_number == 1);
+    REQUIRE(index.at(2).blocks == 2);
+    REQUIRE(index.at(3).subevents == 3);
+    REQUIRE(index.at(3).timestamp_begin == 1000);
+    REQUIRE(index.at(3).timestamp_end == 2000);
+
+    const auto& streams = verifier.getStreams();
+    REQUIRE(streams.size() == 2);
+    const auto& sputnik = streams.at("Sputnik");
+    REQUIRE(sputnik.events == 10);
+    REQUIRE(sputnik.first_event == 1);
+    REQUIRE(sputnik.last_event == 10);
+    REQUIRE(sputnik.bore_event == 0);
+    REQUIRE(sputnik.eore_event == 11);
+    REQUIRE(sputnik.missing_events == 0);
+    REQUIRE(sputnik.block_bytes == 10 * 2 * 7);
+    REQUIRE(streams.at("TluRawDataEvent").subevents == 30);
+}
+
+TEST_CASE("Verify compressed EUDAQ file", "[data]") {
+    const auto path = file_path("compressed.raw.zst");
+
+    if(!BlockFileWriter::isAvailable(Compression::ZSTD)) {
+        open_file(path) << "not available";
+        REQUIRE_THROWS_AS(EudaqFileVerifier(path), RawFileError);
+        return;
+    }
+
+    // Same run uncompressed and compressed in several independent frames
+    const auto plain_path = file_path("compressed.raw");
+    for(const auto& [sample_path, compression] : {std::pair(plain_path, Compression::NONE),
+                                                  std::pair(path, Compression::ZSTD)}) {
+        SampleFile file {sample_path, compression, 1024};
+        file.bor("Sputnik.s1", "Sputnik");
+        for(std::uint32_t n = 1; n <= 100; ++n) {
+            file.data("Sputnik.s1", n, 2);
+        }
+        file.eor("Sputnik.s1", 101);
+    }
+    REQUIRE(std::filesystem::file_size(path) < std::filesystem::file_size(plain_path));
+
+    // Positions refer to the decompressed content
+    EudaqFileVerifier verifier {path};
+    REQUIRE(verifier.verify());
+    REQUIRE(verifier.getFileSize() == std::filesystem::file_size(plain_path));
+    REQUIRE(verifier.getIndex().size() == 102);
+    REQUIRE(verifier.getStreams().at("Sputnik").events == 100);
+
+    // Files ending within a frame are reported even if the checksum is the only missing part
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    EudaqFileVerifier truncated {path};
+    REQUIRE_FALSE(truncated.verify());
+    REQUIRE(has_issue(truncated, "Compressed file ends within a frame"));
+}
+
+TEST_CASE("Verify EUDAQ file with sequence issues", "[data]") {
+    // Serialize the events of a run, then assemble them out of order
+    const auto run_path = file_path("sequence_run.raw");
+    std::vector<std::uint64_t> marks {0};
+    {
+        SampleFile file {run_path};
+        file.bor("Sputnik.s1", "Sputnik");
+        marks.emplace_back(file.mark());
+        for(const std::uint64_t seq : {1, 2, 5, 5, 6}) {
+            file.data("Sputnik.s1", seq, 1);
+            marks.emplace_back(file.mark());
+        }
+        file.eor("Sputnik.s1", 7);
+        marks.emplace_back(file.mark());
+        file.bor("Mariner.m1", "Mariner");
+        marks.emplace_back(file.mark());
+    }
+
+    // Data 1, BORE, data 2, 5 and 5, EORE, data 6, BORE of another stream
+    const auto path = file_path("sequence.raw");
+    assemble(run_path, marks, {1, 0, 2, 3, 4, 6, 5, 7}, path);
+
+    EudaqFileVerifier verifier {path};
+    REQUIRE_FALSE(verifier.verify());
+    REQUIRE(has_issue(verifier, "Data event for Sputnik before BORE"));
+    REQUIRE(has_issue(verifier, "BORE for Sputnik after data events"));
+    REQUIRE(has_issue(verifier, "Missing events 3 to 4 for Sputnik"));
+    REQUIRE(has_issue(verifier, "Event number 5 for Sputnik does not increase after 5"));
+    REQUIRE(has_issue(verifier, "EORE event number 7 for Sputnik does not follow last data event 5"));
+    REQUIRE(has_issue(verifier, "Data event for Sputnik after EORE"));
+    REQUIRE(has_issue(verifier, "No EORE for Mariner"));
+    REQUIRE(verifier.getStreams().at("Sputnik").missing_events == 2);
+}
+
+TEST_CASE("Verify truncated EUDAQ file", "[data]") {
+    const auto path = file_path("truncated.raw");
+    {
+        SampleFile file {path};
+        file.bor("Sputnik.s1", "Sputnik");
+        file.data("Sputnik.s1", 1, 1);
+        file.data("Sputnik.s1", 2, 1);
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    EudaqFileVerifier verifier {path};
+    REQUIRE_FALSE(verifier.verify());
+    REQUIRE(verifier.getIndex().size() == 2);
+    REQUIRE(has_issue(verifier, "Failed to decode event: Unexpected end of file"));
+    REQUIRE(has_issue(verifier, "No EORE for Sputnik"));
+}
+
+TEST_CASE("Verify corrupt EUDAQ file", "[data]") {
+    const auto path = file_path("corrupt.raw");
+    std::uint64_t offset {};
+    {
+        SampleFile file {path};
+        file.bor("Sputnik.s1", "Sputnik");
+        offset = file.mark();
+        file.data("Sputnik.s1", 1, 1);
+    }
+
+    // Wrong type, version and extend word in the header, wrong key of the block written before the sub-event count
+    const auto block_key_offset = std::filesystem::file_size(path) - 4 - 7 - 4 - 4;
+    patch(path, offset, 0xDEADBEEF);
+    patch(path, offset + 4, 1);
+    patch(path, offset + 28, 0);
+    patch(path, block_key_offset, 3);
+
+    EudaqFileVerifier verifier {path};
+    REQUIRE_FALSE(verifier.verify());
+    REQUIRE(has_issue(verifier, "Event type is not RawEvent"));
+    REQUIRE(has_issue(verifier, "Unsupported event version 1"));
+    REQUIRE(has_issue(verifier, "Extend word does not match descriptor Sputnik"));
+    REQUIRE(has_issue(verifier, "Block 0 has key 3"));
+
+    REQUIRE_THROWS_AS(EudaqFileVerifier(file_path("missing.raw")), RawFileError);
+}
+
+TEST_CASE("EUDAQ file verification throughput", "[data][.benchmark]") {
+    const auto path = file_path("throughput.raw");
+    {
+        SampleFile file {path};
+        file.bor("Sputnik.s1", "Sputnik");
+        for(std::uint32_t n = 1; n <= 100000; ++n) {
+            file.data("Sputnik.s1", n, 4);
+        }
+        file.eor("Sputnik.s1", 100001);
+    }
+
+    BENCHMARK("Verify 100000 events") {
+        EudaqFileVerifier verifier {path};
+        return verifier.verify();
+    };
+}
+
+// NOLINTEND(cert-err58-cpp,misc-use-anonymous-namespace)
@@ -0,0 +1,235 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/FrameView.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/data/exceptions.hpp"
+#include "constellation/data/RawFileReader.hpp"
+#include "constellation/data/RawFileWriter.hpp"
+#include "constellation/data/raw_file_format.hpp"
+
+#include "data_files.hpp"
+
+using namespace Catch::Matchers;
+using namespace constellation::config;
+using namespace constellation::data;
+using namespace constellation::message;
+using namespace constellation::utils;
+
+namespace {
+    std::filesystem::path file_path(std::string_view name) {
+        return test_file_path("test_data_rawfile", name);
+    }
+
+    // Write run with BOR, data messages with the given sequence numbers and EOR for a sender
+    void write_run(RawFileWriter& writer, const std::string& sender, const std::vector<std::uint64_t>& sequences) {
+        Dictionary config {};
+        config["threshold"] = std::int64_t(42);
+        writer.write({sender, 0, CDTP1Message::Type::BOR}, config);
+
+        for(const auto seq : sequences) {
+            CDTP1Message msg {{sender, seq, CDTP1Message::Type::DATA}, 2};
+            msg.getHeader().setTag("trigger", static_cast<std::int64_t>(seq * 10));
+            msg.addPayload(std::vector<double>({static_cast<double>(seq), 0.5}));
+            // Odd frame size to check padding
+            msg.addPayload(std::vector<char>({'a', 'b', 'c'}));
+            writer.write(msg);
+        }
+
+        Dictionary run_metadata {};
+        run_metadata["messages"] = static_cast<std::int64_t>(sequences.size());
+        writer.write({sender, sequences.size() + 1, CDTP1Message::Type::EOR}, run_metadata);
+    }
+
+    void check_run(const RawFileReader& reader) {
+        REQUIRE(reader.getSenders() == std::vector<std::string>({"Sputnik.s1", "Sputnik.s2"}));
+        REQUIRE(reader.size("Sputnik.s1") == 3);
+        REQUIRE(reader.size("Sputnik.s2") == 2);
+
+        // BOR and EOR dictionaries
+        REQUIRE(reader.getBOR("Sputnik.s1").value().at("threshold").get<std::int64_t>() == 42);
+        REQUIRE(reader.getEOR("Sputnik.s2").value().at("messages").get<std::int64_t>() == 2);
+
+        // Data messages with tags and frames
+        const auto message = reader.read("Sputnik.s1", 1);
+        REQUIRE(message.header.getSender() == "Sputnik.s1");
+        REQUIRE(message.header.getSequenceNumber() == 2);
+        REQUIRE(message.header.getTag<std::int64_t>("trigger") == 20);
+        REQUIRE(message.frames.size() == 2);
+        REQUIRE(std::ranges::equal(frame_view<double>(message.frames.at(0)), std::vector<double>({2.0, 0.5})));
+        REQUIRE(std::string(to_char_ptr(message.frames.at(1).data()), message.frames.at(1).size()) == "abc");
+
+        // Seek by sequence number
+        REQUIRE(reader.findSequence("Sputnik.s1", 3) == 2);
+        REQUIRE_FALSE(reader.findSequence("Sputnik.s1", 4).has_value());
+        REQUIRE(reader.findSequence("Sputnik.s2", 7) == 1);
+        REQUIRE_FALSE(reader.findSequence("Sputnik.s2", 6).has_value());
+
+        // Seek by time
+        REQUIRE(reader.findTime("Sputnik.s1", {}) == 0);
+        REQUIRE(reader.read("Sputnik.s1", reader.findTime("Sputnik.s1", message.time)).time == message.time);
+        REQUIRE(reader.findTime("Sputnik.s1", std::chrono::system_clock::now() + std::chrono::hours(1)) == 3);
+
+        // Unknown sender and out of range
+        REQUIRE_THROWS_AS(reader.size("Sputnik.s3"), RawFileError);
+        REQUIRE_THROWS_AS(reader.read("Sputnik.s2", 2), RawFileError);
+    }
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
+
+TEST_CASE("Write and read raw file", "[data]") {
+    const auto path = file_path("write_read.cdtp");
+    {
+        RawFileWriter writer {open_file(path)};
+        write_run(writer, "Sputnik.s1", {1, 2, 3});
+        write_run(writer, "Sputnik.s2", {5, 7});
+    }
+
+    const RawFileReader reader {path};
+    REQUIRE(reader.hasIndex());
+    check_run(reader);
+}
+
+TEST_CASE("Rebuild index of raw file", "[data]") {
+    const auto path = file_path("rebuild.cdtp");
+    std::uint64_t size_without_index {};
+    {
+        RawFileWriter writer {open_file(path)};
+        write_run(writer, "Sputnik.s1", {1, 2, 3});
+        write_run(writer, "Sputnik.s2", {5, 7});
+        size_without_index = writer.bytesWritten();
+    }
+
+    // Remove index as if the writer was not closed properly
+    std::filesystem::resize_file(path, size_without_index);
+    {
+        const RawFileReader reader {path};
+        REQUIRE_FALSE(reader.hasIndex());
+        check_run(reader);
+    }
+
+    // Incompletely written last record is ignored
+    std::filesystem::resize_file(path, size_without_index - 10);
+    const RawFileReader reader {path};
+    REQUIRE_FALSE(reader.getEOR("Sputnik.s2").has_value());
+    REQUIRE(reader.size("Sputnik.s2") == 2);
+}
+
+TEST_CASE("Write index of raw file in chunks", "[data]") {
+    const auto path = file_path("chunks.cdtp");
+    std::uint64_t size_without_index {};
+    {
+        // Index entries are written every two data messages
+        RawFileWriter writer {open_file(path), 2};
+        write_run(writer, "Sputnik.s1", {1, 2, 3});
+        write_run(writer, "Sputnik.s2", {5, 7});
+        size_without_index = writer.bytesWritten();
+    }
+
+    {
+        const RawFileReader reader {path};
+        REQUIRE(reader.hasIndex());
+        check_run(reader);
+    }
+
+    // Index chunks are skipped when rebuilding the index
+    std::filesystem::resize_file(path, size_without_index);
+    const RawFileReader reader {path};
+    REQUIRE_FALSE(reader.hasIndex());
+    check_run(reader);
+}
+
+TEST_CASE("Read corrupted raw file record", "[data]") {
+    const auto path = file_path("corrupted.cdtp");
+    {
+        RawFileWriter writer {open_file(path)};
+        write_run(writer, "Sputnik.s1", {1, 2, 3});
+        write_run(writer, "Sputnik.s2", {5, 7});
+    }
+
+    // Number of frames of the first record, the BOR of the first sender, exceeds the record size
+    {
+        std::fstream file {path, std::ios_base::binary | std::ios_base::in | std::ios_base::out};
+        file.seekp(sizeof(raw_file::FileHeader) + offsetof(raw_file::RecordHeader, frames));
+        const std::uint32_t frames = 0xFFFFFFFF;
+        file.write(to_char_ptr(&frames), sizeof(frames));
+    }
+
+    const RawFileReader reader {path};
+    REQUIRE_THROWS_WITH(reader.getBOR("Sputnik.s1"), Equals("Invalid number of frames in record"));
+    REQUIRE(reader.read("Sputnik.s1", 0).frames.size() == 2);
+}
+
+TEST_CASE("Write to closed raw file", "[data]") {
+    const auto path = file_path("closed.cdtp");
+    RawFileWriter writer {open_file(path)};
+    writer.close();
+    REQUIRE_THROWS_WITH(writer.write(CDTP1Message({"Sputnik.s1", 1, CDTP1Message::Type::DATA})),
+                        Equals("Cannot write to closed file"));
+}
+
+TEST_CASE("Open invalid raw file", "[data]") {
+    const auto path = file_path("invalid.cdtp");
+    {
+        std::ofstream file {path};
+        file << "This is not a raw data file";
+    }
+    REQUIRE_THROWS_AS(RawFileReader(path), RawFileError);
+    REQUIRE_THROWS_AS(RawFileReader(file_path("missing.cdtp")), RawFileError);
+}
+
+TEST_CASE("Raw file throughput", "[data][.benchmark]") {
+    const auto path = file_path("throughput.cdtp");
+    constexpr std::size_t messages = 1000;
+    const std::vector<std::byte> frame(64 * 1024, std::byte(0x2A));
+
+    BENCHMARK("Write 1000 messages with 64 KiB") {
+        RawFileWriter writer {open_file(path)};
+        for(std::size_t n = 0; n < messages; ++n) {
+            CDTP1Message msg {{"Sputnik.s1", n + 1, CDTP1Message::Type::DATA}, 1};
+            msg.addPayload(std::vector<std::byte>(frame));
+            writer.write(msg);
+        }
+        writer.close();
+        return writer.bytesWritten();
+    };
+
+    BENCHMARK("Read 1000 messages with 64 KiB") {
+        const RawFileReader reader {path};
+        std::size_t bytes {0};
+        for(std::size_t n = 0; n < reader.size("Sputnik.s1"); ++n) {
+            const auto message = reader.read("Sputnik.s1", n);
+            bytes += static_cast<std::size_t>(std::ranges::count(message.frames.front(), std::byte(0x2A)));
+        }
+        return bytes;
+    };
+
+    BENCHMARK("Seek to sequence number") {
+        const RawFileReader reader {path};
+        return reader.read("Sputnik.s1", reader.findSequence("Sputnik.s1", messages / 2).value()).frames.size();
+    };
+}
+
+// NOLINTEND(cert-err58-cpp,misc-use-anonymous-namespace)
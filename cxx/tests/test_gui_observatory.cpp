@@ -0,0 +1,201 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <QAbstractItemModel>
+#include <QCoreApplication>
+#include <QModelIndex>
+#include <QObject>
+#include <QDateTime>
+#include <QString>
+#include <QVariant>
+
+#include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/core/utils/ManagerLocator.hpp"
+#include "constellation/gui/QLogMessage.hpp"
+
+#include "chirp_mock.hpp"
+#include "cmdp_mock.hpp"
+#include "QLogFilter.hpp"
+#include "QLogListener.hpp"
+
+using namespace constellation::gui;
+using namespace constellation::log;
+using namespace constellation::message;
+using namespace constellation::utils;
+using namespace std::chrono_literals;
+
+namespace {
+    // Arguments for the Qt application
+    int argc = 1;
+    std::array<char*, 1> argv {const_cast<char*>("test_gui_observatory")}; // NOLINT(cppcoreguidelines-pro-type-const-cast)
+
+    // Process Qt events until the condition is fulfilled or the timeout is reached
+    bool process_events_until(const std::function<bool()>& condition) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while(!condition()) {
+            if(std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            QCoreApplication::processEvents();
+            std::this_thread::sleep_for(10ms);
+        }
+        return true;
+    }
+
+    // Wait until the listener subscribed to the sender
+    void await_subscriptions(CMDPSender& sender) {
+        sender.recv();
+        while(sender.canRecv()) {
+        }
+    }
+} // namespace
+
+TEST_CASE("Pre-rendered log message columns", "[gui]") {
+    auto header = CMDP1Message::Header("Dummy.sat1");
+    header.setTag("run", 3);
+    const auto msg = QLogMessage(CMDP1LogMessage(Level::WARNING, "FSM", std::move(header), "first line\nsecond line"));
+
+    REQUIRE(msg[0].value<QDateTime>().isValid());
+    REQUIRE(msg.getText(1) == "Dummy.sat1");
+    REQUIRE(msg.getText(2) == "WARNING");
+    REQUIRE(msg.getText(3) == "FSM");
+    REQUIRE(msg.getText(4) == "first line [...]");
+    REQUIRE(msg.getText(5).contains("run"));
+    REQUIRE(msg.getText(6) == "first line\nsecond line");
+    REQUIRE(msg[4].toString() == msg.getText(4));
+
+    // Cached strings are returned on repeated access
+    REQUIRE(&msg.getText(2) == &msg.getText(2));
+    REQUIRE(&msg.getText(5) == &msg.getText(5));
+
+    // Time and invalid columns have no text representation
+    REQUIRE(msg.getText(0).isEmpty());
+    REQUIRE(msg.getText(7).isEmpty());
+
+    // Single-line messages are not trimmed
+    const auto single = QLogMessage(CMDP1LogMessage(Level::INFO, "", {"Dummy.sat1"}, "single line"));
+    REQUIRE(single.getText(4) == "single line");
+    REQUIRE(single.getText(6) == "single line");
+}
+
+TEST_CASE("Bounded log model", "[gui]") {
+    // Create CHIRP manager for monitoring service discovery
+    create_chirp_manager();
+
+    const QCoreApplication app {argc, argv.data()};
+    QLogListener listener {};
+    listener.setMaxMessages(3);
+
+    // Count row insertions and removals
+    std::size_t insert_batches {0};
+    std::size_t rows_removed {0};
+    QObject::connect(&listener, &QAbstractItemModel::rowsInserted, [&](const QModelIndex&, int, int) {
+        ++insert_batches;
+    });
+    QObject::connect(&listener, &QAbstractItemModel::rowsRemoved, [&](const QModelIndex&, int first, int last) {
+        rows_removed += static_cast<std::size_t>(last - first + 1);
+    });
+
+    listener.setGlobalLogLevel(Level::TRACE);
+    listener.startPool();
+
+    auto sender = CMDPSender("CMDPSender.s1");
+    sender.mockChirpService();
+    await_subscriptions(sender);
+
+    // Messages received between two GUI frames are inserted at once
+    sender.sendLogMessage(Level::INFO, "TEST", "message 0");
+    sender.sendLogMessage(Level::INFO, "TEST", "message 1");
+    std::this_thread::sleep_for(200ms);
+    REQUIRE(process_events_until([&]() { return listener.getNextSequence() == 2; }));
+    REQUIRE(listener.rowCount({}) == 2);
+    REQUIRE(insert_batches == 1);
+    REQUIRE(rows_removed == 0);
+
+    // Oldest messages are evicted as row removal when the retention is reached
+    sender.sendLogMessage(Level::INFO, "TEST", "message 2");
+    sender.sendLogMessage(Level::INFO, "TEST", "message 3");
+    sender.sendLogMessage(Level::INFO, "TEST", "message 4");
+    std::this_thread::sleep_for(200ms);
+    REQUIRE(process_events_until([&]() { return listener.getNextSequence() == 5; }));
+    REQUIRE(listener.rowCount({}) == 3);
+    REQUIRE(insert_batches == 2);
+    REQUIRE(rows_removed == 2);
+    REQUIRE(listener.getFirstSequence() == 2);
+    REQUIRE(listener.getMessage(listener.index(0)).getLogMessage() == "message 2");
+    REQUIRE(listener.getMessage(listener.index(2)).getLogMessage() == "message 4");
+
+    // Reducing the retention evicts the oldest messages immediately
+    listener.setMaxMessages(1);
+    REQUIRE(listener.rowCount({}) == 1);
+    REQUIRE(rows_removed == 4);
+    REQUIRE(listener.getMessage(listener.index(0)).getLogMessage() == "message 4");
+
+    listener.stopPool();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Log filter", "[gui]") {
+    // Create CHIRP manager for monitoring service discovery
+    create_chirp_manager();
+
+    const QCoreApplication app {argc, argv.data()};
+    QLogListener listener {};
+    QLogFilter filter {};
+    filter.setSourceModel(&listener);
+
+    listener.setGlobalLogLevel(Level::TRACE);
+    listener.startPool();
+
+    auto sender = CMDPSender("CMDPSender.s1");
+    sender.mockChirpService();
+    await_subscriptions(sender);
+
+    sender.sendLogMessage(Level::DEBUG, "TEST", "debug message");
+    sender.sendLogMessage(Level::INFO, "TEST", "info message");
+    sender.sendLogMessage(Level::WARNING, "TEST", "warning message");
+    sender.sendLogMessage(Level::CRITICAL, "TEST", "critical message\nwith details");
+    REQUIRE(process_events_until([&]() { return listener.getNextSequence() == 4; }));
+
+    // Level indices are maintained on insertion
+    REQUIRE(listener.getLevelIndex(Level::INFO).size() == 1);
+    REQUIRE(listener.getSenderIndex("CMDPSender.s1").size() == 4);
+    REQUIRE(listener.getTopicIndex("TEST").size() == 4);
+    REQUIRE(listener.getTopicIndex("OTHER").empty());
+
+    // Default filter level is WARNING
+    REQUIRE(filter.rowCount() == 2);
+    filter.setFilterLevel(Level::TRACE);
+    REQUIRE(filter.rowCount() == 4);
+    filter.setFilterLevel(Level::INFO);
+    REQUIRE(filter.rowCount() == 3);
+
+    // Text search runs in the background, including the lines hidden in the message column
+    filter.setFilterMessage("details|info");
+    REQUIRE(process_events_until([&]() { return filter.rowCount() == 2; }));
+    filter.setFilterMessage("WARNING");
+    REQUIRE(process_events_until([&]() { return filter.rowCount() == 1; }));
+
+    // Messages arriving after the search started are checked directly
+    sender.sendLogMessage(Level::INFO, "TEST", "another warning");
+    REQUIRE(process_events_until([&]() { return filter.rowCount() == 2; }));
+
+    filter.setFilterMessage(QString());
+    REQUIRE(filter.rowCount() == 4);
+
+    listener.stopPool();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
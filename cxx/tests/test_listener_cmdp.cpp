@@ -4,22 +4,34 @@
  * SPDX-License-Identifier: EUPL-1.2
  */
 
+#include <algorithm>
 #include <chrono> // IWYU pragma: keep
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
 #include <map>
+#include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <zmq_addon.hpp>
 
 #include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
 #include "constellation/core/metrics/Metric.hpp"
 #include "constellation/core/protocol/CHIRP_definitions.hpp"
 #include "constellation/core/utils/ManagerLocator.hpp"
 #include "constellation/core/utils/string.hpp"
 #include "constellation/listener/CMDPListener.hpp"
+#include "constellation/listener/CMDPRecorder.hpp"
 
 #include "chirp_mock.hpp"
 #include "cmdp_mock.hpp"
@@ -302,3 +314,114 @@ TEST_CASE("Available senders", "[listener]") {
     pool.stopPool();
     ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
 }
+
+TEST_CASE("Record and replay CMDP messages", "[listener]") {
+    const auto directory = std::filesystem::temp_directory_path() / "test_listener_cmdp_record";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    {
+        // Small files and batches to force rotation
+        CMDPRecordWriter writer {directory / "rec", 128, 1};
+        for(int n = 0; n < 3; ++n) {
+            writer.write(CMDP1LogMessage(Level::INFO, "TOPIC", {"Dummy.sat1"}, "message " + to_string(n)).assemble());
+        }
+        writer.write(
+            CMDP1StatMessage({"Dummy.sat1"},
+                             {std::make_shared<Metric>("TEMPERATURE", "C", MetricType::LAST_VALUE), 21.5})
+                .assemble());
+        REQUIRE(writer.countMessages() == 4);
+    }
+
+    // Raw frames are stored and read back unchanged
+    std::vector<std::filesystem::path> files {};
+    for(const auto& entry : std::filesystem::directory_iterator(directory)) {
+        files.push_back(entry.path());
+    }
+    std::ranges::sort(files);
+    REQUIRE(files.size() > 1);
+    REQUIRE(files.front().filename() == "rec_0000.cmdp");
+
+    std::size_t count {0};
+    for(const auto& file : files) {
+        CMDPRecordReader reader {file};
+        while(auto frames = reader.read()) {
+            REQUIRE(frames->size() == 3);
+            const auto msg = CMDP1Message::disassemble(frames.value());
+            REQUIRE(msg.getHeader().getSender() == "Dummy.sat1");
+            ++count;
+        }
+    }
+    REQUIRE(count == 4);
+
+    // Export as text and CSV
+    std::ostringstream text {};
+    std::ostringstream csv {};
+    for(const auto& file : files) {
+        CMDPRecordReader text_reader {file};
+        text_reader.exportMessages(text, false);
+        CMDPRecordReader csv_reader {file};
+        csv_reader.exportMessages(csv, true);
+    }
+    REQUIRE_THAT(text.str(), ContainsSubstring("Dummy.sat1 INFO [TOPIC] message 2"));
+    REQUIRE_THAT(text.str(), ContainsSubstring("Dummy.sat1 STAT TEMPERATURE = 21.5 C"));
+    REQUIRE_THAT(csv.str(), ContainsSubstring(",Dummy.sat1,LOG,\"TOPIC\",INFO,\"message 0\","));
+    REQUIRE_THAT(csv.str(), ContainsSubstring(",Dummy.sat1,STAT,\"TEMPERATURE\",,\"21.5\",\"C\""));
+
+    // Truncated records are rejected without reading beyond the file
+    const auto truncated = directory / "truncated.cmdp";
+    std::filesystem::copy_file(files.front(), truncated);
+    std::filesystem::resize_file(truncated, std::filesystem::file_size(truncated) - 1);
+    CMDPRecordReader truncated_reader {truncated};
+    REQUIRE_THROWS_AS(
+        [&]() {
+            while(truncated_reader.read()) {
+            }
+        }(),
+        CMDPRecordingError);
+
+    // Other files are rejected
+    const auto invalid = directory / "invalid.cmdp";
+    std::ofstream {invalid} << "not a recording";
+    REQUIRE_THROWS_MATCHES(CMDPRecordReader(invalid),
+                           CMDPRecordingError,
+                           Message(invalid.string() + " is not a CMDP recording"));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Record CMDP messages from sender", "[listener]") {
+    // Create CHIRP manager for monitoring service discovery
+    create_chirp_manager();
+
+    const auto directory = std::filesystem::temp_directory_path() / "test_listener_cmdp_recorder";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    {
+        CMDPRecordWriter writer {directory / "rec", 1024 * 1024, 1024};
+        CMDPRecorder recorder {writer, {"LOG/WARNING"}};
+        recorder.startPool();
+
+        auto sender = CMDPSender("CMDPSender.s1");
+        sender.mockChirpService();
+        REQUIRE(check_sub_message(sender.recv().pop(), true, "LOG/WARNING"));
+
+        // Only subscribed topics are recorded
+        sender.sendLogMessage(Level::INFO, "", "not recorded");
+        sender.sendLogMessage(Level::WARNING, "", "recorded");
+        while(writer.countMessages() < 1) {
+            std::this_thread::sleep_for(10ms);
+        }
+
+        recorder.stopPool();
+        ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+    }
+
+    CMDPRecordReader reader {directory / "rec_0000.cmdp"};
+    std::ostringstream text {};
+    REQUIRE(reader.exportMessages(text, false) == 1);
+    REQUIRE_THAT(text.str(), ContainsSubstring("CMDPSender.s1 WARNING [] recorded"));
+
+    std::filesystem::remove_all(directory);
+}
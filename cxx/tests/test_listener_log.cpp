@@ -4,8 +4,13 @@
  * SPDX-License-Identifier: EUPL-1.2
  */
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <map>
+#include <memory>
 #include <string>
+#include <thread>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
@@ -14,7 +19,9 @@
 #include "constellation/core/log/Level.hpp"
 #include "constellation/core/utils/ManagerLocator.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
 #include "constellation/listener/LogListener.hpp"
+#include "constellation/listener/LogStore.hpp"
 
 #include "chirp_mock.hpp"
 #include "cmdp_mock.hpp"
@@ -22,8 +29,10 @@
 using namespace Catch::Matchers;
 using namespace constellation::listener;
 using namespace constellation::log;
+using namespace constellation::message;
 using namespace constellation::protocol;
 using namespace constellation::utils;
+using namespace std::chrono_literals;
 
 TEST_CASE("Global log level", "[listener]") {
     // Create CHIRP manager for monitoring service discovery
@@ -229,3 +238,52 @@ TEST_CASE("Empty extra topic subscription", "[listener]") {
     listener.stopPool();
     ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
 }
+
+TEST_CASE("Store received log messages", "[listener]") {
+    // Create CHIRP manager for monitoring service discovery
+    create_chirp_manager();
+
+    const auto directory = std::filesystem::temp_directory_path() / "test_listener_log_store";
+    std::filesystem::remove_all(directory);
+    auto log_store = std::make_shared<LogStore>(directory);
+
+    // Start pool with log store
+    std::atomic_size_t received {0};
+    auto listener = LogListener("listener", [&](CMDP1LogMessage&&) { ++received; });
+    listener.setLogStore(log_store);
+    listener.startPool();
+    listener.setGlobalLogLevel(Level::WARNING);
+
+    // Start the sender and mock via chirp
+    auto sender = CMDPSender("CMDPSender.s1");
+    sender.mockChirpService();
+
+    // Pop subscription messages
+    REQUIRE(check_sub_message(sender.recv().pop(), true, "LOG/CRITICAL"));
+    REQUIRE(check_sub_message(sender.recv().pop(), true, "LOG/STATUS"));
+    REQUIRE(check_sub_message(sender.recv().pop(), true, "LOG/WARNING"));
+    REQUIRE(check_sub_message(sender.recv().pop(), true, "LOG?"));
+
+    // Messages are stored before being passed to the callback
+    sender.sendLogMessage(Level::WARNING, "FSM", "stored message");
+    while(received.load() < 1) {
+        std::this_thread::sleep_for(10ms);
+    }
+    const auto records = log_store->query({});
+    REQUIRE(records.size() == 1);
+    REQUIRE(records.front().sender == "CMDPSender.s1");
+    REQUIRE(records.front().topic == "FSM");
+    REQUIRE(records.front().message == "stored message");
+
+    // Detached store does not receive further messages
+    listener.setLogStore(nullptr);
+    sender.sendLogMessage(Level::WARNING, "FSM", "not stored");
+    while(received.load() < 2) {
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE(log_store->size() == 1);
+
+    listener.stopPool();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,234 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "constellation/core/log/Level.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/listener/LogStore.hpp"
+
+using namespace constellation::listener;
+using namespace constellation::log;
+using namespace constellation::message;
+using namespace std::chrono_literals;
+
+namespace {
+    std::filesystem::path store_directory() {
+        const auto directory = std::filesystem::temp_directory_path() / "test_listener_logstore";
+        std::filesystem::remove_all(directory);
+        return directory;
+    }
+
+    // Fill store with 100 messages from two senders in one second steps starting at time zero
+    void fill_store(LogStore& store) {
+        for(int n = 0; n < 100; ++n) {
+            const auto time = std::chrono::system_clock::time_point(std::chrono::seconds(n));
+            const auto sender = (n % 2 == 0) ? "Sputnik.s1" : "Sputnik.s2";
+            const auto level = (n % 10 == 0) ? Level::WARNING : Level::INFO;
+            const auto topic = (n % 4 == 0) ? "FSM" : "USER";
+            store.append(CMDP1LogMessage(level, topic, {sender, time}, "Message " + std::to_string(n)));
+        }
+    }
+} // namespace
+
+TEST_CASE("Query by sender, level and topic", "[listener]") {
+    const auto directory = store_directory();
+    LogStore store {directory, 30s};
+    fill_store(store);
+    REQUIRE(store.size() == 100);
+
+    // All messages ordered by time
+    const auto all = store.query({});
+    REQUIRE(all.size() == 100);
+    REQUIRE(all.front().message == "Message 0");
+    REQUIRE(all.back().message == "Message 99");
+
+    // Level
+    LogStore::Query query {};
+    query.level = Level::WARNING;
+    const auto warnings = store.query(query);
+    REQUIRE(warnings.size() == 10);
+    REQUIRE(warnings.at(1).message == "Message 10");
+    REQUIRE(warnings.at(1).level == Level::WARNING);
+
+    // Sender and level
+    query.sender = "Sputnik.s2";
+    REQUIRE(store.query(query).empty());
+    query.sender = "Sputnik.s1";
+    REQUIRE(store.query(query).size() == 10);
+
+    // Topic
+    query = {};
+    query.topic = "FSM";
+    REQUIRE(store.query(query).size() == 25);
+    query.topic = "UNKNOWN";
+    REQUIRE(store.query(query).empty());
+
+    // Limit
+    query = {};
+    query.limit = 5;
+    const auto limited = store.query(query);
+    REQUIRE(limited.size() == 5);
+    REQUIRE(limited.back().message == "Message 4");
+
+    // Limit reached in a later segment
+    query.limit = 35;
+    REQUIRE(store.query(query).back().message == "Message 34");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Query by time range", "[listener]") {
+    const auto directory = store_directory();
+    LogStore store {directory, 30s};
+    fill_store(store);
+
+    // Time range spanning two segments
+    LogStore::Query query {};
+    query.begin = std::chrono::system_clock::time_point(25s);
+    query.end = std::chrono::system_clock::time_point(35s);
+    const auto records = store.query(query);
+    REQUIRE(records.size() == 10);
+    REQUIRE(records.front().message == "Message 25");
+    REQUIRE(records.front().sender == "Sputnik.s2");
+    REQUIRE(records.front().topic == "USER");
+    REQUIRE(records.front().time == std::chrono::system_clock::time_point(25s));
+
+    // Time range and sender
+    query.sender = "Sputnik.s1";
+    REQUIRE(store.query(query).size() == 5);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Reopen store", "[listener]") {
+    const auto directory = store_directory();
+    {
+        LogStore store {directory, 30s};
+        fill_store(store);
+    }
+
+    // Segment duration is read from the existing store
+    LogStore store {directory, 1h};
+    REQUIRE(store.size() == 100);
+
+    LogStore::Query query {};
+    query.sender = "Sputnik.s1";
+    query.level = Level::WARNING;
+    query.begin = std::chrono::system_clock::time_point(30s);
+    const auto records = store.query(query);
+    REQUIRE(records.size() == 7);
+    REQUIRE(records.front().message == "Message 30");
+
+    // Appending after reopening continues the existing segments
+    store.append(CMDP1LogMessage(Level::CRITICAL, "", {"Sputnik.s3", std::chrono::system_clock::time_point(31s)}, "Late"));
+    query = {};
+    query.level = Level::CRITICAL;
+    const auto critical = store.query(query);
+    REQUIRE(critical.size() == 1);
+    REQUIRE(critical.front().sender == "Sputnik.s3");
+    REQUIRE(store.size() == 101);
+
+    // Posting lists written by flush are mapped and extended by new entries
+    store.flush();
+    REQUIRE(store.query(query).size() == 1);
+    store.append(CMDP1LogMessage(Level::CRITICAL, "", {"Sputnik.s3", std::chrono::system_clock::time_point(32s)}, "Later"));
+    const auto critical_later = store.query(query);
+    REQUIRE(critical_later.size() == 2);
+    REQUIRE(critical_later.back().message == "Later");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Recover incompletely written entries", "[listener]") {
+    const auto directory = store_directory();
+    {
+        LogStore store {directory, 30s};
+        fill_store(store);
+    }
+
+    // Simulate a crash while writing the last entry of the second segment and the message of another entry
+    const auto index_path = directory / "30.idx";
+    std::filesystem::resize_file(index_path, std::filesystem::file_size(index_path) - 5);
+    std::ofstream(directory / "30.log", std::ios_base::binary | std::ios_base::app) << "partial";
+
+    // Simulate a crash while writing a new string, i.e. a length prefix of 32 followed by only some characters
+    const auto strings_path = directory / "strings.dat";
+    const auto strings_size = std::filesystem::file_size(strings_path);
+    std::ofstream(strings_path, std::ios_base::binary | std::ios_base::app).write("\x20\0\0\0Sput", 8);
+
+    LogStore store {directory, 30s};
+    REQUIRE(store.size() == 99);
+    REQUIRE(std::filesystem::file_size(strings_path) == strings_size);
+
+    LogStore::Query query {};
+    query.begin = std::chrono::system_clock::time_point(59s);
+    query.end = std::chrono::system_clock::time_point(60s);
+    REQUIRE(store.query(query).empty());
+
+    // Appended entries are aligned to the existing ones
+    store.append(CMDP1LogMessage(Level::INFO, "", {"Sputnik.s1", std::chrono::system_clock::time_point(40s)}, "Recovered"));
+    query.begin = std::chrono::system_clock::time_point(40s);
+    query.end = std::chrono::system_clock::time_point(41s);
+    const auto records = store.query(query);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records.front().message == "Message 40");
+    REQUIRE(records.back().message == "Recovered");
+
+    // Strings interned after recovering keep their identifiers when opening the store again
+    store.append(CMDP1LogMessage(Level::INFO, "NEW", {"Sputnik.s4", std::chrono::system_clock::time_point(41s)}, "New"));
+    store.append(CMDP1LogMessage(Level::INFO, "FSM", {"Sputnik.s5", std::chrono::system_clock::time_point(42s)}, "Next"));
+    store.flush();
+    LogStore reopened_store {directory, 30s};
+    query = {};
+    query.sender = "Sputnik.s5";
+    const auto reopened_records = reopened_store.query(query);
+    REQUIRE(reopened_records.size() == 1);
+    REQUIRE(reopened_records.front().message == "Next");
+    REQUIRE(reopened_records.front().topic == "FSM");
+    query.sender = "Sputnik.s4";
+    REQUIRE(reopened_store.query(query).front().topic == "NEW");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Write posting lists of previous segments", "[listener]") {
+    const auto directory = store_directory();
+    LogStore store {directory, 30s};
+    fill_store(store);
+
+    // Posting lists are written once the next segment is started, not only when flushing
+    REQUIRE(std::filesystem::exists(directory / "0.pst"));
+    REQUIRE(std::filesystem::exists(directory / "60.pst"));
+    REQUIRE_FALSE(std::filesystem::exists(directory / "90.pst"));
+
+    // Late messages are appended as new chunk to the posting lists of a previous segment
+    const auto postings_size = std::filesystem::file_size(directory / "0.pst");
+    store.append(CMDP1LogMessage(Level::CRITICAL, "", {"Sputnik.s3", std::chrono::system_clock::time_point(5s)}, "Late"));
+    store.flush();
+    REQUIRE(std::filesystem::file_size(directory / "0.pst") > postings_size);
+
+    LogStore::Query query {};
+    query.sender = "Sputnik.s3";
+    REQUIRE(store.query(query).size() == 1);
+    query.sender = "Sputnik.s1";
+    query.end = std::chrono::system_clock::time_point(30s);
+    REQUIRE(store.query(query).size() == 15);
+
+    // Chunks are mapped again when opening the store
+    LogStore reopened_store {directory, 30s};
+    REQUIRE(reopened_store.query(query).size() == 15);
+    query.sender = "Sputnik.s3";
+    REQUIRE(reopened_store.query(query).front().message == "Late");
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,133 @@
+/**
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "constellation/core/config/Value.hpp"
+#include "constellation/core/metrics/Metric.hpp"
+#include "constellation/listener/MetricsHistory.hpp"
+
+using namespace Catch;
+using namespace constellation::config;
+using namespace constellation::listener;
+using namespace constellation::metrics;
+using namespace std::chrono_literals;
+
+using Resolution = MetricsHistory::Resolution;
+
+namespace {
+    std::chrono::system_clock::time_point at(std::chrono::system_clock::duration since_epoch) {
+        return std::chrono::system_clock::time_point(since_epoch);
+    }
+} // namespace
+
+TEST_CASE("Raw samples and aggregates", "[listener]") {
+    auto history = MetricsHistory();
+
+    // Ten samples per second over five seconds
+    for(int n = 0; n < 50; ++n) {
+        history.append("Sputnik.s1", "RATE", at(n * 100ms), n);
+    }
+
+    const auto raw = history.query("Sputnik.s1", "RATE", at(0s), at(1h), Resolution::RAW);
+    REQUIRE(raw.size() == 50);
+    REQUIRE(raw.front().mean == 0.);
+    REQUIRE(raw.back().time == at(4900ms));
+
+    const auto seconds = history.query("Sputnik.s1", "RATE", at(0s), at(1h), Resolution::SECOND);
+    REQUIRE(seconds.size() == 5);
+    REQUIRE(seconds[1].time == at(1s));
+    REQUIRE(seconds[1].count == 10);
+    REQUIRE(seconds[1].min == 10.);
+    REQUIRE(seconds[1].max == 19.);
+    REQUIRE(seconds[1].mean == Approx(14.5));
+
+    const auto minutes = history.query("Sputnik.s1", "RATE", at(0s), at(1h), Resolution::MINUTE);
+    REQUIRE(minutes.size() == 1);
+    REQUIRE(minutes[0].count == 50);
+    REQUIRE(minutes[0].max == 49.);
+
+    // Time range selects overlapping aggregates
+    REQUIRE(history.query("Sputnik.s1", "RATE", at(1500ms), at(3s), Resolution::SECOND).size() == 2);
+    REQUIRE(history.query("Sputnik.s1", "RATE", at(1500ms), at(3s), Resolution::RAW).size() == 15);
+
+    // No data was discarded yet, so raw samples are used automatically
+    REQUIRE(history.query("Sputnik.s1", "RATE", at(0s), at(1h)).size() == 50);
+
+    // Unknown metrics
+    REQUIRE(history.query("Sputnik.s1", "OTHER", at(0s), at(1h)).empty());
+    REQUIRE(history.query("Sputnik.s2", "RATE", at(0s), at(1h)).empty());
+    REQUIRE_FALSE(history.getLatest("Sputnik.s2", "RATE").has_value());
+    REQUIRE(history.getLatest("Sputnik.s1", "RATE")->mean == 49.);
+}
+
+TEST_CASE("Retention of tiers", "[listener]") {
+    auto history = MetricsHistory({.raw_duration = 10s, .raw_samples = 100, .seconds = 60, .minutes = 5});
+
+    // One sample per second over ten minutes
+    for(int n = 0; n < 600; ++n) {
+        history.append("Sputnik.s1", "TEMP", at(std::chrono::seconds(n)), n % 60);
+    }
+
+    // Raw samples only cover the last ten seconds
+    const auto raw = history.query("Sputnik.s1", "TEMP", at(0s), at(1h), Resolution::RAW);
+    REQUIRE(raw.size() == 11);
+    REQUIRE(raw.front().time == at(589s));
+
+    // Second aggregates only cover the last minute
+    const auto seconds = history.query("Sputnik.s1", "TEMP", at(0s), at(1h), Resolution::SECOND);
+    REQUIRE(seconds.size() == 60);
+    REQUIRE(seconds.front().time == at(540s));
+
+    // Minute aggregates only cover the last five minutes
+    const auto minutes = history.query("Sputnik.s1", "TEMP", at(0s), at(1h), Resolution::MINUTE);
+    REQUIRE(minutes.size() == 5);
+    REQUIRE(minutes.front().time == at(5min));
+    REQUIRE(minutes.front().count == 60);
+    REQUIRE(minutes.front().min == 0.);
+    REQUIRE(minutes.front().max == 59.);
+    REQUIRE(minutes.front().mean == Approx(29.5));
+
+    // Finest tier covering the start of the range is selected automatically
+    REQUIRE(history.query("Sputnik.s1", "TEMP", at(595s), at(1h)).size() == 5);
+    REQUIRE(history.query("Sputnik.s1", "TEMP", at(570s), at(1h)).size() == 30);
+    REQUIRE(history.query("Sputnik.s1", "TEMP", at(0s), at(1h)).size() == 5);
+
+    // Out-of-order samples are merged into the most recent aggregate
+    history.append("Sputnik.s1", "TEMP", at(10s), 100.);
+    REQUIRE(history.query("Sputnik.s1", "TEMP", at(0s), at(1h), Resolution::MINUTE).back().max == 100.);
+    REQUIRE(history.query("Sputnik.s1", "TEMP", at(0s), at(1h), Resolution::RAW).size() == 11);
+}
+
+TEST_CASE("Metric values", "[listener]") {
+    auto history = MetricsHistory();
+    auto metric = std::make_shared<Metric>("TEMPERATURE", "degC", MetricType::LAST_VALUE);
+
+    REQUIRE(history.append("Sputnik.s1", at(0s), {metric, Value::set(std::int64_t(20))}));
+    REQUIRE(history.append("Sputnik.s1", at(1s), {metric, Value::set(21.5)}));
+    REQUIRE(history.append("Sputnik.s2", at(0s), {metric, Value::set(true)}));
+    REQUIRE_FALSE(history.append("Sputnik.s2", at(1s), {metric, Value::set(std::string("hot"))}));
+
+    REQUIRE(history.getUnit("Sputnik.s1", "TEMPERATURE") == "degC");
+    REQUIRE(history.getLatest("Sputnik.s1", "TEMPERATURE")->mean == 21.5);
+    REQUIRE(history.getLatest("Sputnik.s2", "TEMPERATURE")->mean == 1.);
+
+    const auto metrics = history.getMetrics();
+    REQUIRE(metrics.size() == 2);
+    REQUIRE(metrics.at("Sputnik.s1") == std::set<std::string>({"TEMPERATURE"}));
+
+    history.removeSender("Sputnik.s1");
+    REQUIRE(history.getMetrics().size() == 1);
+    history.clear();
+    REQUIRE(history.getMetrics().empty());
+}
@@ -4,10 +4,16 @@
  * SPDX-License-Identifier: EUPL-1.2
  */
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -23,6 +29,7 @@
 #include "constellation/build.hpp"
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
+#include "constellation/core/config/Value.hpp"
 #include "constellation/core/message/CHIRPMessage.hpp"
 #include "constellation/core/message/CSCP1Message.hpp"
 #include "constellation/core/networking/Port.hpp"
@@ -34,6 +41,8 @@
 #include "constellation/core/utils/msgpack.hpp"
 #include "constellation/core/utils/std_future.hpp"
 #include "constellation/core/utils/string.hpp"
+#include "constellation/satellite/CommandRegistry.hpp"
+#include "constellation/satellite/FSM.hpp"
 #include "constellation/satellite/Satellite.hpp"
 
 #include "chirp_mock.hpp"
@@ -73,6 +82,44 @@ private:
     zmq::socket_t req_socket_;
 };
 
+class RoleSatellite : public DummySatellite<> {
+public:
+    RoleSatellite() : DummySatellite<>("roles") {
+        // Builder needs to be executed after router although registered first
+        addRole("builder", {"router"});
+        addRole("router", {});
+    }
+
+    void addRole(const std::string& name, std::vector<std::string> after) {
+        RoleHooks hooks {};
+        hooks.name = name;
+        hooks.after = std::move(after);
+        hooks.initializing = [this, name](Configuration& /*config*/) { record(name + ":initializing"); };
+        hooks.prepare_starting = [this, name](std::string_view run_identifier, const Configuration& /*config*/, bool) {
+            record(name + ":prepare_starting:" + to_string(run_identifier));
+        };
+        hooks.starting = [this, name]() { record(name + ":starting"); };
+        hooks.pre_stopping = [this, name]() { record(name + ":pre_stopping"); };
+        hooks.stopping = [this, name]() { record(name + ":stopping"); };
+        register_role(std::move(hooks));
+    }
+
+    std::vector<std::string> getCalls() {
+        const std::lock_guard lock {mutex_};
+        return std::exchange(calls_, {});
+    }
+
+private:
+    void record(std::string call) {
+        const std::lock_guard lock {mutex_};
+        calls_.emplace_back(std::move(call));
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> calls_;
+};
+
 // NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
 
 TEST_CASE("Standard commands", "[satellite]") {
@@ -284,6 +331,152 @@ TEST_CASE("User commands", "[satellite]") {
     satellite.exit();
 }
 
+TEST_CASE("Asynchronous user commands", "[satellite]") {
+    // Create and start satellite
+    DummySatellite satellite {};
+
+    // Create sender
+    CSCPSender sender {satellite.getCommandPort()};
+
+    // my_cmd_async with argument as payload returns job identifier
+    auto usr_cmd_async_msg = CSCP1Message({"cscp_sender"}, {CSCP1Message::Type::REQUEST, "my_cmd_async"});
+    List args {};
+    args.push_back(4);
+    usr_cmd_async_msg.addPayload(args.assemble());
+    sender.send(usr_cmd_async_msg);
+
+    auto recv_msg_usr_cmd_async = sender.recv();
+    REQUIRE(recv_msg_usr_cmd_async.getVerb().first == CSCP1Message::Type::SUCCESS);
+    REQUIRE_THAT(to_string(recv_msg_usr_cmd_async.getVerb().second), Equals("Command queued as job 1"));
+    REQUIRE(recv_msg_usr_cmd_async.hasPayload());
+    const auto job_id = Value::disassemble(recv_msg_usr_cmd_async.getPayload()).get<std::uint64_t>();
+    REQUIRE(job_id == 1);
+
+    // Poll result until finished
+    CSCP1Message recv_msg_get_result {{"cscp_sender"}, {CSCP1Message::Type::REQUEST, ""}};
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(true) {
+        REQUIRE(std::chrono::steady_clock::now() < deadline);
+        auto get_result_msg = CSCP1Message({"cscp_sender"}, {CSCP1Message::Type::REQUEST, "_get_result"});
+        get_result_msg.addPayload(Value::set(job_id).assemble());
+        sender.send(get_result_msg);
+        recv_msg_get_result = sender.recv();
+        REQUIRE(recv_msg_get_result.getVerb().first == CSCP1Message::Type::SUCCESS);
+        if(recv_msg_get_result.getHeader().getTag<bool>("finished")) {
+            break;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE_THAT(to_string(recv_msg_get_result.getVerb().second), Equals("Command returned: 8"));
+    REQUIRE(recv_msg_get_result.getHeader().getTag<std::string>("command") == "my_cmd_async");
+    REQUIRE(Value::disassemble(recv_msg_get_result.getPayload()).get<int>() == 8);
+
+    // Result is removed after retrieval
+    auto get_result_again_msg = CSCP1Message({"cscp_sender"}, {CSCP1Message::Type::REQUEST, "_get_result"});
+    get_result_again_msg.addPayload(Value::set(job_id).assemble());
+    sender.send(get_result_again_msg);
+    auto recv_msg_get_result_again = sender.recv();
+    REQUIRE(recv_msg_get_result_again.getVerb().first == CSCP1Message::Type::INVALID);
+    REQUIRE_THAT(to_string(recv_msg_get_result_again.getVerb().second), Equals("Unknown command job 1"));
+
+    // Missing job identifier
+    sender.sendCommand("_get_result");
+    auto recv_msg_get_result_nopayload = sender.recv();
+    REQUIRE(recv_msg_get_result_nopayload.getVerb().first == CSCP1Message::Type::INCOMPLETE);
+
+    satellite.exit();
+}
+
+TEST_CASE("Asynchronous user commands stopped before destruction", "[satellite]") {
+    CommandRegistry registry {};
+    std::atomic_bool completed {false};
+    registry.add(
+        "slow",
+        "Slow command",
+        {},
+        std::function<void()>([&]() {
+            std::this_thread::sleep_for(100ms);
+            completed = true;
+        }),
+        true);
+
+    // Stopping the workers waits for running jobs
+    const auto job_id = registry.call(CSCP::State::NEW, "slow", {}).get<std::uint64_t>();
+    std::this_thread::sleep_for(10ms);
+    registry.stopWorkers();
+    REQUIRE(completed);
+    REQUIRE(registry.getResult(job_id).value().status == CommandRegistry::JobStatus::FINISHED);
+
+    // Jobs queued afterwards fail without being executed
+    completed = false;
+    const auto failed_job_id = registry.call(CSCP::State::NEW, "slow", {}).get<std::uint64_t>();
+    const auto failed_result = registry.getResult(failed_job_id).value();
+    REQUIRE(failed_result.status == CommandRegistry::JobStatus::FAILED);
+    REQUIRE(failed_result.error == "Command workers are stopped");
+    REQUIRE_FALSE(completed);
+}
+
+TEST_CASE("Transitions rejected during asynchronous user commands", "[satellite]") {
+    class AsyncSatellite : public DummySatellite<> {
+    public:
+        AsyncSatellite() {
+            register_command("blocking",
+                             "Command blocking until released",
+                             {CSCP::State::NEW},
+                             std::function<void()>([this]() {
+                                 while(!released) {
+                                     std::this_thread::sleep_for(10ms);
+                                 }
+                             }),
+                             true);
+        }
+        std::atomic_bool released {false};
+    };
+
+    // Create and start satellite
+    AsyncSatellite satellite {};
+
+    // Create sender
+    CSCPSender sender {satellite.getCommandPort()};
+
+    // Asynchronous commands allowed in all states do not block transitions
+    auto usr_cmd_async_msg = CSCP1Message({"cscp_sender"}, {CSCP1Message::Type::REQUEST, "my_cmd_async"});
+    List args {};
+    args.push_back(4);
+    usr_cmd_async_msg.addPayload(args.assemble());
+    sender.send(usr_cmd_async_msg);
+    REQUIRE(sender.recv().getVerb().first == CSCP1Message::Type::SUCCESS);
+
+    // Queue command restricted to NEW state
+    sender.sendCommand("blocking");
+    REQUIRE(sender.recv().getVerb().first == CSCP1Message::Type::SUCCESS);
+
+    // Transition is rejected while the command is running
+    const auto send_initialize = [&]() {
+        auto initialize_msg = CSCP1Message({"cscp_sender"}, {CSCP1Message::Type::REQUEST, "initialize"});
+        initialize_msg.addPayload(Dictionary().assemble());
+        sender.send(initialize_msg);
+        return sender.recv();
+    };
+    auto recv_msg_rejected = send_initialize();
+    REQUIRE(recv_msg_rejected.getVerb().first == CSCP1Message::Type::INVALID);
+    REQUIRE_THAT(to_string(recv_msg_rejected.getVerb().second),
+                 Equals("Transition initialize not possible while 1 asynchronous command jobs are running"));
+    REQUIRE(satellite.getState() == CSCP::State::NEW);
+
+    // Transition is accepted once the command has completed
+    satellite.released = true;
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while(send_initialize().getVerb().first != CSCP1Message::Type::SUCCESS) {
+        REQUIRE(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(10ms);
+    }
+    satellite.progressFsm();
+    REQUIRE(satellite.getState() == CSCP::State::INIT);
+
+    satellite.exit();
+}
+
 TEST_CASE("Case insensitive", "[satellite]") {
     // Create and start satellite
     DummySatellite satellite {};
@@ -333,6 +526,35 @@ TEST_CASE("Transitions", "[satellite]") {
     satellite.exit();
 }
 
+TEST_CASE("Role hooks", "[satellite]") {
+    RoleSatellite satellite {};
+
+    satellite.reactFSM(FSM::Transition::initialize, Configuration());
+    REQUIRE(satellite.getCalls() == std::vector<std::string>({"router:initializing", "builder:initializing"}));
+
+    satellite.reactFSM(FSM::Transition::launch);
+    REQUIRE(satellite.getCalls().empty());
+
+    satellite.reactFSM(FSM::Transition::start, "run1");
+    REQUIRE(satellite.getCalls() == std::vector<std::string>({"router:prepare_starting:run1",
+                                                              "builder:prepare_starting:run1",
+                                                              "router:starting",
+                                                              "builder:starting"}));
+
+    satellite.reactFSM(FSM::Transition::stop);
+    REQUIRE(satellite.getCalls() == std::vector<std::string>({"router:pre_stopping",
+                                                              "builder:pre_stopping",
+                                                              "router:stopping",
+                                                              "builder:stopping"}));
+
+    // Cyclic ordering constraints are rejected
+    REQUIRE_THROWS_MATCHES(satellite.addRole("router2", {"router2"}),
+                           RuntimeError,
+                           Message("Cyclic ordering constraints between satellite roles"));
+
+    satellite.exit();
+}
+
 TEST_CASE("Shutdown", "[satellite]") {
     // Create and start satellite
     DummySatellite satellite {};
@@ -4,26 +4,44 @@
  * SPDX-License-Identifier: EUPL-1.2
  */
 
+#include <atomic>
 #include <chrono> // IWYU pragma: keep
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include <asio/ip/address_v4.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
 
 #include "constellation/build.hpp"
 #include "constellation/core/config/Configuration.hpp"
 #include "constellation/core/config/Dictionary.hpp"
 #include "constellation/core/message/CDTP1Message.hpp"
+#include "constellation/core/message/DataFeedback.hpp"
+#include "constellation/core/networking/Datagram.hpp"
 #include "constellation/core/networking/exceptions.hpp"
+#include "constellation/core/networking/Port.hpp"
+#include "constellation/core/networking/zmq_helpers.hpp"
 #include "constellation/core/protocol/CDTP_definitions.hpp"
 #include "constellation/core/protocol/CHIRP_definitions.hpp"
+#include "constellation/core/utils/casts.hpp"
+#include "constellation/core/utils/exceptions.hpp"
 #include "constellation/core/utils/ManagerLocator.hpp"
 #include "constellation/core/utils/string.hpp"
 #include "constellation/satellite/FSM.hpp"
@@ -42,8 +60,12 @@ using namespace constellation::protocol;
 using namespace constellation::satellite;
 using namespace constellation::utils;
 using namespace std::chrono_literals;
+using namespace std::string_literals;
 
 class Receiver : public DummySatelliteNR<ReceiverSatellite> {
+public:
+    Receiver(std::string_view name = "sat1") : DummySatelliteNR<ReceiverSatellite>(name) {}
+
 protected:
     void receive_bor(const CDTP1Message::Header& header, Configuration config) override {
         const auto sender = to_string(header.getSender());
@@ -55,10 +77,19 @@ protected:
         bor_received_ = true;
     }
     void receive_data(CDTP1Message data_message) override {
+        if(throw_data_) {
+            throw Exception("Throwing in receive_data as requested");
+        }
+        // Simulate slow processing of data or a receiver which stopped reading
+        std::this_thread::sleep_for(data_delay_.load());
+        while(paused_.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
         const auto sender = to_string(data_message.getHeader().getSender());
         const std::lock_guard map_lock {map_mutex_};
         last_data_map_.erase(sender);
         last_data_map_.emplace(sender, std::move(data_message));
+        ++data_count_;
         data_received_ = true;
     }
     void receive_eor(const CDTP1Message::Header& header, Dictionary run_metadata) override {
@@ -68,6 +99,7 @@ protected:
         eor_map_.emplace(sender, std::move(run_metadata));
         eor_tag_map_.erase(sender);
         eor_tag_map_.emplace(sender, header.getTags());
+        ++eor_count_;
         eor_received_ = true;
     }
 
@@ -93,6 +125,16 @@ public:
         eor_received_.store(false);
     }
 
+    std::size_t getDataCount() const { return data_count_.load(); }
+
+    std::size_t getEORCount() const { return eor_count_.load(); }
+
+    void setDataDelay(std::chrono::milliseconds delay) { data_delay_.store(delay); }
+
+    void setPaused(bool paused) { paused_.store(paused); }
+
+    void setThrowData() { throw_data_ = true; }
+
     const Configuration& getBOR(const std::string& sender) {
         const std::lock_guard map_lock {map_mutex_};
         return bor_map_.at(sender);
@@ -119,6 +161,11 @@ private:
     std::atomic_bool bor_received_ {false};
     std::atomic_bool data_received_ {false};
     std::atomic_bool eor_received_ {false};
+    std::atomic_size_t data_count_ {0};
+    std::atomic_size_t eor_count_ {0};
+    std::atomic<std::chrono::milliseconds> data_delay_ {0ms};
+    std::atomic_bool paused_ {false};
+    std::atomic_bool throw_data_ {false};
     std::map<std::string, Configuration> bor_map_;
     std::map<std::string, Dictionary> bor_tag_map_;
     std::map<std::string, CDTP1Message> last_data_map_;
@@ -145,6 +192,162 @@ public:
     }
 };
 
+// Transmitter recording whether an additional preparation role overlaps with the user starting function
+class ParallelTransmitter : public Transmitter {
+public:
+    ParallelTransmitter() {
+        RoleHooks hooks {};
+        hooks.name = "probe";
+        hooks.prepare_starting = [this](std::string_view /*run_identifier*/, const Configuration& /*config*/, bool) {
+            preparing_ = true;
+            prepare_overlapped_ = await(user_starting_);
+        };
+        register_role(std::move(hooks));
+    }
+
+    void starting(std::string_view run_identifier) override {
+        // Run metadata modified in the user starting function should not be reset by the framework
+        markRunTainted();
+        user_starting_ = true;
+        starting_overlapped_ = await(preparing_);
+        Transmitter::starting(run_identifier);
+    }
+
+    bool overlapped() const { return prepare_overlapped_ && starting_overlapped_; }
+
+private:
+    static bool await(const std::atomic_bool& flag) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while(!flag && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return flag;
+    }
+
+    std::atomic_bool preparing_ {false};
+    std::atomic_bool user_starting_ {false};
+    std::atomic_bool prepare_overlapped_ {false};
+    std::atomic_bool starting_overlapped_ {false};
+};
+
+// Proxy between transmitter and receiver dropping data messages with given sequence numbers, optionally announcing a
+// retransmission service in the BOR which never replies
+class DropProxy {
+public:
+    DropProxy(Port transmitter_port, std::set<std::uint64_t> drop, bool stall_retransmission = false)
+        : pull_socket_(*global_zmq_context(), zmq::socket_type::pull),
+          push_socket_(*global_zmq_context(), zmq::socket_type::push), port_(bind_ephemeral_port(push_socket_)),
+          stall_socket_(*global_zmq_context(), zmq::socket_type::router), drop_(std::move(drop)) {
+        if(stall_retransmission) {
+            stall_port_ = bind_ephemeral_port(stall_socket_);
+        }
+        pull_socket_.set(zmq::sockopt::rcvtimeo, 50);
+        pull_socket_.connect("tcp://127.0.0.1:" + std::to_string(transmitter_port));
+        thread_ = std::jthread(std::bind_front(&DropProxy::loop, this));
+    }
+
+    Port getPort() const { return port_; }
+
+    std::size_t getDropped() const { return dropped_.load(); }
+
+private:
+    void loop(const std::stop_token& stop_token) {
+        while(!stop_token.stop_requested()) {
+            zmq::multipart_t frames {};
+            if(!frames.recv(pull_socket_)) {
+                continue;
+            }
+            const auto header =
+                CDTP1Message::Header::disassemble({to_byte_ptr(frames.front().data()), frames.front().size()});
+            if(header.getType() == CDTP1Message::Type::DATA && drop_.contains(header.getSequenceNumber())) {
+                ++dropped_;
+                continue;
+            }
+            if(header.getType() == CDTP1Message::Type::BOR && stall_port_.has_value()) {
+                auto bor_message = CDTP1Message::disassemble(frames);
+                bor_message.getHeader().setTag("retransmit_port", stall_port_.value());
+                frames = bor_message.assemble();
+            }
+            frames.send(push_socket_);
+        }
+    }
+
+private:
+    zmq::socket_t pull_socket_;
+    zmq::socket_t push_socket_;
+    Port port_;
+    zmq::socket_t stall_socket_;
+    std::optional<Port> stall_port_;
+    std::set<std::uint64_t> drop_;
+    std::atomic_size_t dropped_ {0};
+    std::jthread thread_;
+};
+
+namespace {
+    // Run with a group of slow receivers and return the time until all data messages are processed
+    std::chrono::steady_clock::duration run_receiver_group(std::size_t group_size, std::size_t messages) {
+        std::vector<std::unique_ptr<Receiver>> receivers {};
+        for(std::size_t n = 1; n <= group_size; ++n) {
+            receivers.emplace_back(std::make_unique<Receiver>("r" + std::to_string(n)));
+        }
+        auto transmitter = Transmitter();
+        transmitter.mockChirpService(CHIRP::DATA);
+
+        auto config_transmitter = Configuration();
+        config_transmitter.set("_bor_timeout", 1);
+        config_transmitter.set("_eor_timeout", 5);
+        config_transmitter.set("_receiver_group_size", group_size);
+
+        for(auto& receiver : receivers) {
+            auto config_receiver = Configuration();
+            config_receiver.set("_eor_timeout", 5);
+            config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+            receiver->reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+            receiver->reactFSM(FSM::Transition::launch);
+            receiver->reactFSM(FSM::Transition::start, "test");
+        }
+        transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+        transmitter.reactFSM(FSM::Transition::launch);
+        transmitter.reactFSM(FSM::Transition::start, "test");
+        for(auto& receiver : receivers) {
+            receiver->awaitBOR();
+            receiver->setDataDelay(1ms);
+        }
+
+        // Messages fit into the send queues, thus the duration is determined by the processing in the receivers
+        const auto start = std::chrono::steady_clock::now();
+        for(std::size_t n = 0; n < messages; ++n) {
+            transmitter.sendData(std::vector<int>({1, 2, 3, 4}));
+        }
+        const auto count_data = [&]() {
+            std::size_t count = 0;
+            for(const auto& receiver : receivers) {
+                count += receiver->getDataCount();
+            }
+            return count;
+        };
+        while(count_data() < messages) {
+            std::this_thread::sleep_for(1ms);
+        }
+        const auto duration = std::chrono::steady_clock::now() - start;
+
+        // Stop and send EOR
+        for(auto& receiver : receivers) {
+            receiver->reactFSM(FSM::Transition::stop, {}, false);
+        }
+        transmitter.reactFSM(FSM::Transition::stop);
+        for(auto& receiver : receivers) {
+            receiver->progressFsm();
+            receiver->awaitEOR();
+            REQUIRE(receiver->getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+            receiver->exit();
+        }
+        transmitter.exit();
+
+        return duration;
+    }
+} // namespace
+
 // NOLINTBEGIN(cert-err58-cpp,misc-use-anonymous-namespace)
 
 TEST_CASE("Receiver / No transmitters configured", "[satellite]") {
@@ -172,6 +375,33 @@ TEST_CASE("Transmitter / BOR timeout", "[satellite]") {
     transmitter.exit();
 }
 
+TEST_CASE("Transmitter / BOR timeout with parallel starting", "[satellite]") {
+    // Transmitter with a slow user starting function
+    class SlowTransmitter : public Transmitter {
+    public:
+        void starting(std::string_view run_identifier) override {
+            std::this_thread::sleep_for(800ms);
+            Transmitter::starting(run_identifier);
+        }
+    };
+
+    auto transmitter = SlowTransmitter();
+    auto config = Configuration();
+    config.set("_bor_timeout", 1);
+    config.set("_eor_timeout", 1);
+    config.set("_parallel_starting", true);
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config));
+    transmitter.reactFSM(FSM::Transition::launch);
+
+    // Waiting for receivers runs in parallel to the user starting function instead of after it
+    const auto start_time = std::chrono::steady_clock::now();
+    transmitter.reactFSM(FSM::Transition::start, "test");
+    REQUIRE(transmitter.getState() == FSM::State::ERROR);
+    REQUIRE(std::chrono::steady_clock::now() - start_time < 1500ms);
+
+    transmitter.exit();
+}
+
 TEST_CASE("Transmitter / DATA timeout", "[satellite]") {
     // Create CHIRP manager for data service discovery
     create_chirp_manager();
@@ -212,6 +442,46 @@ TEST_CASE("Transmitter / DATA timeout", "[satellite]") {
     ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
 }
 
+TEST_CASE("Receiver / Exception while waiting for EOR", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver = Receiver();
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 10);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_eor_timeout", 1);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+    receiver.awaitBOR();
+
+    // Start waiting for the EOR, then let the BasePool thread fail on the next data message
+    receiver.setThrowData();
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.sendData(std::vector<int>({1, 2, 3, 4}));
+
+    // Receiver fails with the exception instead of waiting for the EOR timeout
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(receiver.getState() != FSM::State::ERROR) {
+        REQUIRE(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(50ms);
+    }
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
 TEST_CASE("Successful run", "[satellite]") {
     // Create CHIRP manager for data service discovery
     create_chirp_manager();
@@ -234,6 +504,8 @@ TEST_CASE("Successful run", "[satellite]") {
     auto config2_transmitter = Configuration();
     config2_transmitter.set("_bor_timeout", 1);
     config2_transmitter.set("_eor_timeout", 1);
+    const auto compact_header = GENERATE(false, true);
+    config2_transmitter.set("_compact_header", compact_header);
     receiver.reactFSM(FSM::Transition::reconfigure, std::move(config2_receiver));
     transmitter.reactFSM(FSM::Transition::reconfigure, std::move(config2_transmitter));
 
@@ -259,6 +531,16 @@ TEST_CASE("Successful run", "[satellite]") {
     REQUIRE(data_msg.countPayloadFrames() == 1);
     REQUIRE(data_msg.getHeader().getTag<int>("test") == 1);
 
+    // Compact header is only used after the receiver announced support in its feedback
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while(transmitter.isCompactHeaderUsed() != compact_header && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE(transmitter.isCompactHeaderUsed() == compact_header);
+    REQUIRE(transmitter.trySendData(std::vector<int>({5, 6, 7, 8})));
+    receiver.awaitData();
+    REQUIRE(receiver.getLastData("Dummy.t1").getHeader().getSender() == "Dummy.t1");
+
     // Set a tag for EOR
     transmitter.setEORTag("buggy_events", 10);
 
@@ -287,6 +569,634 @@ TEST_CASE("Successful run", "[satellite]") {
     ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
 }
 
+TEST_CASE("Successful run with parallel starting", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver = Receiver();
+    auto transmitter = ParallelTransmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 1);
+    config_receiver.set("_parallel_starting", true);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_parallel_starting", true);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+
+    // Set a tag for BOR
+    transmitter.setBORTag("firmware_version", 3);
+
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+
+    // Wait a bit for BOR to be handled by receiver
+    receiver.awaitBOR();
+    REQUIRE(receiver.getBOR("Dummy.t1").get<bool>("_parallel_starting"));
+    REQUIRE(receiver.getBORTags("Dummy.t1").at("firmware_version").get<int>() == 3);
+
+    // Preparation and user starting function were executed at the same time
+    REQUIRE(transmitter.overlapped());
+
+    // Send a data frame
+    const auto sent = transmitter.trySendData(std::vector<int>({1, 2, 3, 4}));
+    REQUIRE(sent);
+    receiver.awaitData();
+    REQUIRE(receiver.getLastData("Dummy.t1").countPayloadFrames() == 1);
+
+    // Stop and send EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+
+    // Run marked as tainted in the user starting function
+    REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "TAINTED");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Successful run with receiver group", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver1 = Receiver("r1");
+    auto receiver2 = Receiver("r2");
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver1 = Configuration();
+    config_receiver1.set("_eor_timeout", 1);
+    config_receiver1.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+    auto config_receiver2 = Configuration();
+    config_receiver2.set("_eor_timeout", 1);
+    config_receiver2.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_receiver_group_size", 2);
+
+    receiver1.reactFSM(FSM::Transition::initialize, std::move(config_receiver1));
+    receiver2.reactFSM(FSM::Transition::initialize, std::move(config_receiver2));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver1.reactFSM(FSM::Transition::launch);
+    receiver2.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver1.reactFSM(FSM::Transition::start, "test");
+    receiver2.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+
+    // Both receivers need to receive the BOR
+    receiver1.awaitBOR();
+    receiver2.awaitBOR();
+    REQUIRE(receiver1.getBORTags("Dummy.t1").at("receiver_group_size").get<int>() == 2);
+    REQUIRE(receiver2.getBORTags("Dummy.t1").at("receiver_group_size").get<int>() == 2);
+
+    // Send data messages as fast as possible, they are distributed over both receivers
+    constexpr std::size_t messages = 10000;
+    for(std::size_t n = 0; n < messages; ++n) {
+        transmitter.sendData(std::vector<int>({1, 2, 3, 4}));
+    }
+    while(receiver1.getDataCount() + receiver2.getDataCount() < messages) {
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE(receiver1.getDataCount() + receiver2.getDataCount() == messages);
+    REQUIRE(receiver1.getDataCount() > 0);
+    REQUIRE(receiver2.getDataCount() > 0);
+
+    // Stop and send EOR
+    receiver1.reactFSM(FSM::Transition::stop, {}, false);
+    receiver2.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver1.progressFsm();
+    receiver2.progressFsm();
+
+    // Both receivers need to receive the EOR, the transmitter accounts all messages as received by the group
+    receiver1.awaitEOR();
+    receiver2.awaitEOR();
+    REQUIRE(receiver1.getEORTags("Dummy.t1").at("receiver_group_missed").get<std::uint64_t>() == 0);
+    REQUIRE(receiver2.getEORTags("Dummy.t1").at("receiver_group_missed").get<std::uint64_t>() == 0);
+    REQUIRE(receiver1.getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+    REQUIRE(receiver2.getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver1.getState() == FSM::State::ORBIT);
+    REQUIRE(receiver2.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver1.exit();
+    receiver2.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Receiver group with member which stopped reading", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver1 = Receiver("r1");
+    auto receiver2 = Receiver("r2");
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver1 = Configuration();
+    config_receiver1.set("_eor_timeout", 10);
+    config_receiver1.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+    auto config_receiver2 = Configuration();
+    config_receiver2.set("_eor_timeout", 10);
+    config_receiver2.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_receiver_group_size", 2);
+
+    receiver1.reactFSM(FSM::Transition::initialize, std::move(config_receiver1));
+    receiver2.reactFSM(FSM::Transition::initialize, std::move(config_receiver2));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver1.reactFSM(FSM::Transition::launch);
+    receiver2.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver1.reactFSM(FSM::Transition::start, "test");
+    receiver2.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+    receiver1.awaitBOR();
+    receiver2.awaitBOR();
+
+    // Second receiver stops reading, such that its queue fills up and the socket only sends to the first receiver
+    receiver2.setPaused(true);
+    constexpr std::size_t messages = 5000;
+    for(std::size_t n = 0; n < messages; ++n) {
+        transmitter.sendData(std::vector<int>(1024));
+    }
+
+    // Transmitter gives up waiting for the feedback of the second receiver and sends the EOR to both receivers
+    receiver1.reactFSM(FSM::Transition::stop, {}, false);
+    receiver2.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    // First receiver obtains exactly one EOR
+    receiver1.progressFsm();
+    receiver1.awaitEOR();
+    REQUIRE(receiver1.getState() == FSM::State::ORBIT);
+    REQUIRE(receiver1.getEORTags("Dummy.t1").at("receiver_group_missed").get<std::uint64_t>() > 0);
+
+    // Second receiver obtains its EOR after processing its queued messages once it reads again
+    receiver2.setPaused(false);
+    receiver2.progressFsm();
+    receiver2.awaitEOR();
+    REQUIRE(receiver2.getState() == FSM::State::ORBIT);
+    REQUIRE(receiver1.getEORCount() == 1);
+    REQUIRE(receiver2.getEORCount() == 1);
+    REQUIRE(receiver1.getDataCount() + receiver2.getDataCount() == messages);
+
+    receiver1.exit();
+    receiver2.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Receiver group increases throughput", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    constexpr std::size_t messages = 200;
+    const auto single_duration = run_receiver_group(1, messages);
+    const auto group_duration = run_receiver_group(2, messages);
+
+    // Slow receivers process messages in parallel, thus the group should be considerably faster
+    REQUIRE(group_duration < single_duration * 3 / 4);
+
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Run with dropped messages", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    const auto retransmit = GENERATE(true, false);
+
+    auto receiver = Receiver();
+    auto transmitter = Transmitter();
+
+    // Receiver connects to the proxy, which drops messages in the middle and at the end of the run
+    const DropProxy proxy {transmitter.getDataPort(), {2, 3, 5}};
+    const MockedChirpService mocked_service {"Dummy.t1", CHIRP::DATA, proxy.getPort()};
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 1);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_retransmit_buffer", retransmit ? 100 : 0);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+
+    receiver.awaitBOR();
+    REQUIRE(receiver.getBORTags("Dummy.t1").contains("retransmit_port") == retransmit);
+
+    for(int n = 1; n <= 5; ++n) {
+        transmitter.sendData(std::vector<int>({n}));
+    }
+
+    // Stop and send EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+    REQUIRE(proxy.getDropped() == 3);
+
+    if(retransmit) {
+        // Missing messages are recovered before the following message and the EOR are handled
+        REQUIRE(receiver.getDataCount() == 5);
+        REQUIRE(receiver.getLastData("Dummy.t1").getHeader().getSequenceNumber() == 5);
+        REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+    } else {
+        REQUIRE(receiver.getDataCount() == 2);
+        REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "INCOMPLETE");
+    }
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Pending retransmission does not block other transmitters", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver = Receiver();
+    auto transmitter1 = Transmitter("t1");
+    auto transmitter2 = Transmitter("t2");
+    transmitter2.mockChirpService(CHIRP::DATA);
+
+    // Retransmission requests to the first transmitter are never answered
+    const DropProxy proxy {transmitter1.getDataPort(), {2}, true};
+    const MockedChirpService mocked_service {"Dummy.t1", CHIRP::DATA, proxy.getPort()};
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 5);
+    config_receiver.set("_retransmit_timeout", 1000);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1", "Dummy.t2"});
+
+    auto config_transmitter1 = Configuration();
+    config_transmitter1.set("_bor_timeout", 1);
+    config_transmitter1.set("_eor_timeout", 1);
+    config_transmitter1.set("_retransmit_buffer", 100);
+    auto config_transmitter2 = Configuration();
+    config_transmitter2.set("_bor_timeout", 1);
+    config_transmitter2.set("_eor_timeout", 1);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter1.reactFSM(FSM::Transition::initialize, std::move(config_transmitter1));
+    transmitter2.reactFSM(FSM::Transition::initialize, std::move(config_transmitter2));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter1.reactFSM(FSM::Transition::launch);
+    transmitter2.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter1.reactFSM(FSM::Transition::start, "test");
+    transmitter2.reactFSM(FSM::Transition::start, "test");
+
+    // Gap in the messages of the first transmitter holds back its following message until the retransmission times out
+    for(int n = 1; n <= 3; ++n) {
+        transmitter1.sendData(std::vector<int>({n}));
+    }
+    receiver.awaitData();
+    REQUIRE(receiver.getDataCount() == 1);
+
+    // Messages of the second transmitter are passed on meanwhile
+    const auto start = std::chrono::steady_clock::now();
+    transmitter2.sendData(std::vector<int>({4}));
+    receiver.awaitData();
+    REQUIRE(std::chrono::steady_clock::now() - start < 500ms);
+    REQUIRE(receiver.getDataCount() == 2);
+
+    // Held back message is passed on once the retransmission timed out
+    receiver.awaitData();
+    REQUIRE(receiver.getDataCount() == 3);
+    REQUIRE(receiver.getLastData("Dummy.t1").getHeader().getSequenceNumber() == 3);
+
+    // Stop and send EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter1.reactFSM(FSM::Transition::stop);
+    transmitter2.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+    REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "INCOMPLETE");
+    REQUIRE(receiver.getEOR("Dummy.t2").at("condition").get<std::string>() == "GOOD");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter1.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter2.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter1.exit();
+    transmitter2.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Backpressure from lagging receiver", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver = Receiver();
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 5);
+    config_receiver.set("_lagging_timeout", 50);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_backpressure_watermark", 20);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+
+    receiver.awaitBOR();
+    REQUIRE(receiver.getBORTags("Dummy.t1").contains("feedback_port"));
+    REQUIRE_FALSE(transmitter.isReceiverLagging());
+
+    // Slow receiver queues up messages and signals that it lags behind
+    receiver.setDataDelay(10ms);
+    constexpr std::size_t messages = 100;
+    for(std::size_t n = 0; n < messages; ++n) {
+        transmitter.sendData(std::vector<int>({1, 2, 3, 4}));
+    }
+    while(!transmitter.isReceiverLagging()) {
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE(transmitter.getReceiverBacklog() > 0);
+
+    // Receiver catches up once processing is fast again
+    receiver.setDataDelay(0ms);
+    while(receiver.getDataCount() < messages || transmitter.isReceiverLagging()) {
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE(transmitter.getReceiverBacklog() <= 20);
+
+    // Stop and send EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+    REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Transmitter / feedback of vanished receiver expires", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver = Receiver();
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 1);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+    receiver.awaitBOR();
+
+    const auto await_lagging = [&](bool lagging) {
+        const auto deadline = std::chrono::steady_clock::now() + 2s;
+        while(transmitter.isReceiverLagging() != lagging && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(10ms);
+        }
+        return transmitter.isReceiverLagging() == lagging;
+    };
+
+    // Another receiver reports once that it lags behind and then vanishes
+    const auto feedback_port = receiver.getBORTags("Dummy.t1").at("feedback_port").get<Port>();
+    zmq::socket_t socket {*global_zmq_context(), zmq::socket_type::dealer};
+    socket.connect("tcp://127.0.0.1:" + std::to_string(feedback_port));
+    DataFeedback(0, true).assemble().send(socket);
+    REQUIRE(await_lagging(true));
+
+    // Its feedback is discarded while the remaining receiver keeps sending feedback without receiving messages
+    REQUIRE(await_lagging(false));
+
+    // Stop and send EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+    REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Transmitter / in-flight byte limit", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    auto receiver = Receiver();
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 5);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    // Messages retained for retransmission keep their payload in flight
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_data_timeout", 1);
+    config_transmitter.set("_retransmit_buffer", 10);
+    config_transmitter.set("_max_inflight_bytes", 8192);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+    receiver.awaitBOR();
+
+    // Two messages of 4096 bytes exhaust the budget while they are retained after being sent
+    transmitter.sendData(std::vector<int>(1024, 1));
+    transmitter.sendData(std::vector<int>(1024, 2));
+    while(receiver.getDataCount() < 2) {
+        std::this_thread::sleep_for(10ms);
+    }
+    REQUIRE(transmitter.getInFlightBytes() == 8192);
+
+    // Retained messages are dropped to release their payload, such that sending resumes without waiting
+    REQUIRE(transmitter.trySendData(std::vector<int>(1024, 3)));
+    constexpr std::size_t messages = 20;
+    for(std::size_t n = 4; n <= messages; ++n) {
+        transmitter.sendData(std::vector<int>(1024, static_cast<int>(n)));
+        REQUIRE(transmitter.getInFlightBytes() <= 8192);
+    }
+    while(receiver.getDataCount() < messages) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    // Stop and send EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+    REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "GOOD");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Run over UDP", "[satellite]") {
+    // Create CHIRP manager for data service discovery
+    create_chirp_manager();
+
+    // Unicast to this host or multicast group on the loopback interface
+    const auto udp_address = GENERATE("127.0.0.1"s, "239.192.47.1"s);
+
+    // Find a free port by binding to an ephemeral port and releasing it again
+    const auto udp_port = DatagramReceiver(asio::ip::address_v4::loopback(), 0, 0).getPort();
+
+    auto receiver = Receiver();
+    auto transmitter = Transmitter();
+    transmitter.mockChirpService(CHIRP::DATA);
+
+    auto config_receiver = Configuration();
+    config_receiver.set("_eor_timeout", 1);
+    config_receiver.setArray<std::string>("_data_transmitters", {"Dummy.t1"});
+
+    auto config_transmitter = Configuration();
+    config_transmitter.set("_bor_timeout", 1);
+    config_transmitter.set("_eor_timeout", 1);
+    config_transmitter.set("_retransmit_buffer", 10);
+    config_transmitter.set("_data_transport", "UDP");
+    config_transmitter.set("_udp_address", udp_address);
+    config_transmitter.set("_udp_port", udp_port);
+    config_transmitter.set("_udp_interface", "127.0.0.1");
+    config_transmitter.set("_udp_datagram_size", 512);
+
+    receiver.reactFSM(FSM::Transition::initialize, std::move(config_receiver));
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config_transmitter));
+    receiver.reactFSM(FSM::Transition::launch);
+    transmitter.reactFSM(FSM::Transition::launch);
+    receiver.reactFSM(FSM::Transition::start, "test");
+    transmitter.reactFSM(FSM::Transition::start, "test");
+
+    // BOR announces the datagram address, messages cannot be retransmitted
+    receiver.awaitBOR();
+    const auto& bor_tags = receiver.getBORTags("Dummy.t1");
+    REQUIRE(bor_tags.at("udp_address").get<std::string>() == udp_address);
+    REQUIRE(bor_tags.at("udp_port").get<Port>() == udp_port);
+    REQUIRE(bor_tags.at("udp_datagram_size").get<std::uint64_t>() == 512);
+    REQUIRE_FALSE(bor_tags.contains("retransmit_port"));
+
+    // Large messages are fragmented into several datagrams
+    transmitter.sendData(std::vector<int>(4096, 1));
+    transmitter.sendData(std::vector<int>({2}));
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(receiver.getDataCount() < 2) {
+        REQUIRE(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(10ms);
+    }
+    const auto& data_msg = receiver.getLastData("Dummy.t1");
+    REQUIRE(data_msg.getHeader().getSequenceNumber() == 2);
+    REQUIRE(data_msg.getHeader().getTag<int>("test") == 1);
+
+    // Lost messages are counted as missed instead of waited for
+    transmitter.newDataMessage();
+    transmitter.sendData(std::vector<int>({4}));
+
+    // Stop and send EOR, all datagrams are handled before the EOR
+    receiver.reactFSM(FSM::Transition::stop, {}, false);
+    transmitter.reactFSM(FSM::Transition::stop);
+    receiver.progressFsm();
+    receiver.awaitEOR();
+    REQUIRE(receiver.getDataCount() == 3);
+    REQUIRE(receiver.getLastData("Dummy.t1").getHeader().getSequenceNumber() == 4);
+    REQUIRE(receiver.getEOR("Dummy.t1").at("condition").get<std::string>() == "INCOMPLETE");
+
+    // Ensure all satellite are happy
+    REQUIRE(receiver.getState() == FSM::State::ORBIT);
+    REQUIRE(transmitter.getState() == FSM::State::ORBIT);
+
+    receiver.exit();
+    transmitter.exit();
+    ManagerLocator::getCHIRPManager()->forgetDiscoveredServices();
+}
+
+TEST_CASE("Transmitter / UDP transport with receiver group", "[satellite]") {
+    auto transmitter = Transmitter();
+
+    auto config = Configuration();
+    config.set("_receiver_group_size", 2);
+    config.set("_data_transport", "UDP");
+    config.set("_udp_port", 47823);
+    transmitter.reactFSM(FSM::Transition::initialize, std::move(config));
+    REQUIRE(transmitter.getState() == FSM::State::ERROR);
+
+    transmitter.exit();
+}
+
 TEST_CASE("Tainted run", "[satellite]") {
     // Create CHIRP manager for data service discovery
     create_chirp_manager();
@@ -0,0 +1,306 @@
+/**
+ * @file
+ * @brief Headless CMDP recorder
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "constellation/build.hpp"
+#include "constellation/core/chirp/Manager.hpp"
+#include "constellation/core/log/Level.hpp"
+#include "constellation/core/log/log.hpp"
+#include "constellation/core/log/Logger.hpp"
+#include "constellation/core/message/CMDP1Message.hpp"
+#include "constellation/core/networking/zmq_helpers.hpp"
+#include "constellation/core/protocol/CHIRP_definitions.hpp"
+#include "constellation/core/utils/enum.hpp"
+#include "constellation/core/utils/ManagerLocator.hpp"
+#include "constellation/core/utils/string.hpp"
+#include "constellation/listener/CMDPRecorder.hpp"
+
+using namespace constellation;
+using namespace constellation::listener;
+using namespace constellation::log;
+using namespace constellation::message;
+using namespace constellation::networking;
+using namespace constellation::protocol;
+using namespace constellation::utils;
+using namespace std::chrono_literals;
+
+namespace {
+    // Use global std::function to work around C linkage
+    std::function<void(int)> signal_handler_f {}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace
+
+extern "C" void signal_hander(int signal) {
+    signal_handler_f(signal);
+}
+
+namespace {
+
+    /**
+     * Generate CMDP topics for the recorder subscriptions
+     *
+     * @param level Lowest log level to record
+     * @param stats Metric names to record
+     * @return List of CMDP topics
+     */
+    std::vector<std::string> generate_topics(Level level, const std::vector<std::string>& stats) {
+        std::vector<std::string> topics {};
+        for(auto lvl = std::to_underlying(level); lvl < std::to_underlying(Level::OFF); ++lvl) {
+            topics.emplace_back("LOG/" + to_string(Level(lvl)));
+        }
+        std::ranges::for_each(stats, [&](const auto& stat) { topics.emplace_back("STAT/" + transform(stat, ::toupper)); });
+        return topics;
+    }
+
+    void record(argparse::ArgumentParser& parser, Logger& logger) {
+        const auto group = parser.get("group");
+        const auto name = parser.get("name");
+        const auto level = enum_cast<Level>(parser.get("level"));
+        if(!level.has_value()) {
+            throw std::invalid_argument("Log level " + parser.get("level") + " is not valid");
+        }
+
+        // Create CHIRP manager and set as default
+        auto chirp_manager = std::make_unique<chirp::Manager>("255.255.255.255", "0.0.0.0", group, name);
+        chirp_manager->start();
+        chirp_manager->sendRequest(CHIRP::ServiceIdentifier::MONITORING);
+        ManagerLocator::setDefaultCHIRPManager(std::move(chirp_manager));
+
+        CMDPRecordWriter writer {parser.get("output"),
+                                 parser.get<std::size_t>("max-size") * 1024 * 1024,
+                                 parser.get<std::size_t>("batch-size") * 1024};
+
+        // Received frames are passed to the writer without decoding them
+        CMDPRecorder recorder {writer, generate_topics(level.value(), parser.get<std::vector<std::string>>("stat"))};
+        recorder.startPool();
+
+        std::stop_source stop_source {};
+        signal_handler_f = [&](int /*signal*/) -> void { stop_source.request_stop(); };
+
+        // NOLINTBEGIN(cert-err33-c)
+        std::signal(SIGTERM, &signal_hander);
+        std::signal(SIGINT, &signal_hander);
+        // NOLINTEND(cert-err33-c)
+
+        LOG(logger, STATUS) << "Recording CMDP messages from group " << std::quoted(group);
+        auto last_flush = std::chrono::steady_clock::now();
+        while(!stop_source.stop_requested()) {
+            std::this_thread::sleep_for(100ms);
+
+            // Flush at least every second such that records are not held back for too long
+            if(std::chrono::steady_clock::now() - last_flush > 1s) {
+                writer.flush();
+                last_flush = std::chrono::steady_clock::now();
+            }
+
+            // Rethrow exceptions from the recorder
+            recorder.checkPoolException();
+        }
+
+        recorder.stopPool();
+        writer.flush();
+        LOG(logger, STATUS) << "Recorded " << writer.countMessages() << " messages (" << writer.countBytes() << " bytes)";
+    }
+
+    void replay(argparse::ArgumentParser& parser, Logger& logger) {
+        const auto csv = parser.get("format") == "csv";
+        if(csv) {
+            std::cout << "time,sender,type,topic,level,value,unit\n";
+        }
+
+        std::uint64_t count {0};
+        for(const auto& file : parser.get<std::vector<std::string>>("files")) {
+            CMDPRecordReader reader {file};
+            count += reader.exportMessages(std::cout, csv);
+        }
+        std::cout << std::flush;
+        LOG(logger, INFO) << "Exported " << count << " messages";
+    }
+
+    void benchmark(argparse::ArgumentParser& parser, Logger& logger) {
+        const auto count = parser.get<std::size_t>("count");
+        const auto target = parser.get<double>("target");
+        const auto directory = std::filesystem::temp_directory_path() / "cmdp_recorder_bench";
+        std::filesystem::create_directories(directory);
+
+        // CHIRP managers for the recorder and the local stand-in sender
+        auto chirp_manager = std::make_unique<chirp::Manager>("0.0.0.0", "0.0.0.0", "cmdp_recorder_bench", "recorder");
+        chirp_manager->start();
+        ManagerLocator::setDefaultCHIRPManager(std::move(chirp_manager));
+        chirp::Manager sender_chirp_manager {"0.0.0.0", "0.0.0.0", "cmdp_recorder_bench", "bench_sender"};
+        sender_chirp_manager.start();
+
+        // Stand-in sender without message limits such that no messages are dropped
+        zmq::socket_t pub_socket {*global_zmq_context(), zmq::socket_type::xpub};
+        pub_socket.set(zmq::sockopt::sndhwm, 0);
+        pub_socket.set(zmq::sockopt::rcvtimeo, 10000);
+        const auto port = bind_ephemeral_port(pub_socket);
+
+        std::uint64_t bytes {};
+        std::chrono::nanoseconds duration {};
+        {
+            // Record via the same path as the record command
+            CMDPRecordWriter writer {directory / "bench", std::size_t(512) * 1024 * 1024, std::size_t(1024) * 1024};
+            const auto topics = generate_topics(Level::INFO, {});
+            CMDPRecorder recorder {writer, topics};
+            recorder.startPool();
+            sender_chirp_manager.registerService(CHIRP::ServiceIdentifier::MONITORING, port);
+
+            // Wait for all subscriptions of the recorder to arrive at the sender
+            for(std::size_t n = 0; n < topics.size(); ++n) {
+                zmq::message_t subscription {};
+                if(!pub_socket.recv(subscription).has_value()) {
+                    throw std::runtime_error("Recorder did not subscribe to the stand-in sender");
+                }
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            std::jthread sender {[&]() {
+                for(std::size_t n = 0; n < count; ++n) {
+                    auto msg = CMDP1LogMessage(Level::INFO, "BENCH", {"bench_sender"}, "Benchmark message " + to_string(n));
+                    msg.assemble().send(pub_socket);
+                }
+            }};
+
+            // Wait until all messages are recorded, give up if no progress is made
+            auto recorded = writer.countMessages();
+            auto last_progress = std::chrono::steady_clock::now();
+            while(recorded < count) {
+                std::this_thread::sleep_for(1ms);
+                recorder.checkPoolException();
+                if(writer.countMessages() > recorded) {
+                    recorded = writer.countMessages();
+                    last_progress = std::chrono::steady_clock::now();
+                } else if(std::chrono::steady_clock::now() - last_progress > 5s) {
+                    throw std::runtime_error("Recorded only " + to_string(recorded) + " of " + to_string(count) +
+                                             " messages");
+                }
+            }
+            writer.flush();
+            duration = std::chrono::steady_clock::now() - start;
+            bytes = writer.countBytes();
+
+            recorder.stopPool();
+            sender_chirp_manager.unregisterServices();
+        }
+        std::filesystem::remove_all(directory);
+
+        const auto seconds = std::chrono::duration<double>(duration).count();
+        const auto rate = static_cast<double>(count) / seconds;
+        LOG(logger, STATUS) << "Recorded " << count << " messages (" << bytes << " bytes) in " << seconds << "s, " << rate
+                            << " messages/s";
+        if(rate < target) {
+            throw std::runtime_error("Recording rate below target of " + to_string(target) + " messages/s");
+        }
+    }
+
+    // NOLINTNEXTLINE(*-avoid-c-arrays)
+    void parse_args(int argc, char* argv[],
+                    argparse::ArgumentParser& parser,
+                    argparse::ArgumentParser& record_parser,
+                    argparse::ArgumentParser& replay_parser,
+                    argparse::ArgumentParser& bench_parser) {
+        // Record
+        record_parser.add_description("record CMDP messages to rotating binary files");
+        record_parser.add_argument("-g", "--group").help("group name").required();
+        record_parser.add_argument("-n", "--name").help("listener name").default_value("cmdp_recorder");
+        record_parser.add_argument("-o", "--output").help("output file prefix").default_value("cmdp_recording");
+        record_parser.add_argument("-l", "--level").help("lowest log level to record").default_value("INFO");
+        record_parser.add_argument("-s", "--stat")
+            .help("metric to record")
+            .nargs(argparse::nargs_pattern::any)
+            .default_value(std::vector<std::string>());
+        record_parser.add_argument("--max-size")
+            .help("maximum file size in MiB before rotating")
+            .scan<'u', std::size_t>()
+            .default_value(std::size_t(512));
+        record_parser.add_argument("--batch-size")
+            .help("size of write batches in KiB")
+            .scan<'u', std::size_t>()
+            .default_value(std::size_t(1024));
+        parser.add_subparser(record_parser);
+
+        // Replay
+        replay_parser.add_description("export recorded CMDP messages as text or CSV");
+        replay_parser.add_argument("files").help("recording files").nargs(argparse::nargs_pattern::at_least_one);
+        replay_parser.add_argument("-f", "--format").help("output format").choices("text", "csv").default_value("text");
+        parser.add_subparser(replay_parser);
+
+        // Benchmark
+        bench_parser.add_description("benchmark recording from a local stand-in sender");
+        bench_parser.add_argument("-c", "--count")
+            .help("number of messages")
+            .scan<'u', std::size_t>()
+            .default_value(std::size_t(1000000));
+        bench_parser.add_argument("-t", "--target")
+            .help("minimum required rate in messages per second")
+            .scan<'g', double>()
+            .default_value(100000.);
+        parser.add_subparser(bench_parser);
+
+        // Note: this might throw
+        parser.parse_args(argc, argv);
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // Get the default logger
+    auto& logger = Logger::getDefault();
+    ManagerLocator::getSinkManager().setConsoleLevels(INFO);
+
+    argparse::ArgumentParser parser {"cmdp_recorder", CNSTLN_VERSION_FULL};
+    argparse::ArgumentParser record_parser {"record"};
+    argparse::ArgumentParser replay_parser {"replay"};
+    argparse::ArgumentParser bench_parser {"bench"};
+    try {
+        parse_args(argc, argv, parser, record_parser, replay_parser, bench_parser);
+    } catch(const std::exception& error) {
+        LOG(logger, CRITICAL) << "Argument parsing failed: " << error.what();
+        LOG(logger, CRITICAL) << "Run " << std::quoted("cmdp_recorder --help") << " for help";
+        return 1;
+    }
+
+    try {
+        if(parser.is_subcommand_used(record_parser)) {
+            record(record_parser, logger);
+        } else if(parser.is_subcommand_used(replay_parser)) {
+            replay(replay_parser, logger);
+        } else if(parser.is_subcommand_used(bench_parser)) {
+            benchmark(bench_parser, logger);
+        } else {
+            std::cout << parser << std::flush;
+        }
+    } catch(const std::exception& error) {
+        LOG(logger, CRITICAL) << error.what();
+        return 1;
+    }
+    return 0;
+}
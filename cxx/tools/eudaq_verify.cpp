@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @brief Offline verification and indexing of EUDAQ2 native binary files
+ *
+ * @copyright Copyright (c) 2024 DESY and the Constellation authors.
+ * This software is distributed under the terms of the EUPL-1.2 License, copied verbatim in the file "LICENSE.md".
+ * SPDX-License-Identifier: EUPL-1.2
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include "constellation/build.hpp"
+#include "constellation/core/log/log.hpp"
+#include "constellation/core/log/Logger.hpp"
+#include "constellation/core/utils/ManagerLocator.hpp"
+#include "constellation/data/EudaqFileVerifier.hpp"
+
+using namespace constellation;
+using namespace constellation::data;
+using namespace constellation::log;
+using namespace constellation::utils;
+
+namespace {
+
+    /**
+     * Write the event index as CSV
+     *
+     * @param verifier Verifier after verification of the file
+     * @param path Path of the CSV file
+     */
+    void write_index(const EudaqFileVerifier& verifier, const std::filesystem::path& path) {
+        std::ofstream file {path};
+        if(!file.good()) {
+            throw std::runtime_error("Failed to open " + path.string());
+        }
+
+        file << "offset,size,descriptor,flags,event,trigger,timestamp_begin,timestamp_end,blocks,subevents\n";
+        for(const auto& event : verifier.getIndex()) {
+            file << event.offset << "," << event.size << "," << event.descriptor << "," << event.flags << ","
+                 << event.event_number << "," << event.trigger_number << "," << event.timestamp_begin << ","
+                 << event.timestamp_end << "," << event.blocks << "," << event.subevents << "\n";
+        }
+    }
+
+    /**
+     * Print the summary of all streams in a file
+     *
+     * @param verifier Verifier after verification of the file
+     */
+    void print_summary(const EudaqFileVerifier& verifier) {
+        const auto optional_str = [](const auto& value) { return value.has_value() ? std::to_string(value.value()) : "-"; };
+
+        std::cout << std::left << std::setw(24) << "descriptor" << std::right << std::setw(8) << "BORE" << std::setw(12)
+                  << "first" << std::setw(12) << "last" << std::setw(8) << "EORE" << std::setw(12) << "events"
+                  << std::setw(12) << "missing" << std::setw(16) << "block bytes"
+                  << "\n";
+        for(const auto& [descriptor, stream] : verifier.getStreams()) {
+            std::cout << std::left << std::setw(24) << descriptor << std::right << std::setw(8)
+                      << optional_str(stream.bore_event) << std::setw(12) << optional_str(stream.first_event)
+                      << std::setw(12) << optional_str(stream.last_event) << std::setw(8)
+                      << optional_str(stream.eore_event) << std::setw(12) << stream.events << std::setw(12)
+                      << stream.missing_events << std::setw(16) << stream.block_bytes << "\n";
+        }
+    }
+
+    /**
+     * Verify a file and report the results
+     *
+     * @return True if the file is valid
+     */
+    bool verify_file(const std::filesystem::path& path, const argparse::ArgumentParser& parser, Logger& logger) {
+        EudaqFileVerifier verifier {path};
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto valid = verifier.verify();
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << path.string() << ": " << verifier.getIndex().size() << " events, " << verifier.getFileSize()
+                  << " bytes\n";
+        print_summary(verifier);
+
+        const auto max_issues = parser.get<std::size_t>("max-issues");
+        const auto& issues = verifier.getIssues();
+        for(std::size_t n = 0; n < issues.size() && n < max_issues; ++n) {
+            std::cout << "  at byte " << issues[n].offset << ": " << issues[n].message << "\n";
+        }
+        if(issues.size() > max_issues) {
+            std::cout << "  ... and " << issues.size() - max_issues << " more issues\n";
+        }
+        std::cout << std::flush;
+
+        if(parser.is_used("index")) {
+            auto index_path = std::filesystem::path(parser.get("index"));
+            if(parser.get<std::vector<std::string>>("files").size() > 1) {
+                // Write one index per file next to the given path
+                index_path.replace_filename(path.stem().string() + "_" + index_path.filename().string());
+            }
+            write_index(verifier, index_path);
+            LOG(logger, INFO) << "Wrote index to " << index_path;
+        }
+
+        LOG(logger, INFO) << "Verified " << path << " in " << seconds << "s, "
+                          << static_cast<double>(verifier.getFileSize()) / seconds / 1e6 << " MB/s";
+        if(!valid) {
+            LOG(logger, WARNING) << "Found " << issues.size() << " issues in " << path;
+        }
+        return valid;
+    }
+
+    // NOLINTNEXTLINE(*-avoid-c-arrays)
+    void parse_args(int argc, char* argv[], argparse::ArgumentParser& parser) {
+        parser.add_description("verify and index EUDAQ2 native binary files written by the EudaqNativeWriter satellite");
+        parser.add_argument("files")
+            .help("EUDAQ2 native binary files, optionally compressed as .raw.zst")
+            .nargs(argparse::nargs_pattern::at_least_one);
+        parser.add_argument("-i", "--index").help("write event index as CSV to this path");
+        parser.add_argument("--max-issues")
+            .help("maximum number of issues to print per file")
+            .scan<'u', std::size_t>()
+            .default_value(std::size_t(20));
+
+        // Note: this might throw
+        parser.parse_args(argc, argv);
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // Get the default logger
+    auto& logger = Logger::getDefault();
+    ManagerLocator::getSinkManager().setConsoleLevels(INFO);
+
+    argparse::ArgumentParser parser {"eudaq_verify", CNSTLN_VERSION_FULL};
+    try {
+        parse_args(argc, argv, parser);
+    } catch(const std::exception& error) {
+        LOG(logger, CRITICAL) << "Argument parsing failed: " << error.what();
+        LOG(logger, CRITICAL) << "Run " << std::quoted("eudaq_verify --help") << " for help";
+        return 1;
+    }
+
+    try {
+        bool valid = true;
+        for(const auto& file : parser.get<std::vector<std::string>>("files")) {
+            valid = verify_file(file, parser, logger) && valid;
+        }
+        return valid ? 0 : 2;
+    } catch(const std::exception& error) {
+        LOG(logger, CRITICAL) << error.what();
+        return 1;
+    }
+}
@@ -11,7 +11,7 @@ from typing import Any
 import msgpack  # type: ignore[import-untyped]
 import zmq
 
-from .protocol import MessageHeader, Protocol
+from .protocol import MessageHeader, Protocol, ext_hook
 
 
 class CDTPMessageIdentifier(Enum):
@@ -171,7 +171,7 @@ class DataTransmitter:
         # Retrieve payload
         if msg.msgtype in [CDTPMessageIdentifier.EOR, CDTPMessageIdentifier.BOR]:
             # decode single-frame EOR/BOR payload
-            msg.payload = msgpack.unpackb(binmsg[1])
+            msg.payload = msgpack.unpackb(binmsg[1], ext_hook=ext_hook)
         else:
             # one-or-many binary frames
             msg.payload = binmsg[1:]
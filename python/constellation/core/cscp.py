@@ -12,7 +12,7 @@ from typing import Any, Optional
 import msgpack  # type: ignore[import-untyped]
 import zmq
 
-from .protocol import MessageHeader, Protocol
+from .protocol import MessageHeader, Protocol, ext_hook
 
 
 class CSCPMessageVerb(Enum):
@@ -152,7 +152,7 @@ class CommandTransmitter:
         # convert to lower case:
         msg.msg = msg.msg.lower()
         try:
-            unpacker = msgpack.Unpacker()
+            unpacker = msgpack.Unpacker(ext_hook=ext_hook)
             unpacker.feed(cmdmsg[2])
             msg.payload = unpacker.unpack()
         except IndexError:
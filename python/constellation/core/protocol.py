@@ -11,8 +11,15 @@ from enum import StrEnum
 from typing import Any, Tuple
 
 import msgpack  # type: ignore[import-untyped]
+import numpy as np
 import zmq
 
+# MessagePack extension type of typed arrays
+TYPED_ARRAY_EXT_TYPE = 0x43
+
+# Element types of typed arrays in order of their dtype marker
+TYPED_ARRAY_DTYPES = ["<i1", "<u1", "<i2", "<u2", "<i4", "<u4", "<i8", "<u8", "<f4", "<f8"]
+
 
 class Protocol(StrEnum):
     CDTP = "CDTP\x01"
@@ -21,6 +28,25 @@ class Protocol(StrEnum):
     CHP = "CHP\x01"
 
 
+def ext_hook(code: int, data: bytes) -> Any:
+    """Decode MessagePack extension types used by Constellation.
+
+    Typed arrays consist of a dtype marker, the number of padding bytes, the
+    padding and the little-endian element data. They are returned as read-only
+    numpy arrays viewing the message data.
+
+    """
+    if code != TYPED_ARRAY_EXT_TYPE:
+        return msgpack.ExtType(code, data)
+    if len(data) < 2 or data[0] >= len(TYPED_ARRAY_DTYPES) or 2 + data[1] > len(data):
+        raise ValueError("Malformed typed array")
+    dtype = np.dtype(TYPED_ARRAY_DTYPES[data[0]])
+    offset = 2 + data[1]
+    if (len(data) - offset) % dtype.itemsize != 0:
+        raise ValueError("Malformed typed array")
+    return np.frombuffer(data, dtype=dtype, offset=offset)
+
+
 class MessageHeader:
     """Class implementing a Constellation message header."""
 
@@ -53,7 +79,7 @@ class MessageHeader:
         self, header: Any
     ) -> Tuple[str, msgpack.Timestamp, dict[str, Any] | None] | Tuple[str, int, int, dict[str, Any] | None]:
         """Decode header string and return host, timestamp and meta map."""
-        unpacker = msgpack.Unpacker()
+        unpacker = msgpack.Unpacker(ext_hook=ext_hook)
         unpacker.feed(header)
         protocol = unpacker.unpack()
         if not protocol == self.protocol.value:
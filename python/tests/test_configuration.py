@@ -5,10 +5,13 @@ SPDX-License-Identifier: EUPL-1.2
 
 import time
 
+import msgpack
+import numpy as np
 import pytest
 
 from constellation.core.configuration import flatten_config
 from constellation.core.cscp import CSCPMessageVerb
+from constellation.core.protocol import TYPED_ARRAY_EXT_TYPE, ext_hook
 
 
 @pytest.mark.forked
@@ -53,3 +56,16 @@ def test_config_flattening(rawconfig):
     assert flatten_config(rawconfig, "nonsatellite"), "Missing dict for non-existing class"
     assert "verbosity" in flatten_config(rawconfig, "nonsatellite"), "Missing value for non-existing class"
     assert flatten_config(rawconfig, "mocksat", "device3"), "Missing dict for not explicitly-defined sat"
+
+
+def test_typed_array_decoding():
+    # Float array with two padding bytes
+    table = np.array([0.5, 1.5, -2.0], dtype="<f4")
+    ext = msgpack.ExtType(TYPED_ARRAY_EXT_TYPE, bytes([8, 2, 0, 0]) + table.tobytes())
+    payload = msgpack.unpackb(msgpack.packb({"table": ext}), ext_hook=ext_hook)
+    np.testing.assert_array_equal(payload["table"], table)
+
+    # Unknown dtype
+    with pytest.raises(ValueError):
+        msgpack.unpackb(msgpack.packb(msgpack.ExtType(TYPED_ARRAY_EXT_TYPE, bytes([10, 0]))), ext_hook=ext_hook)
+